@@ -0,0 +1,269 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_ber.c
+///	@brief Goodput against bit error rate
+///
+/// Sends frames over a simulated binary symmetric channel and measures the
+/// goodput of a link that retransmits every frame not received correctly:
+///   goodput = payload bytes delivered correctly / bytes sent (with delimiters)
+///
+/// Modes:
+///  - hash8: plain frame, only the 8 bit hash
+///  - crc32c: CRC-32C check
+///  - fec: CRC-32C check and Reed-Solomon parity, repaired before decoding
+///
+/// A bit error that creates a 0x00, or damages the delimiter, splits or merges
+/// frames; such frames are lost. Frames decoded with wrong data are counted as
+/// undetected and do not count as delivered.
+///
+/// Usage: dzcobs_bench_ber [payload size] [frames per point] [FEC t]
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_fec.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_MAX_PAYLOAD ( 4096 )
+#define BENCH_MAX_FRAME ( ( BENCH_MAX_PAYLOAD * 2 ) + 64 )
+
+typedef enum e_BENCH_mode
+{
+	BENCH_MODE_HASH8 = 0,
+	BENCH_MODE_CRC32C,
+	BENCH_MODE_FEC,
+	BENCH_MODE_N
+} eBENCH_mode;
+
+typedef struct s_BENCH_result
+{
+	size_t bytesSent;
+	size_t bytesDelivered;
+	size_t framesLost;
+	size_t framesUndetected;
+	size_t framesRepaired;
+} sBENCH_result;
+
+static const char *const s_modeNames[BENCH_MODE_N] = { "hash8", "crc32c", "fec" };
+
+static const double s_bitErrorRates[] = { 0.0, 1e-6, 1e-5, 3e-5, 1e-4, 3e-4, 1e-3, 3e-3, 1e-2 };
+
+static uint64_t s_rngState = 0x9E3779B97F4A7C15ULL;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static uint64_t bench_rand( void )
+{
+	// xorshift64*, so the results are the same on every platform
+	s_rngState ^= s_rngState >> 12;
+	s_rngState ^= s_rngState << 25;
+	s_rngState ^= s_rngState >> 27;
+	return s_rngState * 0x2545F4914F6CDD1DULL;
+}
+
+static double bench_rand_unit( void )
+{
+	return (double)( ( bench_rand() >> 11 ) + 1 ) / 9007199254740993.0; // (0, 1)
+}
+
+/**
+ * @brief Flip the bits of the buffer with the bit error rate, using geometric
+ * distributed gaps between errors.
+ *
+ * @return size_t Number of flipped bits
+ */
+static size_t bench_channel( uint8_t *aBuf, size_t aSize, double aBitErrorRate )
+{
+	if( aBitErrorRate <= 0.0 )
+	{
+		return 0;
+	}
+
+	const double logNoError = log( 1.0 - aBitErrorRate );
+	const size_t nBits			= aSize * 8;
+
+	size_t nFlips = 0;
+	size_t bit		= (size_t)( log( bench_rand_unit() ) / logNoError );
+
+	while( bit < nBits )
+	{
+		aBuf[bit / 8] ^= (uint8_t)( 1 << ( bit % 8 ) );
+		nFlips++;
+		bit += 1 + (size_t)( log( bench_rand_unit() ) / logNoError );
+	}
+
+	return nFlips;
+}
+
+static size_t bench_encode( eBENCH_mode aMode, uint8_t aFecT, const uint8_t *aPayload, size_t aSize, uint8_t *aFrame )
+{
+	sDZCOBS_ctx ctx;
+	size_t encodedLen = 0;
+
+	eDZCOBS_ret ret = dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, aFrame, BENCH_MAX_FRAME );
+	ctx.user6bits		= 1;
+
+	if( aMode != BENCH_MODE_HASH8 )
+	{
+		ret |= dzcobs_encode_set_check( &ctx, DZCOBS_CHECK_CRC32C );
+	}
+
+	if( aMode == BENCH_MODE_FEC )
+	{
+		ret |= dzcobs_encode_set_fec( &ctx, aFecT );
+	}
+
+	ret |= dzcobs_encode_inc( &ctx, aPayload, aSize );
+	ret |= dzcobs_encode_inc_end( &ctx, &encodedLen );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		fprintf( stderr, "encode failed\n" );
+		exit( EXIT_FAILURE );
+	}
+
+	// Frame delimiter
+	aFrame[encodedLen] = 0;
+
+	return encodedLen + 1;
+}
+
+static void bench_point( eBENCH_mode aMode,
+												 uint8_t aFecT,
+												 double aBitErrorRate,
+												 size_t aPayloadSize,
+												 size_t aNFrames,
+												 sBENCH_result *aOutResult )
+{
+	static uint8_t payload[BENCH_MAX_PAYLOAD];
+	static uint8_t frame[BENCH_MAX_FRAME];
+	static uint8_t decoded[BENCH_MAX_PAYLOAD];
+
+	memset( aOutResult, 0, sizeof( *aOutResult ) );
+
+	for( size_t n = 0; n < aNFrames; n++ )
+	{
+		for( size_t i = 0; i < aPayloadSize; i++ )
+		{
+			payload[i] = (uint8_t)bench_rand();
+		}
+
+		const size_t frameLen = bench_encode( aMode, aFecT, payload, aPayloadSize, frame );
+
+		aOutResult->bytesSent += frameLen;
+
+		if( bench_channel( frame, frameLen, aBitErrorRate ) == 0 )
+		{
+			aOutResult->bytesDelivered += aPayloadSize;
+			continue;
+		}
+
+		// The receiver splits the stream on 0x00
+		if( memchr( frame, 0, frameLen - 1 ) || ( frame[frameLen - 1] != 0 ) )
+		{
+			aOutResult->framesLost++;
+			continue;
+		}
+
+		if( aMode == BENCH_MODE_FEC )
+		{
+			size_t corrected = 0;
+
+			if( ( dzcobs_fec_repair( frame, frameLen - 1, &corrected ) == DZCOBS_RET_SUCCESS ) && ( corrected > 0 ) )
+			{
+				aOutResult->framesRepaired++;
+			}
+		}
+
+		sDZCOBS_decodectx decodeCtx;
+		memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+		decodeCtx.srcBufEncoded			= frame;
+		decodeCtx.srcBufEncodedLen	= frameLen - 1;
+		decodeCtx.dstBufDecoded			= decoded;
+		decodeCtx.dstBufDecodedSize = sizeof( decoded );
+
+		size_t decodedLen = 0;
+		uint8_t user6bits = 0;
+
+		if( dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) != DZCOBS_RET_SUCCESS )
+		{
+			aOutResult->framesLost++;
+		}
+		else if( ( decodedLen != aPayloadSize ) || ( memcmp( payload, decoded, aPayloadSize ) != 0 ) )
+		{
+			aOutResult->framesUndetected++;
+		}
+		else
+		{
+			aOutResult->bytesDelivered += aPayloadSize;
+		}
+	}
+}
+
+int main( int argc, char **argv )
+{
+	const size_t payloadSize = ( argc > 1 ) ? (size_t)strtoul( argv[1], NULL, 0 ) : 256;
+	const size_t nFrames		 = ( argc > 2 ) ? (size_t)strtoul( argv[2], NULL, 0 ) : 20000;
+	const uint8_t fecT			 = ( argc > 3 ) ? (uint8_t)strtoul( argv[3], NULL, 0 ) : 8;
+
+	if( ( payloadSize == 0 ) || ( payloadSize > BENCH_MAX_PAYLOAD ) || ( fecT == 0 ) || ( fecT > DZCOBS_FEC_MAX_T ) )
+	{
+		fprintf( stderr, "usage: %s [payload size 1..%d] [frames per point] [FEC t 1..%d]\n",
+						 argv[0],
+						 BENCH_MAX_PAYLOAD,
+						 DZCOBS_FEC_MAX_T );
+		return EXIT_FAILURE;
+	}
+
+	printf( "payload %zu bytes, %zu frames per point, FEC t = %u\n\n", payloadSize, nFrames, fecT );
+	printf( "%-8s", "BER" );
+
+	for( int mode = 0; mode < BENCH_MODE_N; mode++ )
+	{
+		printf( " | %-8s goodput  lost  undet", s_modeNames[mode] );
+	}
+
+	printf( "\n" );
+
+	for( size_t i = 0; i < ( sizeof( s_bitErrorRates ) / sizeof( s_bitErrorRates[0] ) ); i++ )
+	{
+		printf( "%-8.0e", s_bitErrorRates[i] );
+
+		for( int mode = 0; mode < BENCH_MODE_N; mode++ )
+		{
+			sBENCH_result result;
+			bench_point( (eBENCH_mode)mode, fecT, s_bitErrorRates[i], payloadSize, nFrames, &result );
+
+			printf( " | %16.3f %5.1f%% %6zu",
+							(double)result.bytesDelivered / (double)result.bytesSent,
+							( 100.0 * (double)result.framesLost ) / (double)nFrames,
+							result.framesUndetected );
+		}
+
+		printf( "\n" );
+	}
+
+	return EXIT_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
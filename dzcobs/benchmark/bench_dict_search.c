@@ -0,0 +1,327 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_dict_search.c
+///	@brief Memory and speed of the dictionary search engines
+///
+/// For each dictionary, reports the memory of the default binary search (the
+/// sDICT_ctx only), of the packed keys and of the search automaton (sDICT_ctx
+/// and their tables), and the dictionary encoding throughput with each of them.
+/// The encoded frames are checked to be the same with all the engines.
+///
+/// Dictionaries: the default one, and dictionaries learned with dzcobs_learn
+/// from the benchmark data with 32 and 126 words.
+///
+/// Usage: dzcobs_bench_dict_search [data size] [repetitions]
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_dictionary.h>
+#include <dzcobs/dzcobs_learn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_PAYLOAD_SIZE ( 256 )
+#define BENCH_MAX_AUTOMATON_SIZE ( 64 * 1024 )
+#define BENCH_MAX_PACKED_SIZE ( 2 * 1024 )
+
+static uint64_t s_rngState = 0x9E3779B97F4A7C15ULL;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static uint64_t bench_rand( void )
+{
+	// xorshift64*, so the results are the same on every platform
+	s_rngState ^= s_rngState >> 12;
+	s_rngState ^= s_rngState << 25;
+	s_rngState ^= s_rngState >> 27;
+	return s_rngState * 0x2545F4914F6CDD1DULL;
+}
+
+/// Telemetry like text lines
+static void bench_make_data( uint8_t *aData, size_t aSize )
+{
+	static const char *const states[] = { "idle", "run", "fault", "sleep" };
+
+	size_t offset = 0;
+
+	while( offset < aSize )
+	{
+		char line[96];
+
+		const int len = snprintf( line,
+															sizeof( line ),
+															"{\"id\":%u,\"temp\":%u.%u,\"state\":\"%s\",\"err\":%u}\r\n",
+															(unsigned)( bench_rand() % 100000 ),
+															(unsigned)( bench_rand() % 50 ),
+															(unsigned)( bench_rand() % 10 ),
+															states[bench_rand() % 4],
+															(unsigned)( bench_rand() % 3 ) );
+
+		for( int i = 0; ( i < len ) && ( offset < aSize ); i++ )
+		{
+			aData[offset++] = (uint8_t)line[i];
+		}
+	}
+}
+
+/// Encode all the data in payloads, returns the encoded bytes and the time spent
+static size_t bench_encode( const sDICT_ctx *aDict,
+														const uint8_t *aData,
+														size_t aSize,
+														size_t aRepetitions,
+														uint8_t *aOutFrames,
+														double *aOutSeconds )
+{
+	size_t total = 0;
+
+	const clock_t start = clock();
+
+	for( size_t rep = 0; rep < aRepetitions; rep++ )
+	{
+		uint8_t *pFrame = aOutFrames;
+
+		for( size_t offset = 0; offset < aSize; offset += BENCH_PAYLOAD_SIZE )
+		{
+			const size_t payloadSize = ( ( aSize - offset ) < BENCH_PAYLOAD_SIZE ) ? ( aSize - offset ) : BENCH_PAYLOAD_SIZE;
+
+			sDZCOBS_ctx ctx;
+			memset( &ctx, 0, sizeof( ctx ) );
+
+			size_t encodedSize = 0;
+
+			if( ( dzcobs_encode_set_dictionary( &ctx, aDict, DZCOBS_USING_DICT_1 ) != DZCOBS_RET_SUCCESS ) ||
+					( dzcobs_encode_inc_begin( &ctx,
+																		 DZCOBS_USING_DICT_1,
+																		 pFrame,
+																		 DZCOBS_MAX_ENCODED_SIZE( BENCH_PAYLOAD_SIZE ) + DZCOBS_FRAME_HEADER_SIZE ) !=
+						DZCOBS_RET_SUCCESS ) )
+			{
+				fprintf( stderr, "encode begin failed\n" );
+				exit( EXIT_FAILURE );
+			}
+
+			ctx.user6bits = 1;
+
+			if( ( dzcobs_encode_inc( &ctx, aData + offset, payloadSize ) != DZCOBS_RET_SUCCESS ) ||
+					( dzcobs_encode_inc_end( &ctx, &encodedSize ) != DZCOBS_RET_SUCCESS ) )
+			{
+				fprintf( stderr, "encode failed\n" );
+				exit( EXIT_FAILURE );
+			}
+
+			pFrame += encodedSize;
+		}
+
+		total = (size_t)( pFrame - aOutFrames );
+	}
+
+	*aOutSeconds = (double)( clock() - start ) / (double)CLOCKS_PER_SEC;
+
+	return total;
+}
+
+static void bench_dictionary( const char *aName,
+															const char *aDictionary,
+															size_t aDictionarySize,
+															const uint8_t *aData,
+															size_t aSize,
+															size_t aRepetitions )
+{
+	static uint16_t automaton[BENCH_MAX_AUTOMATON_SIZE / sizeof( uint16_t )];
+	static uint64_t packed[BENCH_MAX_PACKED_SIZE / sizeof( uint64_t )];
+
+	const size_t framesSize = ( ( aSize / BENCH_PAYLOAD_SIZE ) + 1 ) *
+														( DZCOBS_MAX_ENCODED_SIZE( BENCH_PAYLOAD_SIZE ) + DZCOBS_FRAME_HEADER_SIZE );
+
+	uint8_t *pFramesBinary		= malloc( framesSize );
+	uint8_t *pFramesPacked		= malloc( framesSize );
+	uint8_t *pFramesAutomaton = malloc( framesSize );
+
+	sDICT_ctx dictBinary;
+	sDICT_ctx dictPacked;
+	sDICT_ctx dictAutomaton;
+
+	if( ( pFramesBinary == NULL ) || ( pFramesPacked == NULL ) || ( pFramesAutomaton == NULL ) ||
+			( dzcobs_dictionary_init( &dictBinary, aDictionary, aDictionarySize ) != DICT_RET_SUCCESS ) ||
+			( dzcobs_dictionary_init( &dictPacked, aDictionary, aDictionarySize ) != DICT_RET_SUCCESS ) ||
+			( dzcobs_dictionary_init( &dictAutomaton, aDictionary, aDictionarySize ) != DICT_RET_SUCCESS ) )
+	{
+		fprintf( stderr, "%s: init failed\n", aName );
+		exit( EXIT_FAILURE );
+	}
+
+	const size_t packedSize		 = dzcobs_dictionary_packed_size( &dictPacked );
+	const size_t automatonSize = dzcobs_dictionary_automaton_size( &dictAutomaton );
+
+	if( dzcobs_dictionary_packed_init( &dictPacked, packed, sizeof( packed ) ) != DICT_RET_SUCCESS )
+	{
+		fprintf( stderr, "%s: packed keys of %zu bytes do not fit\n", aName, packedSize );
+		exit( EXIT_FAILURE );
+	}
+
+	if( dzcobs_dictionary_automaton_init( &dictAutomaton, automaton, sizeof( automaton ) ) != DICT_RET_SUCCESS )
+	{
+		fprintf( stderr, "%s: automaton of %zu bytes does not fit\n", aName, automatonSize );
+		exit( EXIT_FAILURE );
+	}
+
+	size_t nWords = 0;
+
+	for( size_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		nWords += dictBinary.wordSizeTable[i].nEntries;
+	}
+
+	double secondsBinary		= 0.0;
+	double secondsPacked		= 0.0;
+	double secondsAutomaton = 0.0;
+
+	const size_t encodedBinary = bench_encode( &dictBinary, aData, aSize, aRepetitions, pFramesBinary, &secondsBinary );
+	const size_t encodedPacked = bench_encode( &dictPacked, aData, aSize, aRepetitions, pFramesPacked, &secondsPacked );
+	const size_t encodedAutomaton =
+		bench_encode( &dictAutomaton, aData, aSize, aRepetitions, pFramesAutomaton, &secondsAutomaton );
+
+	if( ( encodedBinary != encodedPacked ) || ( encodedBinary != encodedAutomaton ) ||
+			( memcmp( pFramesBinary, pFramesPacked, encodedBinary ) != 0 ) ||
+			( memcmp( pFramesBinary, pFramesAutomaton, encodedBinary ) != 0 ) )
+	{
+		fprintf( stderr, "%s: the engines encoded different frames\n", aName );
+		exit( EXIT_FAILURE );
+	}
+
+	const double megabytes = (double)( aSize * aRepetitions ) / ( 1024.0 * 1024.0 );
+
+	printf( "%-12s | %5zu | %6.1f%% | %6zu | %6zu | %9zu | %6.1f | %6.1f | %9.1f\n",
+					aName,
+					nWords,
+					( 100.0 * (double)encodedBinary ) / (double)aSize,
+					sizeof( sDICT_ctx ),
+					sizeof( sDICT_ctx ) + packedSize,
+					sizeof( sDICT_ctx ) + automatonSize,
+					megabytes / secondsBinary,
+					megabytes / secondsPacked,
+					megabytes / secondsAutomaton );
+
+	free( pFramesBinary );
+	free( pFramesPacked );
+	free( pFramesAutomaton );
+}
+
+static size_t bench_learn( const uint8_t *aData, size_t aSize, size_t aMaxWords, char *aOutDict )
+{
+	static sDZCOBS_learn learn;
+
+	dzcobs_learn_init( &learn );
+
+	for( size_t offset = 0; offset < aSize; offset += BENCH_PAYLOAD_SIZE )
+	{
+		const size_t payloadSize = ( ( aSize - offset ) < BENCH_PAYLOAD_SIZE ) ? ( aSize - offset ) : BENCH_PAYLOAD_SIZE;
+
+		dzcobs_learn_update( &learn, aData + offset, payloadSize );
+		dzcobs_learn_payload_end( &learn );
+	}
+
+	size_t dictSize = 0;
+
+	if( dzcobs_learn_build( &learn, aOutDict, DZCOBS_LEARN_MAX_DICT_SIZE, &dictSize ) != DICT_RET_SUCCESS )
+	{
+		fprintf( stderr, "learn failed\n" );
+		exit( EXIT_FAILURE );
+	}
+
+	// Keep the first aMaxWords words, still sorted
+	size_t offset = 0;
+
+	for( size_t i = 0; ( i < aMaxWords ) && ( aOutDict[offset] != 0 ); i++ )
+	{
+		offset += (size_t)( aOutDict[offset] - '0' ) + 1;
+	}
+
+	aOutDict[offset] = 0;
+
+	return offset + 1;
+}
+
+int main( int argc, char **argv )
+{
+	const size_t dataSize		 = ( argc > 1 ) ? (size_t)strtoul( argv[1], NULL, 0 ) : ( 256 * 1024 );
+	const size_t repetitions = ( argc > 2 ) ? (size_t)strtoul( argv[2], NULL, 0 ) : 20;
+
+	if( ( dataSize == 0 ) || ( repetitions == 0 ) )
+	{
+		fprintf( stderr, "usage: %s [data size] [repetitions]\n", argv[0] );
+		return EXIT_FAILURE;
+	}
+
+	uint8_t *pData = malloc( dataSize );
+
+	if( pData == NULL )
+	{
+		fprintf( stderr, "out of memory\n" );
+		return EXIT_FAILURE;
+	}
+
+	bench_make_data( pData, dataSize );
+
+	static char learned32[DZCOBS_LEARN_MAX_DICT_SIZE];
+	static char learned126[DZCOBS_LEARN_MAX_DICT_SIZE];
+
+	const size_t learned32Size	= bench_learn( pData, dataSize, 32, learned32 );
+	const size_t learned126Size = bench_learn( pData, dataSize, 126, learned126 );
+
+	printf( "%zu bytes of text, %d bytes payloads, %zu repetitions\n\n", dataSize, BENCH_PAYLOAD_SIZE, repetitions );
+	printf( "%-12s | %5s | %7s | %6s | %6s | %9s | %6s | %6s | %9s\n",
+					"dictionary",
+					"words",
+					"encoded",
+					"binary",
+					"packed",
+					"automaton",
+					"binary",
+					"packed",
+					"automaton" );
+	printf( "%-12s | %5s | %7s | %6s | %6s | %9s | %6s | %6s | %9s\n",
+					"",
+					"",
+					"",
+					"bytes",
+					"bytes",
+					"bytes",
+					"MB/s",
+					"MB/s",
+					"MB/s" );
+
+	bench_dictionary( "default",
+										G_DZCOBS_DefaultDictionary,
+										G_DZCOBS_DefaultDictionary_size,
+										pData,
+										dataSize,
+										repetitions );
+	bench_dictionary( "learned 32", learned32, learned32Size, pData, dataSize, repetitions );
+	bench_dictionary( "learned 126", learned126, learned126Size, pData, dataSize, repetitions );
+
+	free( pData );
+
+	return EXIT_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,271 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_latency.c
+///	@brief High priority latency on a serial link, with and without fragmentation
+///
+/// Simulates a UART that is kept busy by a low priority log stream (large
+/// messages always queued) while short high priority control messages arrive
+/// at random times. The latency of a control message is measured from its
+/// submission until the last byte of its frame is on the wire.
+///
+/// Without fragmentation a control message may wait for a whole log message;
+/// with fragmentation it waits at most for one fragment. The link efficiency
+/// (log and control bytes / bytes on the wire) shows the cost of the extra
+/// frame headers.
+///
+/// Usage: dzcobs_bench_latency [baud rate] [log message size] [simulated seconds]
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_frag.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_MAX_LOG_SIZE ( DZCOBS_FRAG_MAX_FRAGMENTS * 32 )
+#define BENCH_CONTROL_SIZE ( 16 )
+#define BENCH_CONTROL_MEAN_PERIOD ( 0.02 ) ///< Mean time between control messages, seconds
+#define BENCH_MAX_PENDING_CONTROL ( 64 )
+#define BENCH_BITS_PER_BYTE ( 10 )				 ///< 8N1
+
+enum
+{
+	BENCH_PRIORITY_CONTROL = 0,
+	BENCH_PRIORITY_LOG		 = 3,
+	BENCH_STREAM_CONTROL	 = 1,
+	BENCH_STREAM_LOG			 = 2
+};
+
+typedef struct s_BENCH_result
+{
+	size_t nControl;
+	double maxLatency;
+	double sumLatency;
+	size_t bytesUseful;
+	size_t bytesOnWire;
+} sBENCH_result;
+
+static const size_t s_fragmentSizes[] = { 0, 512, 256, 128, 64, 32 };
+
+static uint64_t s_rngState = 0x9E3779B97F4A7C15ULL;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static uint64_t bench_rand( void )
+{
+	// xorshift64*, so the results are the same on every platform
+	s_rngState ^= s_rngState >> 12;
+	s_rngState ^= s_rngState << 25;
+	s_rngState ^= s_rngState >> 27;
+	return s_rngState * 0x2545F4914F6CDD1DULL;
+}
+
+static double bench_rand_unit( void )
+{
+	return (double)( ( bench_rand() >> 11 ) + 1 ) / 9007199254740993.0; // (0, 1)
+}
+
+static double bench_rand_exp( double aMean )
+{
+	return -log( bench_rand_unit() ) * aMean;
+}
+
+static void bench_run( size_t aFragmentSize,
+											 double aByteTime,
+											 const uint8_t *aLogData,
+											 size_t aLogSize,
+											 double aDuration,
+											 sBENCH_result *aOutResult )
+{
+	static uint8_t frame[DZCOBS_FRAG_MAX_FRAME_SIZE( BENCH_MAX_LOG_SIZE )];
+	static uint8_t controlData[BENCH_CONTROL_SIZE];
+
+	sDZCOBS_txmsg logMsg;
+	sDZCOBS_txmsg controlMsgs[BENCH_MAX_PENDING_CONTROL];
+	double controlArrival[BENCH_MAX_PENDING_CONTROL];
+	bool isControlPending[BENCH_MAX_PENDING_CONTROL];
+
+	memset( aOutResult, 0, sizeof( *aOutResult ) );
+	memset( isControlPending, 0, sizeof( isControlPending ) );
+
+	for( size_t i = 0; i < BENCH_CONTROL_SIZE; i++ )
+	{
+		controlData[i] = (uint8_t)( i + 1 );
+	}
+
+	sDZCOBS_txsched sched;
+
+	if( dzcobs_txsched_init( &sched, DZCOBS_PLAIN, NULL, aFragmentSize ) != DZCOBS_RET_SUCCESS )
+	{
+		fprintf( stderr, "init failed\n" );
+		exit( EXIT_FAILURE );
+	}
+
+	s_rngState = 0x9E3779B97F4A7C15ULL;
+
+	double now				 = 0.0;
+	double nextControl = bench_rand_exp( BENCH_CONTROL_MEAN_PERIOD );
+	bool isLogQueued	 = false;
+
+	while( now < aDuration )
+	{
+		// Control messages that arrived while the last frame was on the wire
+		while( nextControl <= now )
+		{
+			size_t slot = 0;
+
+			while( ( slot < BENCH_MAX_PENDING_CONTROL ) && isControlPending[slot] )
+			{
+				slot++;
+			}
+
+			if( slot == BENCH_MAX_PENDING_CONTROL )
+			{
+				fprintf( stderr, "too many pending control messages\n" );
+				exit( EXIT_FAILURE );
+			}
+
+			dzcobs_txsched_submit( &sched,
+														 &controlMsgs[slot],
+														 BENCH_PRIORITY_CONTROL,
+														 BENCH_STREAM_CONTROL,
+														 1,
+														 controlData,
+														 BENCH_CONTROL_SIZE );
+
+			isControlPending[slot] = true;
+			controlArrival[slot]	 = nextControl;
+			nextControl += bench_rand_exp( BENCH_CONTROL_MEAN_PERIOD );
+		}
+
+		// The log stream never lets the link idle
+		if( ( !isLogQueued ) || dzcobs_txmsg_isdone( &logMsg ) )
+		{
+			dzcobs_txsched_submit( &sched, &logMsg, BENCH_PRIORITY_LOG, BENCH_STREAM_LOG, 2, aLogData, aLogSize );
+			isLogQueued = true;
+		}
+
+		size_t frameLen = 0;
+
+		if( ( dzcobs_txsched_next( &sched, frame, sizeof( frame ), &frameLen ) != DZCOBS_RET_SUCCESS ) ||
+				( frameLen == 0 ) )
+		{
+			fprintf( stderr, "next failed\n" );
+			exit( EXIT_FAILURE );
+		}
+
+		// Frame and its 0x00 delimiter
+		now += (double)( frameLen + 1 ) * aByteTime;
+		aOutResult->bytesOnWire += frameLen + 1;
+
+		for( size_t i = 0; i < BENCH_MAX_PENDING_CONTROL; i++ )
+		{
+			if( isControlPending[i] && dzcobs_txmsg_isdone( &controlMsgs[i] ) )
+			{
+				const double latency = now - controlArrival[i];
+
+				isControlPending[i] = false;
+				aOutResult->nControl++;
+				aOutResult->sumLatency += latency;
+				aOutResult->bytesUseful += BENCH_CONTROL_SIZE;
+
+				if( latency > aOutResult->maxLatency )
+				{
+					aOutResult->maxLatency = latency;
+				}
+			}
+		}
+
+		if( dzcobs_txmsg_isdone( &logMsg ) )
+		{
+			aOutResult->bytesUseful += aLogSize;
+		}
+	}
+}
+
+int main( int argc, char **argv )
+{
+	const double baudRate = ( argc > 1 ) ? strtod( argv[1], NULL ) : 115200.0;
+	const size_t logSize	= ( argc > 2 ) ? (size_t)strtoul( argv[2], NULL, 0 ) : 4096;
+	const double duration = ( argc > 3 ) ? strtod( argv[3], NULL ) : 60.0;
+
+	if( ( baudRate <= 0.0 ) || ( logSize == 0 ) || ( logSize > BENCH_MAX_LOG_SIZE ) || ( duration <= 0.0 ) )
+	{
+		fprintf( stderr, "usage: %s [baud rate] [log message size 1..%d] [simulated seconds]\n",
+						 argv[0],
+						 BENCH_MAX_LOG_SIZE );
+		return EXIT_FAILURE;
+	}
+
+	static uint8_t logData[BENCH_MAX_LOG_SIZE];
+
+	// Printable text, as a log would be
+	for( size_t i = 0; i < logSize; i++ )
+	{
+		logData[i] = (uint8_t)( 0x20 + ( bench_rand() % 0x5F ) );
+	}
+
+	const double byteTime = (double)BENCH_BITS_PER_BYTE / baudRate;
+
+	printf( "%.0f baud, %zu byte log messages, %d byte control messages every %.0f ms (mean), %.0f s\n\n",
+					baudRate,
+					logSize,
+					BENCH_CONTROL_SIZE,
+					BENCH_CONTROL_MEAN_PERIOD * 1000.0,
+					duration );
+	printf( "%-10s | %8s | %9s | %9s | %10s\n", "fragment", "controls", "mean (ms)", "max (ms)", "efficiency" );
+
+	for( size_t i = 0; i < ( sizeof( s_fragmentSizes ) / sizeof( s_fragmentSizes[0] ) ); i++ )
+	{
+		const size_t fragmentSize = ( s_fragmentSizes[i] == 0 ) ? logSize : s_fragmentSizes[i];
+
+		if( ( ( s_fragmentSizes[i] != 0 ) && ( fragmentSize >= logSize ) ) ||
+				( ( ( logSize + fragmentSize - 1 ) / fragmentSize ) > DZCOBS_FRAG_MAX_FRAGMENTS ) )
+		{
+			continue;
+		}
+
+		sBENCH_result result;
+		bench_run( fragmentSize, byteTime, logData, logSize, duration, &result );
+
+		char label[16];
+
+		if( s_fragmentSizes[i] == 0 )
+		{
+			snprintf( label, sizeof( label ), "none" );
+		}
+		else
+		{
+			snprintf( label, sizeof( label ), "%zu", fragmentSize );
+		}
+
+		printf( "%-10s | %8zu | %9.2f | %9.2f | %9.1f%%\n",
+						label,
+						result.nControl,
+						( result.sumLatency * 1000.0 ) / (double)result.nControl,
+						result.maxLatency * 1000.0,
+						( 100.0 * (double)result.bytesUseful ) / (double)result.bytesOnWire );
+	}
+
+	return EXIT_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,50 @@
+# ===-----------------------------------------------------------------------===#
+# Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+# copy at https://opensource.org/licenses/BSD-3-Clause).
+# SPDX-License-Identifier: BSD-3-Clause
+# ===-----------------------------------------------------------------------===#
+
+# ==============================================================================
+# Dictionary matcher generation
+# ==============================================================================
+
+# Included by the dzcobs build and by the installed package config. The matchers
+# are generated by the dzcobs_dict target when it is built, otherwise by the
+# dzcobs_dict found on the path. When cross compiling, set it to a dzcobs_dict
+# built for the host.
+set(DZCOBS_DICT_EXECUTABLE
+    ""
+    CACHE STRING "dzcobs_dict used to generate the dictionary matchers"
+)
+
+# dzcobs_add_dictionary_matcher(<target> <dictionary source> <symbol>)
+#
+# Generates, at build time, a specialized matcher of the DICT_ADD_WORD list of
+# <dictionary source> and adds it to <target>. It defines the sDICT_ctx
+# <symbol>, to be declared as: extern const sDICT_ctx <symbol>;
+function(dzcobs_add_dictionary_matcher target dictionary symbol)
+  set(dict_executable "${DZCOBS_DICT_EXECUTABLE}")
+
+  if(NOT dict_executable)
+    if(TARGET dzcobs_dict)
+      set(dict_executable dzcobs_dict)
+    else()
+      find_program(DZCOBS_DICT_PROGRAM dzcobs_dict REQUIRED)
+      set(dict_executable "${DZCOBS_DICT_PROGRAM}")
+    endif()
+  endif()
+
+  get_filename_component(dictionary_path "${dictionary}" ABSOLUTE)
+  set(output "${CMAKE_CURRENT_BINARY_DIR}/${symbol}_matcher.c")
+
+  add_custom_command(
+    OUTPUT "${output}"
+    COMMAND ${dict_executable} gen -n ${symbol} "${dictionary_path}" "${output}"
+    DEPENDS "${dictionary_path}" ${dict_executable}
+    COMMENT "Generating the ${symbol} dictionary matcher"
+    VERBATIM
+  )
+
+  target_sources(${target} PRIVATE "${output}")
+  target_link_libraries(${target} PRIVATE dzcobs::dzcobs)
+endfunction()
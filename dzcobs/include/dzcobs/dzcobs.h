@@ -19,7 +19,9 @@
 // Includes
 // /////////////////////////////////////////////////////////////////////////////
 #include <stdbool.h>
+#include "dzcobs_crc.h"
 #include "dzcobs_dictionary.h"
+#include "dzcobs_filter.h"
 
 // clang-format off
 #ifdef __cplusplus
@@ -56,7 +58,11 @@ typedef enum e_DZCOBS_ret
 	DZCOBS_RET_ERR_CRC,
 	DZCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE,
 	DZCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY,
-	DZCOBS_RET_ERR_INVALID_USER6BITS
+	DZCOBS_RET_ERR_INVALID_USER6BITS,
+	DZCOBS_RET_ERR_BAD_FILTER_SEQUENCE,
+	DZCOBS_RET_ERR_FEC_UNCORRECTABLE,
+	DZCOBS_RET_ERR_BAD_FRAGMENT_SEQUENCE,
+	DZCOBS_RET_MORE ///< Not an error, a step-wise call must be called again to end its work
 } eDZCOBS_ret;
 
 typedef enum e_DZCOBS_encoding
@@ -64,9 +70,47 @@ typedef enum e_DZCOBS_encoding
 	DZCOBS_PLAIN				= 0, ///< No compression
 	DZCOBS_USING_DICT_1 = 1, ///< Compression using dictionary 1
 	DZCOBS_USING_DICT_2 = 2, ///< Compression using dictionary 2
-	DZCOBS_RESERVED			= 3, ///< For future uses
+	DZCOBS_RESERVED			= 3, ///< On the wire, signals an extended frame (see DZCOBS_EXT_*)
+	DZCOBS_AUTO					= 4, ///< Not on the wire, the encoder selects the encoding (see dzcobs_encode_inc_begin)
 } eDZCOBS_encoding;
 
+enum
+{
+	DZCOBS_AUTO_SAMPLES = ( 32 ) ///< Maximum searches on each dictionary done by DZCOBS_AUTO to select the encoding
+};
+
+/// Extended frames carry an extension byte before the encoding byte, with the
+/// real encoding and the optional features used on the frame. The extra data
+/// of each feature is placed before the extension byte.
+/// Frame tail:
+/// [payload][filter descriptor][check][FEC parity][FEC descriptor][extension][encoding][hash8]
+enum
+{
+	DZCOBS_EXT_ENCODING_MASK = ( 0x03 ), ///< Real encoding (eDZCOBS_encoding)
+	DZCOBS_EXT_CHECK_MASK		 = ( 0x0C ), ///< Additional check (eDZCOBS_check)
+	DZCOBS_EXT_CHECK_SHIFT	 = ( 2 ),
+	DZCOBS_EXT_FILTER				 = ( 0x10 ), ///< Payload is filtered, a filter descriptor byte is present
+	DZCOBS_EXT_FEC					 = ( 0x20 ), ///< Reed-Solomon parity and a FEC descriptor byte are present
+	DZCOBS_EXT_TAIL_CODED		 = ( 0x40 ), ///< Code bytes trail their runs (see dzcobs_tail.h)
+	DZCOBS_EXT_MARKER				 = ( 0x80 )	 ///< Always set, so the byte is never 0
+};
+
+/// The CRC check is little-endian and covers all the frame bytes before it,
+/// followed by the extension and encoding bytes. It is COBS stuffed to keep the
+/// frame zero-free (see dzcobs_crc_stuff).
+enum
+{
+	DZCOBS_FRAME_EXTENSION_SIZE = ( 1 ), ///< Size of the extension byte
+	DZCOBS_FRAME_FILTER_SIZE		= ( 1 ), ///< Size of the filter descriptor
+	DZCOBS_FRAME_CRC16_SIZE			= DZCOBS_CRC_STUFFED_SIZE( DZCOBS_CRC16_SIZE ),	 ///< Size of the CRC-16 check
+	DZCOBS_FRAME_CRC32C_SIZE		= DZCOBS_CRC_STUFFED_SIZE( DZCOBS_CRC32C_SIZE ), ///< Size of the CRC-32C check
+	DZCOBS_FRAME_FEC_SIZE				= ( 1 )	 ///< Size of the FEC descriptor (see dzcobs_fec.h)
+};
+
+#define DZCOBS_FRAME_CHECK_SIZE( check )                                         \
+	( ( ( check ) == DZCOBS_CHECK_CRC16 ) ? DZCOBS_FRAME_CRC16_SIZE               \
+																				: ( ( ( check ) == DZCOBS_CHECK_CRC32C ) ? DZCOBS_FRAME_CRC32C_SIZE : 0 ) )
+
 typedef struct s_DZRCOB_ctx sDZCOBS_ctx;
 
 typedef eDZCOBS_ret ( *dzcobs_encode_inc_funcPtr )( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
@@ -83,6 +127,18 @@ struct s_DZRCOB_ctx
 	uint8_t user6bits; ///< User application 6 bits, cannot be 0, so must be 1..63 (right aligned)
 
 	bool isLastCodeDictionary;
+	bool isZeroPending;	 ///< A 0x00 closed a non empty run, a dictionary code next would drop it
+	bool isFilterSealed; ///< A partial filter block was already encoded
+
+	uint8_t filter; ///< Filter descriptor of this frame, 0 if not filtered
+
+	eDZCOBS_check check; ///< Additional check of this frame
+
+	uint8_t fecT; ///< Reed-Solomon correctable bytes per codeword, 0 if no FEC
+
+	uint8_t acceleration;	 ///< Dictionary search backoff, 0 if disabled (see dzcobs_encode_set_acceleration)
+	uint8_t searchSkip;		 ///< Positions left to encode without searching the dictionary
+	uint16_t searchMisses; ///< Consecutive dictionary searches that found nothing
 
 	const sDICT_ctx *pDict[DZCOBS_DICT_N];
 
@@ -91,16 +147,66 @@ struct s_DZRCOB_ctx
 	eDZCOBS_encoding encoding;
 };
 
+/// Encoder state saved by dzcobs_encode_checkpoint
+typedef struct s_DZCOBS_checkpoint
+{
+	uint8_t *pCodeDst; ///< Destiny pointer to put the code
+	uint8_t *pCurDst;	 ///< Current destiny pointer
+
+	uint8_t code;		 ///< Current code
+	uint8_t hashsum; ///< Current sum of DZCOBS_HASH8
+
+	bool isLastCodeDictionary;
+	bool isZeroPending;
+	bool isFilterSealed;
+
+	uint8_t searchSkip;
+	uint16_t searchMisses;
+
+	dzcobs_encode_inc_funcPtr encFunc;
+
+	eDZCOBS_encoding encoding; ///< Not yet selected, if it was DZCOBS_AUTO
+} sDZCOBS_checkpoint;
+
 #define DZCOBS_ONE_BYTE_OVERHEAD_EVERY ( 127 )
 #define Z_DZCOBS_DIV_ROUND_UP( n, d ) ( ( ( n ) + ( d ) - 1 ) / ( d ) )
 #define DZCOBS_MAX_OVERHEAD( size ) Z_DZCOBS_DIV_ROUND_UP( ( size ), DZCOBS_ONE_BYTE_OVERHEAD_EVERY )
 #define DZCOBS_MAX_ENCODED_SIZE( size ) ( ( size ) + DZCOBS_MAX_OVERHEAD( ( size ) ) + ( ( size ) == 0 ) )
 
+/// Exact worst-case sizes of a frame with the 8 bit hash tail only. Extended
+/// frames add DZCOBS_FRAME_EXTENSION_SIZE and the size of each feature in use.
+/// A payload of n bytes has a code byte, plus a jump code each time a run of non
+/// zero bytes fills a code (254 bytes plain, 126 with a dictionary). A dictionary
+/// word of 2 or more bytes never costs more than its bytes encoded plain.
+#define Z_DZCOBS_MAX_JUMPS( size, jumpCode ) ( ( ( size ) > 0 ) ? ( ( ( size ) - 1 ) / ( ( jumpCode ) - 1 ) ) : 0 )
+#define DZCOBS_MAX_ENCODED_SIZE_PLAIN( size ) \
+	( 1 + ( size ) + Z_DZCOBS_MAX_JUMPS( ( size ), DZCOBS_CODE_JUMP_PLAIN ) + DZCOBS_FRAME_HEADER_SIZE )
+#define DZCOBS_MAX_ENCODED_SIZE_DICT( size ) \
+	( 1 + ( size ) + Z_DZCOBS_MAX_JUMPS( ( size ), DZCOBS_CODE_JUMP_DICTIONARY ) + DZCOBS_FRAME_HEADER_SIZE )
+
+/// Exact worst-case sizes decoded from a frame of encodedSize bytes. A plain
+/// payload has at least one code byte, a dictionary payload may be all
+/// dictionary codes of the longest word (maxWordSize of the sDICT_ctx).
+#define Z_DZCOBS_PAYLOAD_SIZE( encodedSize ) \
+	( ( ( encodedSize ) > DZCOBS_FRAME_HEADER_SIZE ) ? ( ( encodedSize ) - DZCOBS_FRAME_HEADER_SIZE ) : 0 )
+#define DZCOBS_MAX_DECODED_SIZE_PLAIN( encodedSize ) \
+	( Z_DZCOBS_PAYLOAD_SIZE( encodedSize ) - ( Z_DZCOBS_PAYLOAD_SIZE( encodedSize ) > 0 ) )
+#define DZCOBS_MAX_DECODED_SIZE_DICT( encodedSize, maxWordSize ) \
+	( Z_DZCOBS_PAYLOAD_SIZE( encodedSize ) * ( maxWordSize ) )
+
 enum
 {
 	DZCOBS_HASH_VALUE_WHEN_CRC_IS_ZERO = ( 0xFF )
 };
 
+/// With an acceleration of n, each n * 64 consecutive dictionary misses add a
+/// position to skip before the next search, up to DZCOBS_ACCELERATION_MAX_SKIP
+enum
+{
+	DZCOBS_ACCELERATION_SHIFT		 = ( 6 ),
+	DZCOBS_ACCELERATION_MAX_SKIP = ( 64 )
+};
+
 enum
 {
 	DZCOBS_CODE_JUMP_DICTIONARY = ( 0x7F ),
@@ -123,11 +229,70 @@ eDZCOBS_ret dzcobs_encode_set_dictionary( sDZCOBS_ctx *aCtx,
 																					const sDICT_ctx *aDictCtx,
 																					eDZCOBS_encoding aDictEncoding );
 
+/**
+ * @brief Set a filter to be applied to all the data added to this frame.
+ * Must be called after dzcobs_encode_inc_begin and before adding data.
+ * The filter works in blocks of DZCOBS_FILTER_BLOCK_SIZE, so every call to
+ * dzcobs_encode_inc except the last must add a multiple of that size.
+ *
+ * @param aCtx The encoding context.
+ * @param aFilter The filter to apply
+ * @param aElementSize Size in bytes of each element: 1, 2, 4 or 8
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_encode_set_filter( sDZCOBS_ctx *aCtx, eDZCOBS_filter aFilter, uint8_t aElementSize );
+
+/**
+ * @brief Add a CRC check to the frame, in addition to the 8 bit hash.
+ * Must be called after dzcobs_encode_inc_begin and before
+ * dzcobs_encode_inc_end.
+ *
+ * @param aCtx The encoding context.
+ * @param aCheck The check to add
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_encode_set_check( sDZCOBS_ctx *aCtx, eDZCOBS_check aCheck );
+
+/**
+ * @brief Add Reed-Solomon parity to the frame, so the receiver can repair up
+ * to aT corrupted bytes per codeword with dzcobs_fec_repair (see dzcobs_fec.h).
+ * Must be called after dzcobs_encode_inc_begin and before
+ * dzcobs_encode_inc_end.
+ *
+ * @param aCtx The encoding context.
+ * @param aT Correctable bytes per codeword, 1..DZCOBS_FEC_MAX_T, or 0 to disable
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_encode_set_fec( sDZCOBS_ctx *aCtx, uint8_t aT );
+
+/**
+ * @brief Back off the dictionary search on data that does not compress, as the
+ * LZ4 acceleration. After consecutive misses, the encoder skips some positions
+ * before searching again, encoding them plain, and a hit resets it. Already
+ * compressed or encrypted spans are then encoded near the plain speed, for a
+ * small loss on the words missed. The frame stays valid for any decoder.
+ * Must be called after dzcobs_encode_inc_begin, that disables it.
+ *
+ * @param aCtx The encoding context.
+ * @param aAcceleration 1 is the slowest backoff, 0 disables it (searches always)
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_encode_set_acceleration( sDZCOBS_ctx *aCtx, uint8_t aAcceleration );
+
 /**
  * @brief Begin an incremental encoding of data
  *
+ * With DZCOBS_AUTO, the first data given to dzcobs_encode_inc selects the
+ * encoding: DZCOBS_PLAIN or a dictionary set with dzcobs_encode_set_dictionary
+ * (the slots not set must be NULL), the one with the smallest estimated size.
+ * The estimate counts the non-zero runs, that a dictionary splits every 126
+ * bytes instead of 254, and the words found on one of every 8 positions, up to
+ * DZCOBS_AUTO_SAMPLES evenly spread, so it costs a small part of an encoding.
+ * Encode the frame in one call, or give a representative first part of it, to
+ * select by the whole frame.
+ *
  * @param aCtx Context to be initialized
- * @param aEncoding The desired encoding type for this frame
+ * @param aEncoding The desired encoding type for this frame, or DZCOBS_AUTO
  * @param aDstBuf Destiny buffer
  * @param aDstBufSize Destiny buffer size
  * @return eRCOBS_ret
@@ -147,6 +312,89 @@ eDZCOBS_ret dzcobs_encode_inc_begin( sDZCOBS_ctx *aCtx,
  */
 eDZCOBS_ret dzcobs_encode_inc( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
 
+/**
+ * @brief Add data known to be incompressible (already compressed, encrypted or
+ * random), as dzcobs_encode_inc but without searching the dictionary. On a
+ * dictionary frame the bytes are encoded plain, with the dictionary run length,
+ * and the search backoff of dzcobs_encode_set_acceleration restarts after them.
+ * With DZCOBS_AUTO, it selects the encoding as dzcobs_encode_inc does. Not
+ * allowed on filtered frames.
+ *
+ * @param aCtx Context in use
+ * @param aSrcBuf Source buffer of data to add
+ * @param aSrcBufSize Size of source buffer
+ * @return eRCOBS_ret
+ */
+eDZCOBS_ret dzcobs_encode_inc_raw( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
+
+/**
+ * @brief Add at most aStepSize bytes of the data to encoding, so a long frame
+ * can be encoded on bounded steps interleaved with other work. As with
+ * dzcobs_encode_inc, a dictionary word across two steps is not found, so a
+ * plain or filtered frame is the same as if all the data was added at once.
+ * dzcobs_encode_inc_end still goes over the whole frame once if it has a CRC
+ * check or FEC.
+ *
+ * @param aCtx Context in use
+ * @param aSrcBuf Data to add, advanced past the bytes added
+ * @param aSrcBufSize Size of data to add, decreased by the bytes added
+ * @param aStepSize Maximum bytes to add on this call. If the frame is filtered,
+ * it is rounded down to whole filter blocks, at least one.
+ * @retval DZCOBS_RET_MORE if there is still data to add, it must be called again
+ * @retval DZCOBS_RET_SUCCESS once all the data was added
+ */
+eDZCOBS_ret dzcobs_encode_inc_step( sDZCOBS_ctx *aCtx,
+																		const uint8_t **aSrcBuf,
+																		size_t *aSrcBufSize,
+																		size_t aStepSize );
+
+/**
+ * @brief Get the exact size of the frame if aSrcBuf was added with
+ * dzcobs_encode_inc and the frame ended, without writing it. The frame settings
+ * and the data already added are taken into account, and DZCOBS_AUTO selects
+ * the encoding as dzcobs_encode_inc would. Nothing is written to the destiny
+ * buffer, so the context can be begun on a small scratch buffer to size a frame
+ * before its buffer is allocated.
+ *
+ * @param aCtx Context in use
+ * @param aSrcBuf Data to add, can be NULL if aSrcBufSize is 0
+ * @param aSrcBufSize Size of data to add
+ * @param aOutSizeEncoded Size that dzcobs_encode_inc_end would return
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_encoded_size( const sDZCOBS_ctx *aCtx,
+																 const uint8_t *aSrcBuf,
+																 size_t aSrcBufSize,
+																 size_t *aOutSizeEncoded );
+
+/**
+ * @brief Save the encoder state, so the data added after it can be dropped
+ * with dzcobs_encode_rollback. Taking and restoring it costs the same for any
+ * amount of data, as the encoder never changes the bytes written before the
+ * code position of the checkpoint.
+ *
+ * @param aCtx Context in use
+ * @param aOutCheckpoint Saved state
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_encode_checkpoint( const sDZCOBS_ctx *aCtx, sDZCOBS_checkpoint *aOutCheckpoint );
+
+/**
+ * @brief Drop all the data added after a checkpoint of the same frame, as if it
+ * was never added. It can also be used after dzcobs_encode_inc_end, to drop the
+ * data of a frame that did not fit and end it again.
+ *
+ * The frame settings (filter, check and FEC) and the dictionary stats are not
+ * restored. The encoding is the same for all the frame, so to retry the data
+ * with other encoding the frame must begin again.
+ *
+ * @param aCtx Context in use
+ * @param aCheckpoint State saved by dzcobs_encode_checkpoint after the current
+ * dzcobs_encode_inc_begin
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_encode_rollback( sDZCOBS_ctx *aCtx, const sDZCOBS_checkpoint *aCheckpoint );
+
 /**
  * @brief Finalize the encoding. It does not add the 0 to the end of buffer. You
  * may add it if you want.
@@ -157,6 +405,34 @@ eDZCOBS_ret dzcobs_encode_inc( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t
  */
 eDZCOBS_ret dzcobs_encode_inc_end( sDZCOBS_ctx *aCtx, size_t *aOutSizeEncoded );
 
+/**
+ * @brief Encode a whole buffer on a basic frame (8 bit hash only) of a given
+ * encoding, in a single call. It goes straight to the encoding kernel, without
+ * a context kept between calls, so it suits small frames where the
+ * dzcobs_encode_inc_begin, dzcobs_encode_inc and dzcobs_encode_inc_end calls
+ * would cost more than the encoding itself. The frame is the same that the
+ * incremental encoding of aSrcBuf in one call gives.
+ *
+ * @param aEncoding DZCOBS_PLAIN, DZCOBS_USING_DICT_1 or DZCOBS_USING_DICT_2
+ * @param aDict The dictionary, if aEncoding is not DZCOBS_PLAIN
+ * @param aUser6bits User application 6 bits, 1..63
+ * @param aSrcBuf Source buffer, can be NULL if aSrcBufSize is 0
+ * @param aSrcBufSize Size of source buffer
+ * @param aDstBuf Destiny buffer
+ * @param aDstBufSize Destiny buffer size, at least the worst case of aSrcBufSize
+ * (DZCOBS_MAX_ENCODED_SIZE_PLAIN or DZCOBS_MAX_ENCODED_SIZE_DICT)
+ * @param aOutSizeEncoded Size of encoded data
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_encode( eDZCOBS_encoding aEncoding,
+													 const sDICT_ctx *aDict,
+													 uint8_t aUser6bits,
+													 const uint8_t *aSrcBuf,
+													 size_t aSrcBufSize,
+													 uint8_t *aDstBuf,
+													 size_t aDstBufSize,
+													 size_t *aOutSizeEncoded );
+
 #ifdef __cplusplus
 }
 #endif
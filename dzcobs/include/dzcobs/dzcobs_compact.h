@@ -0,0 +1,132 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_compact.h
+///	@brief Compact encoder context, for many concurrent streams
+///
+/// A sDZCOBS_ctx keeps pointers to its destiny buffer and dictionaries, and a
+/// kernel function pointer, for each frame being encoded. A multiplexer with
+/// one frame open for each of thousands of channels keeps instead a
+/// sDZCOBS_compactctx per channel: 32 bit offsets on a buffer shared by all
+/// the channels, and the encoding as the dictionary slot. The buffer and the
+/// dictionaries are held once, on a sDZCOBS_compactbase.
+///
+/// The frames are encoded incrementally as with dzcobs_encode_inc, and are the
+/// same. Each call expands the compact context to a sDZCOBS_ctx on the stack
+/// and packs it back, a small cost for each call, not for each byte. Only
+/// basic frames (8 bit hash only, not filtered) are supported, of a given
+/// encoding or DZCOBS_AUTO.
+///
+/// Unlike dzcobs_encode_inc, dzcobs_compact_inc never writes past the frame
+/// buffer of the context, so a channel can not corrupt its neighbours.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_COMPACT_H_
+#define _DZCOBS_COMPACT_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "dzcobs.h"
+#include "dzcobs_dictionary.h"
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Shared by all the compact contexts that encode on the same buffer
+typedef struct s_DZCOBS_compactbase
+{
+	uint8_t *pBuf;												 ///< Buffer with the frames of all the contexts
+	size_t bufSize;												 ///< Buffer size, up to 4 GiB are addressed
+	const sDICT_ctx *pDict[DZCOBS_DICT_N]; ///< Dictionaries of DZCOBS_USING_DICT_1 and DZCOBS_USING_DICT_2
+} sDZCOBS_compactbase;
+
+enum
+{
+	DZCOBS_COMPACT_IS_ACTIVE							= ( 0x01 ), ///< Begun and not yet ended
+	DZCOBS_COMPACT_IS_LAST_CODE_DICTIONARY = ( 0x02 ),
+	DZCOBS_COMPACT_IS_ZERO_PENDING				= ( 0x04 )
+};
+
+typedef struct s_DZCOBS_compactctx
+{
+	uint32_t dstOffset;	 ///< Frame buffer start, on the shared buffer
+	uint32_t dstSize;		 ///< Frame buffer size
+	uint32_t codeOffset; ///< Position to put the code, from the frame start
+	uint32_t curOffset;	 ///< Current position, from the frame start
+
+	uint8_t code;			 ///< Current code
+	uint8_t hashsum;	 ///< Current sum of DZCOBS_HASH8
+	uint8_t user6bits; ///< User application 6 bits, cannot be 0, so must be 1..63 (right aligned)
+	uint8_t encoding;	 ///< eDZCOBS_encoding, the dictionary slot, not yet selected if DZCOBS_AUTO
+	uint8_t flags;		 ///< DZCOBS_COMPACT_*
+} sDZCOBS_compactctx;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Begin an incremental encoding on a part of the shared buffer, as
+ * dzcobs_encode_inc_begin. The user6bits must be set before
+ * dzcobs_compact_end.
+ *
+ * @param aBase The shared buffer and dictionaries
+ * @param aCtx Context to be initialized
+ * @param aEncoding The encoding of this frame, or DZCOBS_AUTO
+ * @param aDstOffset Frame buffer start, on the shared buffer
+ * @param aDstSize Frame buffer size
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_compact_begin( const sDZCOBS_compactbase *aBase,
+																	sDZCOBS_compactctx *aCtx,
+																	eDZCOBS_encoding aEncoding,
+																	uint32_t aDstOffset,
+																	uint32_t aDstSize );
+
+/**
+ * @brief Add the data to encoding, as dzcobs_encode_inc
+ *
+ * @param aBase The shared buffer and dictionaries, the same given on begin
+ * @param aCtx Context in use
+ * @param aSrcBuf Source buffer of data to add
+ * @param aSrcBufSize Size of source buffer
+ * @retval DZCOBS_RET_ERR_WRITE_OVERFLOW if the worst case encoding of the data
+ * and the frame tail does not fit on the frame buffer, nothing is added
+ */
+eDZCOBS_ret dzcobs_compact_inc( const sDZCOBS_compactbase *aBase,
+																sDZCOBS_compactctx *aCtx,
+																const uint8_t *aSrcBuf,
+																size_t aSrcBufSize );
+
+/**
+ * @brief Finalize the encoding, as dzcobs_encode_inc_end. The frame is at
+ * aCtx->dstOffset on the shared buffer.
+ *
+ * @param aBase The shared buffer and dictionaries, the same given on begin
+ * @param aCtx Context in use
+ * @param aOutSizeEncoded Size of encoded data
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_compact_end( const sDZCOBS_compactbase *aBase, sDZCOBS_compactctx *aCtx, size_t *aOutSizeEncoded );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
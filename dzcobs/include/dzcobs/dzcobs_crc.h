@@ -0,0 +1,131 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_crc.h
+///	@brief CRC functions used by the optional frame checks
+///
+/// CRC-16 is CRC-16/X-25 (reflected 0x1021, init and xorout 0xFFFF).
+/// CRC-32C is the Castagnoli CRC (reflected 0x1EDC6F41, init and xorout
+/// 0xFFFFFFFF), the one computed by the SSE4.2 crc32 instruction.
+///
+/// Both functions can be called incrementally: start with 0 and pass the
+/// previous returned value to continue.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_CRC_H_
+#define _DZCOBS_CRC_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdint.h>
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+typedef enum e_DZCOBS_check
+{
+	DZCOBS_CHECK_HASH8	= 0, ///< Only the 8 bit order-independent hash (default)
+	DZCOBS_CHECK_CRC16	= 1, ///< CRC-16/X-25 in addition to the hash
+	DZCOBS_CHECK_CRC32C = 2, ///< CRC-32C in addition to the hash
+} eDZCOBS_check;
+
+enum
+{
+	DZCOBS_CRC16_SIZE	 = ( 2 ),
+	DZCOBS_CRC32C_SIZE = ( 4 )
+};
+
+/// Size of a CRC of size bytes COBS stuffed by dzcobs_crc_stuff
+#define DZCOBS_CRC_STUFFED_SIZE( size ) ( ( size ) + 1 )
+
+/// Slice-by-8 tables of the software CRCs, [0] is the one byte table
+extern const uint16_t G_DZCOBS_Crc16Table[8][256];
+extern const uint32_t G_DZCOBS_Crc32cTable[8][256];
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Compute or continue a CRC-16/X-25
+ *
+ * @param aCrc 0 to start, or the previous returned value to continue
+ * @param aBuf Data buffer
+ * @param aSize Size of data buffer
+ * @return uint16_t The CRC of all the data so far
+ */
+uint16_t dzcobs_crc16( uint16_t aCrc, const uint8_t *aBuf, size_t aSize );
+
+/**
+ * @brief Compute or continue a CRC-32C
+ *
+ * @param aCrc 0 to start, or the previous returned value to continue
+ * @param aBuf Data buffer
+ * @param aSize Size of data buffer
+ * @return uint32_t The CRC of all the data so far
+ */
+uint32_t dzcobs_crc32c( uint32_t aCrc, const uint8_t *aBuf, size_t aSize );
+
+/**
+ * @brief Continue a CRC-16/X-25 by one byte, with a table lookup. It is the
+ * same as dzcobs_crc16( aCrc, &aByte, 1 ) without the dispatch of the bulk
+ * paths, for the callers that get their data a byte at a time.
+ *
+ * @param aCrc 0 to start, or the previous returned value to continue
+ * @param aByte Next data byte
+ * @return uint16_t The CRC of all the data so far
+ */
+static inline uint16_t dzcobs_crc16_byte( uint16_t aCrc, uint8_t aByte )
+{
+	const uint16_t crc = (uint16_t)~aCrc;
+
+	return (uint16_t)~( ( crc >> 8 ) ^ G_DZCOBS_Crc16Table[0][( crc ^ aByte ) & 0xFF] );
+}
+
+/**
+ * @brief Continue a CRC-32C by one byte, with a table lookup. It is the same
+ * as dzcobs_crc32c( aCrc, &aByte, 1 ) without the dispatch of the bulk paths.
+ *
+ * @param aCrc 0 to start, or the previous returned value to continue
+ * @param aByte Next data byte
+ * @return uint32_t The CRC of all the data so far
+ */
+static inline uint32_t dzcobs_crc32c_byte( uint32_t aCrc, uint8_t aByte )
+{
+	const uint32_t crc = ~aCrc;
+
+	return ~( ( crc >> 8 ) ^ G_DZCOBS_Crc32cTable[0][( crc ^ aByte ) & 0xFF] );
+}
+
+/**
+ * @brief Write a CRC little-endian and COBS stuffed, so it has no 0x00 byte
+ * and each CRC value is sent as different bytes
+ *
+ * @param aCrc CRC value
+ * @param aSize DZCOBS_CRC16_SIZE or DZCOBS_CRC32C_SIZE
+ * @param aOutStuffed DZCOBS_CRC_STUFFED_SIZE( aSize ) bytes
+ */
+void dzcobs_crc_stuff( uint32_t aCrc, size_t aSize, uint8_t *aOutStuffed );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -18,6 +18,7 @@
 
 // Includes
 // /////////////////////////////////////////////////////////////////////////////
+#include <stdbool.h>
 #include "dzcobs.h"
 #include "dzcobs_dictionary.h"
 
@@ -41,9 +42,84 @@ typedef struct s_DZRCOB_decodectx
 	const sDICT_ctx *pDict[DZCOBS_DICT_N];
 } sDZCOBS_decodectx;
 
+/// Decoded data of a frame read on the encoded frame itself (see dzcobs_view.h)
+typedef struct s_DZCOBS_view
+{
+	const uint8_t *pPayload; ///< Encoded payload, the frame start
+	size_t payloadLen;			 ///< Encoded payload length
+	size_t decodedLen;			 ///< Decoded data length
+	const sDICT_ctx *pDict;	 ///< Dictionary of the payload, NULL if it is plain
+} sDZCOBS_view;
+
+/// Information parsed from the frame tail
+typedef struct s_DZCOBS_frameinfo
+{
+	size_t payloadLen;				 ///< Length of the encoded payload, without the tail
+	eDZCOBS_encoding encoding; ///< Real encoding of the payload
+	uint8_t filter;						 ///< Filter descriptor, 0 if not filtered
+	eDZCOBS_check check;			 ///< Additional check
+	const uint8_t *pCheck;		 ///< First byte of the check, if present
+	bool isTailCoded;					 ///< Code bytes trail their runs
+} sDZCOBS_frameinfo;
+
+/// Progress of a payload decoding, kept between the steps of dzcobs_decode_step
+typedef struct s_DZCOBS_decodepos
+{
+	size_t readIdx;			///< Payload bytes read
+	size_t decodedLen;	///< Decoded bytes written
+	bool isToPlaceZero; ///< The 0x00 that closed the last run waits for the next code
+} sDZCOBS_decodepos;
+
+/// Phases of a step-wise decoding
+typedef enum e_DZCOBS_decodephase
+{
+	DZCOBS_DECODE_PHASE_HASH = 0, ///< Frame hash
+	DZCOBS_DECODE_PHASE_CHECK,		///< Frame CRC check, if present
+	DZCOBS_DECODE_PHASE_PAYLOAD,	///< Payload decoding
+	DZCOBS_DECODE_PHASE_FILTER,		///< Filter revert, if filtered
+	DZCOBS_DECODE_PHASE_DONE,
+} eDZCOBS_decodephase;
+
+/// State of a step-wise decoding (see dzcobs_decode_step)
+typedef struct s_DZCOBS_decodestep
+{
+	sDZCOBS_decodectx decodeCtx; ///< Copy of the decoding context
+	size_t stepSize;						 ///< Bytes processed by each step
+	eDZCOBS_decodephase phase;	 ///< Current phase
+	size_t idx;									 ///< Bytes processed on the current phase
+	uint32_t crc;								 ///< Partial hash or check of the current phase
+	sDZCOBS_frameinfo info;			 ///< Frame tail, parsed once the frame is hashed
+	sDZCOBS_decodepos pos;			 ///< Payload decoding progress
+} sDZCOBS_decodestep;
+
+/// Kind of the decoded data given to a sink
+typedef enum e_DZCOBS_run
+{
+	DZCOBS_RUN_LITERAL = 0, ///< Data copied on the frame, or a block of a filtered frame
+	DZCOBS_RUN_ZERO,				///< A 0x00 byte
+	DZCOBS_RUN_WORD,				///< A dictionary word
+} eDZCOBS_run;
+
+/**
+ * @brief Receives the decoded data of dzcobs_decode_sink, in order
+ *
+ * @param aArg User argument
+ * @param aRun Kind of the data
+ * @param aData The data, valid only during the call
+ * @param aSize Size of the data, never 0
+ * @return DZCOBS_RET_SUCCESS to continue, any other value stops the decoding
+ * and is returned by dzcobs_decode_sink
+ */
+typedef eDZCOBS_ret ( *dzcobs_decode_sink_funcPtr )( void *aArg, eDZCOBS_run aRun, const uint8_t *aData, size_t aSize );
+
 /**
  * @brief Decodes a source encoded buffer.
  *
+ * The frame can be decoded in place, with dstBufDecoded at or before
+ * srcBufEncoded on the same buffer: a plain frame at the same position, a
+ * dictionary frame at least dzcobs_decode_headroom bytes after the decoded
+ * data. Tail-coded frames can not be decoded in place.
+ *
  * @param aDecodeCtx Struct with previous initialized
  * @param aOutDecodedLen Size of decoded data
  * @param uint8_t *aOutUser6bitDataRightAlgn The 6 bit user data that arrived in
@@ -52,11 +128,132 @@ typedef struct s_DZRCOB_decodectx
  * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
  * @retval RCOBS_RET_ERR_OVERFLOW if it overflows the destiny buffer
  * @retval RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if some invalid value (eg: 0x00)
+ * @retval DZCOBS_RET_ERR_BAD_ARG if the buffers overlap and the frame can not be
+ * decoded in place
  */
 eDZCOBS_ret dzcobs_decode( const sDZCOBS_decodectx *aDecodeCtx,
 													 size_t *aOutDecodedLen,
 													 uint8_t *aOutUser6bitDataRightAlgn );
 
+/**
+ * @brief Decodes a basic frame (8 bit hash only) of a given encoding, in a
+ * single call, the counterpart of dzcobs_encode. The frame tail is not parsed,
+ * only its encoding byte is compared, so it suits small frames. Extended frames
+ * and frames of another encoding are rejected, they must be decoded with
+ * dzcobs_decode. The buffers must not overlap.
+ *
+ * @param aEncoding DZCOBS_PLAIN, DZCOBS_USING_DICT_1 or DZCOBS_USING_DICT_2
+ * @param aDict The dictionary, if aEncoding is not DZCOBS_PLAIN
+ * @param aSrcBuf Encoded frame, without its 0x00 delimiter
+ * @param aSrcBufLen Encoded frame length
+ * @param aDstBuf Destiny buffer
+ * @param aDstBufSize Destiny buffer size
+ * @param aOutDecodedLen Size of decoded data
+ * @param aOutUser6bits The 6 bit user data of the frame, 1..63
+ * @retval DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if the frame is not a basic frame
+ * of aEncoding
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_decode_buf( eDZCOBS_encoding aEncoding,
+															 const sDICT_ctx *aDict,
+															 const uint8_t *aSrcBuf,
+															 size_t aSrcBufLen,
+															 uint8_t *aDstBuf,
+															 size_t aDstBufSize,
+															 size_t *aOutDecodedLen,
+															 uint8_t *aOutUser6bits );
+
+/**
+ * @brief Validate a frame as dzcobs_decode, hash, check and payload structure,
+ * without decoding it. The decoded data is then read from the encoded frame,
+ * that must be kept while the view is in use (see dzcobs_view.h).
+ * Filtered and tail-coded frames can not be viewed.
+ *
+ * @param aDecodeCtx As for dzcobs_decode, dstBufDecoded and dstBufDecodedSize
+ * are not used
+ * @param aOutView View of the decoded data
+ * @param aOutUser6bitDataRightAlgn The 6 bit user data of the frame
+ * @retval DZCOBS_RET_ERR_BAD_ARG also if the frame is filtered or tail-coded
+ */
+eDZCOBS_ret dzcobs_decode_view( const sDZCOBS_decodectx *aDecodeCtx,
+																sDZCOBS_view *aOutView,
+																uint8_t *aOutUser6bitDataRightAlgn );
+
+/**
+ * @brief Decodes a source encoded buffer to a sink, without a decoded buffer.
+ * The frame is validated before the sink gets any data, so it only gets data
+ * of a valid frame. Filtered frames are given by filter blocks of
+ * DZCOBS_FILTER_BLOCK_SIZE bytes. Tail-coded frames can not be decoded to a
+ * sink, their data is decoded backwards.
+ *
+ * @param aDecodeCtx As for dzcobs_decode, dstBufDecoded and dstBufDecodedSize
+ * are not used
+ * @param aSinkFunc Called with each run of decoded data
+ * @param aArg User argument of aSinkFunc
+ * @param aOutDecodedLen Decoded length given to the sink
+ * @param aOutUser6bitDataRightAlgn The 6 bit user data of the frame
+ * @retval DZCOBS_RET_ERR_BAD_ARG also if the frame is tail-coded
+ */
+eDZCOBS_ret dzcobs_decode_sink( const sDZCOBS_decodectx *aDecodeCtx,
+																dzcobs_decode_sink_funcPtr aSinkFunc,
+																void *aArg,
+																size_t *aOutDecodedLen,
+																uint8_t *aOutUser6bitDataRightAlgn );
+
+/**
+ * @brief Start a step-wise decoding, where each dzcobs_decode_step call does a
+ * bounded work, so a long frame can be interleaved with other work.
+ *
+ * The decoding is the same as dzcobs_decode, on the same buffers, that must be
+ * kept until the decoding ends. The frame is hashed, then checked, then its
+ * payload is decoded and its filter reverted. Tail-coded frames, and dictionary
+ * frames decoded in place, can not be decoded step-wise.
+ *
+ * @param aStep Step-wise decoding state
+ * @param aDecodeCtx As for dzcobs_decode, it is copied
+ * @param aStepSize Bytes processed on each step. A payload step stops at the
+ * first code at or after it, so it reads up to a run (254 bytes) more.
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_decode_step_begin( sDZCOBS_decodestep *aStep,
+																			const sDZCOBS_decodectx *aDecodeCtx,
+																			size_t aStepSize );
+
+/**
+ * @brief Do the next step of a step-wise decoding
+ *
+ * @param aStep Step-wise decoding state
+ * @param aOutDecodedLen As for dzcobs_decode, once the decoding ends
+ * @param aOutUser6bitDataRightAlgn As for dzcobs_decode, once the decoding ends
+ * @retval DZCOBS_RET_MORE if the decoding did not end, it must be called again
+ * @retval DZCOBS_RET_SUCCESS once the frame is decoded
+ * @retval Other values as dzcobs_decode, the decoding ended
+ */
+eDZCOBS_ret dzcobs_decode_step( sDZCOBS_decodestep *aStep, size_t *aOutDecodedLen, uint8_t *aOutUser6bitDataRightAlgn );
+
+/**
+ * @brief Get the decoded length of an encoded frame, by its codes, without
+ * decoding it. The frame hash and check are not verified, dzcobs_decode does it.
+ *
+ * @param aDecodeCtx As for dzcobs_decode, dstBufDecoded and dstBufDecodedSize
+ * are not used
+ * @param aOutDecodedLen Size dzcobs_decode needs to decode the frame
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_decoded_size( const sDZCOBS_decodectx *aDecodeCtx, size_t *aOutDecodedLen );
+
+/**
+ * @brief Get the offset an encoded frame needs after the start of the decoded
+ * data to be decoded in place, the most the decoded data goes ahead of the
+ * frame bytes read. It is 0 for plain frames. The buffer must hold the frame at
+ * that offset and the decoded data, up to DZCOBS_MAX_DECODED_SIZE_DICT.
+ *
+ * @param aDecodeCtx As for dzcobs_decoded_size
+ * @param aOutHeadroom Minimum srcBufEncoded - dstBufDecoded
+ * @retval DZCOBS_RET_ERR_BAD_ARG also if the frame is tail-coded
+ */
+eDZCOBS_ret dzcobs_decode_headroom( const sDZCOBS_decodectx *aDecodeCtx, size_t *aOutHeadroom );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,155 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_dictfile.h
+///	@brief Binary dictionary file, loaded in place (e.g. from mmap or flash)
+///
+/// A dictionary file holds the dictionary string, its word size table and,
+/// optionally, the packed keys and the search automaton, already built. It is
+/// checked (dzcobs_dictionary_isvalid) and its indexes are built once, when it
+/// is written. Loading it checks the header, the bounds, the CRC-32C and the
+/// dictionary string again, and points a sDICT_ctx to the image, so many
+/// processes mapping the same file share its pages and nothing is rebuilt.
+///
+/// Layout, all the offsets from the image start:
+///  - sDZCOBS_dictfile_header
+///  - dictionary string, with its null terminator
+///  - packed keys (DZCOBS_DICTFILE_PACKED), 8 bytes aligned
+///  - search automaton (DZCOBS_DICTFILE_AUTOMATON), 8 bytes aligned
+///
+/// The integers are stored in the byte order of the writer, a file is only
+/// loaded by a machine with the same byte order (see byteOrder).
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_DICTFILE_H_
+#define _DZCOBS_DICTFILE_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "dzcobs_dictionary.h"
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	DZCOBS_DICTFILE_VERSION		 = ( 1 ),
+	DZCOBS_DICTFILE_BYTE_ORDER = ( 0x0102 ), ///< byteOrder value, as written by the writer
+	DZCOBS_DICTFILE_ALIGNMENT	 = ( 8 )			 ///< Alignment of the image and of its sections
+};
+
+/// Magic bytes at the file start
+#define DZCOBS_DICTFILE_MAGIC "DZCD"
+
+/// Indexes stored on the file
+typedef enum e_DZCOBS_dictfile_index
+{
+	DZCOBS_DICTFILE_PACKED		= ( 1 << 0 ), ///< See dzcobs_dictionary_packed_init
+	DZCOBS_DICTFILE_AUTOMATON = ( 1 << 1 ), ///< See dzcobs_dictionary_automaton_init
+} eDZCOBS_dictfile_index;
+
+/// Word size group, the fields of sDICT_wordentry as offsets
+typedef struct s_DZCOBS_dictfile_group
+{
+	uint32_t wordsOffset;				///< First word entry (with its size byte), 0 if the group is not used
+	uint32_t packedKeysOffset;	///< Packed keys, 0 if not stored
+	uint32_t packedIndexOffset; ///< Packed keys global index, 0 if not stored
+	uint8_t nEntries;
+	uint8_t globalIndex;
+	uint8_t strideSize;
+	uint8_t reserved; ///< 0
+} sDZCOBS_dictfile_group;
+
+typedef struct s_DZCOBS_dictfile_header
+{
+	char magic[4];			///< DZCOBS_DICTFILE_MAGIC, without terminator
+	uint16_t byteOrder; ///< DZCOBS_DICTFILE_BYTE_ORDER
+	uint8_t version;		///< DZCOBS_DICTFILE_VERSION
+	uint8_t indexes;		///< eDZCOBS_dictfile_index flags
+	uint32_t imageSize; ///< Size of the whole image
+	uint32_t checksum;	///< CRC-32C of the whole image, with this field as 0
+
+	uint32_t dictionaryOffset;
+	uint32_t dictionarySize; ///< Including the null terminator
+	uint32_t packedOffset;
+	uint32_t packedSize;
+	uint32_t automatonOffset;
+	uint32_t automatonSize;
+
+	uint16_t nClasses; ///< Automaton number of byte classes
+	uint8_t minWordSize;
+	uint8_t maxWordSize;
+	uint32_t reserved; ///< 0
+
+	sDZCOBS_dictfile_group groups[DICT_MAX_DIFFERENTWORDSIZES];
+} sDZCOBS_dictfile_header;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Size of the dictionary file image of a dictionary
+ *
+ * @param aDictionary Dictionary string, as given to dzcobs_dictionary_init
+ * @param aDictionarySize Size of dictionary string
+ * @param aIndexes eDZCOBS_dictfile_index flags of the indexes to store
+ * @return size_t Image size, 0 if the dictionary is not valid
+ */
+size_t dzcobs_dictfile_size( const char *aDictionary, size_t aDictionarySize, uint8_t aIndexes );
+
+/**
+ * @brief Write the dictionary file image of a dictionary
+ *
+ * @param aDictionary Dictionary string, as given to dzcobs_dictionary_init
+ * @param aDictionarySize Size of dictionary string
+ * @param aIndexes eDZCOBS_dictfile_index flags of the indexes to store
+ * @param aOutImage Image output, DZCOBS_DICTFILE_ALIGNMENT aligned
+ * @param aOutImageSize Size of aOutImage, at least dzcobs_dictfile_size
+ * @param aOutImageLen Image size written
+ * @retval DICT_RET_SUCCESS if the image was written
+ * @retval DICT_RET_ERR_BAD_ARG if invalid arguments are passed or aOutImage is too small
+ * @retval DICT_RET_ERR_INVALID if the dictionary is not valid
+ */
+eDICT_ret dzcobs_dictfile_write( const char *aDictionary,
+																 size_t aDictionarySize,
+																 uint8_t aIndexes,
+																 void *aOutImage,
+																 size_t aOutImageSize,
+																 size_t *aOutImageLen );
+
+/**
+ * @brief Load a dictionary file image. The context points to the image, that
+ * is not modified and must be kept while the context is in use.
+ *
+ * @param aCtx The context to store this dictionary session
+ * @param aImage Dictionary file image, DZCOBS_DICTFILE_ALIGNMENT aligned
+ * @param aImageSize Size of aImage
+ * @retval DICT_RET_SUCCESS if the image was loaded
+ * @retval DICT_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval DICT_RET_ERR_INVALID if the image is not a valid dictionary file
+ * (magic, version, byte order, bounds or checksum)
+ */
+eDICT_ret dzcobs_dictfile_load( sDICT_ctx *aCtx, const void *aImage, size_t aImageSize );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -49,6 +49,12 @@ enum
 	DICT_MAX_DIFFERENTWORDSIZES = ( 4 )
 };
 
+enum
+{
+	DICT_AUTOMATON_BYTECLASS_SIZE = ( 256 ),		///< Bytes of the byte class map, at the automaton memory start
+	DICT_AUTOMATON_MATCH					= ( 0x8000 ) ///< Transition flag of a word match, the low bits are its index
+};
+
 /// Dictionary entry for different word sizes
 typedef struct s_DICT_wordentry
 {
@@ -57,13 +63,37 @@ typedef struct s_DICT_wordentry
 	uint8_t lastIndex;							///< Number of entries -1
 	uint8_t globalIndex;						///< Start index for this dictionary entry on the global dictionary. Starts at 1.
 	uint8_t strideSize;							///< word size + 1, that is the size of each word entry
+
+	const void *pPackedKeys;		 ///< Packed words as integers in Eytzinger order from index 1, NULL if not in use
+	const uint8_t *pPackedIndex; ///< Global index (1 based) of each packed word
 } sDICT_wordentry;
 
+/// Specialized search of a dictionary, as dzcobs_dictionary_search. aSearchKeySize is already limited to the
+/// dictionary word sizes.
+typedef uint8_t ( *dzcobs_dictionary_search_funcPtr )( const uint8_t *aSearchKey,
+																											 size_t aSearchKeySize,
+																											 size_t *aOutKeySizeFound );
+
+/// Specialized word lookup of a dictionary, as dzcobs_dictionary_get
+typedef const uint8_t *( *dzcobs_dictionary_get_funcPtr )( uint8_t aIndex, uint8_t *aOutWordSize );
+
+/// Dictionary words use counters, see dzcobs_stats.h
+typedef struct s_DZCOBS_stats sDZCOBS_stats;
+
 typedef struct s_DICT_ctx
 {
 	sDICT_wordentry wordSizeTable[DICT_MAX_DIFFERENTWORDSIZES];
 	uint8_t minWordSize;
 	uint8_t maxWordSize;
+
+	const uint8_t *pByteClass;		 ///< Automaton byte class of each byte value, NULL if not in use
+	const uint16_t *pTransitions; ///< Automaton transitions, nClasses per state, state 0 is the start
+	uint16_t nClasses;						 ///< Automaton number of byte classes
+
+	dzcobs_dictionary_search_funcPtr searchFunc; ///< Generated matcher (see dzcobs_dict gen), NULL if not in use
+	dzcobs_dictionary_get_funcPtr getFunc;			 ///< Generated word table lookup, NULL if not in use
+
+	sDZCOBS_stats *pStats; ///< Words use counters (see dzcobs_stats_attach), NULL if not in use
 } sDICT_ctx;
 
 typedef enum e_DICT_ret
@@ -114,6 +144,7 @@ eDICT_ret dzcobs_dictionary_init( sDICT_ctx *aCtx, const char *aDictionary, size
  * @param aSearchKeySize The key buffer size
  * @param aOutKeySizeFound The output with the key size found (2..5)
  * @return uint8_t 0 not found, 1..126 index of the key found (1 index based)
+ * If the context has a generated matcher (searchFunc), it is used.
  */
 uint8_t dzcobs_dictionary_search( const sDICT_ctx *aCtx,
 																	const uint8_t *aSearchKey,
@@ -127,9 +158,65 @@ uint8_t dzcobs_dictionary_search( const sDICT_ctx *aCtx,
  * @param aIndex 0..125 index (0 index based)
  * @param aOutWordSize pointer to store the size in bytes of the word
  * @return uint8_t* A pointer to the word, NULL if invalid aIndex is givin
+ * If the context has a generated word table (getFunc), it is used.
  */
 const uint8_t *dzcobs_dictionary_get( const sDICT_ctx *aCtx, uint8_t aIndex, uint8_t *aOutWordSize );
 
+/**
+ * @brief Memory needed by the search automaton of a dictionary
+ *
+ * @param aCtx An initialized dictionary context
+ * @return size_t Bytes needed by dzcobs_dictionary_automaton_init, 0 if aCtx is NULL
+ */
+size_t dzcobs_dictionary_automaton_size( const sDICT_ctx *aCtx );
+
+/**
+ * @brief Compile the dictionary in a search automaton, so dzcobs_dictionary_search
+ * (and so the dictionary encoders) walk a transition table instead of doing a
+ * binary search for each word size. A search costs one table lookup per key
+ * byte, and most positions stop at the first byte.
+ *
+ * The automaton is a DFA of the words (a trie with byte classes): each state
+ * is a prefix of a word and each byte value used by the words has its own
+ * class, the other bytes share one. Its size is
+ * DICT_AUTOMATON_BYTECLASS_SIZE + states * classes * 2 bytes.
+ * Must be called after dzcobs_dictionary_init, that clears it.
+ *
+ * @param aCtx An initialized dictionary context
+ * @param aMem Automaton memory, 2 bytes aligned. It must be kept while aCtx is in use.
+ * @param aMemSize Size of aMem, at least dzcobs_dictionary_automaton_size
+ * @return eDICT_ret DICT_RET_SUCCESS if the automaton is in use
+ */
+eDICT_ret dzcobs_dictionary_automaton_init( sDICT_ctx *aCtx, void *aMem, size_t aMemSize );
+
+/**
+ * @brief Memory needed by the packed keys of a dictionary
+ *
+ * @param aCtx An initialized dictionary context
+ * @return size_t Bytes needed by dzcobs_dictionary_packed_init, 0 if aCtx is NULL
+ */
+size_t dzcobs_dictionary_packed_size( const sDICT_ctx *aCtx );
+
+/**
+ * @brief Pack the dictionary words as integer keys, so dzcobs_dictionary_search
+ * compares integers instead of calling memcmp on each binary search step.
+ *
+ * The words of each size are stored big endian in an uint16_t (2 bytes words),
+ * uint32_t (3 and 4 bytes) or uint64_t (5 bytes) array in Eytzinger order (the
+ * implicit binary tree layout, root at index 1). The search key is loaded as an
+ * integer once and each step descends with the comparison result instead of a
+ * branch. Each word size uses (words + 1) keys and (words + 1) index bytes,
+ * each array rounded up to 8 bytes.
+ * Must be called after dzcobs_dictionary_init, that clears it. If an automaton
+ * is also in use, the automaton is used.
+ *
+ * @param aCtx An initialized dictionary context
+ * @param aMem Packed keys memory, 8 bytes aligned. It must be kept while aCtx is in use.
+ * @param aMemSize Size of aMem, at least dzcobs_dictionary_packed_size
+ * @return eDICT_ret DICT_RET_SUCCESS if the packed keys are in use
+ */
+eDICT_ret dzcobs_dictionary_packed_init( sDICT_ctx *aCtx, void *aMem, size_t aMemSize );
+
 // External declaration of default dictionary
 extern const char G_DZCOBS_DefaultDictionary[];
 extern const size_t G_DZCOBS_DefaultDictionary_size;
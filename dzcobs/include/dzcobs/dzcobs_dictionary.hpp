@@ -0,0 +1,380 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_dictionary.hpp
+///	@brief Dictionary checked and indexed at compile time (C++17)
+///
+/// DZCOBS_CONSTEXPR_DICTIONARY declares a dictionary as constexpr data, from
+/// the same DICT_ADD_WORD list given to dzcobs_dictionary_init:
+///
+///   DZCOBS_CONSTEXPR_DICTIONARY( s_Dictionary,
+///     DICT_ADD_WORD(2, "\r\n")
+///     DICT_ADD_WORD(4, "temp")
+///   );
+///
+/// The list is checked by static_assert (the same rules of
+/// dzcobs_dictionary_isvalid, plus ascending word sizes), and s_Dictionary is
+/// a sDICT_ctx with its packed keys (see dzcobs_dictionary_packed_init)
+/// already built. All of it is placed on read only memory, no code runs and no
+/// RAM is used to set it up.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_DICTIONARY_HPP_
+#define _DZCOBS_DICTIONARY_HPP_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include "dzcobs_dictionary.h"
+
+#if !( ( __cplusplus >= 201703L ) || ( defined( _MSVC_LANG ) && ( _MSVC_LANG >= 201703L ) ) )
+#error "dzcobs_dictionary.hpp requires C++17"
+#endif
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Declares aName as a constexpr sDICT_ctx of the dictionary string aDictionary.
+/// It can be used at namespace or function scope. aName##_words and
+/// aName##_index are also declared, they hold the data aName points to.
+#define DZCOBS_CONSTEXPR_DICTIONARY( aName, aDictionary )                                                           \
+	static constexpr auto aName##_words = ::dzcobs::dictionary_words( aDictionary );                                  \
+	static_assert( aName##_words.valid != DICT_INVALID_WORDSIZE, "dzcobs dictionary: word sizes must be 2..5" );      \
+	static_assert( aName##_words.valid != DICT_INVALID_NOT_SORTED,                                                    \
+								 "dzcobs dictionary: words of the same size must be sorted and unique" );                           \
+	static_assert( aName##_words.valid != DICT_INVALID_WORDCOUNTING, "dzcobs dictionary: must have 1..126 words" );   \
+	static_assert( aName##_words.valid != DICT_INVALID_NUMBER_OF_WORDSIZES,                                           \
+								 "dzcobs dictionary: must have at most 4 different word sizes" );                                   \
+	static_assert( ( aName##_words.valid != DICT_INVALID_OUTOFBOUNDS ) &&                                             \
+									 ( aName##_words.valid != DICT_INVALID_EARLIER_END ),                                             \
+								 "dzcobs dictionary: words do not match the string size" );                                         \
+	static_assert( aName##_words.isAscending, "dzcobs dictionary: word sizes must be ascending" );                    \
+	static constexpr ::dzcobs::DictionaryIndex< aName##_words.packed_count( sizeof( uint16_t ) ),                     \
+																							aName##_words.packed_count( sizeof( uint32_t ) ),                     \
+																							aName##_words.packed_count( sizeof( uint64_t ) ) >                    \
+		aName##_index( aName##_words );                                                                                 \
+	static constexpr sDICT_ctx aName = ::dzcobs::dictionary_ctx( aName##_words, aName##_index )
+
+namespace dzcobs
+{
+
+enum
+{
+	DICT_MIN_WORD_SIZE		 = ( 2 ),
+	DICT_MAX_WORD_SIZE		 = ( 5 ),
+	DICT_MAX_WORD_COUNTING	= ( 126 )
+};
+
+/// Bytes of the integer that holds a word, as dzcobs_dictionary_packed_init stores it
+constexpr size_t dictionary_packed_keysize( size_t aWordSize )
+{
+	return ( aWordSize <= 2 ) ? sizeof( uint16_t ) : ( ( aWordSize <= 4 ) ? sizeof( uint32_t ) : sizeof( uint64_t ) );
+}
+
+/// Dictionary string checked and split in word size groups
+template< size_t N >
+struct DictionaryWords
+{
+	uint8_t bytes[N] = {}; ///< Dictionary string, with its terminator
+	eDICTVALID_ret valid = DICT_IS_VALID;
+	bool isAscending		 = true;
+
+	uint8_t nGroups													= 0;
+	size_t offset[DICT_MAX_DIFFERENTWORDSIZES]			= {}; ///< Group first entry, on bytes
+	uint8_t nEntries[DICT_MAX_DIFFERENTWORDSIZES]		= {};
+	uint8_t globalIndex[DICT_MAX_DIFFERENTWORDSIZES] = {};
+	uint8_t strideSize[DICT_MAX_DIFFERENTWORDSIZES]	= {};
+	uint8_t minWordSize															= 0;
+	uint8_t maxWordSize															= 0;
+
+	/// Packed keys (and global indexes) of a key size, with the unused index 0 of each group
+	constexpr size_t packed_count( size_t aKeySize ) const
+	{
+		size_t count = 0;
+
+		for( size_t i = 0; i < nGroups; i++ )
+		{
+			if( dictionary_packed_keysize( strideSize[i] - 1u ) == aKeySize )
+			{
+				count += nEntries[i] + 1u;
+			}
+		}
+
+		return count;
+	}
+};
+
+/// Same rules as dzcobs_dictionary_isvalid
+template< size_t N >
+constexpr eDICTVALID_ret dictionary_isvalid( const char ( &aDictionary )[N] )
+{
+	size_t pos							 = 0;
+	size_t previousPos			 = 0;
+	size_t previousWordLen	 = 0;
+	size_t wordCount				 = 0;
+	size_t differentWordSize = 0;
+
+	while( pos < N )
+	{
+		const char sizeChar = aDictionary[pos];
+
+		if( !( ( sizeChar >= ( DICT_MIN_WORD_SIZE + '0' ) ) && ( sizeChar <= ( DICT_MAX_WORD_SIZE + '0' ) ) ) )
+		{
+			return DICT_INVALID_WORDSIZE;
+		}
+
+		const size_t wordLen = (size_t)( sizeChar - '0' );
+
+		if( ( pos + 1 + wordLen ) >= N )
+		{
+			return DICT_INVALID_OUTOFBOUNDS;
+		}
+
+		wordCount++;
+
+		if( wordCount > DICT_MAX_WORD_COUNTING )
+		{
+			return DICT_INVALID_WORDCOUNTING;
+		}
+
+		if( ( wordCount > 1 ) && ( previousWordLen == wordLen ) )
+		{
+			// memcmp order
+			int cmp = 0;
+
+			for( size_t i = 0; ( i < wordLen ) && ( cmp == 0 ); i++ )
+			{
+				cmp = (int)(uint8_t)aDictionary[previousPos + 1 + i] - (int)(uint8_t)aDictionary[pos + 1 + i];
+			}
+
+			if( cmp >= 0 )
+			{
+				return DICT_INVALID_NOT_SORTED;
+			}
+		}
+		else
+		{
+			previousWordLen = wordLen;
+			differentWordSize++;
+
+			if( differentWordSize > DICT_MAX_DIFFERENTWORDSIZES )
+			{
+				return DICT_INVALID_NUMBER_OF_WORDSIZES;
+			}
+		}
+
+		previousPos = pos;
+		pos += 1 + wordLen;
+
+		if( aDictionary[pos] == 0 )
+		{
+			break;
+		}
+	}
+
+	if( ( pos + 1 ) < N )
+	{
+		return DICT_INVALID_EARLIER_END;
+	}
+
+	return DICT_IS_VALID;
+}
+
+/// Check and group a dictionary string, as dzcobs_dictionary_init does
+template< size_t N >
+constexpr DictionaryWords< N > dictionary_words( const char ( &aDictionary )[N] )
+{
+	DictionaryWords< N > words;
+
+	words.valid = dictionary_isvalid( aDictionary );
+
+	if( words.valid != DICT_IS_VALID )
+	{
+		return words;
+	}
+
+	for( size_t i = 0; i < N; i++ )
+	{
+		words.bytes[i] = (uint8_t)aDictionary[i];
+	}
+
+	words.minWordSize = 0xFF;
+
+	size_t pos					 = 0;
+	uint8_t globalIndex	 = 1;
+	uint8_t currentStride = 0;
+
+	while( pos < ( N - 1 ) )
+	{
+		const uint8_t stride = (uint8_t)( ( words.bytes[pos] - '0' ) + 1 );
+
+		if( stride != currentStride )
+		{
+			words.isAscending = words.isAscending && ( stride > currentStride );
+
+			const size_t group			 = words.nGroups++;
+			const uint8_t wordSize	 = (uint8_t)( stride - 1 );
+			words.offset[group]			 = pos;
+			words.globalIndex[group] = globalIndex;
+			words.strideSize[group]	 = stride;
+			words.minWordSize				 = ( wordSize < words.minWordSize ) ? wordSize : words.minWordSize;
+			words.maxWordSize				 = ( wordSize > words.maxWordSize ) ? wordSize : words.maxWordSize;
+			currentStride						 = stride;
+		}
+
+		words.nEntries[words.nGroups - 1]++;
+		globalIndex++;
+		pos += stride;
+	}
+
+	return words;
+}
+
+/// Packed keys of each word size, in Eytzinger order (see dzcobs_dictionary_packed_init)
+template< size_t N16, size_t N32, size_t N64 >
+struct DictionaryIndex
+{
+	uint16_t keys16[N16 ? N16 : 1] = {};
+	uint32_t keys32[N32 ? N32 : 1] = {};
+	uint64_t keys64[N64 ? N64 : 1] = {};
+	uint8_t index16[N16 ? N16 : 1] = {};
+	uint8_t index32[N32 ? N32 : 1] = {};
+	uint8_t index64[N64 ? N64 : 1] = {};
+
+	size_t offset[DICT_MAX_DIFFERENTWORDSIZES] = {}; ///< Group keys start, on the arrays of its key size
+
+	template< size_t N >
+	constexpr explicit DictionaryIndex( const DictionaryWords< N > &aWords )
+	{
+		size_t next16 = 0;
+		size_t next32 = 0;
+		size_t next64 = 0;
+
+		for( size_t i = 0; i < aWords.nGroups; i++ )
+		{
+			const size_t wordSize = aWords.strideSize[i] - 1u;
+
+			switch( dictionary_packed_keysize( wordSize ) )
+			{
+			case sizeof( uint16_t ):
+				offset[i] = next16;
+				next16 += aWords.nEntries[i] + 1u;
+				break;
+
+			case sizeof( uint32_t ):
+				offset[i] = next32;
+				next32 += aWords.nEntries[i] + 1u;
+				break;
+
+			default:
+				offset[i] = next64;
+				next64 += aWords.nEntries[i] + 1u;
+				break;
+			}
+
+			fill( aWords, i, 0, 1 );
+		}
+	}
+
+private:
+	/// In-order walk of the implicit tree, as dzcobs_dictionary_packed_fill
+	template< size_t N >
+	constexpr size_t fill( const DictionaryWords< N > &aWords, size_t aGroup, size_t aSortedIdx, size_t aTreeIdx )
+	{
+		if( aTreeIdx > aWords.nEntries[aGroup] )
+		{
+			return aSortedIdx;
+		}
+
+		aSortedIdx = fill( aWords, aGroup, aSortedIdx, 2 * aTreeIdx );
+
+		const size_t wordSize = aWords.strideSize[aGroup] - 1u;
+		const size_t wordPos	= aWords.offset[aGroup] + 1 + ( aSortedIdx * aWords.strideSize[aGroup] );
+		const size_t pos			= offset[aGroup] + aTreeIdx;
+		const uint8_t index		= (uint8_t)( aWords.globalIndex[aGroup] + aSortedIdx );
+
+		uint64_t key = 0;
+
+		for( size_t i = 0; i < wordSize; i++ )
+		{
+			key = ( key << 8 ) | aWords.bytes[wordPos + i];
+		}
+
+		switch( dictionary_packed_keysize( wordSize ) )
+		{
+		case sizeof( uint16_t ):
+			keys16[pos]	 = (uint16_t)key;
+			index16[pos] = index;
+			break;
+
+		case sizeof( uint32_t ):
+			keys32[pos]	 = (uint32_t)key;
+			index32[pos] = index;
+			break;
+
+		default:
+			keys64[pos]	 = key;
+			index64[pos] = index;
+			break;
+		}
+
+		return fill( aWords, aGroup, aSortedIdx + 1, ( 2 * aTreeIdx ) + 1 );
+	}
+};
+
+/// Dictionary context pointing to aWords and aIndex, that must be static constexpr
+template< size_t N, size_t N16, size_t N32, size_t N64 >
+constexpr sDICT_ctx dictionary_ctx( const DictionaryWords< N > &aWords, const DictionaryIndex< N16, N32, N64 > &aIndex )
+{
+	sDICT_ctx ctx{};
+
+	for( size_t i = 0; i < aWords.nGroups; i++ )
+	{
+		sDICT_wordentry &entry = ctx.wordSizeTable[i];
+
+		entry.dictionaryBegin = &aWords.bytes[aWords.offset[i]];
+		entry.nEntries				= aWords.nEntries[i];
+		entry.lastIndex				= (uint8_t)( aWords.nEntries[i] - 1 );
+		entry.globalIndex			= aWords.globalIndex[i];
+		entry.strideSize			= aWords.strideSize[i];
+
+		switch( dictionary_packed_keysize( aWords.strideSize[i] - 1u ) )
+		{
+		case sizeof( uint16_t ):
+			entry.pPackedKeys	 = &aIndex.keys16[aIndex.offset[i]];
+			entry.pPackedIndex = &aIndex.index16[aIndex.offset[i]];
+			break;
+
+		case sizeof( uint32_t ):
+			entry.pPackedKeys	 = &aIndex.keys32[aIndex.offset[i]];
+			entry.pPackedIndex = &aIndex.index32[aIndex.offset[i]];
+			break;
+
+		default:
+			entry.pPackedKeys	 = &aIndex.keys64[aIndex.offset[i]];
+			entry.pPackedIndex = &aIndex.index64[aIndex.offset[i]];
+			break;
+		}
+	}
+
+	ctx.minWordSize = aWords.minWordSize;
+	ctx.maxWordSize = aWords.maxWordSize;
+
+	return ctx;
+}
+
+} // namespace dzcobs
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
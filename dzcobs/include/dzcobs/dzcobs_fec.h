@@ -0,0 +1,107 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_fec.h
+///	@brief Reed-Solomon forward error correction of frames
+///
+/// The FEC protects all the frame bytes before the parity: the encoded payload,
+/// the filter descriptor and the CRC check. These bytes are interleaved in
+/// nB = ceil( M / ( 255 - 2t ) ) Reed-Solomon RS(255, 255 - 2t) codewords
+/// over GF(2^8) (polynomial 0x11D, roots alpha^1..alpha^2t), byte i belongs to
+/// codeword i % nB. Interleaving spreads a burst of errors over the codewords.
+///
+/// The 2t parity bytes of each codeword are COBS stuffed to 2t + 1 bytes, so
+/// each codeword takes exactly DZCOBS_FEC_BLOCK_SIZE bytes on the wire and the
+/// receiver can find the parity from the frame length alone.
+///
+/// Frame tail: [protected][parity][FEC descriptor][extension][encoding][hash8]
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_FEC_H_
+#define _DZCOBS_FEC_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "dzcobs.h"
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	DZCOBS_FEC_MAX_T			= ( 32 ),	 ///< Maximum number of correctable bytes per codeword
+	DZCOBS_FEC_BLOCK_SIZE = ( 256 ), ///< Protected bytes + stuffed parity of each codeword
+};
+
+/// FEC descriptor layout, as it is sent on the frame.
+/// Bits 0..5 correctable bytes per codeword (t), bit 7 always set
+enum
+{
+	DZCOBS_FEC_DESC_T_MASK				= ( 0x3F ),
+	DZCOBS_FEC_DESC_RESERVED_MASK = ( 0x40 ),
+	DZCOBS_FEC_DESC_MARKER				= ( 0x80 )
+};
+
+/// Size of the stuffed parity of aDataLen protected bytes
+#define DZCOBS_FEC_PARITY_SIZE( dataLen, t ) \
+	( ( ( ( dataLen ) + ( 255 - ( 2 * ( t ) ) ) - 1 ) / ( 255 - ( 2 * ( t ) ) ) ) * ( ( 2 * ( t ) ) + 1 ) )
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Compute the stuffed parity of the protected bytes
+ *
+ * @param aT Number of correctable bytes per codeword, 1..DZCOBS_FEC_MAX_T
+ * @param aBuf Buffer with the protected bytes, the parity is written after them
+ * @param aDataLen Number of protected bytes, must be > 0. The buffer must have
+ * space for DZCOBS_FEC_PARITY_SIZE( aDataLen, aT ) more bytes.
+ */
+void dzcobs_fec_encode( uint8_t aT, uint8_t *aBuf, size_t aDataLen );
+
+/**
+ * @brief Get the number of protected bytes from the protected + parity length
+ *
+ * @param aLen Length of the protected bytes and the stuffed parity
+ * @param aT Number of correctable bytes per codeword
+ * @return size_t The number of protected bytes, 0 if aLen is not valid
+ */
+size_t dzcobs_fec_data_size( size_t aLen, uint8_t aT );
+
+/**
+ * @brief Repair a received frame in place, before calling dzcobs_decode.
+ * Frames without FEC are left untouched.
+ *
+ * @param aFrame Received frame, without the 0 delimiter
+ * @param aFrameLen Length of the frame
+ * @param aOutCorrected Number of bytes corrected (may be NULL)
+ * @retval DZCOBS_RET_SUCCESS if the frame has no FEC or all codewords are good
+ * @retval DZCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if the tail is not valid
+ * @retval DZCOBS_RET_ERR_FEC_UNCORRECTABLE if a codeword has more than t errors.
+ * The codewords that could be repaired are still corrected.
+ */
+eDZCOBS_ret dzcobs_fec_repair( uint8_t *aFrame, size_t aFrameLen, size_t *aOutCorrected );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,129 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_filter.h
+///	@brief Reversible pre-transform filters for numeric arrays
+///
+/// Filters reorder or transform the payload before encoding, so that arrays of
+/// multi-byte samples produce long zero and repeated runs.
+/// The payload is processed in independent blocks of DZCOBS_FILTER_BLOCK_SIZE
+/// bytes. Inside a block:
+///  - DELTA replaces each element by the difference to the previous element
+///    (the first element of the block is kept).
+///  - SHUFFLE groups the bytes by significance (byte planes), as Blosc does.
+///  - DELTA_SHUFFLE applies the delta and then the shuffle.
+/// Trailing bytes of a block that do not form a full element are kept as is.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_FILTER_H_
+#define _DZCOBS_FILTER_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdint.h>
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+typedef enum e_DZCOBS_filter
+{
+	DZCOBS_FILTER_NONE					= 0, ///< No filter
+	DZCOBS_FILTER_DELTA					= 1, ///< Per element delta
+	DZCOBS_FILTER_SHUFFLE				= 2, ///< Byte plane shuffle
+	DZCOBS_FILTER_DELTA_SHUFFLE = 3, ///< Per element delta followed by byte plane shuffle
+} eDZCOBS_filter;
+
+enum
+{
+	/// Size of each independently filtered block. It is part of the protocol,
+	/// so both ends must use the same value.
+	DZCOBS_FILTER_BLOCK_SIZE = ( 256 ),
+
+	/// Maximum element width in bytes (1, 2, 4 or 8)
+	DZCOBS_FILTER_MAX_ELEMENT_SIZE = ( 8 )
+};
+
+/// Filter descriptor layout, as it is sent on the frame.
+/// Bits 0..1 filter type, bits 2..3 log2 of the element size, bit 7 always set
+enum
+{
+	DZCOBS_FILTER_DESC_TYPE_MASK		= ( 0x03 ),
+	DZCOBS_FILTER_DESC_WIDTH_SHIFT	= ( 2 ),
+	DZCOBS_FILTER_DESC_WIDTH_MASK		= ( 0x0C ),
+	DZCOBS_FILTER_DESC_RESERVED_MASK = ( 0x70 ),
+	DZCOBS_FILTER_DESC_MARKER				= ( 0x80 )
+};
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Build a filter descriptor
+ *
+ * @param aFilter The filter type
+ * @param aElementSize Size in bytes of each element: 1, 2, 4 or 8
+ * @return uint8_t The descriptor, 0 if the filter is DZCOBS_FILTER_NONE or the
+ * arguments are invalid
+ */
+uint8_t dzcobs_filter_descriptor( eDZCOBS_filter aFilter, uint8_t aElementSize );
+
+/**
+ * @brief Check if a descriptor is well formed
+ *
+ * @param aDescriptor The descriptor to check
+ * @return int 1 if it is valid, 0 otherwise
+ */
+int dzcobs_filter_descriptor_isvalid( uint8_t aDescriptor );
+
+/**
+ * @brief Apply the filter to a buffer
+ *
+ * @param aDescriptor A valid filter descriptor
+ * @param aSrc Source buffer
+ * @param aDst Destiny buffer, must not overlap aSrc
+ * @param aSize Size in bytes of both buffers
+ */
+void dzcobs_filter_encode( uint8_t aDescriptor, const uint8_t *aSrc, uint8_t *aDst, size_t aSize );
+
+/**
+ * @brief Revert the filter of a buffer
+ *
+ * @param aDescriptor A valid filter descriptor
+ * @param aSrc Source (filtered) buffer
+ * @param aDst Destiny buffer, must not overlap aSrc
+ * @param aSize Size in bytes of both buffers
+ */
+void dzcobs_filter_decode( uint8_t aDescriptor, const uint8_t *aSrc, uint8_t *aDst, size_t aSize );
+
+/**
+ * @brief Revert the filter of a buffer in place
+ *
+ * @param aDescriptor A valid filter descriptor
+ * @param aBuf Buffer to revert
+ * @param aSize Size in bytes of the buffer
+ */
+void dzcobs_filter_decode_inplace( uint8_t aDescriptor, uint8_t *aBuf, size_t aSize );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,217 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_frag.h
+///	@brief Fragmentation, priority TX scheduling and reassembly of messages
+///
+/// Large messages are split in fragments, each one sent as its own frame, so a
+/// higher priority message only waits for the fragment being sent instead of
+/// the whole lower priority message.
+///
+/// Each fragment payload starts with a header:
+///  - byte 0: bits 0..3 stream id, bit 7 last fragment flag, bits 4..6 are 0
+///  - byte 1: sequence number of the fragment on the message, from 0
+///
+/// A stream carries one message at a time: the scheduler does not start a
+/// message while another message of the same stream is partially sent.
+///
+/// No memory is allocated: messages are owned by the caller until sent, and the
+/// reassembler works on a caller provided buffer.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_FRAG_H_
+#define _DZCOBS_FRAG_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <stdbool.h>
+#include "dzcobs.h"
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	DZCOBS_FRAG_HEADER_SIZE			= ( 2 ),										 ///< Size of the fragment header
+	DZCOBS_FRAG_MAX_FRAGMENTS		= ( 256 ),									 ///< Maximum fragments of a message
+	DZCOBS_FRAG_N_STREAMS				= ( 16 ),										 ///< Number of stream ids
+	DZCOBS_TXSCHED_N_PRIORITIES = ( 4 ),										 ///< Priority queues, 0 is the highest
+	DZCOBS_REASM_MAX_SLOTS			= ( DZCOBS_FRAG_N_STREAMS ) ///< Maximum messages being reassembled
+};
+
+enum
+{
+	DZCOBS_FRAG_STREAM_MASK		= ( 0x0F ),
+	DZCOBS_FRAG_RESERVED_MASK = ( 0x70 ),
+	DZCOBS_FRAG_LAST					= ( 0x80 )
+};
+
+/// Destiny buffer size that fits any fragment frame of the scheduler
+#define DZCOBS_FRAG_MAX_FRAME_SIZE( maxFragmentData ) \
+	( DZCOBS_MAX_ENCODED_SIZE( ( maxFragmentData ) + DZCOBS_FRAG_HEADER_SIZE ) + DZCOBS_FRAME_HEADER_SIZE )
+
+/// A message to send. It is owned by the caller and must be kept, with its
+/// data, until dzcobs_txmsg_isdone returns true.
+typedef struct s_DZCOBS_txmsg
+{
+	const uint8_t *pData;					///< Message data
+	size_t size;									///< Message size
+	size_t offset;								///< Bytes already sent
+	uint8_t seq;									///< Next fragment sequence number
+	uint8_t streamId;							///< Stream of the message
+	uint8_t user6bits;						///< User 6 bits of the frames
+	bool isDone;									///< All the fragments were sent
+	struct s_DZCOBS_txmsg *pNext; ///< Next message on the queue
+} sDZCOBS_txmsg;
+
+typedef struct s_DZCOBS_txsched
+{
+	sDZCOBS_txmsg *pHead[DZCOBS_TXSCHED_N_PRIORITIES]; ///< First message of each queue
+	sDZCOBS_txmsg *pTail[DZCOBS_TXSCHED_N_PRIORITIES]; ///< Last message of each queue
+
+	uint16_t streamsInFlight; ///< Bit mask of the streams with a partially sent message
+
+	size_t maxFragmentData; ///< Maximum message bytes on each fragment
+
+	eDZCOBS_encoding encoding;
+	const sDICT_ctx *pDict;
+} sDZCOBS_txsched;
+
+/// A message being reassembled
+typedef struct s_DZCOBS_reasmslot
+{
+	uint8_t *pBuf;		 ///< Slot memory
+	size_t size;			 ///< Bytes received
+	uint8_t streamId;	 ///< Stream using the slot
+	uint8_t nextSeq;	 ///< Expected sequence number
+	bool isInUse;
+} sDZCOBS_reasmslot;
+
+typedef struct s_DZCOBS_reasm
+{
+	sDZCOBS_reasmslot slots[DZCOBS_REASM_MAX_SLOTS];
+	size_t nSlots;	 ///< Number of slots, each one can hold a message
+	size_t slotSize; ///< Maximum message size
+} sDZCOBS_reasm;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initialize a TX scheduler
+ *
+ * @param aSched Scheduler to initialize
+ * @param aEncoding Encoding of the fragment frames, not DZCOBS_AUTO
+ * @param aDict Dictionary used if aEncoding uses one, may be NULL otherwise
+ * @param aMaxFragmentData Maximum message bytes on each fragment. It bounds the
+ * time a higher priority message waits for the link.
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_txsched_init( sDZCOBS_txsched *aSched,
+																 eDZCOBS_encoding aEncoding,
+																 const sDICT_ctx *aDict,
+																 size_t aMaxFragmentData );
+
+/**
+ * @brief Add a message to a priority queue
+ *
+ * @param aSched The scheduler
+ * @param aMsg Message storage, owned by the caller until it is done
+ * @param aPriority Queue, 0 (highest) to DZCOBS_TXSCHED_N_PRIORITIES - 1
+ * @param aStreamId Stream of the message, 0 to DZCOBS_FRAG_N_STREAMS - 1
+ * @param aUser6bits User 6 bits of the frames, 1..63
+ * @param aData Message data
+ * @param aSize Message size, 1 to DZCOBS_FRAG_MAX_FRAGMENTS fragments
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_txsched_submit( sDZCOBS_txsched *aSched,
+																	 sDZCOBS_txmsg *aMsg,
+																	 uint8_t aPriority,
+																	 uint8_t aStreamId,
+																	 uint8_t aUser6bits,
+																	 const uint8_t *aData,
+																	 size_t aSize );
+
+/**
+ * @brief Encode the next fragment to send, taken from the highest priority
+ * queue that has a message ready. Call it each time the link can take a frame.
+ *
+ * @param aSched The scheduler
+ * @param aDstBuf Destiny buffer for the frame (the 0 delimiter is not added)
+ * @param aDstBufSize Destiny buffer size, DZCOBS_FRAG_MAX_FRAME_SIZE is always enough
+ * @param aOutSizeEncoded Size of the frame, 0 if there is nothing to send
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_txsched_next( sDZCOBS_txsched *aSched,
+																 uint8_t *aDstBuf,
+																 size_t aDstBufSize,
+																 size_t *aOutSizeEncoded );
+
+/**
+ * @brief Check if all the fragments of a message were encoded
+ *
+ * @param aMsg The message
+ * @return true if the message and its data can be released
+ */
+bool dzcobs_txmsg_isdone( const sDZCOBS_txmsg *aMsg );
+
+/**
+ * @brief Initialize a reassembler
+ *
+ * @param aReasm Reassembler to initialize
+ * @param aBuf Memory used to reassemble the messages
+ * @param aBufSize Size of aBuf, it is the whole memory budget
+ * @param aNSlots Number of messages that can be reassembled at the same time,
+ * 1..DZCOBS_REASM_MAX_SLOTS. Each one can be up to aBufSize / aNSlots bytes.
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_reasm_init( sDZCOBS_reasm *aReasm, uint8_t *aBuf, size_t aBufSize, size_t aNSlots );
+
+/**
+ * @brief Add a received fragment (a decoded frame payload)
+ *
+ * @param aReasm The reassembler
+ * @param aFragment Fragment, with the header
+ * @param aFragmentLen Fragment length
+ * @param aOutMsg Set to the completed message, or NULL if it is not complete.
+ * It is valid until the next call (or while aFragment is valid, for messages of
+ * a single fragment).
+ * @param aOutMsgLen Size of the completed message
+ * @param aOutStreamId Stream of the fragment
+ * @retval DZCOBS_RET_SUCCESS if the fragment was accepted
+ * @retval DZCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if the header is not valid
+ * @retval DZCOBS_RET_ERR_BAD_FRAGMENT_SEQUENCE if a fragment is missing, the
+ * partial message of the stream is dropped
+ * @retval DZCOBS_RET_ERR_WRITE_OVERFLOW if the message does not fit on the
+ * memory budget, it is dropped
+ */
+eDZCOBS_ret dzcobs_reasm_push( sDZCOBS_reasm *aReasm,
+															 const uint8_t *aFragment,
+															 size_t aFragmentLen,
+															 const uint8_t **aOutMsg,
+															 size_t *aOutMsgLen,
+															 uint8_t *aOutStreamId );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
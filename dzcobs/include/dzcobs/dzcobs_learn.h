@@ -0,0 +1,133 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_learn.h
+///	@brief On-device dictionary learner, with a fixed memory budget
+///
+/// Observes payloads (e.g. the ones passed to dzcobs_encode_inc) and keeps the
+/// most frequent 2..5 bytes n-grams with a set associative space-saving table:
+/// each n-gram maps to a bucket of DZCOBS_LEARN_N_WAYS entries and, when it is
+/// not there, it replaces the entry of the bucket with the lowest count and
+/// takes that count + 1. So the cost per byte is constant and no memory is
+/// allocated. Counts are halved when one saturates, so old traffic fades.
+///
+/// dzcobs_learn_build writes a dictionary string in the DICT_ADD_WORD layout,
+/// that can be given to dzcobs_dictionary_init. Note that both ends of the link
+/// must use the same dictionary, so it has to be sent to the peer before use.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_LEARN_H_
+#define _DZCOBS_LEARN_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "dzcobs_dictionary.h"
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Number of buckets of the n-gram table, must be a power of 2.
+/// The table uses DZCOBS_LEARN_N_BUCKETS * DZCOBS_LEARN_N_WAYS * 8 bytes.
+#ifndef DZCOBS_LEARN_N_BUCKETS
+#define DZCOBS_LEARN_N_BUCKETS ( 64 )
+#endif
+
+enum
+{
+	DZCOBS_LEARN_N_WAYS					= ( 4 ), ///< Entries per bucket
+	DZCOBS_LEARN_N_ENTRIES			= ( DZCOBS_LEARN_N_BUCKETS * DZCOBS_LEARN_N_WAYS ),
+	DZCOBS_LEARN_MIN_WORD_SIZE	= ( 2 ),
+	DZCOBS_LEARN_MAX_WORD_SIZE	= ( 5 ),
+	DZCOBS_LEARN_MAX_WORDS			= ( 126 ),
+	DZCOBS_LEARN_MIN_COUNT			= ( 2 ), ///< n-grams seen less times are not used
+
+	/// Buffer size that fits any built dictionary
+	DZCOBS_LEARN_MAX_DICT_SIZE = ( DZCOBS_LEARN_MAX_WORDS * ( DZCOBS_LEARN_MAX_WORD_SIZE + 1 ) + 1 )
+};
+
+typedef struct s_DZCOBS_learnentry
+{
+	uint16_t count;																///< Estimated count, 0 if the entry is free
+	uint8_t size;																	///< n-gram size
+	uint8_t bytes[DZCOBS_LEARN_MAX_WORD_SIZE]; ///< n-gram bytes
+} sDZCOBS_learnentry;
+
+typedef struct s_DZCOBS_learn
+{
+	sDZCOBS_learnentry entries[DZCOBS_LEARN_N_ENTRIES];
+
+	uint8_t window[DZCOBS_LEARN_MAX_WORD_SIZE]; ///< Last bytes of the payload, the newest at the end
+	uint8_t windowLen;													///< Valid bytes on the window
+
+	/// Entries left to halve since a count saturated, the last ones of the
+	/// table. One is halved per counted n-gram, so no update halves them all.
+	size_t nAging;
+} sDZCOBS_learn;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initialize a learner, with no n-grams
+ *
+ * @param aCtx Learner to initialize
+ * @return eDICT_ret
+ */
+eDICT_ret dzcobs_learn_init( sDZCOBS_learn *aCtx );
+
+/**
+ * @brief Observe payload bytes. A payload may be given in several calls,
+ * n-grams are counted across them until dzcobs_learn_payload_end.
+ *
+ * @param aCtx Learner in use
+ * @param aData Payload bytes
+ * @param aDataSize Number of bytes
+ * @return eDICT_ret
+ */
+eDICT_ret dzcobs_learn_update( sDZCOBS_learn *aCtx, const uint8_t *aData, size_t aDataSize );
+
+/**
+ * @brief End of the payload, the next bytes start a new one
+ *
+ * @param aCtx Learner in use
+ * @return eDICT_ret
+ */
+eDICT_ret dzcobs_learn_payload_end( sDZCOBS_learn *aCtx );
+
+/**
+ * @brief Build a dictionary string with the most frequent n-grams. Words that
+ * would never be matched (a shorter word is their prefix, as shorter words are
+ * searched first) are left out.
+ *
+ * @param aCtx Learner in use
+ * @param aOutDict Dictionary string output, null terminated
+ * @param aOutDictSize Size of aOutDict, DZCOBS_LEARN_MAX_DICT_SIZE is always enough
+ * @param aOutDictLen Dictionary size including the terminator, as dzcobs_dictionary_init takes it
+ * @retval DICT_RET_SUCCESS if the dictionary was written
+ * @retval DICT_RET_ERR_BAD_ARG if invalid arguments are passed or aOutDict is too small
+ * @retval DICT_RET_ERR_INVALID if no n-gram is frequent enough yet
+ */
+eDICT_ret dzcobs_learn_build( const sDZCOBS_learn *aCtx, char *aOutDict, size_t aOutDictSize, size_t *aOutDictLen );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
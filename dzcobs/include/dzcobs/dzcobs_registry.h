@@ -0,0 +1,228 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_registry.h
+///	@brief Dictionary registry and per connection dictionary negotiation
+///
+/// A frame can only select DZCOBS_DICT_N dictionaries (DICT_1 and DICT_2), so a
+/// server that talks to peers using different dictionaries keeps them all on a
+/// registry and binds, for each connection, its two slots to registry entries.
+///
+/// Each dictionary is known by its id, the CRC-32C of its words (the dictionary
+/// string without the terminator), so both sides agree on the id of the same
+/// dictionary without sharing any other state.
+///
+/// The registry is a fixed size hash table on caller provided entries. Adding
+/// and finding are lock-free, so many threads can find dictionaries while other
+/// threads add new ones. Entries are never removed, the dictionaries must be
+/// kept while the registry is in use.
+///
+/// Negotiation, with payloads sent on plain frames by the application:
+///  - the initiator sends an offer: the ids it can use, by preference order
+///    [DZCOBS_NEGOTIATE_OFFER][n][id 0]..[id n-1]
+///  - the responder binds DICT_1 and DICT_2 to the first two offered ids it has
+///    on its registry, and replies with them (0 if a slot is not bound)
+///    [DZCOBS_NEGOTIATE_ACCEPT][id DICT_1][id DICT_2]
+///  - the initiator binds its slots to the accepted ids.
+/// The ids are 32 bits little-endian.
+///
+/// After the handshake the connection holds the dictionary pointers, so the
+/// frames are encoded and decoded without any registry lookup.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_REGISTRY_H_
+#define _DZCOBS_REGISTRY_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "dzcobs.h"
+#include "dzcobs_decode.h"
+
+#if defined( __cplusplus )
+#include <atomic>
+#define DZCOBS_ATOMIC( type ) std::atomic< type >
+#elif !defined( __STDC_NO_ATOMICS__ )
+#include <stdatomic.h>
+#define DZCOBS_ATOMIC( type ) _Atomic( type )
+#else
+/// No atomics available, the registry must not be shared between threads
+#define DZCOBS_ATOMIC( type ) type volatile
+#endif
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	DZCOBS_NEGOTIATE_OFFER	 = ( 0x01 ), ///< Offer message type
+	DZCOBS_NEGOTIATE_ACCEPT	 = ( 0x02 ), ///< Accept message type
+	DZCOBS_NEGOTIATE_MAX_IDS = ( 16 )		 ///< Maximum ids on an offer
+};
+
+/// Size of an offer message with n ids
+#define DZCOBS_NEGOTIATE_OFFER_SIZE( n ) ( 2u + ( 4u * ( n ) ) )
+
+/// Size of an accept message
+#define DZCOBS_NEGOTIATE_ACCEPT_SIZE ( 1 + ( 4 * DZCOBS_DICT_N ) )
+
+/// Registry entry. It is free while pDict is NULL, and is found after its id is set.
+typedef struct s_DZCOBS_registry_entry
+{
+	DZCOBS_ATOMIC( uint32_t ) id;
+	DZCOBS_ATOMIC( const sDICT_ctx * ) pDict;
+} sDZCOBS_registry_entry;
+
+typedef struct s_DZCOBS_registry
+{
+	sDZCOBS_registry_entry *pEntries;
+	size_t mask; ///< Number of entries - 1
+} sDZCOBS_registry;
+
+/// Dictionaries of a connection
+typedef struct s_DZCOBS_connection
+{
+	uint32_t dictId[DZCOBS_DICT_N];				///< Id bound to each slot, 0 if not bound
+	const sDICT_ctx *pDict[DZCOBS_DICT_N]; ///< Dictionary bound to each slot, NULL if not bound
+} sDZCOBS_connection;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Id of a dictionary: the CRC-32C of its words, 0 is never returned
+ *
+ * @param aDict The dictionary
+ * @return uint32_t The id, 0 if aDict is not valid
+ */
+uint32_t dzcobs_registry_id( const sDICT_ctx *aDict );
+
+/**
+ * @brief Initialize a registry. It is not thread safe, it must be done before
+ * the registry is shared.
+ *
+ * @param aRegistry Registry to initialize
+ * @param aEntries Entries storage, kept while the registry is in use
+ * @param aNEntries Number of entries, a power of two. Keep some free entries,
+ * each search goes over the consecutive used ones.
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_registry_init( sDZCOBS_registry *aRegistry, sDZCOBS_registry_entry *aEntries, size_t aNEntries );
+
+/**
+ * @brief Add a dictionary to the registry, lock-free
+ *
+ * @param aRegistry The registry
+ * @param aDict The dictionary, kept while the registry is in use
+ * @param aOutId Id of the dictionary, may be NULL
+ * @retval DZCOBS_RET_SUCCESS if it was added, or a dictionary with the same id already was
+ * @retval DZCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval DZCOBS_RET_ERR_WRITE_OVERFLOW if the registry is full
+ */
+eDZCOBS_ret dzcobs_registry_add( sDZCOBS_registry *aRegistry, const sDICT_ctx *aDict, uint32_t *aOutId );
+
+/**
+ * @brief Find a dictionary by its id, lock-free
+ *
+ * @param aRegistry The registry
+ * @param aId Dictionary id
+ * @return const sDICT_ctx* The dictionary, NULL if not found
+ */
+const sDICT_ctx *dzcobs_registry_find( const sDZCOBS_registry *aRegistry, uint32_t aId );
+
+/**
+ * @brief Write an offer message
+ *
+ * @param aIds Ids the initiator can use, by preference order
+ * @param aNIds Number of ids, 1..DZCOBS_NEGOTIATE_MAX_IDS
+ * @param aOutMsg Message output
+ * @param aOutMsgSize Size of aOutMsg, at least DZCOBS_NEGOTIATE_OFFER_SIZE( aNIds )
+ * @param aOutMsgLen Message size written
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_negotiate_offer( const uint32_t *aIds,
+																		size_t aNIds,
+																		uint8_t *aOutMsg,
+																		size_t aOutMsgSize,
+																		size_t *aOutMsgLen );
+
+/**
+ * @brief Responder side: bind a connection to the offered dictionaries found on
+ * the registry and write the accept message
+ *
+ * @param aRegistry The registry
+ * @param aOffer Offer message received
+ * @param aOfferLen Offer message length
+ * @param aConn Connection to bind, slots without a common dictionary are not bound
+ * @param aOutMsg Accept message output
+ * @param aOutMsgSize Size of aOutMsg, at least DZCOBS_NEGOTIATE_ACCEPT_SIZE
+ * @param aOutMsgLen Message size written
+ * @retval DZCOBS_RET_SUCCESS if the connection was bound
+ * @retval DZCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if aOffer is not a valid offer
+ */
+eDZCOBS_ret dzcobs_negotiate_accept( const sDZCOBS_registry *aRegistry,
+																		 const uint8_t *aOffer,
+																		 size_t aOfferLen,
+																		 sDZCOBS_connection *aConn,
+																		 uint8_t *aOutMsg,
+																		 size_t aOutMsgSize,
+																		 size_t *aOutMsgLen );
+
+/**
+ * @brief Initiator side: bind a connection to the accepted dictionaries
+ *
+ * @param aRegistry The registry
+ * @param aAccept Accept message received
+ * @param aAcceptLen Accept message length
+ * @param aConn Connection to bind
+ * @retval DZCOBS_RET_SUCCESS if the connection was bound
+ * @retval DZCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if aAccept is not a valid accept
+ * @retval DZCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE if an accepted id is not on
+ * the registry, the connection is not bound
+ */
+eDZCOBS_ret dzcobs_negotiate_complete( const sDZCOBS_registry *aRegistry,
+																			 const uint8_t *aAccept,
+																			 size_t aAcceptLen,
+																			 sDZCOBS_connection *aConn );
+
+/**
+ * @brief Set the connection dictionaries on an encoding context
+ *
+ * @param aConn The connection
+ * @param aCtx The encoding context
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_connection_set_encoder( const sDZCOBS_connection *aConn, sDZCOBS_ctx *aCtx );
+
+/**
+ * @brief Set the connection dictionaries on a decoding context
+ *
+ * @param aConn The connection
+ * @param aDecodeCtx The decoding context
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_connection_set_decoder( const sDZCOBS_connection *aConn, sDZCOBS_decodectx *aDecodeCtx );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,128 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_ring.h
+///	@brief Ring buffer output of the decoder
+///
+/// Frames are decoded (see dzcobs_decode_sink) to the end of a wraparound ring
+/// buffer, and the decoded data is consumed from its start, so a stream of
+/// frames needs no buffer for the worst case decoded size of a frame.
+///
+/// A ring is used by one producer and one consumer on the same thread, it has
+/// no locking.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_RING_H_
+#define _DZCOBS_RING_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "dzcobs.h"
+#include "dzcobs_decode.h"
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+typedef struct s_DZCOBS_ring
+{
+	uint8_t *pBuf;	///< Ring storage
+	size_t size;		///< Ring storage size
+	size_t readIdx; ///< Index of the oldest byte
+	size_t used;		///< Bytes stored
+} sDZCOBS_ring;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initialize an empty ring
+ *
+ * @param aRing Ring to be initialized
+ * @param aBuf Ring storage
+ * @param aSize Ring storage size
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_ring_init( sDZCOBS_ring *aRing, uint8_t *aBuf, size_t aSize );
+
+/**
+ * @brief Decodes a source encoded buffer to the end of a ring. Nothing is
+ * written if the frame is not valid or the decoded data does not fit.
+ *
+ * @param aDecodeCtx As for dzcobs_decode_sink
+ * @param aRing Ring that receives the decoded data
+ * @param aOutDecodedLen Decoded length written to the ring
+ * @param aOutUser6bitDataRightAlgn The 6 bit user data of the frame
+ * @retval DZCOBS_RET_ERR_WRITE_OVERFLOW if the ring has no space for the data
+ */
+eDZCOBS_ret dzcobs_decode_ring( const sDZCOBS_decodectx *aDecodeCtx,
+																sDZCOBS_ring *aRing,
+																size_t *aOutDecodedLen,
+																uint8_t *aOutUser6bitDataRightAlgn );
+
+/**
+ * @brief A dzcobs_decode_sink_funcPtr that writes the data to the end of a
+ * ring, aArg is the ring
+ *
+ * @retval DZCOBS_RET_ERR_WRITE_OVERFLOW if the ring has no space for aSize bytes,
+ * nothing is written
+ */
+eDZCOBS_ret dzcobs_ring_sink( void *aArg, eDZCOBS_run aRun, const uint8_t *aData, size_t aSize );
+
+/**
+ * @brief Get the contiguous data at the start of a ring, without removing it
+ *
+ * @param aRing The ring
+ * @param aOutData The data
+ * @return Size of the data, it can be less than the ring used size when the
+ * data wraps around
+ */
+size_t dzcobs_ring_peek( const sDZCOBS_ring *aRing, const uint8_t **aOutData );
+
+/**
+ * @brief Remove data from the start of a ring
+ *
+ * @param aRing The ring
+ * @param aDst Destiny of the data, can be NULL to discard it
+ * @param aSize Maximum size to read
+ * @return Size read, less than aSize if the ring has less data
+ */
+size_t dzcobs_ring_read( sDZCOBS_ring *aRing, uint8_t *aDst, size_t aSize );
+
+/**
+ * @brief Get the bytes stored on a ring
+ *
+ * @param aRing The ring
+ * @return Bytes stored
+ */
+size_t dzcobs_ring_used( const sDZCOBS_ring *aRing );
+
+/**
+ * @brief Get the bytes that can still be written to a ring
+ *
+ * @param aRing The ring
+ * @return Free bytes
+ */
+size_t dzcobs_ring_free( const sDZCOBS_ring *aRing );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
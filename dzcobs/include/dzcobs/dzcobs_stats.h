@@ -0,0 +1,117 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_stats.h
+///	@brief Dictionary words use instrumentation
+///
+/// Counts, for each word of a dictionary, how many times the encoder or the
+/// decoder used it and the bytes it saved, and how many encoder searches found
+/// nothing. It shows the dead words, so the dictionary can be pruned or
+/// retrained (see dzcobs_train).
+///
+/// The counting is compiled only when the library is built with DZCOBS_STATS
+/// defined as 1 (DZCOBS_WITH_STATS CMake option). Otherwise the counters of an
+/// attached stats are never updated.
+///
+/// The stats are attached to a dictionary context. The counters are not atomic,
+/// so each thread must use its own dictionary context copy and stats. A copy of
+/// the context also keeps separate stats for the encoder and the decoder.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_STATS_H_
+#define _DZCOBS_STATS_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "dzcobs.h"
+#include "dzcobs_dictionary.h"
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	DZCOBS_STATS_MAX_WORDS = ( 126 ) ///< Maximum words of a dictionary
+};
+
+struct s_DZCOBS_stats
+{
+	uint32_t hits[DZCOBS_STATS_MAX_WORDS];			 ///< Times each word (0 based index) was encoded or decoded
+	uint32_t bytesSaved[DZCOBS_STATS_MAX_WORDS]; ///< Bytes saved by each word, its size - 1 on each hit
+	uint32_t searches;													 ///< Encoder dictionary searches
+	uint32_t misses;														 ///< Encoder dictionary searches that found nothing
+};
+
+/**
+ * @brief Called by dzcobs_stats_dump for each word of the dictionary
+ *
+ * @param aArg User argument
+ * @param aIndex Word index, 0 based
+ * @param aWord The word
+ * @param aWordSize Size of the word
+ * @param aHits Times the word was used, 0 if it is a dead word
+ * @param aBytesSaved Bytes saved by the word
+ */
+typedef void ( *dzcobs_stats_word_funcPtr )( void *aArg,
+																						 uint8_t aIndex,
+																						 const uint8_t *aWord,
+																						 uint8_t aWordSize,
+																						 uint32_t aHits,
+																						 uint32_t aBytesSaved );
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Clear all the counters
+ *
+ * @param aStats The stats
+ */
+void dzcobs_stats_reset( sDZCOBS_stats *aStats );
+
+/**
+ * @brief Attach (or detach, if aStats is NULL) stats to a dictionary context.
+ * The encoder and the decoder count on it each use of the dictionary.
+ *
+ * @param aDict The dictionary context
+ * @param aStats Stats to attach, cleared. Kept while the dictionary is in use.
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_stats_attach( sDICT_ctx *aDict, sDZCOBS_stats *aStats );
+
+/**
+ * @brief Report the counters of each word of a dictionary, by index order
+ *
+ * @param aStats The stats
+ * @param aDict The dictionary the stats were counted on
+ * @param aWordFunc Called for each word
+ * @param aArg User argument of aWordFunc
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_stats_dump( const sDZCOBS_stats *aStats,
+															 const sDICT_ctx *aDict,
+															 dzcobs_stats_word_funcPtr aWordFunc,
+															 void *aArg );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,142 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_tail.h
+///	@brief Tail-coded streaming encoder, with no output buffering
+///
+/// The regular encoder writes each code byte before its run, so it must keep
+/// the run (up to 254 bytes) in the destiny buffer until the run closes.
+/// Tail-coded frames place each code byte after its run (as rCOBS does), so
+/// every byte is final when produced and is passed at once to a put function,
+/// e.g. the UART data register. The context has a fixed size of a few bytes.
+///
+/// Tail-coded frames are extended frames with DZCOBS_EXT_TAIL_CODED set, and
+/// the receiver decodes them with dzcobs_decode as any other frame (it parses
+/// the payload backwards, from the frame tail).
+///
+/// Payload tokens, in wire order:
+///  - run: up to N non zero bytes followed by its code N + 1. A 0x00 is
+///    implied after the run, unless the code is the jump code, the run is the
+///    last token, or the next token is a dictionary word.
+///  - dictionary word (dictionary encodings only): one code byte >= 0x80.
+/// A 0x00 followed by a dictionary word is sent as the run closed by the 0x00
+/// and an empty run (code 1) before the word.
+///
+/// The filter and FEC features need the whole frame, so they are not available
+/// on tail-coded frames. CRC checks are.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_TAIL_H_
+#define _DZCOBS_TAIL_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <stdbool.h>
+#include "dzcobs.h"
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Called for each encoded byte, in wire order
+ *
+ * @param aUser User pointer given on dzcobs_tail_encode_begin
+ * @param aByte Encoded byte, never 0x00
+ */
+typedef void ( *dzcobs_tail_put_funcPtr )( void *aUser, uint8_t aByte );
+
+typedef struct s_DZCOBS_tailctx
+{
+	dzcobs_tail_put_funcPtr putFunc; ///< Output of the encoded bytes
+	void *pUser;										 ///< User pointer passed to putFunc
+
+	const sDICT_ctx *pDict; ///< Dictionary in use, NULL if plain encoding
+
+	uint32_t crc; ///< Current CRC of the sent bytes, if a check is used
+
+	uint8_t runLen;		 ///< Bytes on the current run
+	uint8_t hashsum;	 ///< Current sum of DZCOBS_HASH8
+	uint8_t user6bits; ///< User application 6 bits, 1..63
+	uint8_t jumpCode;	 ///< Code of a full run
+
+	bool isStarted;				///< Bytes were already sent
+	bool isZeroClosed;		///< Last token is a run closed by a 0x00
+	bool isLastDictionary; ///< Last token is a dictionary word
+
+	eDZCOBS_check check;
+	eDZCOBS_encoding encoding;
+} sDZCOBS_tailctx;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Begin a tail-coded frame. No byte is sent yet.
+ *
+ * @param aCtx Context to be initialized
+ * @param aEncoding The desired encoding type for this frame, not DZCOBS_AUTO
+ * @param aDict Dictionary used if aEncoding uses one, may be NULL otherwise
+ * @param aUser6bits User application 6 bits, 1..63
+ * @param aPutFunc Function that receives the encoded bytes
+ * @param aUser User pointer passed to aPutFunc
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_tail_encode_begin( sDZCOBS_tailctx *aCtx,
+																			eDZCOBS_encoding aEncoding,
+																			const sDICT_ctx *aDict,
+																			uint8_t aUser6bits,
+																			dzcobs_tail_put_funcPtr aPutFunc,
+																			void *aUser );
+
+/**
+ * @brief Add a CRC check to the frame. Must be called before adding data.
+ *
+ * @param aCtx The encoding context.
+ * @param aCheck The check to add
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_tail_encode_set_check( sDZCOBS_tailctx *aCtx, eDZCOBS_check aCheck );
+
+/**
+ * @brief Encode data. The encoded bytes are sent while encoding.
+ * Dictionary words are searched on each call buffer, they are not matched
+ * across calls.
+ *
+ * @param aCtx Context in use
+ * @param aSrcBuf Source buffer of data to add
+ * @param aSrcBufSize Size of source buffer
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_tail_encode( sDZCOBS_tailctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
+
+/**
+ * @brief Finalize the frame, sending its last code and the frame tail. It does
+ * not send the 0x00 delimiter.
+ *
+ * @param aCtx Context in use
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_tail_encode_end( sDZCOBS_tailctx *aCtx );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
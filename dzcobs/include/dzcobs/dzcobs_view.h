@@ -0,0 +1,134 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_view.h
+///	@brief Reader of the decoded data of a frame, without copying it
+///
+/// A view (see dzcobs_decode_view) reads the decoded data on the encoded frame
+/// itself. The data is a sequence of segments: the runs of the frame, between
+/// its code bytes, each one followed or not by a 0x00, and the dictionary words,
+/// read on the dictionary. The code bytes of the frame are the segments list,
+/// so a view of any size takes no memory.
+///
+/// The reader gets the data by segments, or copies it, or reads integers, across
+/// the segments boundaries.
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_VIEW_H_
+#define _DZCOBS_VIEW_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <stdbool.h>
+#include "dzcobs.h"
+#include "dzcobs_decode.h"
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Decoded data that is contiguous on the encoded frame or on the dictionary
+typedef struct s_DZCOBS_segment
+{
+	const uint8_t *pData; ///< Segment bytes
+	size_t size;					///< Segment size, it can be 0 if a 0x00 follows it
+	bool isWord;					///< The segment is a dictionary word, otherwise a run of the frame
+	bool isZeroAfter;			///< The decoded data has a 0x00 after the segment
+} sDZCOBS_segment;
+
+typedef struct s_DZCOBS_viewreader
+{
+	const sDZCOBS_view *pView;
+
+	size_t codeIdx; ///< Payload index of the next code
+
+	const uint8_t *pSegment; ///< Bytes not read of the current segment
+	size_t segmentSize;			 ///< Size not read of the current segment
+	bool isWord;						 ///< The current segment is a dictionary word
+	bool isZeroAfter;				 ///< The current segment is followed by a 0x00 not read
+
+	size_t pos; ///< Decoded bytes read
+} sDZCOBS_viewreader;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Start reading a view from its first decoded byte
+ *
+ * @param aReader Reader to be initialized
+ * @param aView View got by dzcobs_decode_view
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_view_reader_init( sDZCOBS_viewreader *aReader, const sDZCOBS_view *aView );
+
+/**
+ * @brief Get the decoded data not read yet of the current segment, and move to
+ * the next one. Concatenated, the segments and their 0x00 are the decoded data.
+ *
+ * @param aReader Reader in use
+ * @param aOutSegment The segment
+ * @return true if a segment was got, false at the end of the data
+ */
+bool dzcobs_view_next_segment( sDZCOBS_viewreader *aReader, sDZCOBS_segment *aOutSegment );
+
+/**
+ * @brief Copy decoded data
+ *
+ * @param aReader Reader in use
+ * @param aDst Destiny of the data, can be NULL to skip it
+ * @param aSize Size to read
+ * @retval DZCOBS_RET_ERR_READ_OVERFLOW if there are less than aSize bytes left,
+ * nothing is read
+ */
+eDZCOBS_ret dzcobs_view_read( sDZCOBS_viewreader *aReader, uint8_t *aDst, size_t aSize );
+
+/**
+ * @brief Read an unsigned little-endian integer
+ *
+ * @param aReader Reader in use
+ * @param aSize Size of the integer, 1 to 8 bytes
+ * @param aOutValue The integer
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_view_read_le( sDZCOBS_viewreader *aReader, uint8_t aSize, uint64_t *aOutValue );
+
+/**
+ * @brief Read an unsigned big-endian integer
+ *
+ * @param aReader Reader in use
+ * @param aSize Size of the integer, 1 to 8 bytes
+ * @param aOutValue The integer
+ * @return eDZCOBS_ret
+ */
+eDZCOBS_ret dzcobs_view_read_be( sDZCOBS_viewreader *aReader, uint8_t aSize, uint64_t *aOutValue );
+
+/**
+ * @brief Get the decoded bytes not read yet
+ *
+ * @param aReader Reader in use
+ * @return Bytes left
+ */
+size_t dzcobs_view_remaining( const sDZCOBS_viewreader *aReader );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -17,13 +17,37 @@
 // /////////////////////////////////////////////////////////////////////////////
 #include <dzcobs/dzcobs.h>
 #include <stdbool.h>
+#include <string.h>
 #include "dzcobs/dzcobs_dictionary.h"
+#include "dzcobs/dzcobs_fec.h"
+#include "dzcobs/dzcobs_stats.h"
 #include "dzcobs_assert.h"
+#include "dzcobs_simd.h"
 
 // Definitions
 // /////////////////////////////////////////////////////////////////////////////
 static eDZCOBS_ret dzcobs_encode_inc_plain( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
 static eDZCOBS_ret dzcobs_encode_inc_dictionary( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
+static eDZCOBS_ret dzcobs_encode_inc_filter( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
+static eDZCOBS_ret dzcobs_encode_inc_auto( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
+static eDZCOBS_ret dzcobs_encode_inc_words( sDZCOBS_ctx *aCtx,
+																						const sDICT_ctx *aDict,
+																						const uint8_t *aSrcBuf,
+																						size_t aSrcBufSize );
+static eDZCOBS_encoding dzcobs_encode_auto_select( const sDZCOBS_ctx *aCtx,
+																									 const uint8_t *aSrcBuf,
+																									 size_t aSrcBufSize );
+
+/// Encoder state of dzcobs_encoded_size, the bytes are counted instead of written
+typedef struct s_DZCOBS_sizectx
+{
+	size_t size;	///< Bytes used, as pCurDst - pDst
+	uint8_t code; ///< Current code
+	bool isLastCodeDictionary;
+	bool isZeroPending;
+	uint8_t searchSkip;
+	uint16_t searchMisses;
+} sDZCOBS_sizectx;
 
 // Implementation
 // /////////////////////////////////////////////////////////////////////////////
@@ -66,6 +90,16 @@ eDZCOBS_ret dzcobs_encode_inc_begin( sDZCOBS_ctx *aCtx,
 	aCtx->hashsum	 = 0;
 
 	aCtx->isLastCodeDictionary = false;
+	aCtx->isZeroPending				 = false;
+	aCtx->isFilterSealed			 = false;
+
+	aCtx->filter = 0;
+	aCtx->check	 = DZCOBS_CHECK_HASH8;
+	aCtx->fecT	 = 0;
+
+	aCtx->acceleration = 0;
+	aCtx->searchSkip	 = 0;
+	aCtx->searchMisses = 0;
 
 	aCtx->encoding = aEncoding;
 
@@ -79,6 +113,11 @@ eDZCOBS_ret dzcobs_encode_inc_begin( sDZCOBS_ctx *aCtx,
 	case DZCOBS_USING_DICT_2:
 		aCtx->encFunc = dzcobs_encode_inc_dictionary;
 		break;
+
+	case DZCOBS_AUTO:
+		aCtx->encFunc = dzcobs_encode_inc_auto;
+		break;
+
 	case DZCOBS_RESERVED:
 	default:
 		aCtx->encFunc = NULL;
@@ -90,23 +129,134 @@ eDZCOBS_ret dzcobs_encode_inc_begin( sDZCOBS_ctx *aCtx,
 	return DZCOBS_RET_SUCCESS;
 }
 
-eDZCOBS_ret dzcobs_encode_inc_end( sDZCOBS_ctx *aCtx, size_t *aOutSizeEncoded )
+eDZCOBS_ret dzcobs_encode_set_filter( sDZCOBS_ctx *aCtx, eDZCOBS_filter aFilter, uint8_t aElementSize )
 {
-	if( ( !aCtx ) || ( !aOutSizeEncoded ) )
+	if( ( !aCtx ) || ( aCtx->encFunc == NULL ) )
 	{
 		return DZCOBS_RET_ERR_BAD_ARG;
 	}
 
-	if( ( aCtx->pCurDst + 1 ) > aCtx->pDstEnd )
+	// Filter must be set before any data is added
+	if( ( aCtx->pCurDst != ( aCtx->pDst + 1 ) ) || ( aCtx->filter != 0 ) )
 	{
-		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+		return DZCOBS_RET_ERR_BAD_FILTER_SEQUENCE;
 	}
 
-	if( aCtx->user6bits == 0 )
+	const uint8_t descriptor = dzcobs_filter_descriptor( aFilter, aElementSize );
+
+	if( descriptor == 0 )
 	{
-		return DZCOBS_RET_ERR_INVALID_USER6BITS;
+		return DZCOBS_RET_ERR_BAD_ARG;
 	}
 
+	aCtx->filter				 = descriptor;
+	aCtx->isFilterSealed = false;
+	aCtx->encFunc				 = dzcobs_encode_inc_filter;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_encode_set_check( sDZCOBS_ctx *aCtx, eDZCOBS_check aCheck )
+{
+	if( ( !aCtx ) || ( aCtx->encFunc == NULL ) ||
+			( !( ( aCheck == DZCOBS_CHECK_HASH8 ) || ( aCheck == DZCOBS_CHECK_CRC16 ) ||
+					 ( aCheck == DZCOBS_CHECK_CRC32C ) ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	aCtx->check = aCheck;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_encode_set_fec( sDZCOBS_ctx *aCtx, uint8_t aT )
+{
+	if( ( !aCtx ) || ( aCtx->encFunc == NULL ) || ( aT > DZCOBS_FEC_MAX_T ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	aCtx->fecT = aT;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_encode_set_acceleration( sDZCOBS_ctx *aCtx, uint8_t aAcceleration )
+{
+	if( ( !aCtx ) || ( aCtx->encFunc == NULL ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	aCtx->acceleration = aAcceleration;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+static void dzcobs_encode_check( sDZCOBS_ctx *aCtx, uint8_t aExtensionByte, uint8_t aEncodingByte )
+{
+	const uint8_t tail[2] = { aExtensionByte, aEncodingByte };
+	const size_t frameSize = (size_t)( aCtx->pCurDst - aCtx->pDst );
+
+	if( aCtx->check == DZCOBS_CHECK_CRC16 )
+	{
+		const uint16_t crc = dzcobs_crc16( dzcobs_crc16( 0, aCtx->pDst, frameSize ), tail, sizeof( tail ) );
+
+		dzcobs_crc_stuff( crc, DZCOBS_CRC16_SIZE, aCtx->pCurDst );
+	}
+	else
+	{
+		DZCOBS_ASSERT( aCtx->check == DZCOBS_CHECK_CRC32C );
+
+		const uint32_t crc = dzcobs_crc32c( dzcobs_crc32c( 0, aCtx->pDst, frameSize ), tail, sizeof( tail ) );
+
+		dzcobs_crc_stuff( crc, DZCOBS_CRC32C_SIZE, aCtx->pCurDst );
+	}
+
+	const size_t checkSize = DZCOBS_FRAME_CHECK_SIZE( aCtx->check );
+
+	for( size_t i = 0; i < checkSize; i++ )
+	{
+		aCtx->hashsum += DZCOBS_HASH8( aCtx->pCurDst[i] );
+	}
+
+	aCtx->pCurDst += checkSize;
+}
+
+/// Size of the frame tail added by dzcobs_encode_inc_end after aPayloadSize bytes
+static size_t dzcobs_encode_tail_size( const sDZCOBS_ctx *aCtx, size_t aPayloadSize )
+{
+	const bool isFiltered = ( aCtx->filter != 0 );
+	const bool isExtended = isFiltered || ( aCtx->check != DZCOBS_CHECK_HASH8 ) || ( aCtx->fecT != 0 );
+
+	size_t tailSize = DZCOBS_FRAME_HEADER_SIZE;
+
+	if( isExtended )
+	{
+		tailSize += DZCOBS_FRAME_EXTENSION_SIZE + DZCOBS_FRAME_CHECK_SIZE( aCtx->check );
+	}
+
+	if( isFiltered )
+	{
+		tailSize += DZCOBS_FRAME_FILTER_SIZE;
+	}
+
+	if( aCtx->fecT != 0 )
+	{
+		// Protected bytes: payload, filter descriptor and check
+		const size_t protectedSize =
+			aPayloadSize + ( tailSize - DZCOBS_FRAME_HEADER_SIZE - DZCOBS_FRAME_EXTENSION_SIZE );
+
+		tailSize += DZCOBS_FEC_PARITY_SIZE( protectedSize, aCtx->fecT ) + DZCOBS_FRAME_FEC_SIZE;
+	}
+
+	return tailSize;
+}
+
+/// Write the code of the last run, or drop the placeholder of a last dictionary code
+static void dzcobs_encode_close( sDZCOBS_ctx *aCtx )
+{
 	if( aCtx->isLastCodeDictionary )
 	{
 		DZCOBS_ASSERT( ( aCtx->pCodeDst + 1 ) == aCtx->pCurDst );
@@ -118,11 +268,13 @@ eDZCOBS_ret dzcobs_encode_inc_end( sDZCOBS_ctx *aCtx, size_t *aOutSizeEncoded )
 		aCtx->hashsum += DZCOBS_HASH8( code );
 		*aCtx->pCodeDst = code;
 	}
+}
 
-	// Add (tail) header info
-
+/// Write the user 6 bits, the encoding and the hash, returns the frame size
+static size_t dzcobs_encode_seal( sDZCOBS_ctx *aCtx, uint8_t aWireEncoding )
+{
 	// User 6 bits and encoding info
-	const uint8_t encodingByte = (uint8_t)( aCtx->user6bits << 2 ) | ( (uint8_t)aCtx->encoding & 0x03 );
+	const uint8_t encodingByte = (uint8_t)( aCtx->user6bits << 2 ) | aWireEncoding;
 
 	aCtx->hashsum += DZCOBS_HASH8( encodingByte );
 
@@ -134,13 +286,223 @@ eDZCOBS_ret dzcobs_encode_inc_end( sDZCOBS_ctx *aCtx, size_t *aOutSizeEncoded )
 	*aCtx->pCurDst++ = ( finalHash == 0x00 ) ? DZCOBS_HASH_VALUE_WHEN_CRC_IS_ZERO : finalHash; // Avoid zero ending CRC.
 
 	// Calc encoded size
-	*aOutSizeEncoded = (size_t)( aCtx->pCurDst - aCtx->pDst );
+	return (size_t)( aCtx->pCurDst - aCtx->pDst );
+}
+
+eDZCOBS_ret dzcobs_encode_inc_end( sDZCOBS_ctx *aCtx, size_t *aOutSizeEncoded )
+{
+	if( ( !aCtx ) || ( !aOutSizeEncoded ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	const bool isFiltered = ( aCtx->filter != 0 );
+	const bool isExtended = isFiltered || ( aCtx->check != DZCOBS_CHECK_HASH8 ) || ( aCtx->fecT != 0 );
+
+	// The placeholder of a last dictionary code is reused by the tail
+	const size_t payloadSize	 = (size_t)( aCtx->pCurDst - aCtx->pDst ) - ( aCtx->isLastCodeDictionary ? 1 : 0 );
+	const size_t availableSize = (size_t)( aCtx->pDstEnd - aCtx->pCurDst ) + ( aCtx->isLastCodeDictionary ? 1 : 0 );
+
+	if( availableSize < dzcobs_encode_tail_size( aCtx, payloadSize ) )
+	{
+		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+	}
+
+	if( aCtx->user6bits == 0 )
+	{
+		return DZCOBS_RET_ERR_INVALID_USER6BITS;
+	}
+
+	dzcobs_encode_close( aCtx );
+
+	// A frame without data did not select its encoding
+	if( aCtx->encoding == DZCOBS_AUTO )
+	{
+		aCtx->encoding = DZCOBS_PLAIN;
+	}
+
+	// Add (tail) header info
+
+	uint8_t wireEncoding = (uint8_t)aCtx->encoding & 0x03;
+
+	if( isExtended )
+	{
+		uint8_t extensionByte = DZCOBS_EXT_MARKER | (uint8_t)( aCtx->check << DZCOBS_EXT_CHECK_SHIFT ) | wireEncoding;
+
+		if( aCtx->fecT != 0 )
+		{
+			extensionByte |= DZCOBS_EXT_FEC;
+		}
+
+		if( isFiltered )
+		{
+			const uint8_t filterDescriptor = aCtx->filter;
+
+			aCtx->hashsum += DZCOBS_HASH8( filterDescriptor );
+			*aCtx->pCurDst++ = filterDescriptor;
+
+			extensionByte |= DZCOBS_EXT_FILTER;
+		}
+
+		wireEncoding = DZCOBS_RESERVED;
+
+		if( aCtx->check != DZCOBS_CHECK_HASH8 )
+		{
+			dzcobs_encode_check( aCtx, extensionByte, (uint8_t)( aCtx->user6bits << 2 ) | wireEncoding );
+		}
+
+		if( aCtx->fecT != 0 )
+		{
+			const size_t protectedSize = (size_t)( aCtx->pCurDst - aCtx->pDst );
+			const size_t paritySize		 = DZCOBS_FEC_PARITY_SIZE( protectedSize, aCtx->fecT );
+
+			dzcobs_fec_encode( aCtx->fecT, aCtx->pDst, protectedSize );
+
+			for( size_t i = 0; i < paritySize; i++ )
+			{
+				aCtx->hashsum += DZCOBS_HASH8( aCtx->pCurDst[i] );
+			}
+
+			aCtx->pCurDst += paritySize;
+
+			const uint8_t fecDescriptor = DZCOBS_FEC_DESC_MARKER | aCtx->fecT;
+
+			aCtx->hashsum += DZCOBS_HASH8( fecDescriptor );
+			*aCtx->pCurDst++ = fecDescriptor;
+		}
+
+		aCtx->hashsum += DZCOBS_HASH8( extensionByte );
+		*aCtx->pCurDst++ = extensionByte;
+	}
+
+	*aOutSizeEncoded = dzcobs_encode_seal( aCtx, wireEncoding );
 
 	aCtx->encFunc = NULL;
 
 	return DZCOBS_RET_SUCCESS;
 }
 
+eDZCOBS_ret dzcobs_encode( eDZCOBS_encoding aEncoding,
+													 const sDICT_ctx *aDict,
+													 uint8_t aUser6bits,
+													 const uint8_t *aSrcBuf,
+													 size_t aSrcBufSize,
+													 uint8_t *aDstBuf,
+													 size_t aDstBufSize,
+													 size_t *aOutSizeEncoded )
+{
+	const bool isPlain			= ( aEncoding == DZCOBS_PLAIN );
+	const bool isDictionary = ( aEncoding == DZCOBS_USING_DICT_1 ) || ( aEncoding == DZCOBS_USING_DICT_2 );
+
+	if( ( !aDstBuf ) || ( !aOutSizeEncoded ) || ( ( !aSrcBuf ) && ( aSrcBufSize != 0 ) ) ||
+			( !( isPlain || ( isDictionary && ( aDict != NULL ) ) ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( ( aUser6bits == 0 ) || ( aUser6bits > 0x3F ) )
+	{
+		return DZCOBS_RET_ERR_INVALID_USER6BITS;
+	}
+
+	// The kernels do not check the destiny, the worst case must fit
+	const size_t maxEncodedSize =
+		isPlain ? DZCOBS_MAX_ENCODED_SIZE_PLAIN( aSrcBufSize ) : DZCOBS_MAX_ENCODED_SIZE_DICT( aSrcBufSize );
+
+	if( aDstBufSize < maxEncodedSize )
+	{
+		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+	}
+
+	// Zeroed, so no field is left undefined: no filter, no check, no FEC
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	ctx.pDst			= aDstBuf;
+	ctx.pCodeDst	= aDstBuf;
+	ctx.pCurDst		= aDstBuf + 1;
+	ctx.pDstEnd		= aDstBuf + aDstBufSize;
+	ctx.code			= 1;
+	ctx.user6bits = aUser6bits;
+	ctx.encoding	= aEncoding;
+
+	if( aSrcBufSize > 0 )
+	{
+		if( isPlain )
+		{
+			dzcobs_encode_inc_plain( &ctx, aSrcBuf, aSrcBufSize );
+		}
+		else
+		{
+			dzcobs_encode_inc_words( &ctx, aDict, aSrcBuf, aSrcBufSize );
+		}
+	}
+
+	dzcobs_encode_close( &ctx );
+
+	*aOutSizeEncoded = dzcobs_encode_seal( &ctx, (uint8_t)aEncoding );
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_encode_checkpoint( const sDZCOBS_ctx *aCtx, sDZCOBS_checkpoint *aOutCheckpoint )
+{
+	if( ( !aCtx ) || ( !aOutCheckpoint ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( aCtx->encFunc == NULL )
+	{
+		return DZCOBS_RET_ERR_NOTINITIALIZED;
+	}
+
+	aOutCheckpoint->pCodeDst						 = aCtx->pCodeDst;
+	aOutCheckpoint->pCurDst							 = aCtx->pCurDst;
+	aOutCheckpoint->code								 = aCtx->code;
+	aOutCheckpoint->hashsum							 = aCtx->hashsum;
+	aOutCheckpoint->isLastCodeDictionary = aCtx->isLastCodeDictionary;
+	aOutCheckpoint->isZeroPending				 = aCtx->isZeroPending;
+	aOutCheckpoint->isFilterSealed			 = aCtx->isFilterSealed;
+	aOutCheckpoint->searchSkip					 = aCtx->searchSkip;
+	aOutCheckpoint->searchMisses				 = aCtx->searchMisses;
+	aOutCheckpoint->encFunc							 = aCtx->encFunc;
+	aOutCheckpoint->encoding						 = aCtx->encoding;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_encode_rollback( sDZCOBS_ctx *aCtx, const sDZCOBS_checkpoint *aCheckpoint )
+{
+	if( ( !aCtx ) || ( !aCheckpoint ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	// Only the data added since the checkpoint can be dropped
+	if( ( aCheckpoint->encFunc == NULL ) || ( aCheckpoint->pCodeDst < aCtx->pDst ) ||
+			( aCheckpoint->pCurDst <= aCheckpoint->pCodeDst ) || ( aCheckpoint->pCurDst > aCtx->pCurDst ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	// The bytes before pCodeDst are never changed by the encoder, the ones after
+	// it are written again
+	aCtx->pCodeDst						 = aCheckpoint->pCodeDst;
+	aCtx->pCurDst							 = aCheckpoint->pCurDst;
+	aCtx->code								 = aCheckpoint->code;
+	aCtx->hashsum							 = aCheckpoint->hashsum;
+	aCtx->isLastCodeDictionary = aCheckpoint->isLastCodeDictionary;
+	aCtx->isZeroPending				 = aCheckpoint->isZeroPending;
+	aCtx->isFilterSealed			 = aCheckpoint->isFilterSealed;
+	aCtx->searchSkip					 = aCheckpoint->searchSkip;
+	aCtx->searchMisses				 = aCheckpoint->searchMisses;
+	aCtx->encFunc							 = aCheckpoint->encFunc;
+	aCtx->encoding						 = aCheckpoint->encoding;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
 eDZCOBS_ret dzcobs_encode_inc( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
 {
 	if( ( !aCtx ) || ( !aSrcBuf ) )
@@ -161,6 +523,82 @@ eDZCOBS_ret dzcobs_encode_inc( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t
 	return aCtx->encFunc( aCtx, aSrcBuf, aSrcBufSize );
 }
 
+eDZCOBS_ret dzcobs_encode_inc_raw( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
+{
+	if( ( !aCtx ) || ( !aSrcBuf ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( aCtx->encFunc == NULL )
+	{
+		return DZCOBS_RET_ERR_NOTINITIALIZED;
+	}
+
+	// The filtered blocks are encoded by dzcobs_encode_inc_filter only
+	if( aCtx->filter != 0 )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( aSrcBufSize == 0 )
+	{
+		return DZCOBS_RET_SUCCESS;
+	}
+
+	if( aCtx->encoding == DZCOBS_AUTO )
+	{
+		aCtx->encoding = dzcobs_encode_auto_select( aCtx, aSrcBuf, aSrcBufSize );
+		aCtx->encFunc	 = ( aCtx->encoding == DZCOBS_PLAIN ) ? dzcobs_encode_inc_plain : dzcobs_encode_inc_dictionary;
+	}
+
+	if( aCtx->encoding == DZCOBS_PLAIN )
+	{
+		return dzcobs_encode_inc_plain( aCtx, aSrcBuf, aSrcBufSize );
+	}
+
+	const eDZCOBS_ret ret = dzcobs_encode_inc_words( aCtx, NULL, aSrcBuf, aSrcBufSize );
+
+	// The misses before the span do not tell about the data after it, that is
+	// searched again from its first byte
+	aCtx->searchSkip	 = 0;
+	aCtx->searchMisses = 0;
+
+	return ret;
+}
+
+eDZCOBS_ret dzcobs_encode_inc_step( sDZCOBS_ctx *aCtx,
+																		const uint8_t **aSrcBuf,
+																		size_t *aSrcBufSize,
+																		size_t aStepSize )
+{
+	if( ( !aCtx ) || ( !aSrcBuf ) || ( !aSrcBufSize ) || ( aStepSize == 0 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	// A filtered frame is added by whole filter blocks
+	if( aCtx->filter != 0 )
+	{
+		aStepSize = ( aStepSize / DZCOBS_FILTER_BLOCK_SIZE ) * DZCOBS_FILTER_BLOCK_SIZE;
+		aStepSize = ( aStepSize == 0 ) ? DZCOBS_FILTER_BLOCK_SIZE : aStepSize;
+	}
+
+	const size_t size = ( *aSrcBufSize < aStepSize ) ? *aSrcBufSize : aStepSize;
+
+	const eDZCOBS_ret ret = dzcobs_encode_inc( aCtx, *aSrcBuf, size );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	*aSrcBuf += size;
+	*aSrcBufSize -= size;
+
+	return ( *aSrcBufSize > 0 ) ? DZCOBS_RET_MORE : DZCOBS_RET_SUCCESS;
+}
+
 eDZCOBS_ret dzcobs_encode_inc_plain( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
 {
 	DZCOBS_ASSERT( aCtx != NULL );
@@ -172,6 +610,16 @@ eDZCOBS_ret dzcobs_encode_inc_plain( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf,
 	uint8_t *pCurDst	= aCtx->pCurDst;
 	uint8_t hashsum		= aCtx->hashsum;
 
+	// A full run left open by the previous call must be closed before adding data
+	if( code == DZCOBS_CODE_JUMP_PLAIN )
+	{
+		hashsum += DZCOBS_HASH8( code );
+
+		*pCodeDst = code;
+		pCodeDst	= pCurDst++;
+		code			= 1;
+	}
+
 	while( aSrcBufSize )
 	{
 		aSrcBufSize--;
@@ -210,25 +658,108 @@ eDZCOBS_ret dzcobs_encode_inc_plain( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf,
 	return DZCOBS_RET_SUCCESS;
 }
 
+/// Positions to encode without searching after a search, see dzcobs_encode_set_acceleration
+static uint8_t dzcobs_encode_search_skip( uint8_t aAcceleration, uint16_t *aSearchMisses, bool aIsHit )
+{
+	if( aIsHit )
+	{
+		*aSearchMisses = 0;
+		return 0;
+	}
+
+	const uint32_t skip = ( (uint32_t)*aSearchMisses * aAcceleration ) >> DZCOBS_ACCELERATION_SHIFT;
+
+	if( skip >= DZCOBS_ACCELERATION_MAX_SKIP )
+	{
+		return DZCOBS_ACCELERATION_MAX_SKIP;
+	}
+
+	// Not counted further once the skip is at its maximum, so it never overflows
+	( *aSearchMisses )++;
+
+	return (uint8_t)skip;
+}
+
 eDZCOBS_ret dzcobs_encode_inc_dictionary( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
+{
+	DZCOBS_ASSERT( aCtx != NULL );
+	DZCOBS_ASSERT( ( aCtx->encoding == DZCOBS_USING_DICT_1 ) || ( aCtx->encoding == DZCOBS_USING_DICT_2 ) );
+
+	return dzcobs_encode_inc_words( aCtx, aCtx->pDict[aCtx->encoding - DZCOBS_USING_DICT_1], aSrcBuf, aSrcBufSize );
+}
+
+/// Dictionary frame kernel, searching the words of aDict, or none if it is NULL
+static eDZCOBS_ret dzcobs_encode_inc_words( sDZCOBS_ctx *aCtx,
+																						const sDICT_ctx *aDict,
+																						const uint8_t *aSrcBuf,
+																						size_t aSrcBufSize )
 {
 	DZCOBS_ASSERT( aCtx != NULL );
 	DZCOBS_ASSERT( aSrcBuf != NULL );
 	DZCOBS_ASSERT( aSrcBufSize > 0 );
-	DZCOBS_ASSERT( ( aCtx->encoding == DZCOBS_USING_DICT_1 ) || ( aCtx->encoding == DZCOBS_USING_DICT_2 ) );
 
-	uint8_t code			= aCtx->code;
-	uint8_t *pCodeDst = aCtx->pCodeDst;
-	uint8_t *pCurDst	= aCtx->pCurDst;
-	uint8_t hashsum		= aCtx->hashsum;
+	uint8_t code					= aCtx->code;
+	uint8_t *pCodeDst			= aCtx->pCodeDst;
+	uint8_t *pCurDst			= aCtx->pCurDst;
+	uint8_t hashsum				= aCtx->hashsum;
+	bool isZeroPending		= aCtx->isZeroPending;
+	uint8_t searchSkip		= aCtx->searchSkip;
+	uint16_t searchMisses = aCtx->searchMisses;
 
-	const sDICT_ctx *pDict = aCtx->pDict[aCtx->encoding - DZCOBS_USING_DICT_1];
+	const uint8_t acceleration = aCtx->acceleration;
+
+#if DZCOBS_STATS == 1
+	sDZCOBS_stats *pStats = ( aDict != NULL ) ? aDict->pStats : NULL;
+#endif
+
+	// A full run left open by the previous call must be closed before adding data
+	if( code == DZCOBS_CODE_JUMP_DICTIONARY )
+	{
+		hashsum += DZCOBS_HASH8( code );
+
+		*pCodeDst = code;
+		pCodeDst	= pCurDst++;
+		code			= 1;
+	}
 
 	while( aSrcBufSize )
 	{
 		size_t sizeOfKeyFound = 0;
+		uint8_t foundIdx			= 0;
 
-		uint8_t foundIdx = dzcobs_dictionary_search( pDict, aSrcBuf, aSrcBufSize, &sizeOfKeyFound );
+		// The decoder drops the 0x00 of a run when a dictionary code follows it, so
+		// after "run, 0x00" the next byte is encoded plain. The positions skipped
+		// by the search backoff are encoded plain too.
+		if( searchSkip > 0 )
+		{
+			searchSkip--;
+		}
+		else if( ( !isZeroPending ) && ( aDict != NULL ) )
+		{
+			foundIdx = dzcobs_dictionary_search( aDict, aSrcBuf, aSrcBufSize, &sizeOfKeyFound );
+
+			if( acceleration != 0 )
+			{
+				searchSkip = dzcobs_encode_search_skip( acceleration, &searchMisses, foundIdx != 0 );
+			}
+
+#if DZCOBS_STATS == 1
+			if( pStats != NULL )
+			{
+				pStats->searches++;
+
+				if( foundIdx )
+				{
+					pStats->hits[foundIdx - 1]++;
+					pStats->bytesSaved[foundIdx - 1] += (uint32_t)( sizeOfKeyFound - 1 );
+				}
+				else
+				{
+					pStats->misses++;
+				}
+			}
+#endif
+		}
 
 		if( foundIdx )
 		{
@@ -268,6 +799,8 @@ eDZCOBS_ret dzcobs_encode_inc_dictionary( sDZCOBS_ctx *aCtx, const uint8_t *aSrc
 
 		if( src_byte == 0 )
 		{
+			isZeroPending = ( code != 1 );
+
 			hashsum += DZCOBS_HASH8( code );
 			*pCodeDst = code;
 			pCodeDst	= pCurDst++;
@@ -275,6 +808,8 @@ eDZCOBS_ret dzcobs_encode_inc_dictionary( sDZCOBS_ctx *aCtx, const uint8_t *aSrc
 		}
 		else
 		{
+			isZeroPending = false;
+
 			hashsum += DZCOBS_HASH8( src_byte );
 			*pCurDst++ = src_byte;
 			code++;
@@ -290,10 +825,398 @@ eDZCOBS_ret dzcobs_encode_inc_dictionary( sDZCOBS_ctx *aCtx, const uint8_t *aSrc
 		}
 	}
 
-	aCtx->code		 = code;
-	aCtx->pCodeDst = pCodeDst;
-	aCtx->pCurDst	 = pCurDst;
-	aCtx->hashsum	 = hashsum;
+	aCtx->code					= code;
+	aCtx->pCodeDst			= pCodeDst;
+	aCtx->pCurDst				= pCurDst;
+	aCtx->hashsum				= hashsum;
+	aCtx->isZeroPending = isZeroPending;
+	aCtx->searchSkip		= searchSkip;
+	aCtx->searchMisses	= searchMisses;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// Encoding with the smallest estimated size of aSrcBuf, see dzcobs_encode_inc_begin
+static eDZCOBS_encoding dzcobs_encode_auto_select( const sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
+{
+	DZCOBS_ASSERT( aSrcBufSize > 0 );
+
+	// Code bytes added to split the long non-zero runs
+	size_t plainSplits = 0;
+	size_t dictSplits	 = 0;
+	size_t runLen			 = 0;
+
+	for( size_t i = 0; i < aSrcBufSize; i++ )
+	{
+		if( aSrcBuf[i] != 0 )
+		{
+			runLen++;
+			continue;
+		}
+
+		plainSplits += runLen / ( DZCOBS_CODE_JUMP_PLAIN - 1 );
+		dictSplits += runLen / ( DZCOBS_CODE_JUMP_DICTIONARY - 1 );
+		runLen = 0;
+	}
+
+	plainSplits += runLen / ( DZCOBS_CODE_JUMP_PLAIN - 1 );
+	dictSplits += runLen / ( DZCOBS_CODE_JUMP_DICTIONARY - 1 );
+
+	// A search every 8 bytes, so small frames are cheap too, up to DZCOBS_AUTO_SAMPLES
+	const size_t nSamples =
+		( aSrcBufSize < ( DZCOBS_AUTO_SAMPLES * 8 ) ) ? ( ( aSrcBufSize + 7 ) / 8 ) : DZCOBS_AUTO_SAMPLES;
+	const size_t step			= aSrcBufSize / nSamples;
+
+	eDZCOBS_encoding bestEncoding = DZCOBS_PLAIN;
+	size_t bestSize								= aSrcBufSize + plainSplits;
+
+	for( uint8_t d = 0; d < DZCOBS_DICT_N; d++ )
+	{
+		const sDICT_ctx *pDict = aCtx->pDict[d];
+
+		if( pDict == NULL )
+		{
+			continue;
+		}
+
+		size_t nHits		 = 0;
+		size_t hitsBytes = 0;
+
+		for( size_t pos = 0; pos < ( nSamples * step ); pos += step )
+		{
+			size_t keySize = 0;
+
+			if( dzcobs_dictionary_search( pDict, &aSrcBuf[pos], aSrcBufSize - pos, &keySize ) != 0 )
+			{
+				nHits++;
+				hitsBytes += keySize;
+			}
+		}
+
+		// A position starts a word with probability p = nHits / nSamples, of mean
+		// size L = hitsBytes / nHits. On the greedy parsing, each token is a word
+		// (p) or a byte (1 - p), so the bytes saved are p * ( L - 1 ) of the
+		// p * L + 1 - p bytes of a token, and the runs are shortened by the
+		// bytes covered by words.
+		const size_t tokenBytes = hitsBytes - nHits + nSamples;
+		const size_t savedBytes = ( aSrcBufSize * ( hitsBytes - nHits ) ) / tokenBytes;
+		const size_t splits			= ( dictSplits * ( nSamples - nHits ) ) / tokenBytes;
+		const size_t dictSize		= aSrcBufSize + splits - savedBytes;
+
+		if( dictSize < bestSize )
+		{
+			bestSize		 = dictSize;
+			bestEncoding = (eDZCOBS_encoding)( DZCOBS_USING_DICT_1 + d );
+		}
+	}
+
+	return bestEncoding;
+}
+
+eDZCOBS_ret dzcobs_encode_inc_auto( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
+{
+	DZCOBS_ASSERT( aCtx != NULL );
+	DZCOBS_ASSERT( aSrcBuf != NULL );
+	DZCOBS_ASSERT( aSrcBufSize > 0 );
+	DZCOBS_ASSERT( aCtx->encoding == DZCOBS_AUTO );
+
+	aCtx->encoding = dzcobs_encode_auto_select( aCtx, aSrcBuf, aSrcBufSize );
+	aCtx->encFunc	 = ( aCtx->encoding == DZCOBS_PLAIN ) ? dzcobs_encode_inc_plain : dzcobs_encode_inc_dictionary;
+
+	return aCtx->encFunc( aCtx, aSrcBuf, aSrcBufSize );
+}
+
+eDZCOBS_ret dzcobs_encode_inc_filter( sDZCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
+{
+	DZCOBS_ASSERT( aCtx != NULL );
+	DZCOBS_ASSERT( aSrcBuf != NULL );
+	DZCOBS_ASSERT( aSrcBufSize > 0 );
+	DZCOBS_ASSERT( aCtx->filter != 0 );
+
+	// Blocks are filtered independently, so a partial block must be the last one
+	if( aCtx->isFilterSealed )
+	{
+		return DZCOBS_RET_ERR_BAD_FILTER_SEQUENCE;
+	}
+
+	uint8_t filteredBlock[DZCOBS_FILTER_BLOCK_SIZE];
+
+	while( aSrcBufSize )
+	{
+		const size_t blockSize = ( aSrcBufSize < DZCOBS_FILTER_BLOCK_SIZE ) ? aSrcBufSize : DZCOBS_FILTER_BLOCK_SIZE;
+
+		if( blockSize != DZCOBS_FILTER_BLOCK_SIZE )
+		{
+			aCtx->isFilterSealed = true;
+		}
+
+		dzcobs_filter_encode( aCtx->filter, aSrcBuf, filteredBlock, blockSize );
+
+		// The encoding is selected by the filtered data
+		if( aCtx->encoding == DZCOBS_AUTO )
+		{
+			aCtx->encoding = dzcobs_encode_auto_select( aCtx, filteredBlock, blockSize );
+		}
+
+		const dzcobs_encode_inc_funcPtr encKernel =
+			( aCtx->encoding == DZCOBS_PLAIN ) ? dzcobs_encode_inc_plain : dzcobs_encode_inc_dictionary;
+
+		const eDZCOBS_ret ret = encKernel( aCtx, filteredBlock, blockSize );
+
+		if( ret != DZCOBS_RET_SUCCESS )
+		{
+			return ret;
+		}
+
+		aSrcBuf += blockSize;
+		aSrcBufSize -= blockSize;
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// Index of the first 0x00 of aBuf, aSize if there is none
+static size_t dzcobs_find_zero( const uint8_t *aBuf, size_t aSize )
+{
+	size_t i = 0;
+
+#if DZCOBS_HAS_SSE2 == 1
+	const __m128i zero = _mm_setzero_si128();
+
+	for( ; ( i + 16 ) <= aSize; i += 16 )
+	{
+		const __m128i bytes = _mm_loadu_si128( (const __m128i *)&aBuf[i] );
+		const int zeroMask	= _mm_movemask_epi8( _mm_cmpeq_epi8( bytes, zero ) );
+
+		if( zeroMask != 0 )
+		{
+			return i + (size_t)__builtin_ctz( (unsigned int)zeroMask );
+		}
+	}
+#endif
+
+	for( ; i < aSize; i++ )
+	{
+		if( aBuf[i] == 0 )
+		{
+			return i;
+		}
+	}
+
+	return aSize;
+}
+
+/// Counts as dzcobs_encode_inc_plain, a whole run at a time
+static void dzcobs_encoded_size_plain( sDZCOBS_sizectx *aSizeCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
+{
+	size_t size = aSizeCtx->size;
+	size_t code = aSizeCtx->code;
+
+	if( code == DZCOBS_CODE_JUMP_PLAIN )
+	{
+		size++;
+		code = 1;
+	}
+
+	size_t i = 0;
+
+	while( i < aSrcBufSize )
+	{
+		const size_t runLen = dzcobs_find_zero( &aSrcBuf[i], aSrcBufSize - i );
+
+		i += runLen;
+		size += runLen;
+		code += runLen;
+
+		// A jump code each time the run fills a code, but the last one is left open
+		// when there is no more data
+		if( code >= DZCOBS_CODE_JUMP_PLAIN )
+		{
+			size_t nJumps = 1 + ( ( code - DZCOBS_CODE_JUMP_PLAIN ) / ( DZCOBS_CODE_JUMP_PLAIN - 1 ) );
+			code -= nJumps * ( DZCOBS_CODE_JUMP_PLAIN - 1 );
+
+			if( ( code == 1 ) && ( i == aSrcBufSize ) )
+			{
+				nJumps--;
+				code = DZCOBS_CODE_JUMP_PLAIN;
+			}
+
+			size += nJumps;
+		}
+
+		if( i < aSrcBufSize )
+		{
+			// The 0x00 closes the run
+			i++;
+			size++;
+			code = 1;
+		}
+	}
+
+	aSizeCtx->size = size;
+	aSizeCtx->code = (uint8_t)code;
+}
+
+/// Counts as dzcobs_encode_inc_dictionary
+static void dzcobs_encoded_size_dictionary( sDZCOBS_sizectx *aSizeCtx,
+																						const sDICT_ctx *aDict,
+																						uint8_t aAcceleration,
+																						const uint8_t *aSrcBuf,
+																						size_t aSrcBufSize )
+{
+	size_t size						= aSizeCtx->size;
+	uint8_t code					= aSizeCtx->code;
+	bool isZeroPending		= aSizeCtx->isZeroPending;
+	uint8_t searchSkip		= aSizeCtx->searchSkip;
+	uint16_t searchMisses = aSizeCtx->searchMisses;
+
+	if( code == DZCOBS_CODE_JUMP_DICTIONARY )
+	{
+		size++;
+		code = 1;
+	}
+
+	while( aSrcBufSize )
+	{
+		size_t sizeOfKeyFound = 0;
+		uint8_t foundIdx			= 0;
+
+		if( searchSkip > 0 )
+		{
+			searchSkip--;
+		}
+		else if( !isZeroPending )
+		{
+			foundIdx = dzcobs_dictionary_search( aDict, aSrcBuf, aSrcBufSize, &sizeOfKeyFound );
+
+			if( aAcceleration != 0 )
+			{
+				searchSkip = dzcobs_encode_search_skip( aAcceleration, &searchMisses, foundIdx != 0 );
+			}
+		}
+
+		if( foundIdx )
+		{
+			if( code != 1 )
+			{
+				size++;
+				code = 1;
+			}
+
+			size++;
+
+			aSrcBufSize -= sizeOfKeyFound;
+			aSrcBuf += sizeOfKeyFound;
+
+			aSizeCtx->isLastCodeDictionary = true;
+			continue;
+		}
+
+		aSizeCtx->isLastCodeDictionary = false;
+
+		aSrcBufSize--;
+		size++;
+
+		if( *aSrcBuf++ == 0 )
+		{
+			isZeroPending = ( code != 1 );
+			code					= 1;
+		}
+		else
+		{
+			isZeroPending = false;
+			code++;
+
+			if( ( code == DZCOBS_CODE_JUMP_DICTIONARY ) && ( aSrcBufSize ) )
+			{
+				size++;
+				code = 1;
+			}
+		}
+	}
+
+	aSizeCtx->size					= size;
+	aSizeCtx->code					= code;
+	aSizeCtx->isZeroPending = isZeroPending;
+	aSizeCtx->searchSkip		= searchSkip;
+	aSizeCtx->searchMisses	= searchMisses;
+}
+
+static void dzcobs_encoded_size_add( const sDZCOBS_ctx *aCtx,
+																		 sDZCOBS_sizectx *aSizeCtx,
+																		 eDZCOBS_encoding *aEncoding,
+																		 const uint8_t *aSrcBuf,
+																		 size_t aSrcBufSize )
+{
+	if( *aEncoding == DZCOBS_AUTO )
+	{
+		*aEncoding = dzcobs_encode_auto_select( aCtx, aSrcBuf, aSrcBufSize );
+	}
+
+	if( *aEncoding == DZCOBS_PLAIN )
+	{
+		dzcobs_encoded_size_plain( aSizeCtx, aSrcBuf, aSrcBufSize );
+	}
+	else
+	{
+		dzcobs_encoded_size_dictionary(
+			aSizeCtx, aCtx->pDict[*aEncoding - DZCOBS_USING_DICT_1], aCtx->acceleration, aSrcBuf, aSrcBufSize );
+	}
+}
+
+eDZCOBS_ret dzcobs_encoded_size( const sDZCOBS_ctx *aCtx,
+																 const uint8_t *aSrcBuf,
+																 size_t aSrcBufSize,
+																 size_t *aOutSizeEncoded )
+{
+	if( ( !aCtx ) || ( ( !aSrcBuf ) && ( aSrcBufSize != 0 ) ) || ( !aOutSizeEncoded ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( aCtx->encFunc == NULL )
+	{
+		return DZCOBS_RET_ERR_NOTINITIALIZED;
+	}
+
+	sDZCOBS_sizectx sizeCtx;
+	sizeCtx.size								 = (size_t)( aCtx->pCurDst - aCtx->pDst );
+	sizeCtx.code								 = aCtx->code;
+	sizeCtx.isLastCodeDictionary = aCtx->isLastCodeDictionary;
+	sizeCtx.isZeroPending				 = aCtx->isZeroPending;
+	sizeCtx.searchSkip					 = aCtx->searchSkip;
+	sizeCtx.searchMisses				 = aCtx->searchMisses;
+
+	eDZCOBS_encoding encoding = aCtx->encoding;
+
+	if( ( aSrcBufSize != 0 ) && ( aCtx->filter != 0 ) )
+	{
+		if( aCtx->isFilterSealed )
+		{
+			return DZCOBS_RET_ERR_BAD_FILTER_SEQUENCE;
+		}
+
+		uint8_t filteredBlock[DZCOBS_FILTER_BLOCK_SIZE];
+
+		while( aSrcBufSize )
+		{
+			const size_t blockSize = ( aSrcBufSize < DZCOBS_FILTER_BLOCK_SIZE ) ? aSrcBufSize : DZCOBS_FILTER_BLOCK_SIZE;
+
+			dzcobs_filter_encode( aCtx->filter, aSrcBuf, filteredBlock, blockSize );
+			dzcobs_encoded_size_add( aCtx, &sizeCtx, &encoding, filteredBlock, blockSize );
+
+			aSrcBuf += blockSize;
+			aSrcBufSize -= blockSize;
+		}
+	}
+	else if( aSrcBufSize != 0 )
+	{
+		dzcobs_encoded_size_add( aCtx, &sizeCtx, &encoding, aSrcBuf, aSrcBufSize );
+	}
+
+	const size_t payloadSize = sizeCtx.size - ( sizeCtx.isLastCodeDictionary ? 1 : 0 );
+
+	*aOutSizeEncoded = payloadSize + dzcobs_encode_tail_size( aCtx, payloadSize );
 
 	return DZCOBS_RET_SUCCESS;
 }
@@ -0,0 +1,183 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_compact.c
+///	@brief Compact encoder context, for many concurrent streams
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_compact.h>
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Full encoder context of a compact one
+static eDZCOBS_ret dzcobs_compact_expand( const sDZCOBS_compactbase *aBase,
+																					const sDZCOBS_compactctx *aCtx,
+																					sDZCOBS_ctx *aOutCtx )
+{
+	if( ( !aBase ) || ( !aCtx ) || ( !aBase->pBuf ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( ( aCtx->flags & DZCOBS_COMPACT_IS_ACTIVE ) == 0 )
+	{
+		return DZCOBS_RET_ERR_NOTINITIALIZED;
+	}
+
+	aOutCtx->pDict[0] = aBase->pDict[0];
+	aOutCtx->pDict[1] = aBase->pDict[1];
+
+	// Begun with the encoding in use, so the kernel is selected as for the first call
+	uint8_t *pDst = aBase->pBuf + aCtx->dstOffset;
+
+	const eDZCOBS_ret ret = dzcobs_encode_inc_begin( aOutCtx, (eDZCOBS_encoding)aCtx->encoding, pDst, aCtx->dstSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	aOutCtx->pCodeDst							= pDst + aCtx->codeOffset;
+	aOutCtx->pCurDst							= pDst + aCtx->curOffset;
+	aOutCtx->code									= aCtx->code;
+	aOutCtx->hashsum							= aCtx->hashsum;
+	aOutCtx->user6bits						= aCtx->user6bits;
+	aOutCtx->isLastCodeDictionary = ( aCtx->flags & DZCOBS_COMPACT_IS_LAST_CODE_DICTIONARY ) != 0;
+	aOutCtx->isZeroPending				= ( aCtx->flags & DZCOBS_COMPACT_IS_ZERO_PENDING ) != 0;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// Keep the state of a full encoder context on the compact one
+static void dzcobs_compact_pack( const sDZCOBS_ctx *aCtx, sDZCOBS_compactctx *aOutCtx )
+{
+	aOutCtx->codeOffset = (uint32_t)( aCtx->pCodeDst - aCtx->pDst );
+	aOutCtx->curOffset	= (uint32_t)( aCtx->pCurDst - aCtx->pDst );
+	aOutCtx->code				= aCtx->code;
+	aOutCtx->hashsum		= aCtx->hashsum;
+	aOutCtx->encoding		= (uint8_t)aCtx->encoding;
+
+	uint8_t flags = DZCOBS_COMPACT_IS_ACTIVE;
+
+	if( aCtx->isLastCodeDictionary )
+	{
+		flags |= DZCOBS_COMPACT_IS_LAST_CODE_DICTIONARY;
+	}
+
+	if( aCtx->isZeroPending )
+	{
+		flags |= DZCOBS_COMPACT_IS_ZERO_PENDING;
+	}
+
+	aOutCtx->flags = flags;
+}
+
+eDZCOBS_ret dzcobs_compact_begin( const sDZCOBS_compactbase *aBase,
+																	sDZCOBS_compactctx *aCtx,
+																	eDZCOBS_encoding aEncoding,
+																	uint32_t aDstOffset,
+																	uint32_t aDstSize )
+{
+	if( ( !aBase ) || ( !aCtx ) || ( !aBase->pBuf ) || ( aDstOffset > aBase->bufSize ) ||
+			( aDstSize > ( aBase->bufSize - aDstOffset ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	// The frame settings are validated by dzcobs_encode_inc_begin
+	sDZCOBS_ctx ctx;
+	ctx.pDict[0] = aBase->pDict[0];
+	ctx.pDict[1] = aBase->pDict[1];
+
+	const eDZCOBS_ret ret = dzcobs_encode_inc_begin( &ctx, aEncoding, aBase->pBuf + aDstOffset, aDstSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	aCtx->dstOffset = aDstOffset;
+	aCtx->dstSize		= aDstSize;
+
+	dzcobs_compact_pack( &ctx, aCtx );
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_compact_inc( const sDZCOBS_compactbase *aBase,
+																sDZCOBS_compactctx *aCtx,
+																const uint8_t *aSrcBuf,
+																size_t aSrcBufSize )
+{
+	if( !aSrcBuf )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	sDZCOBS_ctx ctx;
+
+	eDZCOBS_ret ret = dzcobs_compact_expand( aBase, aCtx, &ctx );
+
+	if( ( ret != DZCOBS_RET_SUCCESS ) || ( aSrcBufSize == 0 ) )
+	{
+		return ret;
+	}
+
+	// Each byte adds at most a byte, a jump code every full run and the code
+	// of a run left open by the previous call. The tail is kept free, so the
+	// frame can always be ended.
+	const size_t jumpCode = ( aCtx->encoding == DZCOBS_PLAIN ) ? DZCOBS_CODE_JUMP_PLAIN : DZCOBS_CODE_JUMP_DICTIONARY;
+	const size_t overhead = ( aSrcBufSize / ( jumpCode - 1 ) ) + 1 + DZCOBS_FRAME_HEADER_SIZE;
+	const size_t available = aCtx->dstSize - aCtx->curOffset;
+
+	if( ( aSrcBufSize > available ) || ( overhead > ( available - aSrcBufSize ) ) )
+	{
+		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+	}
+
+	ret = dzcobs_encode_inc( &ctx, aSrcBuf, aSrcBufSize );
+
+	if( ret == DZCOBS_RET_SUCCESS )
+	{
+		dzcobs_compact_pack( &ctx, aCtx );
+	}
+
+	return ret;
+}
+
+eDZCOBS_ret dzcobs_compact_end( const sDZCOBS_compactbase *aBase, sDZCOBS_compactctx *aCtx, size_t *aOutSizeEncoded )
+{
+	sDZCOBS_ctx ctx;
+
+	eDZCOBS_ret ret = dzcobs_compact_expand( aBase, aCtx, &ctx );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	ret = dzcobs_encode_inc_end( &ctx, aOutSizeEncoded );
+
+	// Kept active if it fails, as a sDZCOBS_ctx is
+	if( ret == DZCOBS_RET_SUCCESS )
+	{
+		aCtx->flags = 0;
+	}
+
+	return ret;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -17,25 +17,36 @@
 // /////////////////////////////////////////////////////////////////////////////
 #include <dzcobs/dzcobs_decode.h>
 #include <stdbool.h>
+#include <string.h>
 #include "dzcobs/dzcobs.h"
-
-// Definitions
-// /////////////////////////////////////////////////////////////////////////////
+#include "dzcobs/dzcobs_crc.h"
+#include "dzcobs/dzcobs_fec.h"
+#include "dzcobs/dzcobs_filter.h"
+#include "dzcobs/dzcobs_stats.h"
+#include "dzcobs/dzcobs_view.h"
+#include "dzcobs_assert.h"
 
 // Implementation
 // /////////////////////////////////////////////////////////////////////////////
-static eDZCOBS_ret dzcobs_decode_plain( const sDZCOBS_decodectx *aDecodeCtx, size_t *aOutDecodedLen )
+/**
+ * @brief Decode a plain payload, from aPos up to the first code at or after
+ * aReadStop, the payload length to decode it all
+ */
+static eDZCOBS_ret dzcobs_decode_plain( const sDZCOBS_decodectx *aDecodeCtx,
+																				size_t aPayloadLen,
+																				size_t aReadStop,
+																				sDZCOBS_decodepos *aPos )
 {
 	// Assume input parameters and conditions are validated
 
-	const uint8_t *pReadEncoded		 = aDecodeCtx->srcBufEncoded;
-	const uint8_t *pReadEncodedEnd = aDecodeCtx->srcBufEncoded + aDecodeCtx->srcBufEncodedLen -
-																	 2; // remove userbits and hash8
+	const uint8_t *pReadEncoded			= aDecodeCtx->srcBufEncoded + aPos->readIdx;
+	const uint8_t *pReadEncodedEnd	= aDecodeCtx->srcBufEncoded + aPayloadLen;
+	const uint8_t *pReadEncodedStop = aDecodeCtx->srcBufEncoded + aReadStop;
 
-	uint8_t *pDecoded					 = aDecodeCtx->dstBufDecoded;
+	uint8_t *pDecoded					 = aDecodeCtx->dstBufDecoded + aPos->decodedLen;
 	const uint8_t *pDecodedEnd = aDecodeCtx->dstBufDecoded + aDecodeCtx->dstBufDecodedSize;
 
-	while( pReadEncoded < pReadEncodedEnd )
+	while( pReadEncoded < pReadEncodedStop )
 	{
 		uint8_t code = *pReadEncoded++;
 
@@ -79,32 +90,41 @@ static eDZCOBS_ret dzcobs_decode_plain( const sDZCOBS_decodectx *aDecodeCtx, siz
 
 		if( code != ( DZCOBS_CODE_JUMP_PLAIN - 1 ) )
 		{
+			if( pDecoded == pDecodedEnd )
+			{
+				return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+			}
+
 			*pDecoded++ = 0;
 		}
 	}
 
-	*aOutDecodedLen = (size_t)( pDecoded - aDecodeCtx->dstBufDecoded );
+	aPos->readIdx		 = (size_t)( pReadEncoded - aDecodeCtx->srcBufEncoded );
+	aPos->decodedLen = (size_t)( pDecoded - aDecodeCtx->dstBufDecoded );
 
 	return DZCOBS_RET_SUCCESS;
 }
 
+/// As dzcobs_decode_plain, for a dictionary payload
 static eDZCOBS_ret dzcobs_decode_dictionary( const sDZCOBS_decodectx *aDecodeCtx,
-																						 size_t *aOutDecodedLen,
+																						 size_t aPayloadLen,
+																						 size_t aReadStop,
+																						 sDZCOBS_decodepos *aPos,
 																						 const sDICT_ctx *aDict )
 {
 	// Assume input parameters and conditions are validated
 
-	const uint8_t *pReadEncoded		 = aDecodeCtx->srcBufEncoded;
-	const uint8_t *pReadEncodedEnd = aDecodeCtx->srcBufEncoded + aDecodeCtx->srcBufEncodedLen -
-																	 2; // remove userbits and hash8
+	const uint8_t *pReadEncoded			= aDecodeCtx->srcBufEncoded + aPos->readIdx;
+	const uint8_t *pReadEncodedEnd	= aDecodeCtx->srcBufEncoded + aPayloadLen;
+	const uint8_t *pReadEncodedStop = aDecodeCtx->srcBufEncoded + aReadStop;
 
-	uint8_t *pDecoded					 = aDecodeCtx->dstBufDecoded;
+	uint8_t *pDecoded					 = aDecodeCtx->dstBufDecoded + aPos->decodedLen;
 	const uint8_t *pDecodedEnd = aDecodeCtx->dstBufDecoded + aDecodeCtx->dstBufDecodedSize;
 
 	bool isPreviousCodeDictionary = false;
-	bool isToPlaceZero						= false;
+	bool isToPlaceZero						= aPos->isToPlaceZero;
 
-	while( pReadEncoded < pReadEncodedEnd )
+	while( pReadEncoded < pReadEncodedStop )
 	{
 		uint8_t code = *pReadEncoded++;
 
@@ -140,6 +160,14 @@ static eDZCOBS_ret dzcobs_decode_dictionary( const sDZCOBS_decodectx *aDecodeCtx
 				return DZCOBS_RET_ERR_WRITE_OVERFLOW;
 			}
 
+#if DZCOBS_STATS == 1
+			if( aDict->pStats != NULL )
+			{
+				aDict->pStats->hits[dictIdx]++;
+				aDict->pStats->bytesSaved[dictIdx] += (uint32_t)( wordSize - 1 );
+			}
+#endif
+
 			while( wordSize-- )
 			{
 				*pDecoded++ = *dictionary_word++;
@@ -157,6 +185,11 @@ static eDZCOBS_ret dzcobs_decode_dictionary( const sDZCOBS_decodectx *aDecodeCtx
 		{
 			isToPlaceZero = false;
 
+			if( remain_output_size == 0 )
+			{
+				return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+			}
+
 			*pDecoded++ = 0;
 			remain_output_size--;
 		}
@@ -196,6 +229,11 @@ static eDZCOBS_ret dzcobs_decode_dictionary( const sDZCOBS_decodectx *aDecodeCtx
 
 		if( code == 0 )
 		{
+			if( pDecoded == pDecodedEnd )
+			{
+				return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+			}
+
 			*pDecoded++		= 0;
 			isToPlaceZero = false;
 		}
@@ -208,84 +246,1138 @@ static eDZCOBS_ret dzcobs_decode_dictionary( const sDZCOBS_decodectx *aDecodeCtx
 		}
 	}
 
-	*aOutDecodedLen = (size_t)( pDecoded - aDecodeCtx->dstBufDecoded );
+	aPos->readIdx				= (size_t)( pReadEncoded - aDecodeCtx->srcBufEncoded );
+	aPos->decodedLen		= (size_t)( pDecoded - aDecodeCtx->dstBufDecoded );
+	aPos->isToPlaceZero = isToPlaceZero;
 
 	return DZCOBS_RET_SUCCESS;
 }
 
-eDZCOBS_ret dzcobs_decode( const sDZCOBS_decodectx *aDecodeCtx,
-													 size_t *aOutDecodedLen,
-													 uint8_t *aOutUser6bitDataRightAlgn )
+/**
+ * @brief Parse a tail-coded payload backwards, from its last token.
+ *
+ * @param aDecodedEnd End of the decoded data, written backwards, or NULL to only
+ * validate the payload and get its decoded length
+ */
+static eDZCOBS_ret dzcobs_decode_tail_pass( const uint8_t *aEncoded,
+																						size_t aPayloadLen,
+																						const sDICT_ctx *aDict,
+																						uint8_t *aDecodedEnd,
+																						size_t *aOutDecodedLen )
 {
-	if( ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aDecodeCtx->dstBufDecoded ) || ( !aOutDecodedLen ) ||
-			( aDecodeCtx->dstBufDecodedSize == 0 ) || ( aDecodeCtx->srcBufEncodedLen < 3 ) )
+	const uint8_t jumpCode = ( aDict == NULL ) ? DZCOBS_CODE_JUMP_PLAIN : DZCOBS_CODE_JUMP_DICTIONARY;
+
+	size_t readIdx		= aPayloadLen;
+	size_t decodedLen = 0;
+
+	bool isLastToken			= true;
+	bool isNextDictionary = false;
+
+	while( readIdx > 0 )
 	{
-		return DZCOBS_RET_ERR_BAD_ARG;
+		const uint8_t code = aEncoded[--readIdx];
+
+		if( code == 0 )
+		{
+			return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
+
+		if( ( aDict != NULL ) && ( code >= DZCOBS_DICTIONARY_BITMASK ) )
+		{
+			uint8_t wordSize = 0;
+
+			const uint8_t *dictionary_word = dzcobs_dictionary_get( aDict, code & ~DZCOBS_DICTIONARY_BITMASK, &wordSize );
+
+			if( dictionary_word == NULL )
+			{
+				return DZCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY;
+			}
+
+			decodedLen += wordSize;
+
+			if( aDecodedEnd )
+			{
+#if DZCOBS_STATS == 1
+				// Counted on the decoding pass only, the first one just validates
+				if( aDict->pStats != NULL )
+				{
+					aDict->pStats->hits[code & ~DZCOBS_DICTIONARY_BITMASK]++;
+					aDict->pStats->bytesSaved[code & ~DZCOBS_DICTIONARY_BITMASK] += (uint32_t)( wordSize - 1 );
+				}
+#endif
+
+				uint8_t *pDecoded = aDecodedEnd - decodedLen;
+
+				while( wordSize-- )
+				{
+					*pDecoded++ = *dictionary_word++;
+				}
+			}
+
+			isLastToken			 = false;
+			isNextDictionary = true;
+			continue;
+		}
+
+		const size_t runLen = (size_t)code - 1;
+
+		if( runLen > readIdx )
+		{
+			return DZCOBS_RET_ERR_READ_OVERFLOW;
+		}
+
+		// The 0x00 that closed the run, it is after the run data
+		if( ( !isLastToken ) && ( !isNextDictionary ) && ( code != jumpCode ) )
+		{
+			decodedLen++;
+
+			if( aDecodedEnd )
+			{
+				*( aDecodedEnd - decodedLen ) = 0;
+			}
+		}
+
+		readIdx -= runLen;
+		decodedLen += runLen;
+
+		const uint8_t *pRun = aEncoded + readIdx;
+
+		if( aDecodedEnd )
+		{
+			uint8_t *pDecoded = aDecodedEnd - decodedLen;
+
+			for( size_t i = runLen; i != 0; i-- )
+			{
+				*pDecoded++ = *pRun++;
+			}
+		}
+		else
+		{
+			for( size_t i = runLen; i != 0; i-- )
+			{
+				if( *pRun++ == 0 )
+				{
+					return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+				}
+			}
+		}
+
+		isLastToken			 = false;
+		isNextDictionary = false;
+	}
+
+	*aOutDecodedLen = decodedLen;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+static eDZCOBS_ret dzcobs_decode_tail( const sDZCOBS_decodectx *aDecodeCtx,
+																			 size_t aPayloadLen,
+																			 size_t *aOutDecodedLen,
+																			 const sDICT_ctx *aDict )
+{
+	// Assume input parameters and conditions are validated
+
+	// The first pass gets the decoded length, so the second one knows where the
+	// decoded data ends
+	size_t decodedLen = 0;
+
+	eDZCOBS_ret ret = dzcobs_decode_tail_pass( aDecodeCtx->srcBufEncoded, aPayloadLen, aDict, NULL, &decodedLen );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	if( decodedLen > aDecodeCtx->dstBufDecodedSize )
+	{
+		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+	}
+
+	ret = dzcobs_decode_tail_pass( aDecodeCtx->srcBufEncoded,
+																 aPayloadLen,
+																 aDict,
+																 aDecodeCtx->dstBufDecoded + decodedLen,
+																 aOutDecodedLen );
+
+	DZCOBS_ASSERT( ( ret != DZCOBS_RET_SUCCESS ) || ( *aOutDecodedLen == decodedLen ) );
+
+	return ret;
+}
+
+/// Headroom raised so that aDecodedEnd, the end of a write, does not pass the
+/// aReadIdx payload bytes already read
+static size_t dzcobs_decode_headroom_need( size_t aHeadroom, size_t aDecodedEnd, size_t aReadIdx )
+{
+	return ( aDecodedEnd > ( aReadIdx + aHeadroom ) ) ? ( aDecodedEnd - aReadIdx ) : aHeadroom;
+}
+
+/**
+ * @brief Get the decoded length of a payload by its codes, without reading the
+ * runs data. A twin of dzcobs_decode_plain and dzcobs_decode_dictionary.
+ *
+ * @param aDict Dictionary of the payload, NULL if it is plain
+ * @param aOutHeadroom Offset the payload must have after the decoded data to be
+ * decoded in place, the most the decoded data goes ahead of the payload read
+ */
+static eDZCOBS_ret dzcobs_decode_scan( const uint8_t *aEncoded,
+																			 size_t aPayloadLen,
+																			 const sDICT_ctx *aDict,
+																			 size_t *aOutDecodedLen,
+																			 size_t *aOutHeadroom )
+{
+	const uint8_t jumpCode = ( aDict == NULL ) ? DZCOBS_CODE_JUMP_PLAIN : DZCOBS_CODE_JUMP_DICTIONARY;
+
+	size_t readIdx		= 0;
+	size_t decodedLen = 0;
+	size_t headroom		= 0;
+
+	bool isToPlaceZero = false;
+
+	while( readIdx < aPayloadLen )
+	{
+		const uint8_t code = aEncoded[readIdx++];
+
+		if( code == 0 )
+		{
+			return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
+
+		if( ( aDict != NULL ) && ( code >= DZCOBS_DICTIONARY_BITMASK ) )
+		{
+			uint8_t wordSize = 0;
+
+			if( dzcobs_dictionary_get( aDict, code & ~DZCOBS_DICTIONARY_BITMASK, &wordSize ) == NULL )
+			{
+				return DZCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY;
+			}
+
+			// A dictionary code drops the 0x00 of the run before it
+			isToPlaceZero = false;
+			decodedLen += wordSize;
+
+			headroom = dzcobs_decode_headroom_need( headroom, decodedLen, readIdx );
+			continue;
+		}
+
+		if( isToPlaceZero )
+		{
+			decodedLen++;
+
+			// The plain decoder places it before reading this code
+			headroom = dzcobs_decode_headroom_need( headroom, decodedLen, readIdx - ( ( aDict == NULL ) ? 1 : 0 ) );
+		}
+
+		const size_t runLen = (size_t)code - 1;
+
+		if( runLen > ( aPayloadLen - readIdx ) )
+		{
+			return DZCOBS_RET_ERR_READ_OVERFLOW;
+		}
+
+		// Each run byte is read before it is written
+		headroom = dzcobs_decode_headroom_need( headroom, decodedLen, readIdx );
+
+		readIdx += runLen;
+		decodedLen += runLen;
+
+		// The 0x00 that closed the run is placed when the next code is known, but
+		// the one of an empty run is kept before a dictionary code
+		isToPlaceZero = ( code != jumpCode );
+
+		if( ( aDict != NULL ) && ( code == 1 ) && ( readIdx < aPayloadLen ) )
+		{
+			decodedLen++;
+			isToPlaceZero = false;
+
+			headroom = dzcobs_decode_headroom_need( headroom, decodedLen, readIdx );
+		}
+	}
+
+	*aOutDecodedLen = decodedLen;
+
+	if( aOutHeadroom )
+	{
+		*aOutHeadroom = headroom;
 	}
 
-	const uint8_t *pReadEncoded = aDecodeCtx->srcBufEncoded + aDecodeCtx->srcBufEncodedLen - 1;
+	return DZCOBS_RET_SUCCESS;
+}
+
+static eDZCOBS_ret dzcobs_decode_frameinfo( const sDZCOBS_decodectx *aDecodeCtx, sDZCOBS_frameinfo *aOutInfo )
+{
+	// Assume input parameters are validated and the frame has at least 3 bytes
+
+	const uint8_t *pReadEncoded = aDecodeCtx->srcBufEncoded + aDecodeCtx->srcBufEncodedLen - 2; // skip hash8
+	size_t tailSize							= DZCOBS_FRAME_HEADER_SIZE;
 
-	const uint8_t receivedChecksum8		 = *pReadEncoded--;
 	const uint8_t receivedUserEncoding = *pReadEncoded--;
 
-	if( ( receivedChecksum8 == 0 ) || ( receivedUserEncoding == 0 ) )
+	aOutInfo->encoding = (eDZCOBS_encoding)( receivedUserEncoding & 0x03 );
+	aOutInfo->filter	 = 0;
+	aOutInfo->check		 = DZCOBS_CHECK_HASH8;
+	aOutInfo->pCheck	 = NULL;
+
+	aOutInfo->isTailCoded = false;
+
+	if( aOutInfo->encoding == DZCOBS_RESERVED )
 	{
-		return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		tailSize += DZCOBS_FRAME_EXTENSION_SIZE;
+
+		if( aDecodeCtx->srcBufEncodedLen < ( tailSize + 1 ) )
+		{
+			return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
+
+		const uint8_t extensionByte = *pReadEncoded--;
+
+		if( ( extensionByte & DZCOBS_EXT_MARKER ) == 0 )
+		{
+			return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
+
+		aOutInfo->isTailCoded = ( extensionByte & DZCOBS_EXT_TAIL_CODED ) != 0;
+
+		aOutInfo->encoding = (eDZCOBS_encoding)( extensionByte & DZCOBS_EXT_ENCODING_MASK );
+
+		aOutInfo->check = (eDZCOBS_check)( ( extensionByte & DZCOBS_EXT_CHECK_MASK ) >> DZCOBS_EXT_CHECK_SHIFT );
+
+		if( ( aOutInfo->encoding == DZCOBS_RESERVED ) ||
+				( ( aOutInfo->check != DZCOBS_CHECK_HASH8 ) && ( aOutInfo->check != DZCOBS_CHECK_CRC16 ) &&
+					( aOutInfo->check != DZCOBS_CHECK_CRC32C ) ) )
+		{
+			return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
+
+		if( extensionByte & DZCOBS_EXT_FEC )
+		{
+			tailSize += DZCOBS_FRAME_FEC_SIZE;
+
+			if( aDecodeCtx->srcBufEncodedLen < ( tailSize + 1 ) )
+			{
+				return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+			}
+
+			const uint8_t fecDescriptor = *pReadEncoded--;
+
+			if( ( ( fecDescriptor & DZCOBS_FEC_DESC_MARKER ) == 0 ) ||
+					( ( fecDescriptor & DZCOBS_FEC_DESC_RESERVED_MASK ) != 0 ) )
+			{
+				return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+			}
+
+			// Skip the parity, it was already used by dzcobs_fec_repair
+			const size_t protectedLen = aDecodeCtx->srcBufEncodedLen - tailSize;
+			const size_t dataLen			= dzcobs_fec_data_size( protectedLen, fecDescriptor & DZCOBS_FEC_DESC_T_MASK );
+
+			if( dataLen == 0 )
+			{
+				return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+			}
+
+			tailSize += protectedLen - dataLen;
+			pReadEncoded -= protectedLen - dataLen;
+		}
+
+		const size_t checkSize = DZCOBS_FRAME_CHECK_SIZE( aOutInfo->check );
+
+		tailSize += checkSize;
+
+		if( aDecodeCtx->srcBufEncodedLen < ( tailSize + 1 ) )
+		{
+			return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
+
+		pReadEncoded -= checkSize;
+		aOutInfo->pCheck = pReadEncoded + 1;
+
+		if( extensionByte & DZCOBS_EXT_FILTER )
+		{
+			tailSize += DZCOBS_FRAME_FILTER_SIZE;
+
+			if( aDecodeCtx->srcBufEncodedLen < ( tailSize + 1 ) )
+			{
+				return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+			}
+
+			aOutInfo->filter = *pReadEncoded--;
+
+			if( !dzcobs_filter_descriptor_isvalid( aOutInfo->filter ) )
+			{
+				return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+			}
+		}
 	}
 
-	uint8_t checksum8 = 0;
+	aOutInfo->payloadLen = aDecodeCtx->srcBufEncodedLen - tailSize;
 
-	const uint8_t *pData		= aDecodeCtx->srcBufEncoded;
-	const uint8_t *pDataEnd = aDecodeCtx->srcBufEncoded + aDecodeCtx->srcBufEncodedLen - 1; // -1 removed CRC
+	return DZCOBS_RET_SUCCESS;
+}
 
-	while( pData < pDataEnd )
+/// Add aSize bytes to a partial CRC check
+static uint32_t dzcobs_decode_check_update( eDZCOBS_check aCheck, uint32_t aCrc, const uint8_t *aData, size_t aSize )
+{
+	if( aCheck == DZCOBS_CHECK_CRC16 )
 	{
-		const uint8_t value = *pData++;
-		checksum8 += DZCOBS_HASH8( value );
+		return dzcobs_crc16( (uint16_t)aCrc, aData, aSize );
 	}
 
-	if( ( ( checksum8 != 0 ) && ( checksum8 != receivedChecksum8 ) ) ||
-			( ( checksum8 == 0 ) && ( receivedChecksum8 != DZCOBS_HASH_VALUE_WHEN_CRC_IS_ZERO ) ) )
+	return dzcobs_crc32c( aCrc, aData, aSize );
+}
+
+/// Compare the CRC check of a frame, given the partial check of all the frame up to it
+static eDZCOBS_ret dzcobs_decode_check_end( const sDZCOBS_decodectx *aDecodeCtx,
+																						const sDZCOBS_frameinfo *aInfo,
+																						uint32_t aCrc )
+{
+	// The check covers the frame up to it, followed by the extension and encoding bytes
+	const uint8_t *pTail = aDecodeCtx->srcBufEncoded + aDecodeCtx->srcBufEncodedLen - 3;
+
+	const uint32_t crc = dzcobs_decode_check_update( aInfo->check, aCrc, pTail, 2 );
+
+	// Stuffing is one to one, so the stuffed check is compared as received
+	uint8_t check[DZCOBS_FRAME_CRC32C_SIZE];
+	dzcobs_crc_stuff( crc, ( aInfo->check == DZCOBS_CHECK_CRC16 ) ? DZCOBS_CRC16_SIZE : DZCOBS_CRC32C_SIZE, check );
+
+	if( memcmp( aInfo->pCheck, check, DZCOBS_FRAME_CHECK_SIZE( aInfo->check ) ) != 0 )
 	{
 		return DZCOBS_RET_ERR_CRC;
 	}
 
-	// Get and validate encoding type
-	const eDZCOBS_encoding encoding = (eDZCOBS_encoding)( receivedUserEncoding & 0x03 );
+	return DZCOBS_RET_SUCCESS;
+}
 
-	eDZCOBS_ret ret = DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+static eDZCOBS_ret dzcobs_decode_check( const sDZCOBS_decodectx *aDecodeCtx, const sDZCOBS_frameinfo *aInfo )
+{
+	const size_t frameSize = (size_t)( aInfo->pCheck - aDecodeCtx->srcBufEncoded );
 
-	switch( encoding )
-	{
-	case DZCOBS_PLAIN:
-		ret = dzcobs_decode_plain( aDecodeCtx, aOutDecodedLen );
-		break;
-	// [[fallthrough]]
-	case DZCOBS_USING_DICT_1:
-	case DZCOBS_USING_DICT_2:
+	return dzcobs_decode_check_end(
+		aDecodeCtx, aInfo, dzcobs_decode_check_update( aInfo->check, 0, aDecodeCtx->srcBufEncoded, frameSize ) );
+}
+
+/**
+ * @brief Scan the payload codes of a parsed frame
+ *
+ * @param aOutHeadroom Headroom to decode in place, NULL if not needed. Tail-coded
+ * frames are decoded backwards, so they can not be decoded in place.
+ */
+static eDZCOBS_ret dzcobs_decode_prescan( const sDZCOBS_decodectx *aDecodeCtx,
+																					const sDZCOBS_frameinfo *aInfo,
+																					size_t *aOutDecodedLen,
+																					size_t *aOutHeadroom )
+{
+	const sDICT_ctx *pDict = NULL;
+
+	if( aInfo->encoding != DZCOBS_PLAIN )
 	{
-		const sDICT_ctx *pDict = aDecodeCtx->pDict[encoding - DZCOBS_USING_DICT_1];
+		pDict = aDecodeCtx->pDict[aInfo->encoding - DZCOBS_USING_DICT_1];
 
 		if( pDict == NULL )
 		{
 			return DZCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE;
 		}
+	}
+
+	if( aInfo->isTailCoded )
+	{
+		if( aOutHeadroom )
+		{
+			return DZCOBS_RET_ERR_BAD_ARG;
+		}
 
-		ret = dzcobs_decode_dictionary( aDecodeCtx, aOutDecodedLen, pDict );
+		return dzcobs_decode_tail_pass( aDecodeCtx->srcBufEncoded, aInfo->payloadLen, pDict, NULL, aOutDecodedLen );
 	}
-	break;
 
-	case DZCOBS_RESERVED:
-	default:
-		break;
+	return dzcobs_decode_scan( aDecodeCtx->srcBufEncoded, aInfo->payloadLen, pDict, aOutDecodedLen, aOutHeadroom );
+}
+
+eDZCOBS_ret dzcobs_decoded_size( const sDZCOBS_decodectx *aDecodeCtx, size_t *aOutDecodedLen )
+{
+	if( ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aOutDecodedLen ) ||
+			( aDecodeCtx->srcBufEncodedLen < 3 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
 	}
 
-	if( ret == DZCOBS_RET_SUCCESS )
+	sDZCOBS_frameinfo frameInfo;
+
+	const eDZCOBS_ret ret = dzcobs_decode_frameinfo( aDecodeCtx, &frameInfo );
+
+	if( ret != DZCOBS_RET_SUCCESS )
 	{
-		*aOutUser6bitDataRightAlgn = ( receivedUserEncoding >> 2 ) & 0x3F;
+		return ret;
 	}
 
-	return ret;
+	return dzcobs_decode_prescan( aDecodeCtx, &frameInfo, aOutDecodedLen, NULL );
+}
+
+eDZCOBS_ret dzcobs_decode_headroom( const sDZCOBS_decodectx *aDecodeCtx, size_t *aOutHeadroom )
+{
+	if( ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aOutHeadroom ) ||
+			( aDecodeCtx->srcBufEncodedLen < 3 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	sDZCOBS_frameinfo frameInfo;
+
+	const eDZCOBS_ret ret = dzcobs_decode_frameinfo( aDecodeCtx, &frameInfo );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	size_t decodedLen = 0;
+
+	return dzcobs_decode_prescan( aDecodeCtx, &frameInfo, &decodedLen, aOutHeadroom );
+}
+
+/// Add the hash of aSize bytes to a partial frame hash
+static uint8_t dzcobs_decode_hash8( uint8_t aChecksum8, const uint8_t *aData, size_t aSize )
+{
+	const uint8_t *pDataEnd = aData + aSize;
+
+	while( aData < pDataEnd )
+	{
+		const uint8_t value = *aData++;
+		aChecksum8 += DZCOBS_HASH8( value );
+	}
+
+	return aChecksum8;
+}
+
+/// Compare the hash of a frame, given the hash of all its bytes but the last
+static eDZCOBS_ret dzcobs_decode_hash_compare( const uint8_t *aEncoded, size_t aEncodedLen, uint8_t aChecksum8 )
+{
+	// Assume input parameters are validated and the frame has at least 3 bytes
+
+	const uint8_t receivedChecksum8		 = aEncoded[aEncodedLen - 1];
+	const uint8_t receivedUserEncoding = aEncoded[aEncodedLen - 2];
+
+	if( ( receivedChecksum8 == 0 ) || ( receivedUserEncoding == 0 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	if( ( ( aChecksum8 != 0 ) && ( aChecksum8 != receivedChecksum8 ) ) ||
+			( ( aChecksum8 == 0 ) && ( receivedChecksum8 != DZCOBS_HASH_VALUE_WHEN_CRC_IS_ZERO ) ) )
+	{
+		return DZCOBS_RET_ERR_CRC;
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// Compare the hash of a frame, given the hash of all its bytes but the last,
+/// and parse its tail
+static eDZCOBS_ret dzcobs_decode_hash_end( const sDZCOBS_decodectx *aDecodeCtx,
+																					 uint8_t aChecksum8,
+																					 sDZCOBS_frameinfo *aOutInfo )
+{
+	const eDZCOBS_ret ret =
+		dzcobs_decode_hash_compare( aDecodeCtx->srcBufEncoded, aDecodeCtx->srcBufEncodedLen, aChecksum8 );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	// Get and validate encoding type
+	return dzcobs_decode_frameinfo( aDecodeCtx, aOutInfo );
+}
+
+/// Verify the hash and the check of a frame, and parse its tail
+static eDZCOBS_ret dzcobs_decode_validate( const sDZCOBS_decodectx *aDecodeCtx, sDZCOBS_frameinfo *aOutInfo )
+{
+	// Assume input parameters are validated and the frame has at least 3 bytes
+
+	const uint8_t checksum8 =
+		dzcobs_decode_hash8( 0, aDecodeCtx->srcBufEncoded, aDecodeCtx->srcBufEncodedLen - 1 ); // -1 removed CRC
+
+	const eDZCOBS_ret ret = dzcobs_decode_hash_end( aDecodeCtx, checksum8, aOutInfo );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	if( aOutInfo->check != DZCOBS_CHECK_HASH8 )
+	{
+		return dzcobs_decode_check( aDecodeCtx, aOutInfo );
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// Get the view of a validated frame, not tail-coded
+static eDZCOBS_ret dzcobs_decode_open( const sDZCOBS_decodectx *aDecodeCtx,
+																			 const sDZCOBS_frameinfo *aInfo,
+																			 sDZCOBS_view *aOutView )
+{
+	DZCOBS_ASSERT( !aInfo->isTailCoded );
+
+	// Codes and runs are never 0x00
+	if( memchr( aDecodeCtx->srcBufEncoded, 0, aInfo->payloadLen ) != NULL )
+	{
+		return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	size_t decodedLen = 0;
+
+	const eDZCOBS_ret ret = dzcobs_decode_prescan( aDecodeCtx, aInfo, &decodedLen, NULL );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	aOutView->pPayload	 = aDecodeCtx->srcBufEncoded;
+	aOutView->payloadLen = aInfo->payloadLen;
+	aOutView->decodedLen = decodedLen;
+	aOutView->pDict =
+		( aInfo->encoding == DZCOBS_PLAIN ) ? NULL : aDecodeCtx->pDict[aInfo->encoding - DZCOBS_USING_DICT_1];
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_decode_view( const sDZCOBS_decodectx *aDecodeCtx,
+																sDZCOBS_view *aOutView,
+																uint8_t *aOutUser6bitDataRightAlgn )
+{
+	if( ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aOutView ) || ( !aOutUser6bitDataRightAlgn ) ||
+			( aDecodeCtx->srcBufEncodedLen < 3 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	sDZCOBS_frameinfo frameInfo;
+
+	eDZCOBS_ret ret = dzcobs_decode_validate( aDecodeCtx, &frameInfo );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	// The view reads the runs as they are, forward and not filtered
+	if( ( frameInfo.isTailCoded ) || ( frameInfo.filter != 0 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	ret = dzcobs_decode_open( aDecodeCtx, &frameInfo, aOutView );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	*aOutUser6bitDataRightAlgn = ( aDecodeCtx->srcBufEncoded[aDecodeCtx->srcBufEncodedLen - 2] >> 2 ) & 0x3F;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// Give a filtered frame to a sink, by filter blocks
+static eDZCOBS_ret dzcobs_decode_sink_filtered( sDZCOBS_viewreader *aReader,
+																								uint8_t aFilter,
+																								dzcobs_decode_sink_funcPtr aSinkFunc,
+																								void *aArg )
+{
+	uint8_t filtered[DZCOBS_FILTER_BLOCK_SIZE];
+	uint8_t block[DZCOBS_FILTER_BLOCK_SIZE];
+
+	while( dzcobs_view_remaining( aReader ) > 0 )
+	{
+		const size_t remaining = dzcobs_view_remaining( aReader );
+		const size_t blockSize = ( remaining < DZCOBS_FILTER_BLOCK_SIZE ) ? remaining : DZCOBS_FILTER_BLOCK_SIZE;
+
+		eDZCOBS_ret ret = dzcobs_view_read( aReader, filtered, blockSize );
+
+		if( ret != DZCOBS_RET_SUCCESS )
+		{
+			return ret;
+		}
+
+		dzcobs_filter_decode( aFilter, filtered, block, blockSize );
+
+		ret = aSinkFunc( aArg, DZCOBS_RUN_LITERAL, block, blockSize );
+
+		if( ret != DZCOBS_RET_SUCCESS )
+		{
+			return ret;
+		}
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_decode_sink( const sDZCOBS_decodectx *aDecodeCtx,
+																dzcobs_decode_sink_funcPtr aSinkFunc,
+																void *aArg,
+																size_t *aOutDecodedLen,
+																uint8_t *aOutUser6bitDataRightAlgn )
+{
+	if( ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aSinkFunc ) || ( !aOutDecodedLen ) ||
+			( !aOutUser6bitDataRightAlgn ) || ( aDecodeCtx->srcBufEncodedLen < 3 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	sDZCOBS_frameinfo frameInfo;
+
+	eDZCOBS_ret ret = dzcobs_decode_validate( aDecodeCtx, &frameInfo );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	if( frameInfo.isTailCoded )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	// The whole payload is checked before the sink gets any data
+	sDZCOBS_view view;
+	sDZCOBS_viewreader reader;
+
+	ret = dzcobs_decode_open( aDecodeCtx, &frameInfo, &view );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	ret = dzcobs_view_reader_init( &reader, &view );
+
+	DZCOBS_ASSERT( ret == DZCOBS_RET_SUCCESS );
+
+	if( frameInfo.filter != 0 )
+	{
+		ret = dzcobs_decode_sink_filtered( &reader, frameInfo.filter, aSinkFunc, aArg );
+	}
+	else
+	{
+		static const uint8_t s_zero = 0;
+
+		sDZCOBS_segment segment;
+
+		while( ( ret == DZCOBS_RET_SUCCESS ) && dzcobs_view_next_segment( &reader, &segment ) )
+		{
+			if( segment.size > 0 )
+			{
+				ret = aSinkFunc( aArg, segment.isWord ? DZCOBS_RUN_WORD : DZCOBS_RUN_LITERAL, segment.pData, segment.size );
+			}
+
+			if( ( ret == DZCOBS_RET_SUCCESS ) && segment.isZeroAfter )
+			{
+				ret = aSinkFunc( aArg, DZCOBS_RUN_ZERO, &s_zero, 1 );
+			}
+		}
+	}
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	*aOutDecodedLen						 = view.decodedLen;
+	*aOutUser6bitDataRightAlgn = ( aDecodeCtx->srcBufEncoded[aDecodeCtx->srcBufEncodedLen - 2] >> 2 ) & 0x3F;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// The decoded data and the frame overlap on the same buffer
+static bool dzcobs_decode_isinplace( const sDZCOBS_decodectx *aDecodeCtx )
+{
+	const uintptr_t srcBegin = (uintptr_t)aDecodeCtx->srcBufEncoded;
+	const uintptr_t dstBegin = (uintptr_t)aDecodeCtx->dstBufDecoded;
+
+	return ( dstBegin < ( srcBegin + aDecodeCtx->srcBufEncodedLen ) ) &&
+				 ( srcBegin < ( dstBegin + aDecodeCtx->dstBufDecodedSize ) );
+}
+
+eDZCOBS_ret dzcobs_decode( const sDZCOBS_decodectx *aDecodeCtx,
+													 size_t *aOutDecodedLen,
+													 uint8_t *aOutUser6bitDataRightAlgn )
+{
+	if( ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aDecodeCtx->dstBufDecoded ) || ( !aOutDecodedLen ) ||
+			( aDecodeCtx->dstBufDecodedSize == 0 ) || ( aDecodeCtx->srcBufEncodedLen < 3 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	sDZCOBS_frameinfo frameInfo;
+
+	eDZCOBS_ret ret = dzcobs_decode_validate( aDecodeCtx, &frameInfo );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	const uint8_t receivedUserEncoding = aDecodeCtx->srcBufEncoded[aDecodeCtx->srcBufEncodedLen - 2];
+
+	// Decoding in place, the decoded data must never pass the payload not read yet
+	const uintptr_t srcBegin = (uintptr_t)aDecodeCtx->srcBufEncoded;
+	const uintptr_t dstBegin = (uintptr_t)aDecodeCtx->dstBufDecoded;
+
+	if( dzcobs_decode_isinplace( aDecodeCtx ) )
+	{
+		if( dstBegin > srcBegin )
+		{
+			return DZCOBS_RET_ERR_BAD_ARG;
+		}
+
+		// A plain payload is never shorter than its decoded data, so it needs no headroom
+		if( ( frameInfo.encoding != DZCOBS_PLAIN ) || ( frameInfo.isTailCoded ) )
+		{
+			size_t decodedLen = 0;
+			size_t headroom		= 0;
+
+			ret = dzcobs_decode_prescan( aDecodeCtx, &frameInfo, &decodedLen, &headroom );
+
+			if( ret != DZCOBS_RET_SUCCESS )
+			{
+				return ret;
+			}
+
+			if( ( srcBegin - dstBegin ) < headroom )
+			{
+				return DZCOBS_RET_ERR_BAD_ARG;
+			}
+		}
+	}
+
+	const eDZCOBS_encoding encoding = frameInfo.encoding;
+
+	sDZCOBS_decodepos pos = { 0, 0, false };
+
+	ret = DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+
+	switch( encoding )
+	{
+	case DZCOBS_PLAIN:
+		if( frameInfo.isTailCoded )
+		{
+			ret = dzcobs_decode_tail( aDecodeCtx, frameInfo.payloadLen, aOutDecodedLen, NULL );
+		}
+		else
+		{
+			ret							= dzcobs_decode_plain( aDecodeCtx, frameInfo.payloadLen, frameInfo.payloadLen, &pos );
+			*aOutDecodedLen = pos.decodedLen;
+		}
+		break;
+	// [[fallthrough]]
+	case DZCOBS_USING_DICT_1:
+	case DZCOBS_USING_DICT_2:
+	{
+		const sDICT_ctx *pDict = aDecodeCtx->pDict[encoding - DZCOBS_USING_DICT_1];
+
+		if( pDict == NULL )
+		{
+			return DZCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE;
+		}
+
+		if( frameInfo.isTailCoded )
+		{
+			ret = dzcobs_decode_tail( aDecodeCtx, frameInfo.payloadLen, aOutDecodedLen, pDict );
+		}
+		else
+		{
+			ret							= dzcobs_decode_dictionary( aDecodeCtx, frameInfo.payloadLen, frameInfo.payloadLen, &pos, pDict );
+			*aOutDecodedLen = pos.decodedLen;
+		}
+	}
+	break;
+
+	case DZCOBS_RESERVED:
+	default:
+		break;
+	}
+
+	if( ret == DZCOBS_RET_SUCCESS )
+	{
+		if( frameInfo.filter != 0 )
+		{
+			dzcobs_filter_decode_inplace( frameInfo.filter, aDecodeCtx->dstBufDecoded, *aOutDecodedLen );
+		}
+
+		*aOutUser6bitDataRightAlgn = ( receivedUserEncoding >> 2 ) & 0x3F;
+	}
+
+	return ret;
+}
+
+eDZCOBS_ret dzcobs_decode_buf( eDZCOBS_encoding aEncoding,
+															 const sDICT_ctx *aDict,
+															 const uint8_t *aSrcBuf,
+															 size_t aSrcBufLen,
+															 uint8_t *aDstBuf,
+															 size_t aDstBufSize,
+															 size_t *aOutDecodedLen,
+															 uint8_t *aOutUser6bits )
+{
+	const bool isPlain			= ( aEncoding == DZCOBS_PLAIN );
+	const bool isDictionary = ( aEncoding == DZCOBS_USING_DICT_1 ) || ( aEncoding == DZCOBS_USING_DICT_2 );
+
+	if( ( !aSrcBuf ) || ( !aDstBuf ) || ( !aOutDecodedLen ) || ( !aOutUser6bits ) || ( aDstBufSize == 0 ) ||
+			( aSrcBufLen < 3 ) || ( !( isPlain || ( isDictionary && ( aDict != NULL ) ) ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	sDZCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= aSrcBuf;
+	decodeCtx.srcBufEncodedLen	= aSrcBufLen;
+	decodeCtx.dstBufDecoded			= aDstBuf;
+	decodeCtx.dstBufDecodedSize = aDstBufSize;
+	decodeCtx.pDict[0]					= aDict;
+	decodeCtx.pDict[1]					= aDict;
+
+	if( dzcobs_decode_isinplace( &decodeCtx ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	// An extended frame has DZCOBS_RESERVED, never equal to aEncoding
+	const uint8_t receivedUserEncoding = aSrcBuf[aSrcBufLen - 2];
+
+	if( ( receivedUserEncoding & 0x03 ) != (uint8_t)aEncoding )
+	{
+		return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	const uint8_t checksum8 = dzcobs_decode_hash8( 0, aSrcBuf, aSrcBufLen - 1 ); // -1 removed CRC
+
+	eDZCOBS_ret ret = dzcobs_decode_hash_compare( aSrcBuf, aSrcBufLen, checksum8 );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	const size_t payloadLen = aSrcBufLen - DZCOBS_FRAME_HEADER_SIZE;
+
+	sDZCOBS_decodepos pos = { 0, 0, false };
+
+	ret = isPlain ? dzcobs_decode_plain( &decodeCtx, payloadLen, payloadLen, &pos )
+								: dzcobs_decode_dictionary( &decodeCtx, payloadLen, payloadLen, &pos, aDict );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	*aOutDecodedLen = pos.decodedLen;
+	*aOutUser6bits	= ( receivedUserEncoding >> 2 ) & 0x3F;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_decode_step_begin( sDZCOBS_decodestep *aStep,
+																			const sDZCOBS_decodectx *aDecodeCtx,
+																			size_t aStepSize )
+{
+	if( ( !aStep ) || ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aDecodeCtx->dstBufDecoded ) ||
+			( aDecodeCtx->dstBufDecodedSize == 0 ) || ( aDecodeCtx->srcBufEncodedLen < 3 ) || ( aStepSize == 0 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	aStep->decodeCtx = *aDecodeCtx;
+	aStep->stepSize	 = aStepSize;
+	aStep->phase		 = DZCOBS_DECODE_PHASE_HASH;
+	aStep->idx			 = 0;
+	aStep->crc			 = 0;
+
+	aStep->pos.readIdx			 = 0;
+	aStep->pos.decodedLen		 = 0;
+	aStep->pos.isToPlaceZero = false;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// Bytes to process on this step, of the aSize bytes of the current phase
+static size_t dzcobs_decode_step_size( const sDZCOBS_decodestep *aStep, size_t aSize )
+{
+	const size_t remaining = aSize - aStep->idx;
+
+	return ( remaining < aStep->stepSize ) ? remaining : aStep->stepSize;
+}
+
+/// Hash a part of the frame, and once it is all hashed parse its tail
+static eDZCOBS_ret dzcobs_decode_step_hash( sDZCOBS_decodestep *aStep )
+{
+	const sDZCOBS_decodectx *pDecodeCtx = &aStep->decodeCtx;
+
+	const size_t hashedSize = pDecodeCtx->srcBufEncodedLen - 1; // -1 removed CRC
+	const size_t size				= dzcobs_decode_step_size( aStep, hashedSize );
+
+	aStep->crc = dzcobs_decode_hash8( (uint8_t)aStep->crc, &pDecodeCtx->srcBufEncoded[aStep->idx], size );
+	aStep->idx += size;
+
+	if( aStep->idx < hashedSize )
+	{
+		return DZCOBS_RET_SUCCESS;
+	}
+
+	const eDZCOBS_ret ret = dzcobs_decode_hash_end( pDecodeCtx, (uint8_t)aStep->crc, &aStep->info );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	// Both need the whole payload before the first decoded byte is written
+	if( ( aStep->info.isTailCoded ) ||
+			( dzcobs_decode_isinplace( pDecodeCtx ) &&
+				( ( aStep->info.encoding != DZCOBS_PLAIN ) ||
+					( (uintptr_t)pDecodeCtx->dstBufDecoded > (uintptr_t)pDecodeCtx->srcBufEncoded ) ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( ( aStep->info.encoding != DZCOBS_PLAIN ) &&
+			( pDecodeCtx->pDict[aStep->info.encoding - DZCOBS_USING_DICT_1] == NULL ) )
+	{
+		return DZCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE;
+	}
+
+	aStep->phase =
+		( aStep->info.check != DZCOBS_CHECK_HASH8 ) ? DZCOBS_DECODE_PHASE_CHECK : DZCOBS_DECODE_PHASE_PAYLOAD;
+	aStep->idx = 0;
+	aStep->crc = 0;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// Add a part of the frame to its CRC check, and once it is all added compare it
+static eDZCOBS_ret dzcobs_decode_step_check( sDZCOBS_decodestep *aStep )
+{
+	const sDZCOBS_decodectx *pDecodeCtx = &aStep->decodeCtx;
+
+	const size_t frameSize = (size_t)( aStep->info.pCheck - pDecodeCtx->srcBufEncoded );
+	const size_t size			 = dzcobs_decode_step_size( aStep, frameSize );
+
+	aStep->crc =
+		dzcobs_decode_check_update( aStep->info.check, aStep->crc, &pDecodeCtx->srcBufEncoded[aStep->idx], size );
+	aStep->idx += size;
+
+	if( aStep->idx < frameSize )
+	{
+		return DZCOBS_RET_SUCCESS;
+	}
+
+	const eDZCOBS_ret ret = dzcobs_decode_check_end( pDecodeCtx, &aStep->info, aStep->crc );
+
+	if( ret == DZCOBS_RET_SUCCESS )
+	{
+		aStep->phase = DZCOBS_DECODE_PHASE_PAYLOAD;
+	}
+
+	return ret;
+}
+
+/// Decode a part of the payload with the dzcobs_decode kernels
+static eDZCOBS_ret dzcobs_decode_step_payload( sDZCOBS_decodestep *aStep )
+{
+	const sDZCOBS_decodectx *pDecodeCtx = &aStep->decodeCtx;
+
+	const size_t payloadLen = aStep->info.payloadLen;
+	const size_t remaining	= payloadLen - aStep->pos.readIdx;
+	const size_t readStop		= aStep->pos.readIdx + ( ( remaining < aStep->stepSize ) ? remaining : aStep->stepSize );
+
+	eDZCOBS_ret ret;
+
+	if( aStep->info.encoding == DZCOBS_PLAIN )
+	{
+		ret = dzcobs_decode_plain( pDecodeCtx, payloadLen, readStop, &aStep->pos );
+	}
+	else
+	{
+		const sDICT_ctx *pDict = pDecodeCtx->pDict[aStep->info.encoding - DZCOBS_USING_DICT_1];
+
+		ret = dzcobs_decode_dictionary( pDecodeCtx, payloadLen, readStop, &aStep->pos, pDict );
+	}
+
+	if( ( ret == DZCOBS_RET_SUCCESS ) && ( aStep->pos.readIdx >= payloadLen ) )
+	{
+		aStep->phase = ( aStep->info.filter != 0 ) ? DZCOBS_DECODE_PHASE_FILTER : DZCOBS_DECODE_PHASE_DONE;
+		aStep->idx	 = 0;
+	}
+
+	return ret;
+}
+
+/// Revert the filter of a part of the decoded data, by whole filter blocks
+static void dzcobs_decode_step_filter( sDZCOBS_decodestep *aStep )
+{
+	const size_t decodedLen = aStep->pos.decodedLen;
+
+	size_t size = ( aStep->stepSize / DZCOBS_FILTER_BLOCK_SIZE ) * DZCOBS_FILTER_BLOCK_SIZE;
+
+	size = ( size == 0 ) ? DZCOBS_FILTER_BLOCK_SIZE : size;
+	size = ( size < ( decodedLen - aStep->idx ) ) ? size : ( decodedLen - aStep->idx );
+
+	dzcobs_filter_decode_inplace( aStep->info.filter, &aStep->decodeCtx.dstBufDecoded[aStep->idx], size );
+	aStep->idx += size;
+
+	if( aStep->idx >= decodedLen )
+	{
+		aStep->phase = DZCOBS_DECODE_PHASE_DONE;
+	}
+}
+
+eDZCOBS_ret dzcobs_decode_step( sDZCOBS_decodestep *aStep, size_t *aOutDecodedLen, uint8_t *aOutUser6bitDataRightAlgn )
+{
+	if( ( !aStep ) || ( !aOutDecodedLen ) || ( !aOutUser6bitDataRightAlgn ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	eDZCOBS_ret ret = DZCOBS_RET_SUCCESS;
+
+	switch( aStep->phase )
+	{
+	case DZCOBS_DECODE_PHASE_HASH:
+		ret = dzcobs_decode_step_hash( aStep );
+		break;
+
+	case DZCOBS_DECODE_PHASE_CHECK:
+		ret = dzcobs_decode_step_check( aStep );
+		break;
+
+	case DZCOBS_DECODE_PHASE_PAYLOAD:
+		ret = dzcobs_decode_step_payload( aStep );
+		break;
+
+	case DZCOBS_DECODE_PHASE_FILTER:
+		dzcobs_decode_step_filter( aStep );
+		break;
+
+	case DZCOBS_DECODE_PHASE_DONE:
+	default:
+		break;
+	}
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	if( aStep->phase != DZCOBS_DECODE_PHASE_DONE )
+	{
+		return DZCOBS_RET_MORE;
+	}
+
+	const sDZCOBS_decodectx *pDecodeCtx = &aStep->decodeCtx;
+
+	*aOutDecodedLen						 = aStep->pos.decodedLen;
+	*aOutUser6bitDataRightAlgn = ( pDecodeCtx->srcBufEncoded[pDecodeCtx->srcBufEncodedLen - 2] >> 2 ) & 0x3F;
+
+	return DZCOBS_RET_SUCCESS;
 }
 
 // EOF
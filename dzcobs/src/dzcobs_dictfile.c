@@ -0,0 +1,655 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_dictfile.c
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_crc.h>
+#include <dzcobs/dzcobs_dictfile.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dzcobs_assert.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+typedef struct s_DZCOBS_dictfile_layout
+{
+	size_t dictionaryOffset;
+	size_t packedOffset;
+	size_t packedSize;
+	size_t automatonOffset;
+	size_t automatonSize;
+	size_t imageSize;
+} sDZCOBS_dictfile_layout;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+/// CRC-32C of the whole image, with the checksum field as 0
+static uint32_t dzcobs_dictfile_checksum( const uint8_t *aImage, size_t aImageSize )
+{
+	sDZCOBS_dictfile_header header;
+	memcpy( &header, aImage, sizeof( header ) );
+
+	header.checksum = 0;
+
+	const uint32_t crc = dzcobs_crc32c( 0, (const uint8_t *)&header, sizeof( header ) );
+
+	return dzcobs_crc32c( crc, aImage + sizeof( header ), aImageSize - sizeof( header ) );
+}
+
+static size_t dzcobs_dictfile_align( size_t aSize )
+{
+	return ( aSize + ( DZCOBS_DICTFILE_ALIGNMENT - 1 ) ) & ~(size_t)( DZCOBS_DICTFILE_ALIGNMENT - 1 );
+}
+
+/// Bytes of each packed key of a word size, as dzcobs_dictionary_packed_init stores them
+static size_t dzcobs_dictfile_packed_keysize( uint8_t aStrideSize )
+{
+	return ( aStrideSize <= 3 ) ? sizeof( uint16_t ) : ( ( aStrideSize <= 5 ) ? sizeof( uint32_t ) : sizeof( uint64_t ) );
+}
+
+static void dzcobs_dictfile_get_layout( const sDICT_ctx *aCtx,
+																				size_t aDictionarySize,
+																				uint8_t aIndexes,
+																				sDZCOBS_dictfile_layout *aOutLayout )
+{
+	aOutLayout->dictionaryOffset = dzcobs_dictfile_align( sizeof( sDZCOBS_dictfile_header ) );
+	aOutLayout->packedOffset		 = dzcobs_dictfile_align( aOutLayout->dictionaryOffset + aDictionarySize );
+	aOutLayout->packedSize = ( aIndexes & DZCOBS_DICTFILE_PACKED ) ? dzcobs_dictionary_packed_size( aCtx ) : 0;
+	aOutLayout->automatonOffset = dzcobs_dictfile_align( aOutLayout->packedOffset + aOutLayout->packedSize );
+	aOutLayout->automatonSize = ( aIndexes & DZCOBS_DICTFILE_AUTOMATON ) ? dzcobs_dictionary_automaton_size( aCtx ) : 0;
+	aOutLayout->imageSize			= dzcobs_dictfile_align( aOutLayout->automatonOffset + aOutLayout->automatonSize );
+}
+
+size_t dzcobs_dictfile_size( const char *aDictionary, size_t aDictionarySize, uint8_t aIndexes )
+{
+	sDICT_ctx dictCtx;
+
+	if( dzcobs_dictionary_init( &dictCtx, aDictionary, aDictionarySize ) != DICT_RET_SUCCESS )
+	{
+		return 0;
+	}
+
+	sDZCOBS_dictfile_layout layout;
+	dzcobs_dictfile_get_layout( &dictCtx, aDictionarySize, aIndexes, &layout );
+
+	return layout.imageSize;
+}
+
+eDICT_ret dzcobs_dictfile_write( const char *aDictionary,
+																 size_t aDictionarySize,
+																 uint8_t aIndexes,
+																 void *aOutImage,
+																 size_t aOutImageSize,
+																 size_t *aOutImageLen )
+{
+	if( ( !aDictionary ) || ( !aOutImage ) || ( !aOutImageLen ) ||
+			( ( (uintptr_t)aOutImage % DZCOBS_DICTFILE_ALIGNMENT ) != 0 ) ||
+			( ( aIndexes & ~( DZCOBS_DICTFILE_PACKED | DZCOBS_DICTFILE_AUTOMATON ) ) != 0 ) )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	sDICT_ctx dictCtx;
+
+	if( dzcobs_dictionary_init( &dictCtx, aDictionary, aDictionarySize ) != DICT_RET_SUCCESS )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	sDZCOBS_dictfile_layout layout;
+	dzcobs_dictfile_get_layout( &dictCtx, aDictionarySize, aIndexes, &layout );
+
+	if( ( aOutImageSize < layout.imageSize ) || ( layout.imageSize > UINT32_MAX ) )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	uint8_t *pImage = (uint8_t *)aOutImage;
+
+	// Padding and the unused fields are 0, so the image of a dictionary is always the same
+	memset( pImage, 0, layout.imageSize );
+	memcpy( pImage + layout.dictionaryOffset, aDictionary, aDictionarySize );
+
+	// Build the indexes on the image copy, so they point to it
+	const eDICT_ret ret =
+		dzcobs_dictionary_init( &dictCtx, (const char *)( pImage + layout.dictionaryOffset ), aDictionarySize );
+	DZCOBS_ASSERT( ret == DICT_RET_SUCCESS );
+	(void)ret;
+
+	if( ( aIndexes & DZCOBS_DICTFILE_PACKED ) &&
+			( dzcobs_dictionary_packed_init( &dictCtx, pImage + layout.packedOffset, layout.packedSize ) !=
+				DICT_RET_SUCCESS ) )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	if( ( aIndexes & DZCOBS_DICTFILE_AUTOMATON ) &&
+			( dzcobs_dictionary_automaton_init( &dictCtx, pImage + layout.automatonOffset, layout.automatonSize ) !=
+				DICT_RET_SUCCESS ) )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	sDZCOBS_dictfile_header header;
+	memset( &header, 0, sizeof( header ) );
+
+	memcpy( header.magic, DZCOBS_DICTFILE_MAGIC, sizeof( header.magic ) );
+	header.byteOrder				= DZCOBS_DICTFILE_BYTE_ORDER;
+	header.version					= DZCOBS_DICTFILE_VERSION;
+	header.indexes					= aIndexes;
+	header.imageSize				= (uint32_t)layout.imageSize;
+	header.dictionaryOffset = (uint32_t)layout.dictionaryOffset;
+	header.dictionarySize		= (uint32_t)aDictionarySize;
+	header.packedOffset			= ( aIndexes & DZCOBS_DICTFILE_PACKED ) ? (uint32_t)layout.packedOffset : 0;
+	header.packedSize				= (uint32_t)layout.packedSize;
+	header.automatonOffset	= ( aIndexes & DZCOBS_DICTFILE_AUTOMATON ) ? (uint32_t)layout.automatonOffset : 0;
+	header.automatonSize		= (uint32_t)layout.automatonSize;
+	header.nClasses					= dictCtx.nClasses;
+	header.minWordSize			= dictCtx.minWordSize;
+	header.maxWordSize			= dictCtx.maxWordSize;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *pWordEntry = &dictCtx.wordSizeTable[i];
+		sDZCOBS_dictfile_group *pGroup		= &header.groups[i];
+
+		if( pWordEntry->nEntries == 0 )
+		{
+			continue;
+		}
+
+		pGroup->wordsOffset = (uint32_t)( pWordEntry->dictionaryBegin - pImage );
+		pGroup->nEntries		= pWordEntry->nEntries;
+		pGroup->globalIndex = pWordEntry->globalIndex;
+		pGroup->strideSize	= pWordEntry->strideSize;
+
+		if( pWordEntry->pPackedKeys != NULL )
+		{
+			pGroup->packedKeysOffset	= (uint32_t)( (const uint8_t *)pWordEntry->pPackedKeys - pImage );
+			pGroup->packedIndexOffset = (uint32_t)( pWordEntry->pPackedIndex - pImage );
+		}
+	}
+
+	memcpy( pImage, &header, sizeof( header ) );
+
+	header.checksum = dzcobs_dictfile_checksum( pImage, layout.imageSize );
+
+	memcpy( pImage, &header, sizeof( header ) );
+
+	*aOutImageLen = layout.imageSize;
+
+	return DICT_RET_SUCCESS;
+}
+
+/// True if [aOffset, aOffset + aSize) is inside [aBegin, aBegin + aRangeSize)
+static bool dzcobs_dictfile_is_inside( size_t aOffset, size_t aSize, size_t aBegin, size_t aRangeSize )
+{
+	return ( aOffset >= aBegin ) && ( aSize <= aRangeSize ) && ( ( aOffset - aBegin ) <= ( aRangeSize - aSize ) );
+}
+
+/// Checks the word size groups and the packed keys, so a search never reads out of the image
+static bool dzcobs_dictfile_check_groups( const sDZCOBS_dictfile_header *aHeader, const uint8_t *aImage )
+{
+	size_t nextGlobalIndex = 1;
+	uint8_t prevStrideSize = 0;
+	size_t nextWordsOffset = aHeader->dictionaryOffset;
+	bool isEnded					 = false;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDZCOBS_dictfile_group *pGroup = &aHeader->groups[i];
+
+		if( pGroup->nEntries == 0 )
+		{
+			isEnded = true;
+			continue;
+		}
+
+		// Groups follow each other on the dictionary string, word sizes ascending
+		if( isEnded || ( pGroup->wordsOffset != nextWordsOffset ) || ( pGroup->globalIndex != nextGlobalIndex ) ||
+				( pGroup->strideSize <= prevStrideSize ) || ( pGroup->strideSize < 3 ) || ( pGroup->strideSize > 6 ) )
+		{
+			return false;
+		}
+
+		const size_t n = pGroup->nEntries;
+
+		nextWordsOffset += n * pGroup->strideSize;
+		nextGlobalIndex += n;
+		prevStrideSize = pGroup->strideSize;
+
+		if( ( nextGlobalIndex > 127 ) ||
+				( !dzcobs_dictfile_is_inside(
+					pGroup->wordsOffset, n * pGroup->strideSize, aHeader->dictionaryOffset, aHeader->dictionarySize - 1 ) ) )
+		{
+			return false;
+		}
+
+		// Every word of the group has the size of the group
+		const uint8_t *pWords = aImage + pGroup->wordsOffset;
+
+		for( size_t k = 0; k < n; k++ )
+		{
+			if( pWords[k * pGroup->strideSize] != (uint8_t)( '0' + pGroup->strideSize - 1 ) )
+			{
+				return false;
+			}
+		}
+
+		if( aHeader->indexes & DZCOBS_DICTFILE_PACKED )
+		{
+			const size_t keysSize		 = ( n + 1 ) * dzcobs_dictfile_packed_keysize( pGroup->strideSize );
+			const size_t packedOffset = aHeader->packedOffset;
+			const size_t packedSize	 = aHeader->packedSize;
+
+			if( ( ( pGroup->packedKeysOffset % DZCOBS_DICTFILE_ALIGNMENT ) != 0 ) ||
+					( !dzcobs_dictfile_is_inside( pGroup->packedKeysOffset, keysSize, packedOffset, packedSize ) ) ||
+					( !dzcobs_dictfile_is_inside( pGroup->packedIndexOffset, n + 1, packedOffset, packedSize ) ) )
+			{
+				return false;
+			}
+
+			const uint8_t *pIndex = aImage + pGroup->packedIndexOffset;
+
+			// Index 0 is the not found exit
+			if( pIndex[0] != 0 )
+			{
+				return false;
+			}
+
+			for( size_t k = 1; k <= n; k++ )
+			{
+				if( ( pIndex[k] < pGroup->globalIndex ) || ( pIndex[k] >= ( pGroup->globalIndex + n ) ) )
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	// All the words, and the null terminator
+	return ( nextGlobalIndex > 1 ) &&
+				 ( nextWordsOffset == ( aHeader->dictionaryOffset + aHeader->dictionarySize - 1 ) ) &&
+				 ( aHeader->minWordSize == ( aHeader->groups[0].strideSize - 1 ) ) &&
+				 ( aHeader->maxWordSize == ( prevStrideSize - 1 ) );
+}
+
+/// Checks that every automaton transition is a state or a word
+static bool dzcobs_dictfile_check_automaton( const sDZCOBS_dictfile_header *aHeader, const uint8_t *aImage )
+{
+	const size_t nClasses = aHeader->nClasses;
+
+	if( ( nClasses == 0 ) || ( ( aHeader->automatonOffset % DZCOBS_DICTFILE_ALIGNMENT ) != 0 ) ||
+			( aHeader->automatonSize < DICT_AUTOMATON_BYTECLASS_SIZE ) ||
+			( ( ( aHeader->automatonSize - DICT_AUTOMATON_BYTECLASS_SIZE ) % ( nClasses * sizeof( uint16_t ) ) ) != 0 ) )
+	{
+		return false;
+	}
+
+	const uint8_t *pByteClass = aImage + aHeader->automatonOffset;
+
+	for( size_t i = 0; i < DICT_AUTOMATON_BYTECLASS_SIZE; i++ )
+	{
+		if( pByteClass[i] >= nClasses )
+		{
+			return false;
+		}
+	}
+
+	const uint16_t *pTransitions = (const uint16_t *)( pByteClass + DICT_AUTOMATON_BYTECLASS_SIZE );
+	const size_t nTransitions		 = ( aHeader->automatonSize - DICT_AUTOMATON_BYTECLASS_SIZE ) / sizeof( uint16_t );
+	const size_t nStates				 = nTransitions / nClasses;
+
+	size_t nWords = 0;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		nWords += aHeader->groups[i].nEntries;
+	}
+
+	for( size_t i = 0; i < nTransitions; i++ )
+	{
+		const uint16_t transition = pTransitions[i];
+		const size_t value				= transition & ~DICT_AUTOMATON_MATCH;
+
+		if( ( transition & DICT_AUTOMATON_MATCH ) ? ( ( value == 0 ) || ( value > nWords ) ) : ( value >= nStates ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// Big endian, so the integer order is the memcmp order, as the packed keys
+static uint64_t dzcobs_dictfile_word_key( const uint8_t *aWord, size_t aWordSize )
+{
+	uint64_t key = 0;
+
+	for( size_t i = 0; i < aWordSize; i++ )
+	{
+		key = ( key << 8 ) | aWord[i];
+	}
+
+	return key;
+}
+
+static uint64_t dzcobs_dictfile_packed_key( const sDICT_wordentry *aWordEntry, uint32_t aTreeIdx )
+{
+	switch( dzcobs_dictfile_packed_keysize( aWordEntry->strideSize ) )
+	{
+	case sizeof( uint16_t ):
+		return ( (const uint16_t *)aWordEntry->pPackedKeys )[aTreeIdx];
+
+	case sizeof( uint32_t ):
+		return ( (const uint32_t *)aWordEntry->pPackedKeys )[aTreeIdx];
+
+	default:
+		return ( (const uint64_t *)aWordEntry->pPackedKeys )[aTreeIdx];
+	}
+}
+
+/**
+ * @brief In-order walk of the packed keys tree of a word size. It visits the
+ * words sorted, so each node has the key and the index of the next word.
+ *
+ * @param aWordEntry Word size to check
+ * @param aTreeIdx Tree node, 1 is the root
+ * @param aSortedIdx Next sorted word expected, updated
+ * @return true if the subtree is the one dzcobs_dictionary_packed_init builds
+ */
+static bool dzcobs_dictfile_check_packed_node( const sDICT_wordentry *aWordEntry,
+																							 uint32_t aTreeIdx,
+																							 uint8_t *aSortedIdx )
+{
+	if( aTreeIdx > aWordEntry->nEntries )
+	{
+		return true;
+	}
+
+	if( !dzcobs_dictfile_check_packed_node( aWordEntry, 2 * aTreeIdx, aSortedIdx ) )
+	{
+		return false;
+	}
+
+	const size_t wordSize = (size_t)aWordEntry->strideSize - 1;
+	const uint8_t *pWord	= aWordEntry->dictionaryBegin + 1 + ( *aSortedIdx * aWordEntry->strideSize );
+
+	if( ( aWordEntry->pPackedIndex[aTreeIdx] != ( aWordEntry->globalIndex + *aSortedIdx ) ) ||
+			( dzcobs_dictfile_packed_key( aWordEntry, aTreeIdx ) != dzcobs_dictfile_word_key( pWord, wordSize ) ) )
+	{
+		return false;
+	}
+
+	( *aSortedIdx )++;
+
+	return dzcobs_dictfile_check_packed_node( aWordEntry, ( 2 * aTreeIdx ) + 1, aSortedIdx );
+}
+
+/// Checks that each packed key and index is the one of its word
+static bool dzcobs_dictfile_check_packed_words( const sDICT_ctx *aCtx )
+{
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *pWordEntry = &aCtx->wordSizeTable[i];
+		uint8_t sortedIdx									= 0;
+
+		if( ( pWordEntry->nEntries > 0 ) && ( !dzcobs_dictfile_check_packed_node( pWordEntry, 1, &sortedIdx ) ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Checks that the automaton is the one dzcobs_dictionary_automaton_init
+ * builds from the words: same byte classes, a state for each word prefix
+ * numbered in word order, each word matched at its last byte (or by a shorter
+ * word that starts it), and no other transition.
+ *
+ * @param aCtx Loaded dictionary, its words already checked
+ * @param aNStates Number of automaton states
+ * @return true if the automaton matches the words
+ */
+static bool dzcobs_dictfile_check_automaton_words( const sDICT_ctx *aCtx, size_t aNStates )
+{
+	const size_t nClasses = aCtx->nClasses;
+	uint8_t nWords				= 0;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		nWords += aCtx->wordSizeTable[i].nEntries;
+	}
+
+	// The bytes used by the words get their own class, in order, the others share the last one
+	uint8_t byteClass[DICT_AUTOMATON_BYTECLASS_SIZE];
+	bool isByteUsed[DICT_AUTOMATON_BYTECLASS_SIZE];
+	const uint8_t otherClass = (uint8_t)( nClasses - 1 );
+	uint8_t nUsed						 = 0;
+	size_t nBytesUsed				 = 0;
+	uint8_t wordSize				 = 0;
+
+	memset( byteClass, otherClass, sizeof( byteClass ) );
+	memset( isByteUsed, 0, sizeof( isByteUsed ) );
+
+	for( uint8_t wordIdx = 0; wordIdx < nWords; wordIdx++ )
+	{
+		const uint8_t *pWord = dzcobs_dictionary_get( aCtx, wordIdx, &wordSize );
+
+		for( uint8_t i = 0; i < wordSize; i++ )
+		{
+			nBytesUsed += isByteUsed[pWord[i]] ? 0 : 1;
+			isByteUsed[pWord[i]] = true;
+
+			if( ( byteClass[pWord[i]] == otherClass ) && ( nUsed != otherClass ) )
+			{
+				byteClass[pWord[i]] = nUsed++;
+			}
+		}
+	}
+
+	if( ( ( nBytesUsed + ( ( nBytesUsed < DICT_AUTOMATON_BYTECLASS_SIZE ) ? 1 : 0 ) ) != nClasses ) ||
+			( memcmp( byteClass, aCtx->pByteClass, sizeof( byteClass ) ) != 0 ) )
+	{
+		return false;
+	}
+
+	size_t nextState = 1;
+	size_t nMatches	 = 0;
+
+	for( uint8_t wordIdx = 0; wordIdx < nWords; wordIdx++ )
+	{
+		const uint8_t *pWord = dzcobs_dictionary_get( aCtx, wordIdx, &wordSize );
+		size_t state				 = 0;
+
+		for( uint8_t i = 0; i < wordSize; i++ )
+		{
+			const uint16_t transition = aCtx->pTransitions[( state * nClasses ) + byteClass[pWord[i]]];
+			const uint8_t prefixSize	= i + 1;
+
+			// A previous word that is this prefix (matched first), or that continues it
+			uint8_t shadowIdx = 0;
+			bool isNew				= true;
+
+			for( uint8_t otherIdx = 0; otherIdx < wordIdx; otherIdx++ )
+			{
+				uint8_t otherSize					= 0;
+				const uint8_t *pOther = dzcobs_dictionary_get( aCtx, otherIdx, &otherSize );
+
+				if( ( otherSize >= prefixSize ) && ( memcmp( pOther, pWord, prefixSize ) == 0 ) )
+				{
+					shadowIdx = ( otherSize == prefixSize ) ? (uint8_t)( otherIdx + 1 ) : shadowIdx;
+					isNew			= false;
+				}
+			}
+
+			if( shadowIdx != 0 )
+			{
+				if( transition != ( DICT_AUTOMATON_MATCH | shadowIdx ) )
+				{
+					return false;
+				}
+
+				break;
+			}
+
+			if( prefixSize == wordSize )
+			{
+				if( transition != ( DICT_AUTOMATON_MATCH | ( wordIdx + 1 ) ) )
+				{
+					return false;
+				}
+
+				nMatches++;
+			}
+			else if( ( transition & DICT_AUTOMATON_MATCH ) || ( transition == 0 ) ||
+							 ( isNew && ( transition != nextState++ ) ) )
+			{
+				return false;
+			}
+
+			state = transition;
+		}
+	}
+
+	size_t nUsedTransitions = 0;
+
+	for( size_t i = 0; i < ( aNStates * nClasses ); i++ )
+	{
+		nUsedTransitions += ( aCtx->pTransitions[i] != 0 ) ? 1 : 0;
+	}
+
+	return ( nextState == aNStates ) && ( nUsedTransitions == ( ( nextState - 1 ) + nMatches ) );
+}
+
+eDICT_ret dzcobs_dictfile_load( sDICT_ctx *aCtx, const void *aImage, size_t aImageSize )
+{
+	if( ( !aCtx ) || ( !aImage ) || ( ( (uintptr_t)aImage % DZCOBS_DICTFILE_ALIGNMENT ) != 0 ) )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	memset( aCtx, 0, sizeof( sDICT_ctx ) );
+
+	if( aImageSize < sizeof( sDZCOBS_dictfile_header ) )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	const uint8_t *pImage = (const uint8_t *)aImage;
+
+	sDZCOBS_dictfile_header header;
+	memcpy( &header, pImage, sizeof( header ) );
+
+	if( ( memcmp( header.magic, DZCOBS_DICTFILE_MAGIC, sizeof( header.magic ) ) != 0 ) ||
+			( header.byteOrder != DZCOBS_DICTFILE_BYTE_ORDER ) || ( header.version != DZCOBS_DICTFILE_VERSION ) ||
+			( ( header.indexes & ~( DZCOBS_DICTFILE_PACKED | DZCOBS_DICTFILE_AUTOMATON ) ) != 0 ) ||
+			( header.imageSize > aImageSize ) || ( header.imageSize < sizeof( sDZCOBS_dictfile_header ) ) )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	if( dzcobs_dictfile_checksum( pImage, header.imageSize ) != header.checksum )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	// The sections are inside the image
+	if( ( header.dictionaryOffset < sizeof( sDZCOBS_dictfile_header ) ) || ( header.dictionarySize < 3 ) ||
+			( !dzcobs_dictfile_is_inside( header.dictionaryOffset, header.dictionarySize, 0, header.imageSize ) ) ||
+			( pImage[header.dictionaryOffset + header.dictionarySize - 1] != 0 ) ||
+			( ( header.indexes & DZCOBS_DICTFILE_PACKED ) &&
+				( !dzcobs_dictfile_is_inside( header.packedOffset, header.packedSize, 0, header.imageSize ) ) ) ||
+			( ( header.indexes & DZCOBS_DICTFILE_AUTOMATON ) &&
+				( !dzcobs_dictfile_is_inside( header.automatonOffset, header.automatonSize, 0, header.imageSize ) ) ) )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	// Words sorted, as the binary searches need, and known sizes
+	if( dzcobs_dictionary_isvalid( (const char *)( pImage + header.dictionaryOffset ), header.dictionarySize ) !=
+			DICT_IS_VALID )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	if( ( !dzcobs_dictfile_check_groups( &header, pImage ) ) ||
+			( ( header.indexes & DZCOBS_DICTFILE_AUTOMATON ) && ( !dzcobs_dictfile_check_automaton( &header, pImage ) ) ) )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	aCtx->minWordSize = header.minWordSize;
+	aCtx->maxWordSize = header.maxWordSize;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDZCOBS_dictfile_group *pGroup = &header.groups[i];
+		sDICT_wordentry *pWordEntry					 = &aCtx->wordSizeTable[i];
+
+		if( pGroup->nEntries == 0 )
+		{
+			continue;
+		}
+
+		pWordEntry->dictionaryBegin = pImage + pGroup->wordsOffset;
+		pWordEntry->nEntries				= pGroup->nEntries;
+		pWordEntry->lastIndex				= pGroup->nEntries - 1;
+		pWordEntry->globalIndex			= pGroup->globalIndex;
+		pWordEntry->strideSize			= pGroup->strideSize;
+
+		if( header.indexes & DZCOBS_DICTFILE_PACKED )
+		{
+			pWordEntry->pPackedKeys	 = pImage + pGroup->packedKeysOffset;
+			pWordEntry->pPackedIndex = pImage + pGroup->packedIndexOffset;
+		}
+	}
+
+	if( header.indexes & DZCOBS_DICTFILE_AUTOMATON )
+	{
+		aCtx->pByteClass	 = pImage + header.automatonOffset;
+		aCtx->pTransitions = (const uint16_t *)( pImage + header.automatonOffset + DICT_AUTOMATON_BYTECLASS_SIZE );
+		aCtx->nClasses		 = header.nClasses;
+	}
+
+	// The indexes are inside the image, they must also find the right words
+	size_t nStates = 0;
+
+	if( header.nClasses > 0 )
+	{
+		nStates = ( header.automatonSize - DICT_AUTOMATON_BYTECLASS_SIZE ) / sizeof( uint16_t ) / header.nClasses;
+	}
+
+	const bool isPackedValid		=
+		( ( header.indexes & DZCOBS_DICTFILE_PACKED ) == 0 ) || dzcobs_dictfile_check_packed_words( aCtx );
+	const bool isAutomatonValid =
+		( ( header.indexes & DZCOBS_DICTFILE_AUTOMATON ) == 0 ) || dzcobs_dictfile_check_automaton_words( aCtx, nStates );
+
+	if( ( !isPackedValid ) || ( !isAutomatonValid ) )
+	{
+		memset( aCtx, 0, sizeof( sDICT_ctx ) );
+
+		return DICT_RET_ERR_INVALID;
+	}
+
+	return DICT_RET_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -16,7 +16,9 @@
 // Includes
 // /////////////////////////////////////////////////////////////////////////////
 #include "dzcobs/dzcobs_dictionary.h"
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include "dzcobs_assert.h"
 
@@ -89,10 +91,19 @@ eDICT_ret dzcobs_dictionary_init( sDICT_ctx *aCtx, const char *aDictionary, size
 		currentWordIndex++;
 	}
 
-	DZCOBS_ASSERT( ( aCtx->wordSizeTable[0].strideSize == ( 2 + 1 ) ) || ( aCtx->wordSizeTable[0].nEntries == 0 ) );
-	DZCOBS_ASSERT( ( aCtx->wordSizeTable[1].strideSize == ( 3 + 1 ) ) || ( aCtx->wordSizeTable[1].nEntries == 0 ) );
-	DZCOBS_ASSERT( ( aCtx->wordSizeTable[2].strideSize == ( 4 + 1 ) ) || ( aCtx->wordSizeTable[2].nEntries == 0 ) );
-	DZCOBS_ASSERT( ( aCtx->wordSizeTable[3].strideSize == ( 5 + 1 ) ) || ( aCtx->wordSizeTable[3].nEntries == 0 ) );
+	if( pWordEntry != NULL )
+	{
+		pWordEntry->lastIndex = pWordEntry->nEntries - 1;
+	}
+
+	// Word sizes may skip values (e.g. a trained dictionary of 2 and 4 bytes words)
+	// but they are always ascending
+	DZCOBS_ASSERT( ( aCtx->wordSizeTable[1].nEntries == 0 ) ||
+								 ( aCtx->wordSizeTable[1].strideSize > aCtx->wordSizeTable[0].strideSize ) );
+	DZCOBS_ASSERT( ( aCtx->wordSizeTable[2].nEntries == 0 ) ||
+								 ( aCtx->wordSizeTable[2].strideSize > aCtx->wordSizeTable[1].strideSize ) );
+	DZCOBS_ASSERT( ( aCtx->wordSizeTable[3].nEntries == 0 ) ||
+								 ( aCtx->wordSizeTable[3].strideSize > aCtx->wordSizeTable[2].strideSize ) );
 
 	return DICT_RET_SUCCESS;
 }
@@ -151,8 +162,7 @@ eDICTVALID_ret dzcobs_dictionary_isvalid( const char *aDictionary, size_t aDicti
 		}
 		else
 		{
-			previousWordLen			= currentWordLen;
-			pPreviousWordBuffer = tmpBuffer[1];
+			previousWordLen = currentWordLen;
 			differentWordCount++;
 
 			if( differentWordCount > DICT_MAX_DIFFERENTWORDSIZES )
@@ -166,10 +176,9 @@ eDICTVALID_ret dzcobs_dictionary_isvalid( const char *aDictionary, size_t aDicti
 			break;
 		}
 
-		// Swap
-		char *tmpPtr				= pPreviousWordBuffer;
+		// Swap, the current word is kept as the previous one
 		pPreviousWordBuffer = pCurrentWordBuffer;
-		pCurrentWordBuffer	= tmpPtr;
+		pCurrentWordBuffer	= ( pCurrentWordBuffer == tmpBuffer[0] ) ? tmpBuffer[1] : tmpBuffer[0];
 	}
 
 	if( *pDictBuffer != 0 )
@@ -229,6 +238,94 @@ uint8_t DZCOBS_Dictionary_SearchKeyOnEntry( const uint8_t *aSearchKey, const sDI
 	return 0;
 }
 
+/// Bytes of the integer that holds a word of aWordSize bytes
+static size_t dzcobs_dictionary_packed_keysize( uint8_t aWordSize )
+{
+	return ( aWordSize <= 2 ) ? sizeof( uint16_t ) : ( ( aWordSize <= 4 ) ? sizeof( uint32_t ) : sizeof( uint64_t ) );
+}
+
+/// Rounds up to a multiple of 8, so each packed array is 8 bytes aligned
+static size_t dzcobs_dictionary_packed_align( size_t aSize )
+{
+	return ( aSize + 7 ) & ~(size_t)7;
+}
+
+/// Big endian, so the integer order is the memcmp order
+static uint64_t dzcobs_dictionary_packed_load( const uint8_t *aKey, size_t aKeySize )
+{
+	uint64_t key = 0;
+
+	for( size_t i = 0; i < aKeySize; i++ )
+	{
+		key = ( key << 8 ) | aKey[i];
+	}
+
+	return key;
+}
+
+/// Eytzinger lower bound exit: drop the right turns taken after the last left turn
+static uint32_t dzcobs_dictionary_packed_exit( uint32_t aIdx )
+{
+#if defined( __GNUC__ )
+	return aIdx >> ( __builtin_ctz( ~aIdx ) + 1 );
+#else
+	while( aIdx & 1 )
+	{
+		aIdx >>= 1;
+	}
+
+	return aIdx >> 1;
+#endif
+}
+
+static uint8_t dzcobs_dictionary_packed_search16( const sDICT_wordentry *aWordEntry, uint16_t aKey )
+{
+	const uint16_t *pKeys = (const uint16_t *)aWordEntry->pPackedKeys;
+	const uint32_t n			= aWordEntry->nEntries;
+	uint32_t idx					= 1;
+
+	while( idx <= n )
+	{
+		idx = ( 2 * idx ) + ( pKeys[idx] < aKey );
+	}
+
+	idx = dzcobs_dictionary_packed_exit( idx );
+
+	return ( pKeys[idx] == aKey ) ? aWordEntry->pPackedIndex[idx] : 0;
+}
+
+static uint8_t dzcobs_dictionary_packed_search32( const sDICT_wordentry *aWordEntry, uint32_t aKey )
+{
+	const uint32_t *pKeys = (const uint32_t *)aWordEntry->pPackedKeys;
+	const uint32_t n			= aWordEntry->nEntries;
+	uint32_t idx					= 1;
+
+	while( idx <= n )
+	{
+		idx = ( 2 * idx ) + ( pKeys[idx] < aKey );
+	}
+
+	idx = dzcobs_dictionary_packed_exit( idx );
+
+	return ( pKeys[idx] == aKey ) ? aWordEntry->pPackedIndex[idx] : 0;
+}
+
+static uint8_t dzcobs_dictionary_packed_search64( const sDICT_wordentry *aWordEntry, uint64_t aKey )
+{
+	const uint64_t *pKeys = (const uint64_t *)aWordEntry->pPackedKeys;
+	const uint32_t n			= aWordEntry->nEntries;
+	uint32_t idx					= 1;
+
+	while( idx <= n )
+	{
+		idx = ( 2 * idx ) + ( pKeys[idx] < aKey );
+	}
+
+	idx = dzcobs_dictionary_packed_exit( idx );
+
+	return ( pKeys[idx] == aKey ) ? aWordEntry->pPackedIndex[idx] : 0;
+}
+
 uint8_t dzcobs_dictionary_search( const sDICT_ctx *aCtx,
 																	const uint8_t *aSearchKey,
 																	size_t aSearchKeySize,
@@ -238,10 +335,13 @@ uint8_t dzcobs_dictionary_search( const sDICT_ctx *aCtx,
 	DZCOBS_ASSERT( aSearchKey != NULL );
 	DZCOBS_ASSERT( aOutKeySizeFound != NULL );
 
-	DZCOBS_ASSERT( ( aCtx->wordSizeTable[0].strideSize == ( 2 + 1 ) ) || ( aCtx->wordSizeTable[0].nEntries == 0 ) );
-	DZCOBS_ASSERT( ( aCtx->wordSizeTable[1].strideSize == ( 3 + 1 ) ) || ( aCtx->wordSizeTable[1].nEntries == 0 ) );
-	DZCOBS_ASSERT( ( aCtx->wordSizeTable[2].strideSize == ( 4 + 1 ) ) || ( aCtx->wordSizeTable[2].nEntries == 0 ) );
-	DZCOBS_ASSERT( ( aCtx->wordSizeTable[3].strideSize == ( 5 + 1 ) ) || ( aCtx->wordSizeTable[3].nEntries == 0 ) );
+	// Word size groups are ascending, see dzcobs_dictionary_init
+	DZCOBS_ASSERT( ( aCtx->wordSizeTable[1].nEntries == 0 ) ||
+								 ( aCtx->wordSizeTable[1].strideSize > aCtx->wordSizeTable[0].strideSize ) );
+	DZCOBS_ASSERT( ( aCtx->wordSizeTable[2].nEntries == 0 ) ||
+								 ( aCtx->wordSizeTable[2].strideSize > aCtx->wordSizeTable[1].strideSize ) );
+	DZCOBS_ASSERT( ( aCtx->wordSizeTable[3].nEntries == 0 ) ||
+								 ( aCtx->wordSizeTable[3].strideSize > aCtx->wordSizeTable[2].strideSize ) );
 
 	if( aSearchKeySize < aCtx->minWordSize )
 	{
@@ -253,6 +353,82 @@ uint8_t dzcobs_dictionary_search( const sDICT_ctx *aCtx,
 		aSearchKeySize = aCtx->maxWordSize;
 	}
 
+	if( aCtx->searchFunc != NULL )
+	{
+		return aCtx->searchFunc( aSearchKey, aSearchKeySize, aOutKeySizeFound );
+	}
+
+	if( aCtx->pTransitions != NULL )
+	{
+		const uint8_t *pByteClass			 = aCtx->pByteClass;
+		const uint16_t *pTransitions = aCtx->pTransitions;
+		const size_t nClasses				 = aCtx->nClasses;
+		uint16_t state							 = 0;
+
+		for( size_t i = 0; i < aSearchKeySize; i++ )
+		{
+			state = pTransitions[( state * nClasses ) + pByteClass[aSearchKey[i]]];
+
+			if( state & DICT_AUTOMATON_MATCH )
+			{
+				*aOutKeySizeFound = i + 1;
+
+				return (uint8_t)( state & ~DICT_AUTOMATON_MATCH );
+			}
+
+			if( state == 0 )
+			{
+				break;
+			}
+		}
+
+		return 0;
+	}
+
+	if( aCtx->wordSizeTable[0].pPackedKeys != NULL )
+	{
+		// Load the key once, each word size uses its first bytes
+		const uint64_t key = dzcobs_dictionary_packed_load( aSearchKey, aSearchKeySize );
+
+		for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+		{
+			const sDICT_wordentry *wordEntry = &aCtx->wordSizeTable[i];
+			const size_t wordSize						 = (size_t)wordEntry->strideSize - 1;
+
+			if( ( wordEntry->nEntries == 0 ) || ( wordSize > aSearchKeySize ) )
+			{
+				break;
+			}
+
+			const uint64_t wordKey = key >> ( 8 * ( aSearchKeySize - wordSize ) );
+			uint8_t idxFound			 = 0;
+
+			switch( dzcobs_dictionary_packed_keysize( (uint8_t)wordSize ) )
+			{
+			case sizeof( uint16_t ):
+				idxFound = dzcobs_dictionary_packed_search16( wordEntry, (uint16_t)wordKey );
+				break;
+
+			case sizeof( uint32_t ):
+				idxFound = dzcobs_dictionary_packed_search32( wordEntry, (uint32_t)wordKey );
+				break;
+
+			default:
+				idxFound = dzcobs_dictionary_packed_search64( wordEntry, wordKey );
+				break;
+			}
+
+			if( idxFound != 0 )
+			{
+				*aOutKeySizeFound = wordSize;
+
+				return idxFound;
+			}
+		}
+
+		return 0;
+	}
+
 	const size_t compareKeySize = aSearchKeySize + 1; // this is just to fake a dummy header byte
 
 	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
@@ -281,6 +457,11 @@ const uint8_t *dzcobs_dictionary_get( const sDICT_ctx *aCtx, uint8_t aIndex, uin
 	DZCOBS_ASSERT( aIndex < 126 );
 	DZCOBS_ASSERT( aOutWordSize != NULL );
 
+	if( aCtx->getFunc != NULL )
+	{
+		return aCtx->getFunc( aIndex, aOutWordSize );
+	}
+
 	aIndex++; // convert to start as a 1 index (for easy comparison)
 
 	for( uint8_t i = 0; i < (uint8_t)DICT_MAX_DIFFERENTWORDSIZES; i++ )
@@ -302,5 +483,301 @@ const uint8_t *dzcobs_dictionary_get( const sDICT_ctx *aCtx, uint8_t aIndex, uin
 	return NULL;
 }
 
+static uint8_t dzcobs_dictionary_nwords( const sDICT_ctx *aCtx )
+{
+	uint8_t nWords = 0;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		nWords += aCtx->wordSizeTable[i].nEntries;
+	}
+
+	return nWords;
+}
+
+/**
+ * @brief Count the states and the byte classes of the dictionary automaton
+ *
+ * @param aCtx The dictionary context
+ * @param aOutNStates Number of states, a state for each word prefix that can
+ * still match a word, and the start state
+ * @param aOutNClasses Number of byte classes
+ */
+static void dzcobs_dictionary_automaton_count( const sDICT_ctx *aCtx, size_t *aOutNStates, size_t *aOutNClasses )
+{
+	uint8_t isByteUsed[DICT_AUTOMATON_BYTECLASS_SIZE / 8];
+	memset( isByteUsed, 0, sizeof( isByteUsed ) );
+
+	const uint8_t nWords = dzcobs_dictionary_nwords( aCtx );
+
+	size_t nStates = 1;
+	size_t nUsed	 = 0;
+
+	for( uint8_t wordIdx = 0; wordIdx < nWords; wordIdx++ )
+	{
+		uint8_t wordSize					= 0;
+		const uint8_t *pWord = dzcobs_dictionary_get( aCtx, wordIdx, &wordSize );
+
+		for( uint8_t i = 0; i < wordSize; i++ )
+		{
+			if( ( isByteUsed[pWord[i] / 8] & ( 1 << ( pWord[i] % 8 ) ) ) == 0 )
+			{
+				isByteUsed[pWord[i] / 8] |= (uint8_t)( 1 << ( pWord[i] % 8 ) );
+				nUsed++;
+			}
+		}
+
+		// Each prefix not found on a previous word is a new state. Words are sorted
+		// by size, so a word with a shorter word as prefix is never matched and adds
+		// no more states.
+		bool isShadowed = false;
+
+		for( uint8_t prefixSize = 1; ( prefixSize < wordSize ) && ( !isShadowed ); prefixSize++ )
+		{
+			bool isNew = true;
+
+			for( uint8_t otherIdx = 0; otherIdx < wordIdx; otherIdx++ )
+			{
+				uint8_t otherSize					= 0;
+				const uint8_t *pOther = dzcobs_dictionary_get( aCtx, otherIdx, &otherSize );
+
+				if( ( otherSize >= prefixSize ) && ( memcmp( pOther, pWord, prefixSize ) == 0 ) )
+				{
+					isNew			 = false;
+					isShadowed = ( otherSize == prefixSize );
+					break;
+				}
+			}
+
+			if( isNew )
+			{
+				nStates++;
+			}
+		}
+	}
+
+	*aOutNStates	= nStates;
+	*aOutNClasses = nUsed + ( ( nUsed < DICT_AUTOMATON_BYTECLASS_SIZE ) ? 1 : 0 );
+}
+
+size_t dzcobs_dictionary_automaton_size( const sDICT_ctx *aCtx )
+{
+	if( !aCtx )
+	{
+		return 0;
+	}
+
+	size_t nStates	= 0;
+	size_t nClasses = 0;
+
+	dzcobs_dictionary_automaton_count( aCtx, &nStates, &nClasses );
+
+	return DICT_AUTOMATON_BYTECLASS_SIZE + ( nStates * nClasses * sizeof( uint16_t ) );
+}
+
+eDICT_ret dzcobs_dictionary_automaton_init( sDICT_ctx *aCtx, void *aMem, size_t aMemSize )
+{
+	if( ( !aCtx ) || ( !aMem ) || ( ( (uintptr_t)aMem % sizeof( uint16_t ) ) != 0 ) || ( aCtx->maxWordSize == 0 ) )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	size_t nStates	= 0;
+	size_t nClasses = 0;
+
+	dzcobs_dictionary_automaton_count( aCtx, &nStates, &nClasses );
+
+	if( aMemSize < ( DICT_AUTOMATON_BYTECLASS_SIZE + ( nStates * nClasses * sizeof( uint16_t ) ) ) )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	uint8_t *pByteClass			= (uint8_t *)aMem;
+	uint16_t *pTransitions	= (uint16_t *)( pByteClass + DICT_AUTOMATON_BYTECLASS_SIZE );
+	const uint8_t otherClass = (uint8_t)( nClasses - 1 );
+
+	// The bytes used by the words get their own class, the others share the last one
+	memset( pByteClass, otherClass, DICT_AUTOMATON_BYTECLASS_SIZE );
+
+	const uint8_t nWords = dzcobs_dictionary_nwords( aCtx );
+
+	uint8_t wordSize = 0;
+	uint8_t nUsed		 = 0;
+
+	for( uint8_t wordIdx = 0; wordIdx < nWords; wordIdx++ )
+	{
+		const uint8_t *pWord = dzcobs_dictionary_get( aCtx, wordIdx, &wordSize );
+
+		for( uint8_t i = 0; i < wordSize; i++ )
+		{
+			if( ( pByteClass[pWord[i]] == otherClass ) && ( nUsed != otherClass ) )
+			{
+				pByteClass[pWord[i]] = nUsed++;
+			}
+		}
+	}
+
+	memset( pTransitions, 0, nStates * nClasses * sizeof( uint16_t ) );
+
+	uint16_t nextState = 1;
+
+	for( uint8_t wordIdx = 0; wordIdx < nWords; wordIdx++ )
+	{
+		const uint8_t *pWord = dzcobs_dictionary_get( aCtx, wordIdx, &wordSize );
+		uint16_t state			 = 0;
+		bool isShadowed			 = false;
+
+		for( uint8_t i = 0; ( i + 1 ) < wordSize; i++ )
+		{
+			uint16_t *pTransition = &pTransitions[( state * nClasses ) + pByteClass[pWord[i]]];
+
+			if( *pTransition & DICT_AUTOMATON_MATCH )
+			{
+				// A shorter word is matched first
+				isShadowed = true;
+				break;
+			}
+
+			if( *pTransition == 0 )
+			{
+				*pTransition = nextState++;
+			}
+
+			state = *pTransition;
+		}
+
+		if( !isShadowed )
+		{
+			uint16_t *pTransition = &pTransitions[( state * nClasses ) + pByteClass[pWord[wordSize - 1]]];
+
+			DZCOBS_ASSERT( *pTransition == 0 );
+
+			*pTransition = (uint16_t)( DICT_AUTOMATON_MATCH | ( wordIdx + 1 ) );
+		}
+	}
+
+	DZCOBS_ASSERT( nextState == nStates );
+
+	aCtx->pByteClass	 = pByteClass;
+	aCtx->pTransitions = pTransitions;
+	aCtx->nClasses		 = (uint16_t)nClasses;
+
+	return DICT_RET_SUCCESS;
+}
+
+size_t dzcobs_dictionary_packed_size( const sDICT_ctx *aCtx )
+{
+	if( !aCtx )
+	{
+		return 0;
+	}
+
+	size_t size = 0;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *wordEntry = &aCtx->wordSizeTable[i];
+
+		if( wordEntry->nEntries > 0 )
+		{
+			const size_t n = (size_t)wordEntry->nEntries + 1;
+
+			size += dzcobs_dictionary_packed_align( n * dzcobs_dictionary_packed_keysize( wordEntry->strideSize - 1 ) );
+			size += dzcobs_dictionary_packed_align( n );
+		}
+	}
+
+	return size;
+}
+
+/**
+ * @brief Place the sorted words of a word size in Eytzinger order, an in-order
+ * walk of the implicit tree visits them sorted
+ *
+ * @param aWordEntry Word size to pack
+ * @param aKeys Packed keys output
+ * @param aIndex Global index output
+ * @param aSortedIdx Next sorted word to place
+ * @param aTreeIdx Tree node, 1 is the root
+ * @return uint8_t Next sorted word to place after this subtree
+ */
+static uint8_t dzcobs_dictionary_packed_fill(
+	const sDICT_wordentry *aWordEntry, void *aKeys, uint8_t *aIndex, uint8_t aSortedIdx, uint32_t aTreeIdx )
+{
+	if( aTreeIdx > aWordEntry->nEntries )
+	{
+		return aSortedIdx;
+	}
+
+	aSortedIdx = dzcobs_dictionary_packed_fill( aWordEntry, aKeys, aIndex, aSortedIdx, 2 * aTreeIdx );
+
+	const size_t wordSize = (size_t)aWordEntry->strideSize - 1;
+	const uint8_t *pWord	= aWordEntry->dictionaryBegin + 1 + ( aSortedIdx * aWordEntry->strideSize );
+	const uint64_t key		= dzcobs_dictionary_packed_load( pWord, wordSize );
+
+	switch( dzcobs_dictionary_packed_keysize( (uint8_t)wordSize ) )
+	{
+	case sizeof( uint16_t ):
+		( (uint16_t *)aKeys )[aTreeIdx] = (uint16_t)key;
+		break;
+
+	case sizeof( uint32_t ):
+		( (uint32_t *)aKeys )[aTreeIdx] = (uint32_t)key;
+		break;
+
+	default:
+		( (uint64_t *)aKeys )[aTreeIdx] = key;
+		break;
+	}
+
+	aIndex[aTreeIdx] = (uint8_t)( aWordEntry->globalIndex + aSortedIdx );
+
+	return dzcobs_dictionary_packed_fill( aWordEntry, aKeys, aIndex, aSortedIdx + 1, ( 2 * aTreeIdx ) + 1 );
+}
+
+eDICT_ret dzcobs_dictionary_packed_init( sDICT_ctx *aCtx, void *aMem, size_t aMemSize )
+{
+	if( ( !aCtx ) || ( !aMem ) || ( ( (uintptr_t)aMem % sizeof( uint64_t ) ) != 0 ) || ( aCtx->maxWordSize == 0 ) ||
+			( aMemSize < dzcobs_dictionary_packed_size( aCtx ) ) )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	uint8_t *pMem = (uint8_t *)aMem;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		sDICT_wordentry *wordEntry = &aCtx->wordSizeTable[i];
+
+		if( wordEntry->nEntries == 0 )
+		{
+			continue;
+		}
+
+		const size_t n				= (size_t)wordEntry->nEntries + 1;
+		const size_t keySize	= dzcobs_dictionary_packed_keysize( wordEntry->strideSize - 1 );
+		const size_t keysSize = dzcobs_dictionary_packed_align( n * keySize );
+
+		void *pKeys			= pMem;
+		uint8_t *pIndex = pMem + keysSize;
+
+		// Index 0 is where the search exits when all the words are smaller than the
+		// key, its key is 0 and its index 0 (not found)
+		memset( pMem, 0, keysSize + dzcobs_dictionary_packed_align( n ) );
+
+		const uint8_t nPlaced = dzcobs_dictionary_packed_fill( wordEntry, pKeys, pIndex, 0, 1 );
+
+		DZCOBS_ASSERT( nPlaced == wordEntry->nEntries );
+		(void)nPlaced;
+
+		wordEntry->pPackedKeys	= pKeys;
+		wordEntry->pPackedIndex = pIndex;
+
+		pMem += keysSize + dzcobs_dictionary_packed_align( n );
+	}
+
+	return DICT_RET_SUCCESS;
+}
+
 // EOF
 // /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,523 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_fec.c
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_fec.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dzcobs_assert.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define DZCOBS_FEC_NN ( 255 )											 // Codeword size
+#define DZCOBS_FEC_MAX_ROOTS ( 2 * DZCOBS_FEC_MAX_T ) // Maximum parity symbols
+
+// GF(2^8) tables, polynomial 0x11D, alpha = 2. The exp table is doubled so the
+// sum of two logs can be used without the modulo.
+static const uint8_t s_gfExp[512] = {
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1D, 0x3A, 0x74, 0xE8, 0xCD, 0x87, 0x13, 0x26,
+	0x4C, 0x98, 0x2D, 0x5A, 0xB4, 0x75, 0xEA, 0xC9, 0x8F, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0,
+	0x9D, 0x27, 0x4E, 0x9C, 0x25, 0x4A, 0x94, 0x35, 0x6A, 0xD4, 0xB5, 0x77, 0xEE, 0xC1, 0x9F, 0x23,
+	0x46, 0x8C, 0x05, 0x0A, 0x14, 0x28, 0x50, 0xA0, 0x5D, 0xBA, 0x69, 0xD2, 0xB9, 0x6F, 0xDE, 0xA1,
+	0x5F, 0xBE, 0x61, 0xC2, 0x99, 0x2F, 0x5E, 0xBC, 0x65, 0xCA, 0x89, 0x0F, 0x1E, 0x3C, 0x78, 0xF0,
+	0xFD, 0xE7, 0xD3, 0xBB, 0x6B, 0xD6, 0xB1, 0x7F, 0xFE, 0xE1, 0xDF, 0xA3, 0x5B, 0xB6, 0x71, 0xE2,
+	0xD9, 0xAF, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0D, 0x1A, 0x34, 0x68, 0xD0, 0xBD, 0x67, 0xCE,
+	0x81, 0x1F, 0x3E, 0x7C, 0xF8, 0xED, 0xC7, 0x93, 0x3B, 0x76, 0xEC, 0xC5, 0x97, 0x33, 0x66, 0xCC,
+	0x85, 0x17, 0x2E, 0x5C, 0xB8, 0x6D, 0xDA, 0xA9, 0x4F, 0x9E, 0x21, 0x42, 0x84, 0x15, 0x2A, 0x54,
+	0xA8, 0x4D, 0x9A, 0x29, 0x52, 0xA4, 0x55, 0xAA, 0x49, 0x92, 0x39, 0x72, 0xE4, 0xD5, 0xB7, 0x73,
+	0xE6, 0xD1, 0xBF, 0x63, 0xC6, 0x91, 0x3F, 0x7E, 0xFC, 0xE5, 0xD7, 0xB3, 0x7B, 0xF6, 0xF1, 0xFF,
+	0xE3, 0xDB, 0xAB, 0x4B, 0x96, 0x31, 0x62, 0xC4, 0x95, 0x37, 0x6E, 0xDC, 0xA5, 0x57, 0xAE, 0x41,
+	0x82, 0x19, 0x32, 0x64, 0xC8, 0x8D, 0x07, 0x0E, 0x1C, 0x38, 0x70, 0xE0, 0xDD, 0xA7, 0x53, 0xA6,
+	0x51, 0xA2, 0x59, 0xB2, 0x79, 0xF2, 0xF9, 0xEF, 0xC3, 0x9B, 0x2B, 0x56, 0xAC, 0x45, 0x8A, 0x09,
+	0x12, 0x24, 0x48, 0x90, 0x3D, 0x7A, 0xF4, 0xF5, 0xF7, 0xF3, 0xFB, 0xEB, 0xCB, 0x8B, 0x0B, 0x16,
+	0x2C, 0x58, 0xB0, 0x7D, 0xFA, 0xE9, 0xCF, 0x83, 0x1B, 0x36, 0x6C, 0xD8, 0xAD, 0x47, 0x8E, 0x01,
+	0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1D, 0x3A, 0x74, 0xE8, 0xCD, 0x87, 0x13, 0x26, 0x4C,
+	0x98, 0x2D, 0x5A, 0xB4, 0x75, 0xEA, 0xC9, 0x8F, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x9D,
+	0x27, 0x4E, 0x9C, 0x25, 0x4A, 0x94, 0x35, 0x6A, 0xD4, 0xB5, 0x77, 0xEE, 0xC1, 0x9F, 0x23, 0x46,
+	0x8C, 0x05, 0x0A, 0x14, 0x28, 0x50, 0xA0, 0x5D, 0xBA, 0x69, 0xD2, 0xB9, 0x6F, 0xDE, 0xA1, 0x5F,
+	0xBE, 0x61, 0xC2, 0x99, 0x2F, 0x5E, 0xBC, 0x65, 0xCA, 0x89, 0x0F, 0x1E, 0x3C, 0x78, 0xF0, 0xFD,
+	0xE7, 0xD3, 0xBB, 0x6B, 0xD6, 0xB1, 0x7F, 0xFE, 0xE1, 0xDF, 0xA3, 0x5B, 0xB6, 0x71, 0xE2, 0xD9,
+	0xAF, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0D, 0x1A, 0x34, 0x68, 0xD0, 0xBD, 0x67, 0xCE, 0x81,
+	0x1F, 0x3E, 0x7C, 0xF8, 0xED, 0xC7, 0x93, 0x3B, 0x76, 0xEC, 0xC5, 0x97, 0x33, 0x66, 0xCC, 0x85,
+	0x17, 0x2E, 0x5C, 0xB8, 0x6D, 0xDA, 0xA9, 0x4F, 0x9E, 0x21, 0x42, 0x84, 0x15, 0x2A, 0x54, 0xA8,
+	0x4D, 0x9A, 0x29, 0x52, 0xA4, 0x55, 0xAA, 0x49, 0x92, 0x39, 0x72, 0xE4, 0xD5, 0xB7, 0x73, 0xE6,
+	0xD1, 0xBF, 0x63, 0xC6, 0x91, 0x3F, 0x7E, 0xFC, 0xE5, 0xD7, 0xB3, 0x7B, 0xF6, 0xF1, 0xFF, 0xE3,
+	0xDB, 0xAB, 0x4B, 0x96, 0x31, 0x62, 0xC4, 0x95, 0x37, 0x6E, 0xDC, 0xA5, 0x57, 0xAE, 0x41, 0x82,
+	0x19, 0x32, 0x64, 0xC8, 0x8D, 0x07, 0x0E, 0x1C, 0x38, 0x70, 0xE0, 0xDD, 0xA7, 0x53, 0xA6, 0x51,
+	0xA2, 0x59, 0xB2, 0x79, 0xF2, 0xF9, 0xEF, 0xC3, 0x9B, 0x2B, 0x56, 0xAC, 0x45, 0x8A, 0x09, 0x12,
+	0x24, 0x48, 0x90, 0x3D, 0x7A, 0xF4, 0xF5, 0xF7, 0xF3, 0xFB, 0xEB, 0xCB, 0x8B, 0x0B, 0x16, 0x2C,
+	0x58, 0xB0, 0x7D, 0xFA, 0xE9, 0xCF, 0x83, 0x1B, 0x36, 0x6C, 0xD8, 0xAD, 0x47, 0x8E, 0x01, 0x02,};
+
+static const uint8_t s_gfLog[256] = {
+	0x00, 0x00, 0x01, 0x19, 0x02, 0x32, 0x1A, 0xC6, 0x03, 0xDF, 0x33, 0xEE, 0x1B, 0x68, 0xC7, 0x4B,
+	0x04, 0x64, 0xE0, 0x0E, 0x34, 0x8D, 0xEF, 0x81, 0x1C, 0xC1, 0x69, 0xF8, 0xC8, 0x08, 0x4C, 0x71,
+	0x05, 0x8A, 0x65, 0x2F, 0xE1, 0x24, 0x0F, 0x21, 0x35, 0x93, 0x8E, 0xDA, 0xF0, 0x12, 0x82, 0x45,
+	0x1D, 0xB5, 0xC2, 0x7D, 0x6A, 0x27, 0xF9, 0xB9, 0xC9, 0x9A, 0x09, 0x78, 0x4D, 0xE4, 0x72, 0xA6,
+	0x06, 0xBF, 0x8B, 0x62, 0x66, 0xDD, 0x30, 0xFD, 0xE2, 0x98, 0x25, 0xB3, 0x10, 0x91, 0x22, 0x88,
+	0x36, 0xD0, 0x94, 0xCE, 0x8F, 0x96, 0xDB, 0xBD, 0xF1, 0xD2, 0x13, 0x5C, 0x83, 0x38, 0x46, 0x40,
+	0x1E, 0x42, 0xB6, 0xA3, 0xC3, 0x48, 0x7E, 0x6E, 0x6B, 0x3A, 0x28, 0x54, 0xFA, 0x85, 0xBA, 0x3D,
+	0xCA, 0x5E, 0x9B, 0x9F, 0x0A, 0x15, 0x79, 0x2B, 0x4E, 0xD4, 0xE5, 0xAC, 0x73, 0xF3, 0xA7, 0x57,
+	0x07, 0x70, 0xC0, 0xF7, 0x8C, 0x80, 0x63, 0x0D, 0x67, 0x4A, 0xDE, 0xED, 0x31, 0xC5, 0xFE, 0x18,
+	0xE3, 0xA5, 0x99, 0x77, 0x26, 0xB8, 0xB4, 0x7C, 0x11, 0x44, 0x92, 0xD9, 0x23, 0x20, 0x89, 0x2E,
+	0x37, 0x3F, 0xD1, 0x5B, 0x95, 0xBC, 0xCF, 0xCD, 0x90, 0x87, 0x97, 0xB2, 0xDC, 0xFC, 0xBE, 0x61,
+	0xF2, 0x56, 0xD3, 0xAB, 0x14, 0x2A, 0x5D, 0x9E, 0x84, 0x3C, 0x39, 0x53, 0x47, 0x6D, 0x41, 0xA2,
+	0x1F, 0x2D, 0x43, 0xD8, 0xB7, 0x7B, 0xA4, 0x76, 0xC4, 0x17, 0x49, 0xEC, 0x7F, 0x0C, 0x6F, 0xF6,
+	0x6C, 0xA1, 0x3B, 0x52, 0x29, 0x9D, 0x55, 0xAA, 0xFB, 0x60, 0x86, 0xB1, 0xBB, 0xCC, 0x3E, 0x5A,
+	0xCB, 0x59, 0x5F, 0xB0, 0x9C, 0xA9, 0xA0, 0x51, 0x0B, 0xF5, 0x16, 0xEB, 0x7A, 0x75, 0x2C, 0xD7,
+	0x4F, 0xAE, 0xD5, 0xE9, 0xE6, 0xE7, 0xAD, 0xE8, 0x74, 0xD6, 0xF4, 0xEA, 0xA8, 0x50, 0x58, 0xAF,};
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static uint8_t dzcobs_fec_mul( uint8_t aA, uint8_t aB )
+{
+	if( ( aA == 0 ) || ( aB == 0 ) )
+	{
+		return 0;
+	}
+
+	return s_gfExp[s_gfLog[aA] + s_gfLog[aB]];
+}
+
+static uint8_t dzcobs_fec_div( uint8_t aA, uint8_t aB )
+{
+	DZCOBS_ASSERT( aB != 0 );
+
+	if( aA == 0 )
+	{
+		return 0;
+	}
+
+	return s_gfExp[s_gfLog[aA] + DZCOBS_FEC_NN - s_gfLog[aB]];
+}
+
+// alpha^aPower, for any aPower >= 0
+static uint8_t dzcobs_fec_alpha( size_t aPower )
+{
+	return s_gfExp[aPower % DZCOBS_FEC_NN];
+}
+
+// Generator polynomial g(x) = (x + alpha^1)...(x + alpha^nRoots), aOutGen[k]
+// is the coefficient of x^k
+static void dzcobs_fec_generator( size_t aNRoots, uint8_t *aOutGen )
+{
+	memset( aOutGen, 0, aNRoots + 1 );
+	aOutGen[0] = 1;
+
+	for( size_t i = 1; i <= aNRoots; i++ )
+	{
+		const uint8_t root = dzcobs_fec_alpha( i );
+
+		for( size_t k = i; k > 0; k-- )
+		{
+			aOutGen[k] = aOutGen[k - 1] ^ dzcobs_fec_mul( aOutGen[k], root );
+		}
+
+		aOutGen[0] = dzcobs_fec_mul( aOutGen[0], root );
+	}
+}
+
+// COBS stuffing of aSize bytes to aSize + 1 bytes. It can work in place when
+// aSrc == aDst + 1.
+static void dzcobs_fec_stuff( const uint8_t *aSrc, uint8_t *aDst, size_t aSize )
+{
+	size_t codeIdx = 0;
+	uint8_t code	 = 1;
+
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		const uint8_t value = aSrc[i];
+
+		if( value == 0 )
+		{
+			aDst[codeIdx] = code;
+			codeIdx				= i + 1;
+			code					= 1;
+		}
+		else
+		{
+			aDst[i + 1] = value;
+			code++;
+		}
+	}
+
+	aDst[codeIdx] = code;
+}
+
+// Reverse of dzcobs_fec_stuff. A damaged code only changes a few bytes of the
+// output, that are then corrected as parity errors.
+static void dzcobs_fec_unstuff( const uint8_t *aSrc, uint8_t *aDst, size_t aSize )
+{
+	size_t nextCodeIdx = aSrc[0];
+
+	for( size_t i = 1; i <= aSize; i++ )
+	{
+		if( i == nextCodeIdx )
+		{
+			aDst[i - 1] = 0;
+			nextCodeIdx += aSrc[i];
+		}
+		else
+		{
+			aDst[i - 1] = aSrc[i];
+		}
+	}
+}
+
+void dzcobs_fec_encode( uint8_t aT, uint8_t *aBuf, size_t aDataLen )
+{
+	DZCOBS_ASSERT( ( aT >= 1 ) && ( aT <= DZCOBS_FEC_MAX_T ) );
+	DZCOBS_ASSERT( aBuf != NULL );
+	DZCOBS_ASSERT( aDataLen > 0 );
+
+	const size_t nRoots			 = 2 * (size_t)aT;
+	const size_t dataPerBlock = DZCOBS_FEC_NN - nRoots;
+	const size_t nBlocks			 = ( aDataLen + dataPerBlock - 1 ) / dataPerBlock;
+
+	uint8_t generator[DZCOBS_FEC_MAX_ROOTS + 1];
+	dzcobs_fec_generator( nRoots, generator );
+
+	// The LFSR of each codeword is kept on its parity slot, after the COBS code
+	uint8_t *pParity = aBuf + aDataLen;
+
+	memset( pParity, 0, nBlocks * ( nRoots + 1 ) );
+
+	size_t block = 0;
+
+	for( size_t i = 0; i < aDataLen; i++ )
+	{
+		uint8_t *pReg = pParity + ( block * ( nRoots + 1 ) ) + 1;
+
+		const uint8_t feedback = aBuf[i] ^ pReg[0];
+
+		if( feedback != 0 )
+		{
+			const size_t feedbackLog = s_gfLog[feedback];
+
+			for( size_t j = 0; j < ( nRoots - 1 ); j++ )
+			{
+				const uint8_t coef = generator[nRoots - 1 - j];
+				pReg[j]						 = pReg[j + 1] ^ ( ( coef != 0 ) ? s_gfExp[feedbackLog + s_gfLog[coef]] : 0 );
+			}
+
+			pReg[nRoots - 1] = s_gfExp[feedbackLog + s_gfLog[generator[0]]];
+		}
+		else
+		{
+			memmove( pReg, pReg + 1, nRoots - 1 );
+			pReg[nRoots - 1] = 0;
+		}
+
+		if( ++block == nBlocks )
+		{
+			block = 0;
+		}
+	}
+
+	for( block = 0; block < nBlocks; block++ )
+	{
+		uint8_t *pSlot = pParity + ( block * ( nRoots + 1 ) );
+		dzcobs_fec_stuff( pSlot + 1, pSlot, nRoots );
+	}
+}
+
+size_t dzcobs_fec_data_size( size_t aLen, uint8_t aT )
+{
+	if( ( aT < 1 ) || ( aT > DZCOBS_FEC_MAX_T ) )
+	{
+		return 0;
+	}
+
+	const size_t nRoots			 = 2 * (size_t)aT;
+	const size_t dataPerBlock = DZCOBS_FEC_NN - nRoots;
+	const size_t nBlocks			 = ( aLen + DZCOBS_FEC_BLOCK_SIZE - 1 ) / DZCOBS_FEC_BLOCK_SIZE;
+	const size_t parityLen		 = nBlocks * ( nRoots + 1 );
+
+	if( aLen <= parityLen )
+	{
+		return 0;
+	}
+
+	const size_t dataLen = aLen - parityLen;
+
+	// The parity size must match the one used by the encoder for dataLen
+	if( ( ( dataLen + dataPerBlock - 1 ) / dataPerBlock ) != nBlocks )
+	{
+		return 0;
+	}
+
+	return dataLen;
+}
+
+/**
+ * @brief Correct one interleaved codeword
+ *
+ * @param aData First data symbol of the codeword
+ * @param aStride Distance between the data symbols
+ * @param aNData Number of data symbols
+ * @param aParity Unstuffed parity symbols, they are also corrected
+ * @param aNRoots Number of parity symbols
+ * @return int Number of corrected symbols, -1 if it could not be corrected
+ */
+static int dzcobs_fec_decode_block(
+	uint8_t *aData, size_t aStride, size_t aNData, uint8_t *aParity, size_t aNRoots )
+{
+	const size_t n = aNData + aNRoots;
+
+	// Syndromes S[m] = c(alpha^(m + 1)), by Horner's rule
+	uint8_t syndromes[DZCOBS_FEC_MAX_ROOTS];
+	memset( syndromes, 0, aNRoots );
+
+	for( size_t j = 0; j < n; j++ )
+	{
+		const uint8_t symbol = ( j < aNData ) ? aData[j * aStride] : aParity[j - aNData];
+
+		for( size_t m = 0; m < aNRoots; m++ )
+		{
+			syndromes[m] = dzcobs_fec_mul( syndromes[m], dzcobs_fec_alpha( m + 1 ) ) ^ symbol;
+		}
+	}
+
+	bool hasError = false;
+
+	for( size_t m = 0; m < aNRoots; m++ )
+	{
+		hasError = hasError || ( syndromes[m] != 0 );
+	}
+
+	if( !hasError )
+	{
+		return 0;
+	}
+
+	// Berlekamp-Massey, error locator lambda(x)
+	uint8_t lambda[DZCOBS_FEC_MAX_ROOTS + 1];
+	uint8_t prev[DZCOBS_FEC_MAX_ROOTS + 1];
+	uint8_t tmp[DZCOBS_FEC_MAX_ROOTS + 1];
+
+	memset( lambda, 0, sizeof( lambda ) );
+	memset( prev, 0, sizeof( prev ) );
+	lambda[0] = 1;
+	prev[0]		= 1;
+
+	size_t nErrors			= 0;
+	size_t shift				= 1;
+	uint8_t prevDiscrep = 1;
+
+	for( size_t r = 0; r < aNRoots; r++ )
+	{
+		uint8_t discrepancy = syndromes[r];
+
+		for( size_t i = 1; i <= nErrors; i++ )
+		{
+			discrepancy ^= dzcobs_fec_mul( lambda[i], syndromes[r - i] );
+		}
+
+		if( discrepancy == 0 )
+		{
+			shift++;
+			continue;
+		}
+
+		const uint8_t scale = dzcobs_fec_div( discrepancy, prevDiscrep );
+
+		memcpy( tmp, lambda, sizeof( lambda ) );
+
+		for( size_t i = shift; i <= aNRoots; i++ )
+		{
+			lambda[i] ^= dzcobs_fec_mul( scale, prev[i - shift] );
+		}
+
+		if( ( 2 * nErrors ) <= r )
+		{
+			nErrors			= r + 1 - nErrors;
+			prevDiscrep = discrepancy;
+			memcpy( prev, tmp, sizeof( prev ) );
+			shift = 1;
+		}
+		else
+		{
+			shift++;
+		}
+	}
+
+	if( ( 2 * nErrors ) > aNRoots )
+	{
+		return -1;
+	}
+
+	// Error evaluator omega(x) = S(x) * lambda(x) mod x^nRoots
+	uint8_t omega[DZCOBS_FEC_MAX_ROOTS];
+
+	for( size_t k = 0; k < aNRoots; k++ )
+	{
+		uint8_t value = 0;
+
+		for( size_t i = 0; ( i <= k ) && ( i <= nErrors ); i++ )
+		{
+			value ^= dzcobs_fec_mul( lambda[i], syndromes[k - i] );
+		}
+
+		omega[k] = value;
+	}
+
+	// Chien search on the positions of the shortened codeword, then Forney
+	size_t nFound = 0;
+	size_t positions[DZCOBS_FEC_MAX_T];
+	uint8_t magnitudes[DZCOBS_FEC_MAX_T];
+
+	for( size_t j = 0; j < n; j++ )
+	{
+		// Position j has the locator X = alpha^(n - 1 - j), evaluate at X^-1
+		const size_t invLog = ( DZCOBS_FEC_NN - ( ( n - 1 - j ) % DZCOBS_FEC_NN ) ) % DZCOBS_FEC_NN;
+
+		uint8_t lambdaValue = 0;
+		uint8_t derivative	= 0;
+
+		for( size_t i = 0; i <= nErrors; i++ )
+		{
+			const uint8_t term = dzcobs_fec_mul( lambda[i], dzcobs_fec_alpha( invLog * i ) );
+			lambdaValue ^= term;
+
+			// Formal derivative, only odd powers remain: lambda_i * x^(i - 1)
+			if( i & 1 )
+			{
+				derivative ^= dzcobs_fec_mul( lambda[i], dzcobs_fec_alpha( invLog * ( i - 1 ) ) );
+			}
+		}
+
+		if( lambdaValue != 0 )
+		{
+			continue;
+		}
+
+		if( ( nFound == nErrors ) || ( derivative == 0 ) )
+		{
+			return -1;
+		}
+
+		uint8_t omegaValue = 0;
+
+		for( size_t k = 0; k < aNRoots; k++ )
+		{
+			omegaValue ^= dzcobs_fec_mul( omega[k], dzcobs_fec_alpha( invLog * k ) );
+		}
+
+		positions[nFound]	 = j;
+		magnitudes[nFound] = dzcobs_fec_div( omegaValue, derivative );
+		nFound++;
+	}
+
+	if( nFound != nErrors )
+	{
+		return -1;
+	}
+
+	for( size_t e = 0; e < nFound; e++ )
+	{
+		const size_t j = positions[e];
+
+		if( j < aNData )
+		{
+			aData[j * aStride] ^= magnitudes[e];
+		}
+		else
+		{
+			aParity[j - aNData] ^= magnitudes[e];
+		}
+	}
+
+	return (int)nFound;
+}
+
+eDZCOBS_ret dzcobs_fec_repair( uint8_t *aFrame, size_t aFrameLen, size_t *aOutCorrected )
+{
+	if( !aFrame )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( aOutCorrected )
+	{
+		*aOutCorrected = 0;
+	}
+
+	// [parity][FEC descriptor][extension][encoding][hash8]
+	const size_t fecTailSize = DZCOBS_FRAME_HEADER_SIZE + DZCOBS_FRAME_EXTENSION_SIZE + DZCOBS_FRAME_FEC_SIZE;
+
+	if( ( aFrameLen < DZCOBS_FRAME_HEADER_SIZE ) || ( ( aFrame[aFrameLen - 2] & 0x03 ) != DZCOBS_RESERVED ) ||
+			( aFrameLen < fecTailSize ) || ( ( aFrame[aFrameLen - 3] & DZCOBS_EXT_FEC ) == 0 ) )
+	{
+		// Nothing to repair
+		return DZCOBS_RET_SUCCESS;
+	}
+
+	const uint8_t fecDescriptor = aFrame[aFrameLen - fecTailSize];
+	const uint8_t t							= fecDescriptor & DZCOBS_FEC_DESC_T_MASK;
+
+	if( ( ( fecDescriptor & DZCOBS_FEC_DESC_MARKER ) == 0 ) || ( ( fecDescriptor & DZCOBS_FEC_DESC_RESERVED_MASK ) != 0 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	const size_t protectedLen = aFrameLen - fecTailSize;
+	const size_t dataLen			= dzcobs_fec_data_size( protectedLen, t );
+
+	if( dataLen == 0 )
+	{
+		return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	const size_t nRoots	 = 2 * (size_t)t;
+	const size_t nBlocks = ( protectedLen - dataLen ) / ( nRoots + 1 );
+
+	eDZCOBS_ret ret		 = DZCOBS_RET_SUCCESS;
+	size_t nCorrected = 0;
+
+	for( size_t block = 0; block < nBlocks; block++ )
+	{
+		uint8_t *pSlot = aFrame + dataLen + ( block * ( nRoots + 1 ) );
+
+		uint8_t parity[DZCOBS_FEC_MAX_ROOTS];
+		dzcobs_fec_unstuff( pSlot, parity, nRoots );
+
+		const size_t nData = ( ( dataLen - block ) + nBlocks - 1 ) / nBlocks;
+
+		const int corrected = dzcobs_fec_decode_block( aFrame + block, nBlocks, nData, parity, nRoots );
+
+		if( corrected < 0 )
+		{
+			ret = DZCOBS_RET_ERR_FEC_UNCORRECTABLE;
+			continue;
+		}
+
+		// Restore the parity as it was sent, so the hash matches again. This also
+		// fixes a damaged last code, that does not change the unstuffed parity.
+		dzcobs_fec_stuff( parity, pSlot, nRoots );
+		nCorrected += (size_t)corrected;
+	}
+
+	if( aOutCorrected )
+	{
+		*aOutCorrected = nCorrected;
+	}
+
+	return ret;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
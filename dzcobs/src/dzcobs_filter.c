@@ -0,0 +1,503 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_filter.c
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_filter.h>
+#include <string.h>
+#include "dzcobs_assert.h"
+#include "dzcobs_simd.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Number of elements processed on each SIMD step of the shuffle
+#define DZCOBS_FILTER_SIMD_ELEMENTS ( 16 )
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+// Elements are handled as little-endian integers, so that the output does not
+// depend on the platform endianness.
+
+static uint64_t dzcobs_filter_load_le( const uint8_t *aSrc, size_t aElementSize )
+{
+	uint64_t value = 0;
+
+	for( size_t i = aElementSize; i != 0; i-- )
+	{
+		value = ( value << 8 ) | aSrc[i - 1];
+	}
+
+	return value;
+}
+
+static void dzcobs_filter_store_le( uint8_t *aDst, uint64_t aValue, size_t aElementSize )
+{
+	for( size_t i = 0; i < aElementSize; i++ )
+	{
+		aDst[i] = (uint8_t)aValue;
+		aValue >>= 8;
+	}
+}
+
+static void dzcobs_filter_delta_encode( const uint8_t *aSrc, uint8_t *aDst, size_t aElementSize, size_t aNElements )
+{
+	DZCOBS_ASSERT( aNElements > 0 );
+
+	const size_t dataSize = aElementSize * aNElements;
+
+	// The first element is kept
+	memcpy( aDst, aSrc, aElementSize );
+
+	size_t offset = aElementSize;
+
+#if DZCOBS_HAS_SSE2 == 1
+	for( ; ( offset + sizeof( __m128i ) ) <= dataSize; offset += sizeof( __m128i ) )
+	{
+		const __m128i cur	 = _mm_loadu_si128( (const __m128i *)( aSrc + offset ) );
+		const __m128i prev = _mm_loadu_si128( (const __m128i *)( aSrc + offset - aElementSize ) );
+		__m128i delta;
+
+		switch( aElementSize )
+		{
+		case 1:
+			delta = _mm_sub_epi8( cur, prev );
+			break;
+		case 2:
+			delta = _mm_sub_epi16( cur, prev );
+			break;
+		case 4:
+			delta = _mm_sub_epi32( cur, prev );
+			break;
+		default:
+			delta = _mm_sub_epi64( cur, prev );
+			break;
+		}
+
+		_mm_storeu_si128( (__m128i *)( aDst + offset ), delta );
+	}
+#endif
+
+	for( ; offset < dataSize; offset += aElementSize )
+	{
+		const uint64_t cur	= dzcobs_filter_load_le( aSrc + offset, aElementSize );
+		const uint64_t prev = dzcobs_filter_load_le( aSrc + offset - aElementSize, aElementSize );
+
+		dzcobs_filter_store_le( aDst + offset, cur - prev, aElementSize );
+	}
+}
+
+#if DZCOBS_HAS_SSE2 == 1
+static __m128i dzcobs_filter_prefix_sum( __m128i aValue, size_t aElementSize )
+{
+	switch( aElementSize )
+	{
+	case 1:
+		aValue = _mm_add_epi8( aValue, _mm_slli_si128( aValue, 1 ) );
+		aValue = _mm_add_epi8( aValue, _mm_slli_si128( aValue, 2 ) );
+		aValue = _mm_add_epi8( aValue, _mm_slli_si128( aValue, 4 ) );
+		aValue = _mm_add_epi8( aValue, _mm_slli_si128( aValue, 8 ) );
+		break;
+	case 2:
+		aValue = _mm_add_epi16( aValue, _mm_slli_si128( aValue, 2 ) );
+		aValue = _mm_add_epi16( aValue, _mm_slli_si128( aValue, 4 ) );
+		aValue = _mm_add_epi16( aValue, _mm_slli_si128( aValue, 8 ) );
+		break;
+	case 4:
+		aValue = _mm_add_epi32( aValue, _mm_slli_si128( aValue, 4 ) );
+		aValue = _mm_add_epi32( aValue, _mm_slli_si128( aValue, 8 ) );
+		break;
+	default:
+		aValue = _mm_add_epi64( aValue, _mm_slli_si128( aValue, 8 ) );
+		break;
+	}
+
+	return aValue;
+}
+
+static __m128i dzcobs_filter_broadcast( uint64_t aValue, size_t aElementSize )
+{
+	switch( aElementSize )
+	{
+	case 1:
+		return _mm_set1_epi8( (char)aValue );
+	case 2:
+		return _mm_set1_epi16( (short)aValue );
+	case 4:
+		return _mm_set1_epi32( (int)aValue );
+	default:
+		return _mm_set1_epi64x( (long long)aValue );
+	}
+}
+
+static __m128i dzcobs_filter_broadcast_last( __m128i aValue, size_t aElementSize )
+{
+	switch( aElementSize )
+	{
+	case 1:
+		aValue = _mm_srli_si128( aValue, 15 );
+		aValue = _mm_unpacklo_epi8( aValue, aValue );
+		aValue = _mm_unpacklo_epi16( aValue, aValue );
+		return _mm_shuffle_epi32( aValue, 0x00 );
+	case 2:
+		aValue = _mm_srli_si128( aValue, 14 );
+		aValue = _mm_unpacklo_epi16( aValue, aValue );
+		return _mm_shuffle_epi32( aValue, 0x00 );
+	case 4:
+		return _mm_shuffle_epi32( aValue, 0xFF );
+	default:
+		return _mm_unpackhi_epi64( aValue, aValue );
+	}
+}
+
+static __m128i dzcobs_filter_add( __m128i aA, __m128i aB, size_t aElementSize )
+{
+	switch( aElementSize )
+	{
+	case 1:
+		return _mm_add_epi8( aA, aB );
+	case 2:
+		return _mm_add_epi16( aA, aB );
+	case 4:
+		return _mm_add_epi32( aA, aB );
+	default:
+		return _mm_add_epi64( aA, aB );
+	}
+}
+#endif
+
+/// Revert the delta. aSrc and aDst may be the same buffer.
+static void dzcobs_filter_delta_decode( const uint8_t *aSrc, uint8_t *aDst, size_t aElementSize, size_t aNElements )
+{
+	DZCOBS_ASSERT( aNElements > 0 );
+
+	const size_t dataSize = aElementSize * aNElements;
+
+	if( aSrc != aDst )
+	{
+		memcpy( aDst, aSrc, aElementSize );
+	}
+
+	size_t offset = aElementSize;
+
+#if DZCOBS_HAS_SSE2 == 1
+	if( ( offset + sizeof( __m128i ) ) <= dataSize )
+	{
+		// Carry is the last decoded element, broadcasted to all lanes
+		__m128i carry = dzcobs_filter_broadcast( dzcobs_filter_load_le( aDst, aElementSize ), aElementSize );
+
+		for( ; ( offset + sizeof( __m128i ) ) <= dataSize; offset += sizeof( __m128i ) )
+		{
+			__m128i value = _mm_loadu_si128( (const __m128i *)( aSrc + offset ) );
+
+			value = dzcobs_filter_add( dzcobs_filter_prefix_sum( value, aElementSize ), carry, aElementSize );
+
+			_mm_storeu_si128( (__m128i *)( aDst + offset ), value );
+
+			carry = dzcobs_filter_broadcast_last( value, aElementSize );
+		}
+	}
+#endif
+
+	for( ; offset < dataSize; offset += aElementSize )
+	{
+		const uint64_t delta = dzcobs_filter_load_le( aSrc + offset, aElementSize );
+		const uint64_t prev	 = dzcobs_filter_load_le( aDst + offset - aElementSize, aElementSize );
+
+		dzcobs_filter_store_le( aDst + offset, prev + delta, aElementSize );
+	}
+}
+
+#if DZCOBS_HAS_SSE2 == 1
+// Splits the 32 bytes of aA:aB in the even and odd bytes
+static void dzcobs_filter_deinterleave( __m128i aA, __m128i aB, __m128i *aOutEven, __m128i *aOutOdd )
+{
+	const __m128i lowMask = _mm_set1_epi16( 0x00FF );
+
+	*aOutEven = _mm_packus_epi16( _mm_and_si128( aA, lowMask ), _mm_and_si128( aB, lowMask ) );
+	*aOutOdd	= _mm_packus_epi16( _mm_srli_epi16( aA, 8 ), _mm_srli_epi16( aB, 8 ) );
+}
+#endif
+
+static void dzcobs_filter_shuffle( const uint8_t *aSrc, uint8_t *aDst, size_t aElementSize, size_t aNElements )
+{
+	size_t element = 0;
+
+#if DZCOBS_HAS_SSE2 == 1
+	if( aElementSize > 1 )
+	{
+		for( ; ( element + DZCOBS_FILTER_SIMD_ELEMENTS ) <= aNElements; element += DZCOBS_FILTER_SIMD_ELEMENTS )
+		{
+			__m128i v[DZCOBS_FILTER_MAX_ELEMENT_SIZE];
+			__m128i tmp[DZCOBS_FILTER_MAX_ELEMENT_SIZE];
+
+			const uint8_t *pSrc = aSrc + ( element * aElementSize );
+
+			for( size_t i = 0; i < aElementSize; i++ )
+			{
+				v[i] = _mm_loadu_si128( (const __m128i *)( pSrc + ( i * sizeof( __m128i ) ) ) );
+			}
+
+			// Each round splits every stream in its even and odd bytes.
+			// After log2(aElementSize) rounds v[p] holds the byte plane p.
+			for( size_t round = aElementSize; round > 1; round >>= 1 )
+			{
+				const size_t half = aElementSize / 2;
+
+				for( size_t j = 0; j < half; j++ )
+				{
+					dzcobs_filter_deinterleave( v[2 * j], v[( 2 * j ) + 1], &tmp[j], &tmp[j + half] );
+				}
+
+				memcpy( v, tmp, sizeof( __m128i ) * aElementSize );
+			}
+
+			for( size_t plane = 0; plane < aElementSize; plane++ )
+			{
+				_mm_storeu_si128( (__m128i *)( aDst + ( plane * aNElements ) + element ), v[plane] );
+			}
+		}
+	}
+#endif
+
+	for( ; element < aNElements; element++ )
+	{
+		for( size_t plane = 0; plane < aElementSize; plane++ )
+		{
+			aDst[( plane * aNElements ) + element] = aSrc[( element * aElementSize ) + plane];
+		}
+	}
+}
+
+static void dzcobs_filter_unshuffle( const uint8_t *aSrc, uint8_t *aDst, size_t aElementSize, size_t aNElements )
+{
+	size_t element = 0;
+
+#if DZCOBS_HAS_SSE2 == 1
+	if( aElementSize > 1 )
+	{
+		for( ; ( element + DZCOBS_FILTER_SIMD_ELEMENTS ) <= aNElements; element += DZCOBS_FILTER_SIMD_ELEMENTS )
+		{
+			__m128i v[DZCOBS_FILTER_MAX_ELEMENT_SIZE];
+			__m128i tmp[DZCOBS_FILTER_MAX_ELEMENT_SIZE];
+
+			for( size_t plane = 0; plane < aElementSize; plane++ )
+			{
+				v[plane] = _mm_loadu_si128( (const __m128i *)( aSrc + ( plane * aNElements ) + element ) );
+			}
+
+			// Inverse of the shuffle rounds: interleave the even and odd streams
+			for( size_t round = aElementSize; round > 1; round >>= 1 )
+			{
+				const size_t half = aElementSize / 2;
+
+				for( size_t j = 0; j < half; j++ )
+				{
+					tmp[2 * j]				 = _mm_unpacklo_epi8( v[j], v[j + half] );
+					tmp[( 2 * j ) + 1] = _mm_unpackhi_epi8( v[j], v[j + half] );
+				}
+
+				memcpy( v, tmp, sizeof( __m128i ) * aElementSize );
+			}
+
+			uint8_t *pDst = aDst + ( element * aElementSize );
+
+			for( size_t i = 0; i < aElementSize; i++ )
+			{
+				_mm_storeu_si128( (__m128i *)( pDst + ( i * sizeof( __m128i ) ) ), v[i] );
+			}
+		}
+	}
+#endif
+
+	for( ; element < aNElements; element++ )
+	{
+		for( size_t plane = 0; plane < aElementSize; plane++ )
+		{
+			aDst[( element * aElementSize ) + plane] = aSrc[( plane * aNElements ) + element];
+		}
+	}
+}
+
+static void dzcobs_filter_encode_block( uint8_t aDescriptor, const uint8_t *aSrc, uint8_t *aDst, size_t aSize )
+{
+	DZCOBS_ASSERT( aSize <= DZCOBS_FILTER_BLOCK_SIZE );
+
+	const size_t elementSize = (size_t)1 << ( ( aDescriptor & DZCOBS_FILTER_DESC_WIDTH_MASK ) >>
+																						DZCOBS_FILTER_DESC_WIDTH_SHIFT );
+	const size_t nElements = aSize / elementSize;
+	const size_t dataSize	 = nElements * elementSize;
+
+	if( nElements > 0 )
+	{
+		switch( (eDZCOBS_filter)( aDescriptor & DZCOBS_FILTER_DESC_TYPE_MASK ) )
+		{
+		case DZCOBS_FILTER_DELTA:
+			dzcobs_filter_delta_encode( aSrc, aDst, elementSize, nElements );
+			break;
+
+		case DZCOBS_FILTER_SHUFFLE:
+			dzcobs_filter_shuffle( aSrc, aDst, elementSize, nElements );
+			break;
+
+		case DZCOBS_FILTER_DELTA_SHUFFLE:
+		{
+			uint8_t tmp[DZCOBS_FILTER_BLOCK_SIZE];
+
+			dzcobs_filter_delta_encode( aSrc, tmp, elementSize, nElements );
+			dzcobs_filter_shuffle( tmp, aDst, elementSize, nElements );
+		}
+		break;
+
+		case DZCOBS_FILTER_NONE:
+		default:
+			memcpy( aDst, aSrc, dataSize );
+			break;
+		}
+	}
+
+	// Trailing bytes that do not form an element
+	memcpy( aDst + dataSize, aSrc + dataSize, aSize - dataSize );
+}
+
+static void dzcobs_filter_decode_block( uint8_t aDescriptor, const uint8_t *aSrc, uint8_t *aDst, size_t aSize )
+{
+	DZCOBS_ASSERT( aSize <= DZCOBS_FILTER_BLOCK_SIZE );
+
+	const size_t elementSize = (size_t)1 << ( ( aDescriptor & DZCOBS_FILTER_DESC_WIDTH_MASK ) >>
+																						DZCOBS_FILTER_DESC_WIDTH_SHIFT );
+	const size_t nElements = aSize / elementSize;
+	const size_t dataSize	 = nElements * elementSize;
+
+	if( nElements > 0 )
+	{
+		switch( (eDZCOBS_filter)( aDescriptor & DZCOBS_FILTER_DESC_TYPE_MASK ) )
+		{
+		case DZCOBS_FILTER_DELTA:
+			dzcobs_filter_delta_decode( aSrc, aDst, elementSize, nElements );
+			break;
+
+		case DZCOBS_FILTER_SHUFFLE:
+			dzcobs_filter_unshuffle( aSrc, aDst, elementSize, nElements );
+			break;
+
+		case DZCOBS_FILTER_DELTA_SHUFFLE:
+			dzcobs_filter_unshuffle( aSrc, aDst, elementSize, nElements );
+			dzcobs_filter_delta_decode( aDst, aDst, elementSize, nElements );
+			break;
+
+		case DZCOBS_FILTER_NONE:
+		default:
+			memcpy( aDst, aSrc, dataSize );
+			break;
+		}
+	}
+
+	memcpy( aDst + dataSize, aSrc + dataSize, aSize - dataSize );
+}
+
+uint8_t dzcobs_filter_descriptor( eDZCOBS_filter aFilter, uint8_t aElementSize )
+{
+	uint8_t widthLog2 = 0;
+
+	switch( aElementSize )
+	{
+	case 1:
+		widthLog2 = 0;
+		break;
+	case 2:
+		widthLog2 = 1;
+		break;
+	case 4:
+		widthLog2 = 2;
+		break;
+	case 8:
+		widthLog2 = 3;
+		break;
+	default:
+		return 0;
+	}
+
+	if( ( aFilter == DZCOBS_FILTER_NONE ) || ( (unsigned)aFilter > DZCOBS_FILTER_DESC_TYPE_MASK ) )
+	{
+		return 0;
+	}
+
+	return (uint8_t)( DZCOBS_FILTER_DESC_MARKER | ( widthLog2 << DZCOBS_FILTER_DESC_WIDTH_SHIFT ) | (uint8_t)aFilter );
+}
+
+int dzcobs_filter_descriptor_isvalid( uint8_t aDescriptor )
+{
+	return ( ( aDescriptor & DZCOBS_FILTER_DESC_MARKER ) != 0 ) &&
+				 ( ( aDescriptor & DZCOBS_FILTER_DESC_RESERVED_MASK ) == 0 ) &&
+				 ( ( aDescriptor & DZCOBS_FILTER_DESC_TYPE_MASK ) != DZCOBS_FILTER_NONE );
+}
+
+void dzcobs_filter_encode( uint8_t aDescriptor, const uint8_t *aSrc, uint8_t *aDst, size_t aSize )
+{
+	DZCOBS_ASSERT( dzcobs_filter_descriptor_isvalid( aDescriptor ) );
+	DZCOBS_ASSERT( ( aSrc != NULL ) && ( aDst != NULL ) );
+
+	while( aSize )
+	{
+		const size_t blockSize = ( aSize < DZCOBS_FILTER_BLOCK_SIZE ) ? aSize : DZCOBS_FILTER_BLOCK_SIZE;
+
+		dzcobs_filter_encode_block( aDescriptor, aSrc, aDst, blockSize );
+
+		aSrc += blockSize;
+		aDst += blockSize;
+		aSize -= blockSize;
+	}
+}
+
+void dzcobs_filter_decode( uint8_t aDescriptor, const uint8_t *aSrc, uint8_t *aDst, size_t aSize )
+{
+	DZCOBS_ASSERT( dzcobs_filter_descriptor_isvalid( aDescriptor ) );
+	DZCOBS_ASSERT( ( aSrc != NULL ) && ( aDst != NULL ) );
+
+	while( aSize )
+	{
+		const size_t blockSize = ( aSize < DZCOBS_FILTER_BLOCK_SIZE ) ? aSize : DZCOBS_FILTER_BLOCK_SIZE;
+
+		dzcobs_filter_decode_block( aDescriptor, aSrc, aDst, blockSize );
+
+		aSrc += blockSize;
+		aDst += blockSize;
+		aSize -= blockSize;
+	}
+}
+
+void dzcobs_filter_decode_inplace( uint8_t aDescriptor, uint8_t *aBuf, size_t aSize )
+{
+	DZCOBS_ASSERT( dzcobs_filter_descriptor_isvalid( aDescriptor ) );
+	DZCOBS_ASSERT( aBuf != NULL );
+
+	uint8_t tmp[DZCOBS_FILTER_BLOCK_SIZE];
+
+	while( aSize )
+	{
+		const size_t blockSize = ( aSize < DZCOBS_FILTER_BLOCK_SIZE ) ? aSize : DZCOBS_FILTER_BLOCK_SIZE;
+
+		memcpy( tmp, aBuf, blockSize );
+		dzcobs_filter_decode_block( aDescriptor, tmp, aBuf, blockSize );
+
+		aBuf += blockSize;
+		aSize -= blockSize;
+	}
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,341 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_frag.c
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_frag.h>
+#include <string.h>
+#include "dzcobs_assert.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+eDZCOBS_ret dzcobs_txsched_init( sDZCOBS_txsched *aSched,
+																 eDZCOBS_encoding aEncoding,
+																 const sDICT_ctx *aDict,
+																 size_t aMaxFragmentData )
+{
+	if( ( !aSched ) || ( aMaxFragmentData == 0 ) || ( aEncoding == DZCOBS_RESERVED ) ||
+			( aEncoding == DZCOBS_AUTO ) || ( ( aEncoding != DZCOBS_PLAIN ) && ( aDict == NULL ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	memset( aSched, 0, sizeof( *aSched ) );
+
+	aSched->maxFragmentData = aMaxFragmentData;
+	aSched->encoding				= aEncoding;
+	aSched->pDict						= aDict;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_txsched_submit( sDZCOBS_txsched *aSched,
+																	 sDZCOBS_txmsg *aMsg,
+																	 uint8_t aPriority,
+																	 uint8_t aStreamId,
+																	 uint8_t aUser6bits,
+																	 const uint8_t *aData,
+																	 size_t aSize )
+{
+	if( ( !aSched ) || ( !aMsg ) || ( !aData ) || ( aSize == 0 ) || ( aPriority >= DZCOBS_TXSCHED_N_PRIORITIES ) ||
+			( aStreamId >= DZCOBS_FRAG_N_STREAMS ) || ( aUser6bits == 0 ) || ( aUser6bits > 0x3F ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	const size_t nFragments = ( aSize + aSched->maxFragmentData - 1 ) / aSched->maxFragmentData;
+
+	if( nFragments > DZCOBS_FRAG_MAX_FRAGMENTS )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	aMsg->pData			= aData;
+	aMsg->size			= aSize;
+	aMsg->offset		= 0;
+	aMsg->seq				= 0;
+	aMsg->streamId	= aStreamId;
+	aMsg->user6bits = aUser6bits;
+	aMsg->isDone		= false;
+	aMsg->pNext			= NULL;
+
+	if( aSched->pTail[aPriority] )
+	{
+		aSched->pTail[aPriority]->pNext = aMsg;
+	}
+	else
+	{
+		aSched->pHead[aPriority] = aMsg;
+	}
+
+	aSched->pTail[aPriority] = aMsg;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_txsched_next( sDZCOBS_txsched *aSched,
+																 uint8_t *aDstBuf,
+																 size_t aDstBufSize,
+																 size_t *aOutSizeEncoded )
+{
+	if( ( !aSched ) || ( !aDstBuf ) || ( !aOutSizeEncoded ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	*aOutSizeEncoded = 0;
+
+	size_t priority		= 0;
+	sDZCOBS_txmsg *pMsg = NULL;
+
+	for( ; priority < DZCOBS_TXSCHED_N_PRIORITIES; priority++ )
+	{
+		pMsg = aSched->pHead[priority];
+
+		// A message cannot start while its stream is used by a partial message
+		if( ( pMsg ) && ( ( pMsg->offset != 0 ) || ( ( aSched->streamsInFlight & ( 1U << pMsg->streamId ) ) == 0 ) ) )
+		{
+			break;
+		}
+
+		pMsg = NULL;
+	}
+
+	if( !pMsg )
+	{
+		// Nothing to send
+		return DZCOBS_RET_SUCCESS;
+	}
+
+	const size_t remaining = pMsg->size - pMsg->offset;
+	const size_t dataSize	 = ( remaining < aSched->maxFragmentData ) ? remaining : aSched->maxFragmentData;
+	const bool isLast			 = ( dataSize == remaining );
+
+	if( aDstBufSize < DZCOBS_FRAG_MAX_FRAME_SIZE( dataSize ) )
+	{
+		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+	}
+
+	const uint8_t header[DZCOBS_FRAG_HEADER_SIZE] = { (uint8_t)( pMsg->streamId | ( isLast ? DZCOBS_FRAG_LAST : 0 ) ),
+																									 pMsg->seq };
+
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	if( aSched->encoding != DZCOBS_PLAIN )
+	{
+		dzcobs_encode_set_dictionary( &ctx, aSched->pDict, aSched->encoding );
+	}
+
+	eDZCOBS_ret ret = dzcobs_encode_inc_begin( &ctx, aSched->encoding, aDstBuf, aDstBufSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	ctx.user6bits = pMsg->user6bits;
+
+	ret = dzcobs_encode_inc( &ctx, header, sizeof( header ) );
+
+	if( ret == DZCOBS_RET_SUCCESS )
+	{
+		ret = dzcobs_encode_inc( &ctx, pMsg->pData + pMsg->offset, dataSize );
+	}
+
+	size_t encodedSize = 0;
+
+	if( ret == DZCOBS_RET_SUCCESS )
+	{
+		ret = dzcobs_encode_inc_end( &ctx, &encodedSize );
+	}
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		// The message state is unchanged, the fragment can be tried again
+		return ret;
+	}
+
+	pMsg->offset += dataSize;
+	pMsg->seq++;
+
+	if( isLast )
+	{
+		pMsg->isDone = true;
+
+		aSched->pHead[priority] = pMsg->pNext;
+
+		if( aSched->pHead[priority] == NULL )
+		{
+			aSched->pTail[priority] = NULL;
+		}
+
+		aSched->streamsInFlight &= (uint16_t) ~( 1U << pMsg->streamId );
+	}
+	else
+	{
+		aSched->streamsInFlight |= (uint16_t)( 1U << pMsg->streamId );
+	}
+
+	*aOutSizeEncoded = encodedSize;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+bool dzcobs_txmsg_isdone( const sDZCOBS_txmsg *aMsg )
+{
+	DZCOBS_ASSERT( aMsg != NULL );
+
+	return aMsg->isDone;
+}
+
+eDZCOBS_ret dzcobs_reasm_init( sDZCOBS_reasm *aReasm, uint8_t *aBuf, size_t aBufSize, size_t aNSlots )
+{
+	if( ( !aReasm ) || ( !aBuf ) || ( aNSlots == 0 ) || ( aNSlots > DZCOBS_REASM_MAX_SLOTS ) ||
+			( aBufSize < aNSlots ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	memset( aReasm, 0, sizeof( *aReasm ) );
+
+	aReasm->nSlots	 = aNSlots;
+	aReasm->slotSize = aBufSize / aNSlots;
+
+	for( size_t i = 0; i < aNSlots; i++ )
+	{
+		aReasm->slots[i].pBuf = aBuf + ( i * aReasm->slotSize );
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_reasm_push( sDZCOBS_reasm *aReasm,
+															 const uint8_t *aFragment,
+															 size_t aFragmentLen,
+															 const uint8_t **aOutMsg,
+															 size_t *aOutMsgLen,
+															 uint8_t *aOutStreamId )
+{
+	if( ( !aReasm ) || ( !aFragment ) || ( !aOutMsg ) || ( !aOutMsgLen ) || ( !aOutStreamId ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	*aOutMsg		= NULL;
+	*aOutMsgLen = 0;
+
+	if( ( aFragmentLen < DZCOBS_FRAG_HEADER_SIZE ) || ( ( aFragment[0] & DZCOBS_FRAG_RESERVED_MASK ) != 0 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	const uint8_t streamId = aFragment[0] & DZCOBS_FRAG_STREAM_MASK;
+	const bool isLast			 = ( aFragment[0] & DZCOBS_FRAG_LAST ) != 0;
+	const uint8_t seq			 = aFragment[1];
+	const uint8_t *pData	 = aFragment + DZCOBS_FRAG_HEADER_SIZE;
+	const size_t dataSize	 = aFragmentLen - DZCOBS_FRAG_HEADER_SIZE;
+
+	*aOutStreamId = streamId;
+
+	sDZCOBS_reasmslot *pSlot = NULL;
+
+	for( size_t i = 0; i < aReasm->nSlots; i++ )
+	{
+		if( aReasm->slots[i].isInUse && ( aReasm->slots[i].streamId == streamId ) )
+		{
+			pSlot = &aReasm->slots[i];
+			break;
+		}
+	}
+
+	if( seq == 0 )
+	{
+		// A new message drops an incomplete previous one of the same stream
+		if( pSlot )
+		{
+			pSlot->isInUse = false;
+		}
+
+		if( isLast )
+		{
+			// Single fragment, no need to copy it
+			*aOutMsg		= pData;
+			*aOutMsgLen = dataSize;
+
+			return DZCOBS_RET_SUCCESS;
+		}
+
+		pSlot = NULL;
+
+		for( size_t i = 0; i < aReasm->nSlots; i++ )
+		{
+			if( !aReasm->slots[i].isInUse )
+			{
+				pSlot = &aReasm->slots[i];
+				break;
+			}
+		}
+
+		if( !pSlot )
+		{
+			return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+		}
+
+		pSlot->isInUse	= true;
+		pSlot->streamId = streamId;
+		pSlot->nextSeq	= 0;
+		pSlot->size			= 0;
+	}
+	else if( ( !pSlot ) || ( pSlot->nextSeq != seq ) )
+	{
+		if( pSlot )
+		{
+			pSlot->isInUse = false;
+		}
+
+		return DZCOBS_RET_ERR_BAD_FRAGMENT_SEQUENCE;
+	}
+
+	if( dataSize > ( aReasm->slotSize - pSlot->size ) )
+	{
+		pSlot->isInUse = false;
+
+		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+	}
+
+	memcpy( pSlot->pBuf + pSlot->size, pData, dataSize );
+
+	pSlot->size += dataSize;
+	pSlot->nextSeq++;
+
+	if( isLast )
+	{
+		// The data stays on the slot until it is used again
+		pSlot->isInUse = false;
+
+		*aOutMsg		= pSlot->pBuf;
+		*aOutMsgLen = pSlot->size;
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,271 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_learn.c
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_learn.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dzcobs_assert.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	DZCOBS_LEARN_COUNT_SATURATION = ( 0xFFFF )
+};
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Count of an entry, halved if the running aging did not reach it yet
+static uint16_t dzcobs_learn_count( const sDZCOBS_learn *aCtx, size_t aIdx )
+{
+	const uint16_t count = aCtx->entries[aIdx].count;
+
+	return ( aIdx >= ( DZCOBS_LEARN_N_ENTRIES - aCtx->nAging ) ) ? (uint16_t)( count >> 1 ) : count;
+}
+
+static void dzcobs_learn_add( sDZCOBS_learn *aCtx, const uint8_t *aNgram, uint8_t aSize )
+{
+	// Aging, one entry per n-gram so the cost per byte does not depend on the table size
+	if( aCtx->nAging > 0 )
+	{
+		aCtx->entries[DZCOBS_LEARN_N_ENTRIES - aCtx->nAging].count >>= 1;
+		aCtx->nAging--;
+	}
+
+	// FNV-1a
+	uint32_t hash = 2166136261u ^ aSize;
+
+	for( uint8_t i = 0; i < aSize; i++ )
+	{
+		hash ^= aNgram[i];
+		hash *= 16777619u;
+	}
+
+	const size_t bucketIdx = ( ( hash ^ ( hash >> 16 ) ) & ( DZCOBS_LEARN_N_BUCKETS - 1 ) ) * DZCOBS_LEARN_N_WAYS;
+	size_t minIdx					 = bucketIdx;
+
+	for( size_t idx = bucketIdx; idx < ( bucketIdx + DZCOBS_LEARN_N_WAYS ); idx++ )
+	{
+		const sDZCOBS_learnentry *pEntry = &aCtx->entries[idx];
+
+		if( ( pEntry->count != 0 ) && ( pEntry->size == aSize ) && ( memcmp( pEntry->bytes, aNgram, aSize ) == 0 ) )
+		{
+			minIdx = idx;
+			break;
+		}
+
+		if( dzcobs_learn_count( aCtx, idx ) < dzcobs_learn_count( aCtx, minIdx ) )
+		{
+			minIdx = idx;
+		}
+	}
+
+	sDZCOBS_learnentry *pMin = &aCtx->entries[minIdx];
+
+	if( ( pMin->size != aSize ) || ( memcmp( pMin->bytes, aNgram, aSize ) != 0 ) )
+	{
+		// Space-saving, the new n-gram takes over the lowest count
+		pMin->size = aSize;
+		memcpy( pMin->bytes, aNgram, aSize );
+	}
+
+	if( pMin->count < DZCOBS_LEARN_COUNT_SATURATION )
+	{
+		pMin->count++;
+	}
+
+	// A saturated count stays so until the aging reaches it
+	if( ( pMin->count == DZCOBS_LEARN_COUNT_SATURATION ) && ( aCtx->nAging == 0 ) )
+	{
+		aCtx->nAging = DZCOBS_LEARN_N_ENTRIES;
+	}
+}
+
+eDICT_ret dzcobs_learn_init( sDZCOBS_learn *aCtx )
+{
+	if( !aCtx )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	memset( aCtx, 0, sizeof( sDZCOBS_learn ) );
+
+	return DICT_RET_SUCCESS;
+}
+
+eDICT_ret dzcobs_learn_update( sDZCOBS_learn *aCtx, const uint8_t *aData, size_t aDataSize )
+{
+	if( ( !aCtx ) || ( !aData ) )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	uint8_t *pWindow = aCtx->window;
+
+	while( aDataSize-- )
+	{
+		memmove( pWindow, pWindow + 1, DZCOBS_LEARN_MAX_WORD_SIZE - 1 );
+		pWindow[DZCOBS_LEARN_MAX_WORD_SIZE - 1] = *aData++;
+
+		if( aCtx->windowLen < DZCOBS_LEARN_MAX_WORD_SIZE )
+		{
+			aCtx->windowLen++;
+		}
+
+		for( uint8_t size = DZCOBS_LEARN_MIN_WORD_SIZE; size <= aCtx->windowLen; size++ )
+		{
+			dzcobs_learn_add( aCtx, pWindow + DZCOBS_LEARN_MAX_WORD_SIZE - size, size );
+		}
+	}
+
+	return DICT_RET_SUCCESS;
+}
+
+eDICT_ret dzcobs_learn_payload_end( sDZCOBS_learn *aCtx )
+{
+	if( !aCtx )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	aCtx->windowLen = 0;
+
+	return DICT_RET_SUCCESS;
+}
+
+/// Dictionary order: word size ascending, then bytes ascending
+static int dzcobs_learn_compare( const sDZCOBS_learnentry *aLeft, const sDZCOBS_learnentry *aRight )
+{
+	if( aLeft->size != aRight->size )
+	{
+		return ( aLeft->size < aRight->size ) ? -1 : 1;
+	}
+
+	return memcmp( aLeft->bytes, aRight->bytes, aLeft->size );
+}
+
+eDICT_ret dzcobs_learn_build( const sDZCOBS_learn *aCtx, char *aOutDict, size_t aOutDictSize, size_t *aOutDictLen )
+{
+	if( ( !aCtx ) || ( !aOutDict ) || ( !aOutDictLen ) )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	uint16_t picked[DZCOBS_LEARN_MAX_WORDS];
+	uint8_t isVisited[( DZCOBS_LEARN_N_ENTRIES + 7 ) / 8];
+	size_t nPicked = 0;
+
+	memset( isVisited, 0, sizeof( isVisited ) );
+
+	// Pick by estimated gain, each match replaces the word by one code byte
+	while( nPicked < DZCOBS_LEARN_MAX_WORDS )
+	{
+		size_t bestIdx	= DZCOBS_LEARN_N_ENTRIES;
+		uint32_t bestGain = 0;
+
+		for( size_t i = 0; i < DZCOBS_LEARN_N_ENTRIES; i++ )
+		{
+			const uint16_t count = dzcobs_learn_count( aCtx, i );
+			const uint32_t gain	 = (uint32_t)count * (uint32_t)( aCtx->entries[i].size - 1 );
+
+			if( ( ( isVisited[i / 8] & ( 1 << ( i % 8 ) ) ) == 0 ) && ( count >= DZCOBS_LEARN_MIN_COUNT ) &&
+					( gain > bestGain ) )
+			{
+				bestIdx	= i;
+				bestGain = gain;
+			}
+		}
+
+		if( bestIdx == DZCOBS_LEARN_N_ENTRIES )
+		{
+			break;
+		}
+
+		isVisited[bestIdx / 8] |= (uint8_t)( 1 << ( bestIdx % 8 ) );
+
+		const sDZCOBS_learnentry *pBest = &aCtx->entries[bestIdx];
+
+		// Shorter words are searched first, so a word with a picked shorter word as
+		// its prefix is never matched, and a prefix of a picked word shadows it
+		bool isShadowed = false;
+
+		for( size_t i = 0; ( i < nPicked ) && ( !isShadowed ); i++ )
+		{
+			const sDZCOBS_learnentry *pPicked = &aCtx->entries[picked[i]];
+			const uint8_t minSize							= ( pPicked->size < pBest->size ) ? pPicked->size : pBest->size;
+
+			isShadowed = ( memcmp( pPicked->bytes, pBest->bytes, minSize ) == 0 );
+		}
+
+		if( !isShadowed )
+		{
+			picked[nPicked++] = (uint16_t)bestIdx;
+		}
+	}
+
+	if( nPicked == 0 )
+	{
+		return DICT_RET_ERR_INVALID;
+	}
+
+	// Dictionary order, insertion sort
+	size_t dictLen = 1;
+
+	for( size_t i = 0; i < nPicked; i++ )
+	{
+		const uint16_t idx = picked[i];
+		size_t j					 = i;
+
+		while( ( j > 0 ) && ( dzcobs_learn_compare( &aCtx->entries[picked[j - 1]], &aCtx->entries[idx] ) > 0 ) )
+		{
+			picked[j] = picked[j - 1];
+			j--;
+		}
+
+		picked[j] = idx;
+		dictLen += (size_t)aCtx->entries[idx].size + 1;
+	}
+
+	if( aOutDictSize < dictLen )
+	{
+		return DICT_RET_ERR_BAD_ARG;
+	}
+
+	char *pDict = aOutDict;
+
+	for( size_t i = 0; i < nPicked; i++ )
+	{
+		const sDZCOBS_learnentry *pEntry = &aCtx->entries[picked[i]];
+
+		*pDict++ = (char)( '0' + pEntry->size );
+		memcpy( pDict, pEntry->bytes, pEntry->size );
+		pDict += pEntry->size;
+	}
+
+	*pDict = 0;
+
+	*aOutDictLen = dictLen;
+
+	DZCOBS_ASSERT( dzcobs_dictionary_isvalid( aOutDict, dictLen ) == DICT_IS_VALID );
+
+	return DICT_RET_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,341 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_registry.c
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_crc.h>
+#include <dzcobs/dzcobs_registry.h>
+#include <stdbool.h>
+#include "dzcobs_assert.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// An entry is claimed by setting its pDict, then it is published by setting its
+// id (release), so a reader that finds the id (acquire) also sees its pDict.
+// A claimed entry without id yet is skipped, only a free entry ends a search.
+#if !defined( __STDC_NO_ATOMICS__ )
+#define DZCOBS_REG_LOAD( pObj, order ) atomic_load_explicit( ( pObj ), memory_order_##order )
+#define DZCOBS_REG_STORE( pObj, value, order ) atomic_store_explicit( ( pObj ), ( value ), memory_order_##order )
+#define DZCOBS_REG_CLAIM( pObj, pExpected, value ) \
+	atomic_compare_exchange_strong_explicit(         \
+		( pObj ), ( pExpected ), ( value ), memory_order_acq_rel, memory_order_acquire )
+#else
+#define DZCOBS_REG_LOAD( pObj, order ) ( *( pObj ) )
+#define DZCOBS_REG_STORE( pObj, value, order ) ( *( pObj ) = ( value ) )
+#define DZCOBS_REG_CLAIM( pObj, pExpected, value ) \
+	( ( *( pObj ) == *( pExpected ) ) ? ( ( *( pObj ) = ( value ) ), true ) : ( ( *( pExpected ) = *( pObj ) ), false ) )
+#endif
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static void dzcobs_registry_put_id( uint8_t *aOut, uint32_t aId )
+{
+	aOut[0] = (uint8_t)( aId );
+	aOut[1] = (uint8_t)( aId >> 8 );
+	aOut[2] = (uint8_t)( aId >> 16 );
+	aOut[3] = (uint8_t)( aId >> 24 );
+}
+
+static uint32_t dzcobs_registry_get_id( const uint8_t *aIn )
+{
+	return (uint32_t)aIn[0] | ( (uint32_t)aIn[1] << 8 ) | ( (uint32_t)aIn[2] << 16 ) | ( (uint32_t)aIn[3] << 24 );
+}
+
+/// Bind the connection slots to the ids, all the ids must be found
+static eDZCOBS_ret dzcobs_registry_bind( const sDZCOBS_registry *aRegistry,
+																				 const uint32_t *aIds,
+																				 sDZCOBS_connection *aConn )
+{
+	const sDICT_ctx *pDict[DZCOBS_DICT_N];
+
+	for( size_t i = 0; i < DZCOBS_DICT_N; i++ )
+	{
+		pDict[i] = NULL;
+
+		if( aIds[i] != 0 )
+		{
+			pDict[i] = dzcobs_registry_find( aRegistry, aIds[i] );
+
+			if( pDict[i] == NULL )
+			{
+				return DZCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE;
+			}
+		}
+	}
+
+	for( size_t i = 0; i < DZCOBS_DICT_N; i++ )
+	{
+		aConn->dictId[i] = aIds[i];
+		aConn->pDict[i]	 = pDict[i];
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+uint32_t dzcobs_registry_id( const sDICT_ctx *aDict )
+{
+	if( ( !aDict ) || ( aDict->wordSizeTable[0].nEntries == 0 ) )
+	{
+		return 0;
+	}
+
+	// The groups are consecutive on the dictionary string, so this is the CRC of its words
+	uint32_t crc = 0;
+
+	for( size_t i = 0; ( i < DICT_MAX_DIFFERENTWORDSIZES ) && ( aDict->wordSizeTable[i].nEntries > 0 ); i++ )
+	{
+		const sDICT_wordentry *pEntry = &aDict->wordSizeTable[i];
+
+		crc = dzcobs_crc32c( crc, pEntry->dictionaryBegin, (size_t)pEntry->nEntries * pEntry->strideSize );
+	}
+
+	return ( crc != 0 ) ? crc : 1;
+}
+
+eDZCOBS_ret dzcobs_registry_init( sDZCOBS_registry *aRegistry, sDZCOBS_registry_entry *aEntries, size_t aNEntries )
+{
+	if( ( !aRegistry ) || ( !aEntries ) || ( aNEntries == 0 ) || ( ( aNEntries & ( aNEntries - 1 ) ) != 0 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	for( size_t i = 0; i < aNEntries; i++ )
+	{
+		DZCOBS_REG_STORE( &aEntries[i].id, 0, relaxed );
+		DZCOBS_REG_STORE( &aEntries[i].pDict, NULL, relaxed );
+	}
+
+	aRegistry->pEntries = aEntries;
+	aRegistry->mask			= aNEntries - 1;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_registry_add( sDZCOBS_registry *aRegistry, const sDICT_ctx *aDict, uint32_t *aOutId )
+{
+	const uint32_t id = dzcobs_registry_id( aDict );
+
+	if( ( !aRegistry ) || ( !aRegistry->pEntries ) || ( id == 0 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( aOutId )
+	{
+		*aOutId = id;
+	}
+
+	for( size_t n = 0; n <= aRegistry->mask; n++ )
+	{
+		sDZCOBS_registry_entry *pEntry = &aRegistry->pEntries[( id + n ) & aRegistry->mask];
+
+		const sDICT_ctx *pExpected = NULL;
+
+		if( DZCOBS_REG_CLAIM( &pEntry->pDict, &pExpected, aDict ) )
+		{
+			DZCOBS_REG_STORE( &pEntry->id, id, release );
+
+			return DZCOBS_RET_SUCCESS;
+		}
+
+		// Claimed by another one. If it is the same dictionary still being added,
+		// its id is published here too (same value), so it is added only once and
+		// found as soon as this returns.
+		if( ( DZCOBS_REG_LOAD( &pEntry->id, acquire ) == id ) || ( pExpected == aDict ) ||
+				( dzcobs_registry_id( pExpected ) == id ) )
+		{
+			DZCOBS_REG_STORE( &pEntry->id, id, release );
+
+			return DZCOBS_RET_SUCCESS;
+		}
+	}
+
+	return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+}
+
+const sDICT_ctx *dzcobs_registry_find( const sDZCOBS_registry *aRegistry, uint32_t aId )
+{
+	if( ( !aRegistry ) || ( !aRegistry->pEntries ) || ( aId == 0 ) )
+	{
+		return NULL;
+	}
+
+	for( size_t n = 0; n <= aRegistry->mask; n++ )
+	{
+		sDZCOBS_registry_entry *pEntry = &aRegistry->pEntries[( aId + n ) & aRegistry->mask];
+
+		const uint32_t id = DZCOBS_REG_LOAD( &pEntry->id, acquire );
+
+		if( id == aId )
+		{
+			return DZCOBS_REG_LOAD( &pEntry->pDict, relaxed );
+		}
+
+		if( ( id == 0 ) && ( DZCOBS_REG_LOAD( &pEntry->pDict, relaxed ) == NULL ) )
+		{
+			return NULL;
+		}
+	}
+
+	return NULL;
+}
+
+eDZCOBS_ret dzcobs_negotiate_offer( const uint32_t *aIds,
+																		size_t aNIds,
+																		uint8_t *aOutMsg,
+																		size_t aOutMsgSize,
+																		size_t *aOutMsgLen )
+{
+	if( ( !aIds ) || ( aNIds == 0 ) || ( aNIds > DZCOBS_NEGOTIATE_MAX_IDS ) || ( !aOutMsg ) || ( !aOutMsgLen ) ||
+			( aOutMsgSize < DZCOBS_NEGOTIATE_OFFER_SIZE( aNIds ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	aOutMsg[0] = DZCOBS_NEGOTIATE_OFFER;
+	aOutMsg[1] = (uint8_t)aNIds;
+
+	for( size_t i = 0; i < aNIds; i++ )
+	{
+		if( aIds[i] == 0 )
+		{
+			return DZCOBS_RET_ERR_BAD_ARG;
+		}
+
+		dzcobs_registry_put_id( &aOutMsg[2 + ( 4 * i )], aIds[i] );
+	}
+
+	*aOutMsgLen = DZCOBS_NEGOTIATE_OFFER_SIZE( aNIds );
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_negotiate_accept( const sDZCOBS_registry *aRegistry,
+																		 const uint8_t *aOffer,
+																		 size_t aOfferLen,
+																		 sDZCOBS_connection *aConn,
+																		 uint8_t *aOutMsg,
+																		 size_t aOutMsgSize,
+																		 size_t *aOutMsgLen )
+{
+	if( ( !aRegistry ) || ( !aOffer ) || ( !aConn ) || ( !aOutMsg ) || ( !aOutMsgLen ) ||
+			( aOutMsgSize < DZCOBS_NEGOTIATE_ACCEPT_SIZE ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( ( aOfferLen < DZCOBS_NEGOTIATE_OFFER_SIZE( 1 ) ) || ( aOffer[0] != DZCOBS_NEGOTIATE_OFFER ) ||
+			( aOffer[1] == 0 ) || ( aOffer[1] > DZCOBS_NEGOTIATE_MAX_IDS ) ||
+			( aOfferLen != DZCOBS_NEGOTIATE_OFFER_SIZE( aOffer[1] ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	uint32_t ids[DZCOBS_DICT_N] = { 0 };
+	size_t nBound								= 0;
+
+	for( size_t i = 0; ( i < aOffer[1] ) && ( nBound < DZCOBS_DICT_N ); i++ )
+	{
+		const uint32_t id = dzcobs_registry_get_id( &aOffer[2 + ( 4 * i )] );
+
+		bool isBound = false;
+
+		for( size_t j = 0; j < nBound; j++ )
+		{
+			isBound = isBound || ( ids[j] == id );
+		}
+
+		if( ( !isBound ) && ( dzcobs_registry_find( aRegistry, id ) != NULL ) )
+		{
+			ids[nBound++] = id;
+		}
+	}
+
+	// Entries are never removed, so the ids just found are always bound
+	const eDZCOBS_ret ret = dzcobs_registry_bind( aRegistry, ids, aConn );
+
+	DZCOBS_ASSERT( ret == DZCOBS_RET_SUCCESS );
+
+	aOutMsg[0] = DZCOBS_NEGOTIATE_ACCEPT;
+
+	for( size_t i = 0; i < DZCOBS_DICT_N; i++ )
+	{
+		dzcobs_registry_put_id( &aOutMsg[1 + ( 4 * i )], ids[i] );
+	}
+
+	*aOutMsgLen = DZCOBS_NEGOTIATE_ACCEPT_SIZE;
+
+	return ret;
+}
+
+eDZCOBS_ret dzcobs_negotiate_complete( const sDZCOBS_registry *aRegistry,
+																			 const uint8_t *aAccept,
+																			 size_t aAcceptLen,
+																			 sDZCOBS_connection *aConn )
+{
+	if( ( !aRegistry ) || ( !aAccept ) || ( !aConn ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( ( aAcceptLen != DZCOBS_NEGOTIATE_ACCEPT_SIZE ) || ( aAccept[0] != DZCOBS_NEGOTIATE_ACCEPT ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	uint32_t ids[DZCOBS_DICT_N];
+
+	for( size_t i = 0; i < DZCOBS_DICT_N; i++ )
+	{
+		ids[i] = dzcobs_registry_get_id( &aAccept[1 + ( 4 * i )] );
+	}
+
+	return dzcobs_registry_bind( aRegistry, ids, aConn );
+}
+
+eDZCOBS_ret dzcobs_connection_set_encoder( const sDZCOBS_connection *aConn, sDZCOBS_ctx *aCtx )
+{
+	if( ( !aConn ) || ( !aCtx ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	for( size_t i = 0; i < DZCOBS_DICT_N; i++ )
+	{
+		aCtx->pDict[i] = aConn->pDict[i];
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_connection_set_decoder( const sDZCOBS_connection *aConn, sDZCOBS_decodectx *aDecodeCtx )
+{
+	if( ( !aConn ) || ( !aDecodeCtx ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	for( size_t i = 0; i < DZCOBS_DICT_N; i++ )
+	{
+		aDecodeCtx->pDict[i] = aConn->pDict[i];
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
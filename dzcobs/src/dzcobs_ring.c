@@ -0,0 +1,154 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_ring.c
+///	@brief Ring buffer output of the decoder
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_ring.h>
+#include <string.h>
+#include "dzcobs_assert.h"
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+eDZCOBS_ret dzcobs_ring_init( sDZCOBS_ring *aRing, uint8_t *aBuf, size_t aSize )
+{
+	if( ( !aRing ) || ( !aBuf ) || ( aSize == 0 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	aRing->pBuf		 = aBuf;
+	aRing->size		 = aSize;
+	aRing->readIdx = 0;
+	aRing->used		 = 0;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_decode_ring( const sDZCOBS_decodectx *aDecodeCtx,
+																sDZCOBS_ring *aRing,
+																size_t *aOutDecodedLen,
+																uint8_t *aOutUser6bitDataRightAlgn )
+{
+	if( ( !aRing ) || ( !aRing->pBuf ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	// Only the codes are read, so the ring is not touched when it has no space
+	size_t decodedLen = 0;
+
+	const eDZCOBS_ret ret = dzcobs_decoded_size( aDecodeCtx, &decodedLen );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	if( decodedLen > dzcobs_ring_free( aRing ) )
+	{
+		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+	}
+
+	return dzcobs_decode_sink( aDecodeCtx, dzcobs_ring_sink, aRing, aOutDecodedLen, aOutUser6bitDataRightAlgn );
+}
+
+eDZCOBS_ret dzcobs_ring_sink( void *aArg, eDZCOBS_run aRun, const uint8_t *aData, size_t aSize )
+{
+	sDZCOBS_ring *pRing = (sDZCOBS_ring *)aArg;
+
+	DZCOBS_ASSERT( pRing != NULL );
+	DZCOBS_ASSERT( aData != NULL );
+
+	(void)aRun;
+
+	if( aSize > dzcobs_ring_free( pRing ) )
+	{
+		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+	}
+
+	size_t writeIdx = pRing->readIdx + pRing->used;
+
+	writeIdx = ( writeIdx >= pRing->size ) ? ( writeIdx - pRing->size ) : writeIdx;
+
+	// Up to the end of the storage, then from its start
+	const size_t firstSize = ( aSize < ( pRing->size - writeIdx ) ) ? aSize : ( pRing->size - writeIdx );
+
+	memcpy( &pRing->pBuf[writeIdx], aData, firstSize );
+	memcpy( pRing->pBuf, aData + firstSize, aSize - firstSize );
+
+	pRing->used += aSize;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+size_t dzcobs_ring_peek( const sDZCOBS_ring *aRing, const uint8_t **aOutData )
+{
+	DZCOBS_ASSERT( aRing != NULL );
+	DZCOBS_ASSERT( aOutData != NULL );
+
+	const size_t toEnd = aRing->size - aRing->readIdx;
+
+	*aOutData = &aRing->pBuf[aRing->readIdx];
+
+	return ( aRing->used < toEnd ) ? aRing->used : toEnd;
+}
+
+size_t dzcobs_ring_read( sDZCOBS_ring *aRing, uint8_t *aDst, size_t aSize )
+{
+	DZCOBS_ASSERT( aRing != NULL );
+
+	size_t readSize = 0;
+
+	while( ( readSize < aSize ) && ( aRing->used > 0 ) )
+	{
+		const uint8_t *pData = NULL;
+
+		size_t size = dzcobs_ring_peek( aRing, &pData );
+
+		size = ( size < ( aSize - readSize ) ) ? size : ( aSize - readSize );
+
+		if( aDst )
+		{
+			memcpy( &aDst[readSize], pData, size );
+		}
+
+		aRing->readIdx += size;
+		aRing->readIdx = ( aRing->readIdx == aRing->size ) ? 0 : aRing->readIdx;
+		aRing->used -= size;
+
+		readSize += size;
+	}
+
+	return readSize;
+}
+
+size_t dzcobs_ring_used( const sDZCOBS_ring *aRing )
+{
+	DZCOBS_ASSERT( aRing != NULL );
+
+	return aRing->used;
+}
+
+size_t dzcobs_ring_free( const sDZCOBS_ring *aRing )
+{
+	DZCOBS_ASSERT( aRing != NULL );
+
+	return aRing->size - aRing->used;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
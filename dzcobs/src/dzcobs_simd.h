@@ -0,0 +1,72 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_simd.h
+///	@brief SIMD availability detection
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZCOBS_SIMD_H_
+#define _DZCOBS_SIMD_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Define DZCOBS_USE_SIMD to 0 to force the portable implementations
+#ifndef DZCOBS_USE_SIMD
+#define DZCOBS_USE_SIMD 1
+#endif
+
+// SSE2 is part of the x86-64 baseline, so it can be used without runtime checks
+#if( DZCOBS_USE_SIMD == 1 ) && ( defined( __SSE2__ ) || defined( _M_X64 ) )
+#define DZCOBS_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define DZCOBS_HAS_SSE2 0
+#endif
+
+// SSE4.2 (crc32 instruction), PCLMUL and AVX-512 VPCLMULQDQ are not baseline.
+// On x86-64 GCC and Clang build their kernels with target attributes, and they
+// are selected at runtime with DZCOBS_CPU_SUPPORTS. Other compilers use them
+// only when allowed to emit them (eg: /arch:AVX), without runtime checks.
+#if( DZCOBS_HAS_SSE2 == 1 ) && defined( __x86_64__ ) && defined( __GNUC__ )
+#define DZCOBS_HAS_SSE42 1
+#define DZCOBS_HAS_PCLMUL 1
+#define DZCOBS_HAS_VPCLMUL 1
+#define DZCOBS_TARGET( aFeatures ) __attribute__( ( target( aFeatures ) ) )
+#define DZCOBS_CPU_SUPPORTS( aFeature ) __builtin_cpu_supports( aFeature )
+#include <immintrin.h>
+#else
+#define DZCOBS_HAS_VPCLMUL 0
+#define DZCOBS_TARGET( aFeatures )
+#define DZCOBS_CPU_SUPPORTS( aFeature ) ( 1 )
+
+#if( DZCOBS_HAS_SSE2 == 1 ) && ( defined( __SSE4_2__ ) || defined( __AVX__ ) ) && defined( _M_X64 )
+#define DZCOBS_HAS_SSE42 1
+#include <nmmintrin.h>
+#else
+#define DZCOBS_HAS_SSE42 0
+#endif
+
+#if( DZCOBS_HAS_SSE2 == 1 ) && ( defined( __PCLMUL__ ) || defined( __AVX__ ) )
+#define DZCOBS_HAS_PCLMUL 1
+#include <wmmintrin.h>
+#else
+#define DZCOBS_HAS_PCLMUL 0
+#endif
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,77 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_stats.c
+///	@brief Dictionary words use instrumentation
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_stats.h>
+#include <string.h>
+#include "dzcobs_assert.h"
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+void dzcobs_stats_reset( sDZCOBS_stats *aStats )
+{
+	DZCOBS_ASSERT( aStats != NULL );
+
+	memset( aStats, 0, sizeof( sDZCOBS_stats ) );
+}
+
+eDZCOBS_ret dzcobs_stats_attach( sDICT_ctx *aDict, sDZCOBS_stats *aStats )
+{
+	if( !aDict )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( aStats )
+	{
+		dzcobs_stats_reset( aStats );
+	}
+
+	aDict->pStats = aStats;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_stats_dump( const sDZCOBS_stats *aStats,
+															 const sDICT_ctx *aDict,
+															 dzcobs_stats_word_funcPtr aWordFunc,
+															 void *aArg )
+{
+	if( ( !aStats ) || ( !aDict ) || ( !aWordFunc ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	for( uint8_t i = 0; i < (uint8_t)DZCOBS_STATS_MAX_WORDS; i++ )
+	{
+		uint8_t wordSize		 = 0;
+		const uint8_t *pWord = dzcobs_dictionary_get( aDict, i, &wordSize );
+
+		if( pWord == NULL )
+		{
+			break;
+		}
+
+		aWordFunc( aArg, i, pWord, wordSize, aStats->hits[i], aStats->bytesSaved[i] );
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,242 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_tail.c
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_tail.h>
+#include "dzcobs/dzcobs_crc.h"
+#include "dzcobs/dzcobs_dictionary.h"
+#include "dzcobs_assert.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static void dzcobs_tail_put( sDZCOBS_tailctx *aCtx, uint8_t aByte )
+{
+	DZCOBS_ASSERT( aByte != 0 );
+
+	aCtx->hashsum += DZCOBS_HASH8( aByte );
+
+	if( aCtx->check == DZCOBS_CHECK_CRC16 )
+	{
+		aCtx->crc = dzcobs_crc16_byte( (uint16_t)aCtx->crc, aByte );
+	}
+	else if( aCtx->check == DZCOBS_CHECK_CRC32C )
+	{
+		aCtx->crc = dzcobs_crc32c_byte( aCtx->crc, aByte );
+	}
+
+	aCtx->isStarted = true;
+
+	aCtx->putFunc( aCtx->pUser, aByte );
+}
+
+eDZCOBS_ret dzcobs_tail_encode_begin( sDZCOBS_tailctx *aCtx,
+																			eDZCOBS_encoding aEncoding,
+																			const sDICT_ctx *aDict,
+																			uint8_t aUser6bits,
+																			dzcobs_tail_put_funcPtr aPutFunc,
+																			void *aUser )
+{
+	if( ( !aCtx ) || ( !aPutFunc ) || ( aEncoding == DZCOBS_RESERVED ) || ( aEncoding == DZCOBS_AUTO ) ||
+			( ( aEncoding != DZCOBS_PLAIN ) && ( aDict == NULL ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( ( aUser6bits == 0 ) || ( aUser6bits > 0x3F ) )
+	{
+		return DZCOBS_RET_ERR_INVALID_USER6BITS;
+	}
+
+	aCtx->putFunc = aPutFunc;
+	aCtx->pUser		= aUser;
+	aCtx->pDict		= ( aEncoding == DZCOBS_PLAIN ) ? NULL : aDict;
+
+	aCtx->crc				= 0;
+	aCtx->runLen		= 0;
+	aCtx->hashsum		= 0;
+	aCtx->user6bits = aUser6bits;
+	aCtx->jumpCode	= ( aEncoding == DZCOBS_PLAIN ) ? DZCOBS_CODE_JUMP_PLAIN : DZCOBS_CODE_JUMP_DICTIONARY;
+
+	aCtx->isStarted				 = false;
+	aCtx->isZeroClosed		 = false;
+	aCtx->isLastDictionary = false;
+
+	aCtx->check		 = DZCOBS_CHECK_HASH8;
+	aCtx->encoding = aEncoding;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_tail_encode_set_check( sDZCOBS_tailctx *aCtx, eDZCOBS_check aCheck )
+{
+	if( ( !aCtx ) || ( !aCtx->putFunc ) || ( aCtx->isStarted ) ||
+			( !( ( aCheck == DZCOBS_CHECK_HASH8 ) || ( aCheck == DZCOBS_CHECK_CRC16 ) ||
+					 ( aCheck == DZCOBS_CHECK_CRC32C ) ) ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	aCtx->check = aCheck;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_tail_encode( sDZCOBS_tailctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
+{
+	if( ( !aCtx ) || ( !aSrcBuf ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( !aCtx->putFunc )
+	{
+		return DZCOBS_RET_ERR_NOTINITIALIZED;
+	}
+
+	while( aSrcBufSize )
+	{
+		if( aCtx->pDict )
+		{
+			size_t sizeOfKeyFound = 0;
+
+			const uint8_t foundIdx = dzcobs_dictionary_search( aCtx->pDict, aSrcBuf, aSrcBufSize, &sizeOfKeyFound );
+
+			if( foundIdx )
+			{
+				DZCOBS_ASSERT( sizeOfKeyFound > 0 );
+				DZCOBS_ASSERT( sizeOfKeyFound <= aSrcBufSize );
+
+				if( aCtx->runLen != 0 )
+				{
+					// Run closed by the word, no 0x00 after it
+					dzcobs_tail_put( aCtx, (uint8_t)( aCtx->runLen + 1 ) );
+					aCtx->runLen = 0;
+				}
+				else if( aCtx->isZeroClosed )
+				{
+					// Empty run, so the 0x00 before it is kept
+					dzcobs_tail_put( aCtx, 1 );
+				}
+
+				dzcobs_tail_put( aCtx, (uint8_t)( DZCOBS_DICTIONARY_BITMASK | ( foundIdx - 1 ) ) );
+
+				aCtx->isZeroClosed		 = false;
+				aCtx->isLastDictionary = true;
+
+				aSrcBufSize -= sizeOfKeyFound;
+				aSrcBuf += sizeOfKeyFound;
+				continue;
+			}
+		}
+
+		aSrcBufSize--;
+
+		const uint8_t src_byte = *aSrcBuf++;
+
+		aCtx->isLastDictionary = false;
+
+		if( src_byte == 0 )
+		{
+			dzcobs_tail_put( aCtx, (uint8_t)( aCtx->runLen + 1 ) );
+			aCtx->runLen			 = 0;
+			aCtx->isZeroClosed = true;
+		}
+		else
+		{
+			dzcobs_tail_put( aCtx, src_byte );
+			aCtx->runLen++;
+			aCtx->isZeroClosed = false;
+
+			if( ( aCtx->runLen + 1 ) == aCtx->jumpCode )
+			{
+				// The run is full. If the frame ends here, an empty run is added.
+				dzcobs_tail_put( aCtx, aCtx->jumpCode );
+				aCtx->runLen = 0;
+			}
+		}
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_tail_encode_end( sDZCOBS_tailctx *aCtx )
+{
+	if( !aCtx )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( !aCtx->putFunc )
+	{
+		return DZCOBS_RET_ERR_NOTINITIALIZED;
+	}
+
+	// Last run, it may be empty
+	if( ( aCtx->runLen != 0 ) || ( !aCtx->isLastDictionary ) )
+	{
+		dzcobs_tail_put( aCtx, (uint8_t)( aCtx->runLen + 1 ) );
+	}
+
+	const uint8_t extensionByte = DZCOBS_EXT_MARKER | DZCOBS_EXT_TAIL_CODED |
+																(uint8_t)( aCtx->check << DZCOBS_EXT_CHECK_SHIFT ) | (uint8_t)aCtx->encoding;
+
+	const uint8_t encodingByte = (uint8_t)( aCtx->user6bits << 2 ) | DZCOBS_RESERVED;
+
+	uint8_t hashsum = aCtx->hashsum;
+
+	if( aCtx->check != DZCOBS_CHECK_HASH8 )
+	{
+		const uint8_t tail[2] = { extensionByte, encodingByte };
+
+		uint8_t check[DZCOBS_FRAME_CRC32C_SIZE];
+
+		if( aCtx->check == DZCOBS_CHECK_CRC16 )
+		{
+			dzcobs_crc_stuff( dzcobs_crc16( (uint16_t)aCtx->crc, tail, sizeof( tail ) ), DZCOBS_CRC16_SIZE, check );
+		}
+		else
+		{
+			dzcobs_crc_stuff( dzcobs_crc32c( aCtx->crc, tail, sizeof( tail ) ), DZCOBS_CRC32C_SIZE, check );
+		}
+
+		const size_t checkSize = DZCOBS_FRAME_CHECK_SIZE( aCtx->check );
+
+		for( size_t i = 0; i < checkSize; i++ )
+		{
+			hashsum += DZCOBS_HASH8( check[i] );
+			aCtx->putFunc( aCtx->pUser, check[i] );
+		}
+	}
+
+	hashsum += DZCOBS_HASH8( extensionByte );
+	aCtx->putFunc( aCtx->pUser, extensionByte );
+
+	hashsum += DZCOBS_HASH8( encodingByte );
+	aCtx->putFunc( aCtx->pUser, encodingByte );
+
+	aCtx->putFunc( aCtx->pUser, ( hashsum == 0x00 ) ? DZCOBS_HASH_VALUE_WHEN_CRC_IS_ZERO : hashsum );
+
+	aCtx->putFunc = NULL;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
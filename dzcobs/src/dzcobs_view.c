@@ -0,0 +1,226 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_view.c
+///	@brief Reader of the decoded data of a frame, without copying it
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_view.h>
+#include <string.h>
+#include "dzcobs_assert.h"
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Load the next segment, once the current one and its 0x00 were read
+static void dzcobs_view_load( sDZCOBS_viewreader *aReader )
+{
+	const sDZCOBS_view *pView = aReader->pView;
+
+	while( ( aReader->segmentSize == 0 ) && ( !aReader->isZeroAfter ) && ( aReader->codeIdx < pView->payloadLen ) )
+	{
+		const uint8_t code = pView->pPayload[aReader->codeIdx++];
+
+		if( ( pView->pDict != NULL ) && ( code >= DZCOBS_DICTIONARY_BITMASK ) )
+		{
+			uint8_t wordSize = 0;
+
+			// The word was found by dzcobs_decode_view
+			aReader->pSegment		 = dzcobs_dictionary_get( pView->pDict, code & ~DZCOBS_DICTIONARY_BITMASK, &wordSize );
+			aReader->segmentSize = wordSize;
+			aReader->isWord			 = true;
+			continue;
+		}
+
+		aReader->pSegment		 = &pView->pPayload[aReader->codeIdx];
+		aReader->segmentSize = (size_t)code - 1;
+		aReader->isWord			 = false;
+		aReader->codeIdx += (size_t)code - 1;
+
+		// As dzcobs_decode, there is no 0x00 after the last run nor after a full
+		// run, and a dictionary code drops the one of a non empty run before it
+		const bool hasNext = ( aReader->codeIdx < pView->payloadLen );
+
+		if( pView->pDict == NULL )
+		{
+			aReader->isZeroAfter = hasNext && ( code != DZCOBS_CODE_JUMP_PLAIN );
+		}
+		else
+		{
+			const bool isNextDictionary = hasNext && ( pView->pPayload[aReader->codeIdx] >= DZCOBS_DICTIONARY_BITMASK );
+
+			aReader->isZeroAfter =
+				hasNext && ( ( code == 1 ) || ( ( code != DZCOBS_CODE_JUMP_DICTIONARY ) && ( !isNextDictionary ) ) );
+		}
+	}
+}
+
+eDZCOBS_ret dzcobs_view_reader_init( sDZCOBS_viewreader *aReader, const sDZCOBS_view *aView )
+{
+	if( ( !aReader ) || ( !aView ) || ( !aView->pPayload ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	aReader->pView			 = aView;
+	aReader->codeIdx		 = 0;
+	aReader->pSegment		 = aView->pPayload;
+	aReader->segmentSize = 0;
+	aReader->isWord			 = false;
+	aReader->isZeroAfter = false;
+	aReader->pos				 = 0;
+
+	dzcobs_view_load( aReader );
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+bool dzcobs_view_next_segment( sDZCOBS_viewreader *aReader, sDZCOBS_segment *aOutSegment )
+{
+	DZCOBS_ASSERT( aReader != NULL );
+	DZCOBS_ASSERT( aOutSegment != NULL );
+
+	if( ( aReader->segmentSize == 0 ) && ( !aReader->isZeroAfter ) )
+	{
+		return false;
+	}
+
+	aOutSegment->pData			 = aReader->pSegment;
+	aOutSegment->size				 = aReader->segmentSize;
+	aOutSegment->isWord			 = aReader->isWord;
+	aOutSegment->isZeroAfter = aReader->isZeroAfter;
+
+	aReader->pos += aReader->segmentSize + ( aReader->isZeroAfter ? 1 : 0 );
+	aReader->segmentSize = 0;
+	aReader->isZeroAfter = false;
+
+	dzcobs_view_load( aReader );
+
+	return true;
+}
+
+eDZCOBS_ret dzcobs_view_read( sDZCOBS_viewreader *aReader, uint8_t *aDst, size_t aSize )
+{
+	if( !aReader )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( aSize > dzcobs_view_remaining( aReader ) )
+	{
+		return DZCOBS_RET_ERR_READ_OVERFLOW;
+	}
+
+	aReader->pos += aSize;
+
+	while( aSize )
+	{
+		if( aReader->segmentSize == 0 )
+		{
+			DZCOBS_ASSERT( aReader->isZeroAfter );
+
+			if( aDst )
+			{
+				*aDst++ = 0;
+			}
+
+			aReader->isZeroAfter = false;
+			aSize--;
+		}
+		else
+		{
+			const size_t size = ( aSize < aReader->segmentSize ) ? aSize : aReader->segmentSize;
+
+			if( aDst )
+			{
+				memcpy( aDst, aReader->pSegment, size );
+				aDst += size;
+			}
+
+			aReader->pSegment += size;
+			aReader->segmentSize -= size;
+			aSize -= size;
+		}
+
+		dzcobs_view_load( aReader );
+	}
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_view_read_le( sDZCOBS_viewreader *aReader, uint8_t aSize, uint64_t *aOutValue )
+{
+	if( ( !aOutValue ) || ( aSize == 0 ) || ( aSize > 8 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	uint8_t bytes[8];
+
+	const eDZCOBS_ret ret = dzcobs_view_read( aReader, bytes, aSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	uint64_t value = 0;
+
+	for( uint8_t i = aSize; i != 0; i-- )
+	{
+		value = ( value << 8 ) | bytes[i - 1];
+	}
+
+	*aOutValue = value;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+eDZCOBS_ret dzcobs_view_read_be( sDZCOBS_viewreader *aReader, uint8_t aSize, uint64_t *aOutValue )
+{
+	if( ( !aOutValue ) || ( aSize == 0 ) || ( aSize > 8 ) )
+	{
+		return DZCOBS_RET_ERR_BAD_ARG;
+	}
+
+	uint8_t bytes[8];
+
+	const eDZCOBS_ret ret = dzcobs_view_read( aReader, bytes, aSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	uint64_t value = 0;
+
+	for( uint8_t i = 0; i < aSize; i++ )
+	{
+		value = ( value << 8 ) | bytes[i];
+	}
+
+	*aOutValue = value;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+size_t dzcobs_view_remaining( const sDZCOBS_viewreader *aReader )
+{
+	DZCOBS_ASSERT( aReader != NULL );
+
+	return aReader->pView->decodedLen - aReader->pos;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,319 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_compact.cpp
+///	@brief Tests the compact encoder context
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_compact.h>
+#include <dzcobs/dzcobs_decode.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_COMPACT_CHANNELS ( 32 )
+#define UTEST_COMPACT_DATA_SIZE ( 600 )
+#define UTEST_COMPACT_FRAME_SIZE ( DZCOBS_MAX_ENCODED_SIZE_DICT( UTEST_COMPACT_DATA_SIZE ) )
+
+// clang-format off
+// NOLINTBEGIN
+static const char s_TEST_Dictionary[] =
+	DICT_ADD_WORD(2, "ok")
+	DICT_ADD_WORD(3, "the")
+	DICT_ADD_WORD(4, "temp")
+	DICT_ADD_WORD(5, "error")
+;
+// NOLINTEND
+// clang-format on
+
+static uint8_t s_buf[UTEST_COMPACT_CHANNELS * UTEST_COMPACT_FRAME_SIZE];
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_COMPACT ){
+	void setup()
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &m_dict, s_TEST_Dictionary, sizeof( s_TEST_Dictionary ) ) );
+
+		m_base.pBuf			= s_buf;
+		m_base.bufSize	= sizeof( s_buf );
+		m_base.pDict[0] = &m_dict;
+		m_base.pDict[1] = NULL;
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx m_dict;
+	sDZCOBS_compactbase m_base;
+};
+// NOLINTEND
+// clang-format on
+
+/// Data of a channel, text with dictionary words on even channels, random on odd ones
+static void utest_channel_data( size_t aChannel, uint8_t *aOutData, size_t aSize )
+{
+	static const char text[] = "the temp is ok, no error ";
+
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		if( ( aChannel & 1 ) == 0 )
+		{
+			aOutData[i] = (uint8_t)text[( i + aChannel ) % ( sizeof( text ) - 1 )];
+		}
+		else
+		{
+			aOutData[i] = ( ( rand() % 5 ) == 0 ) ? 0 : (uint8_t)rand();
+		}
+	}
+}
+
+/// Size of the aChunk data chunk of a channel
+static size_t utest_chunk_size( size_t aChannel, size_t aChunk )
+{
+	return 1 + ( ( aChannel * 7 + aChunk * 13 ) % 50 );
+}
+
+/// Encodes the chunks of all the channels interleaved, and checks each frame
+/// is the same of a sDZCOBS_ctx and decodes to the data
+static void utest_interleaved( sDZCOBS_compactbase *aBase, eDZCOBS_encoding aEncoding )
+{
+	static uint8_t data[UTEST_COMPACT_CHANNELS][UTEST_COMPACT_DATA_SIZE];
+	sDZCOBS_compactctx compact[UTEST_COMPACT_CHANNELS];
+	size_t offset[UTEST_COMPACT_CHANNELS];
+
+	for( size_t c = 0; c < UTEST_COMPACT_CHANNELS; c++ )
+	{
+		utest_channel_data( c, data[c], UTEST_COMPACT_DATA_SIZE );
+		offset[c] = 0;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+								 dzcobs_compact_begin( aBase,
+																			 &compact[c],
+																			 aEncoding,
+																			 (uint32_t)( c * UTEST_COMPACT_FRAME_SIZE ),
+																			 UTEST_COMPACT_FRAME_SIZE ) );
+		compact[c].user6bits = (uint8_t)( 1 + c );
+	}
+
+	// Round robin, a chunk of each channel not yet finished
+	for( size_t chunk = 0, nActive = UTEST_COMPACT_CHANNELS; nActive > 0; chunk++ )
+	{
+		nActive = 0;
+
+		for( size_t c = 0; c < UTEST_COMPACT_CHANNELS; c++ )
+		{
+			size_t size = utest_chunk_size( c, chunk );
+
+			if( offset[c] >= UTEST_COMPACT_DATA_SIZE )
+			{
+				continue;
+			}
+
+			if( size > ( UTEST_COMPACT_DATA_SIZE - offset[c] ) )
+			{
+				size = UTEST_COMPACT_DATA_SIZE - offset[c];
+			}
+
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_compact_inc( aBase, &compact[c], &data[c][offset[c]], size ) );
+			offset[c] += size;
+			nActive++;
+		}
+	}
+
+	for( size_t c = 0; c < UTEST_COMPACT_CHANNELS; c++ )
+	{
+		size_t compactLen = 0;
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_compact_end( aBase, &compact[c], &compactLen ) );
+
+		// The same chunks, on a full context
+		uint8_t encoded[UTEST_COMPACT_FRAME_SIZE];
+		size_t encodedLen = 0;
+
+		sDZCOBS_ctx ctx;
+		memset( &ctx, 0, sizeof( ctx ) );
+		ctx.pDict[0] = aBase->pDict[0];
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, aEncoding, encoded, sizeof( encoded ) ) );
+		ctx.user6bits = (uint8_t)( 1 + c );
+
+		size_t pos = 0;
+
+		for( size_t chunk = 0; pos < UTEST_COMPACT_DATA_SIZE; chunk++ )
+		{
+			size_t size = utest_chunk_size( c, chunk );
+
+			if( size > ( UTEST_COMPACT_DATA_SIZE - pos ) )
+			{
+				size = UTEST_COMPACT_DATA_SIZE - pos;
+			}
+
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, &data[c][pos], size ) );
+			pos += size;
+		}
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+		const uint8_t *pFrame = aBase->pBuf + compact[c].dstOffset;
+
+		CHECK_EQUAL( encodedLen, compactLen );
+		MEMCMP_EQUAL( encoded, pFrame, encodedLen );
+
+		uint8_t decoded[UTEST_COMPACT_DATA_SIZE];
+		size_t decodedLen = 0;
+		uint8_t user6bits = 0;
+
+		sDZCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= pFrame;
+		decodeCtx.srcBufEncodedLen	= compactLen;
+		decodeCtx.dstBufDecoded			= decoded;
+		decodeCtx.dstBufDecodedSize = sizeof( decoded );
+		decodeCtx.pDict[0]					= aBase->pDict[0];
+		decodeCtx.pDict[1]					= NULL;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) );
+		CHECK_EQUAL( UTEST_COMPACT_DATA_SIZE, decodedLen );
+		CHECK_EQUAL( 1 + c, user6bits );
+		MEMCMP_EQUAL( data[c], decoded, UTEST_COMPACT_DATA_SIZE );
+	}
+}
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_COMPACT, Interleaved )
+// NOLINTEND
+{
+	CHECK( ( sizeof( sDZCOBS_compactctx ) * 2 ) < sizeof( sDZCOBS_ctx ) );
+
+	srand( 50 );
+
+	utest_interleaved( &m_base, DZCOBS_PLAIN );
+	utest_interleaved( &m_base, DZCOBS_USING_DICT_1 );
+	utest_interleaved( &m_base, DZCOBS_AUTO );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_COMPACT, Overflow )
+// NOLINTEND
+{
+	enum
+	{
+		FRAME_OFFSET = ( 16 ),
+		FRAME_SIZE	 = ( 32 )
+	};
+
+	uint8_t ones[64];
+	memset( ones, 0x01, sizeof( ones ) );
+	memset( s_buf, 0xAA, sizeof( s_buf ) );
+
+	const eDZCOBS_encoding encodings[2] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 };
+
+	for( size_t e = 0; e < 2; e++ )
+	{
+		sDZCOBS_compactctx ctx;
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_compact_begin( &m_base, &ctx, encodings[e], FRAME_OFFSET, FRAME_SIZE ) );
+		ctx.user6bits = 1;
+
+		// Fed a byte at a time, until the worst case of a byte does not fit
+		size_t nAdded = 0;
+
+		while( dzcobs_compact_inc( &m_base, &ctx, ones, 1 ) == DZCOBS_RET_SUCCESS )
+		{
+			nAdded++;
+		}
+
+		CHECK( nAdded > 0 );
+		CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_compact_inc( &m_base, &ctx, ones, sizeof( ones ) ) );
+
+		size_t encodedLen = 0;
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_compact_end( &m_base, &ctx, &encodedLen ) );
+		CHECK( encodedLen <= FRAME_SIZE );
+
+		// The neighbours are not touched
+		for( size_t i = 0; i < FRAME_OFFSET; i++ )
+		{
+			CHECK_EQUAL( 0xAA, s_buf[i] );
+			CHECK_EQUAL( 0xAA, s_buf[FRAME_OFFSET + FRAME_SIZE + i] );
+		}
+
+		uint8_t decoded[FRAME_SIZE];
+		size_t decodedLen = 0;
+		uint8_t user6bits = 0;
+
+		sDZCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= s_buf + FRAME_OFFSET;
+		decodeCtx.srcBufEncodedLen	= encodedLen;
+		decodeCtx.dstBufDecoded			= decoded;
+		decodeCtx.dstBufDecodedSize = sizeof( decoded );
+		decodeCtx.pDict[0]					= &m_dict;
+		decodeCtx.pDict[1]					= NULL;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) );
+		CHECK_EQUAL( nAdded, decodedLen );
+		MEMCMP_EQUAL( ones, decoded, nAdded );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_COMPACT, BadArgs )
+// NOLINTEND
+{
+	const uint8_t data[4] = { 1, 2, 3, 4 };
+	sDZCOBS_compactctx ctx;
+	size_t encodedLen = 0;
+
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	// Not yet begun
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_compact_inc( &m_base, &ctx, data, sizeof( data ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_compact_end( &m_base, &ctx, &encodedLen ) );
+
+	// Outside of the shared buffer
+	const uint32_t bufSize = (uint32_t)sizeof( s_buf );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_compact_begin( NULL, &ctx, DZCOBS_PLAIN, 0, 64 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_compact_begin( &m_base, NULL, DZCOBS_PLAIN, 0, 64 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_compact_begin( &m_base, &ctx, DZCOBS_PLAIN, bufSize - 63, 64 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_compact_begin( &m_base, &ctx, DZCOBS_PLAIN, bufSize + 1, 0 ) );
+
+	// No dictionary set on the second slot
+	CHECK( DZCOBS_RET_SUCCESS != dzcobs_compact_begin( &m_base, &ctx, DZCOBS_USING_DICT_2, 0, 64 ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_compact_begin( &m_base, &ctx, DZCOBS_PLAIN, bufSize - 64, 64 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_compact_inc( &m_base, &ctx, NULL, 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_compact_inc( NULL, &ctx, data, 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_compact_inc( &m_base, &ctx, data, 0 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_compact_inc( &m_base, &ctx, data, sizeof( data ) ) );
+
+	// Ended, it must begin again
+	ctx.user6bits = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_compact_end( &m_base, &ctx, &encodedLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_compact_inc( &m_base, &ctx, data, sizeof( data ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_compact_end( &m_base, &ctx, &encodedLen ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
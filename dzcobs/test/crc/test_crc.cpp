@@ -0,0 +1,451 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_crc.cpp
+///	@brief Tests for the CRC functions and the frame CRC checks
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_crc.h>
+#include <dzcobs/dzcobs_decode.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_CRC_MAX_SIZE ( 2048 )
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_CRC ){
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+// NOLINTEND
+// clang-format on
+
+static const eDZCOBS_check s_checks[] = { DZCOBS_CHECK_HASH8, DZCOBS_CHECK_CRC16, DZCOBS_CHECK_CRC32C };
+
+/// Bit by bit reference of a reflected CRC
+static uint32_t crc_reference( uint32_t aPoly, uint32_t aMask, const uint8_t *aBuf, size_t aSize )
+{
+	uint32_t crc = aMask;
+
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		crc ^= aBuf[i];
+
+		for( int bit = 0; bit < 8; bit++ )
+		{
+			crc = ( crc & 1 ) ? ( ( crc >> 1 ) ^ aPoly ) : ( crc >> 1 );
+		}
+	}
+
+	return ( crc ^ aMask ) & aMask;
+}
+
+static eDZCOBS_ret encode_checked( eDZCOBS_encoding aEncoding,
+																	 const sDICT_ctx *aDict,
+																	 eDZCOBS_check aCheck,
+																	 const uint8_t *aData,
+																	 size_t aDataSize,
+																	 uint8_t *aDst,
+																	 size_t aDstSize,
+																	 size_t *aOutEncodedLen )
+{
+	sDZCOBS_ctx ctx;
+
+	if( aDict )
+	{
+		dzcobs_encode_set_dictionary( &ctx, aDict, aEncoding );
+	}
+
+	eDZCOBS_ret ret = dzcobs_encode_inc_begin( &ctx, aEncoding, aDst, aDstSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	ctx.user6bits = 0x15;
+
+	ret = dzcobs_encode_set_check( &ctx, aCheck );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	ret = dzcobs_encode_inc( &ctx, aData, aDataSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	return dzcobs_encode_inc_end( &ctx, aOutEncodedLen );
+}
+
+static eDZCOBS_ret decode( const sDICT_ctx *aDict,
+													 const uint8_t *aEncoded,
+													 size_t aEncodedLen,
+													 uint8_t *aDecoded,
+													 size_t aDecodedSize,
+													 size_t *aOutDecodedLen )
+{
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	decodeCtx.srcBufEncoded			= aEncoded;
+	decodeCtx.srcBufEncodedLen	= aEncodedLen;
+	decodeCtx.dstBufDecoded			= aDecoded;
+	decodeCtx.dstBufDecodedSize = aDecodedSize;
+	decodeCtx.pDict[0]					= aDict;
+
+	uint8_t user6bitsValue = 0;
+
+	return dzcobs_decode( &decodeCtx, aOutDecodedLen, &user6bitsValue );
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_CRC, KnownValues )
+// NOLINTEND
+{
+	const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+	CHECK_EQUAL( 0x906E, dzcobs_crc16( 0, check, sizeof( check ) ) );
+	CHECK_EQUAL( 0xE3069283, dzcobs_crc32c( 0, check, sizeof( check ) ) );
+
+	CHECK_EQUAL( 0, dzcobs_crc16( 0, check, 0 ) );
+	CHECK_EQUAL( 0, dzcobs_crc32c( 0, check, 0 ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_CRC, MatchReferenceAndIncremental )
+// NOLINTEND
+{
+	uint8_t buf[UTEST_CRC_MAX_SIZE + 8];
+
+	for( size_t i = 0; i < sizeof( buf ); i++ )
+	{
+		buf[i] = (uint8_t)( rand() & 0xFF );
+	}
+
+	// Cover the unaligned starts, the fold/stream sizes and their remainders
+	for( size_t offset = 0; offset < 8; offset += 3 )
+	{
+		for( size_t size = 0; size <= UTEST_CRC_MAX_SIZE; size += ( size < 160 ) ? 1 : 13 )
+		{
+			const uint8_t *pData = buf + offset;
+
+			const uint16_t crc16	 = dzcobs_crc16( 0, pData, size );
+			const uint32_t crc32c = dzcobs_crc32c( 0, pData, size );
+
+			CHECK_EQUAL( crc_reference( 0x8408, 0xFFFF, pData, size ), crc16 );
+			CHECK_EQUAL( crc_reference( 0x82F63B78, 0xFFFFFFFF, pData, size ), crc32c );
+
+			const size_t split = size / 3;
+
+			CHECK_EQUAL( crc16, dzcobs_crc16( dzcobs_crc16( 0, pData, split ), pData + split, size - split ) );
+			CHECK_EQUAL( crc32c, dzcobs_crc32c( dzcobs_crc32c( 0, pData, split ), pData + split, size - split ) );
+
+			// A byte at a time, as the tail encoder
+			uint16_t byteCrc16	= 0;
+			uint32_t byteCrc32c = 0;
+
+			for( size_t i = 0; i < size; i++ )
+			{
+				byteCrc16	= dzcobs_crc16_byte( byteCrc16, pData[i] );
+				byteCrc32c = dzcobs_crc32c_byte( byteCrc32c, pData[i] );
+			}
+
+			CHECK_EQUAL( crc16, byteCrc16 );
+			CHECK_EQUAL( crc32c, byteCrc32c );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_CRC, EncodeDecodeFrame )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS,
+							 dzcobs_dictionary_init( &dictCtx, G_DZCOBS_DefaultDictionary, G_DZCOBS_DefaultDictionary_size ) );
+
+	uint8_t src[UTEST_CRC_MAX_SIZE];
+	uint8_t encoded[DZCOBS_MAX_ENCODED_SIZE( UTEST_CRC_MAX_SIZE ) + 8];
+	uint8_t decoded[UTEST_CRC_MAX_SIZE];
+
+	for( size_t i = 0; i < sizeof( src ); i++ )
+	{
+		// Some zeros and dictionary words
+		src[i] = ( ( rand() % 4 ) == 0 ) ? 0 : (uint8_t)( rand() & 0xFF );
+	}
+
+	for( const eDZCOBS_check check : s_checks )
+	{
+		for( size_t size = 1; size <= sizeof( src ); size += 97 )
+		{
+			for( const eDZCOBS_encoding encoding : { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 } )
+			{
+				size_t encodedLen = 0;
+
+				eDZCOBS_ret ret = encode_checked(
+					encoding, &dictCtx, check, src, size, encoded, sizeof( encoded ), &encodedLen );
+				CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+
+				for( size_t i = 0; i < encodedLen; i++ )
+				{
+					CHECK( encoded[i] != 0 );
+				}
+
+				if( check != DZCOBS_CHECK_HASH8 )
+				{
+					CHECK_EQUAL( DZCOBS_EXT_MARKER | ( check << DZCOBS_EXT_CHECK_SHIFT ) | encoding, encoded[encodedLen - 3] );
+					CHECK_EQUAL( ( 0x15 << 2 ) | DZCOBS_RESERVED, encoded[encodedLen - 2] );
+				}
+
+				size_t decodedLen = 0;
+
+				ret = decode( &dictCtx, encoded, encodedLen, decoded, sizeof( decoded ), &decodedLen );
+				CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+				CHECK_EQUAL( size, decodedLen );
+				CHECK_EQUAL( 0, memcmp( src, decoded, size ) );
+			}
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_CRC, WithFilter )
+// NOLINTEND
+{
+	uint8_t src[DZCOBS_FILTER_BLOCK_SIZE + 40];
+	uint8_t encoded[DZCOBS_MAX_ENCODED_SIZE( sizeof( src ) ) + 8];
+	uint8_t decoded[sizeof( src )];
+
+	for( size_t i = 0; i < sizeof( src ); i++ )
+	{
+		src[i] = (uint8_t)( i * 7 );
+	}
+
+	sDZCOBS_ctx ctx;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, encoded, sizeof( encoded ) ) );
+	ctx.user6bits = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA, 2 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_check( &ctx, DZCOBS_CHECK_CRC32C ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, src, sizeof( src ) ) );
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	// [filter][stuffed crc32c][extension][encoding][hash8]
+	CHECK_EQUAL( dzcobs_filter_descriptor( DZCOBS_FILTER_DELTA, 2 ), encoded[encodedLen - 9] );
+	CHECK_EQUAL( DZCOBS_EXT_MARKER | DZCOBS_EXT_FILTER | ( DZCOBS_CHECK_CRC32C << DZCOBS_EXT_CHECK_SHIFT ),
+							 encoded[encodedLen - 3] );
+
+	size_t decodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, decode( NULL, encoded, encodedLen, decoded, sizeof( decoded ), &decodedLen ) );
+	CHECK_EQUAL( sizeof( src ), decodedLen );
+	CHECK_EQUAL( 0, memcmp( src, decoded, sizeof( src ) ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_CRC, DetectSwappedBytes )
+// NOLINTEND
+{
+	const uint8_t src[] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 };
+	uint8_t encoded[DZCOBS_MAX_ENCODED_SIZE( sizeof( src ) ) + 8];
+	uint8_t decoded[sizeof( src )];
+
+	for( const eDZCOBS_check check : s_checks )
+	{
+		size_t encodedLen = 0;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+								 encode_checked( DZCOBS_PLAIN, NULL, check, src, sizeof( src ), encoded, sizeof( encoded ), &encodedLen ) );
+
+		// Swap two payload bytes: the order-independent hash cannot detect it
+		const uint8_t tmp = encoded[2];
+		encoded[2]				= encoded[5];
+		encoded[5]				= tmp;
+
+		size_t decodedLen = 0;
+		const eDZCOBS_ret ret = decode( NULL, encoded, encodedLen, decoded, sizeof( decoded ), &decodedLen );
+
+		if( check == DZCOBS_CHECK_HASH8 )
+		{
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+			CHECK( memcmp( src, decoded, sizeof( src ) ) != 0 );
+		}
+		else
+		{
+			CHECK_EQUAL( DZCOBS_RET_ERR_CRC, ret );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_CRC, DetectBitErrors )
+// NOLINTEND
+{
+	uint8_t src[64];
+	uint8_t encoded[DZCOBS_MAX_ENCODED_SIZE( sizeof( src ) ) + 8];
+	uint8_t decoded[sizeof( src )];
+
+	for( size_t i = 0; i < sizeof( src ); i++ )
+	{
+		src[i] = (uint8_t)( 1 + ( rand() % 255 ) );
+	}
+
+	size_t encodedLen = 0;
+
+	CHECK_EQUAL(
+		DZCOBS_RET_SUCCESS,
+		encode_checked( DZCOBS_PLAIN, NULL, DZCOBS_CHECK_CRC32C, src, sizeof( src ), encoded, sizeof( encoded ), &encodedLen ) );
+
+	// Every 2 bit error that keeps the bytes not zero must be detected
+	for( size_t i = 0; i < ( encodedLen - 1 ); i++ )
+	{
+		for( size_t j = i; j < ( encodedLen - 1 ); j++ )
+		{
+			for( uint8_t bit = 0; bit < 8; bit++ )
+			{
+				encoded[i] ^= (uint8_t)( 1 << bit );
+				encoded[j] ^= (uint8_t)( 1 << ( 7 - bit ) );
+
+				if( ( encoded[i] != 0 ) && ( encoded[j] != 0 ) && ( ( i != j ) || ( bit != ( 7 - bit ) ) ) )
+				{
+					size_t decodedLen = 0;
+					const eDZCOBS_ret ret = decode( NULL, encoded, encodedLen, decoded, sizeof( decoded ), &decodedLen );
+					CHECK( ret != DZCOBS_RET_SUCCESS );
+				}
+
+				encoded[i] ^= (uint8_t)( 1 << bit );
+				encoded[j] ^= (uint8_t)( 1 << ( 7 - bit ) );
+			}
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_CRC, Stuff )
+// NOLINTEND
+{
+	// Every CRC-16 value is sent zero-free and as different bytes
+	static uint8_t seen[0x10000 * DZCOBS_FRAME_CRC16_SIZE];
+
+	for( uint32_t crc = 0; crc <= 0xFFFF; crc++ )
+	{
+		uint8_t *pStuffed = &seen[crc * DZCOBS_FRAME_CRC16_SIZE];
+		dzcobs_crc_stuff( crc, DZCOBS_CRC16_SIZE, pStuffed );
+
+		for( size_t i = 0; i < DZCOBS_FRAME_CRC16_SIZE; i++ )
+		{
+			CHECK( pStuffed[i] != 0 );
+		}
+
+		// Stuffing is one to one when its first byte only depends on the zero bytes
+		const uint8_t expectedCode = ( ( crc & 0xFF ) == 0 ) ? 1 : ( ( crc >> 8 ) == 0 ) ? 2 : 3;
+		CHECK_EQUAL( expectedCode, pStuffed[0] );
+	}
+
+	for( uint32_t crc = 1; crc <= 0xFFFF; crc++ )
+	{
+		CHECK( memcmp( &seen[( crc - 1 ) * DZCOBS_FRAME_CRC16_SIZE], &seen[crc * DZCOBS_FRAME_CRC16_SIZE],
+									 DZCOBS_FRAME_CRC16_SIZE ) != 0 );
+	}
+
+	// CRC-32C values made of zero and 0xFF bytes only, which the stuffing must tell apart
+	uint8_t stuffed[16][DZCOBS_FRAME_CRC32C_SIZE];
+
+	for( uint32_t mask = 0; mask < 16; mask++ )
+	{
+		uint32_t crc = 0;
+
+		for( size_t i = 0; i < DZCOBS_CRC32C_SIZE; i++ )
+		{
+			crc |= ( ( mask >> i ) & 1 ) ? ( 0xFFu << ( 8 * i ) ) : 0;
+		}
+
+		dzcobs_crc_stuff( crc, DZCOBS_CRC32C_SIZE, stuffed[mask] );
+
+		for( size_t i = 0; i < DZCOBS_FRAME_CRC32C_SIZE; i++ )
+		{
+			CHECK( stuffed[mask][i] != 0 );
+		}
+
+		for( uint32_t other = 0; other < mask; other++ )
+		{
+			CHECK( memcmp( stuffed[other], stuffed[mask], DZCOBS_FRAME_CRC32C_SIZE ) != 0 );
+		}
+	}
+
+	const uint8_t expected[DZCOBS_FRAME_CRC32C_SIZE] = { 0x02, 0x12, 0x03, 0x34, 0x56 };
+	dzcobs_crc_stuff( 0x56340012, DZCOBS_CRC32C_SIZE, stuffed[0] );
+	MEMCMP_EQUAL( expected, stuffed[0], sizeof( expected ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_CRC, InvalidArguments )
+// NOLINTEND
+{
+	uint8_t encoded[16];
+	sDZCOBS_ctx ctx;
+
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_set_check( NULL, DZCOBS_CHECK_CRC16 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_set_check( &ctx, DZCOBS_CHECK_CRC16 ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, encoded, sizeof( encoded ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_set_check( &ctx, (eDZCOBS_check)3 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_check( &ctx, DZCOBS_CHECK_CRC32C ) );
+
+	// Not enough space for the tail: code, extension, 5 bytes stuffed CRC, encoding, hash8
+	ctx.user6bits = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, encoded, 0 ) );
+
+	sDZCOBS_ctx smallCtx;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &smallCtx, DZCOBS_PLAIN, encoded, 8 ) );
+	smallCtx.user6bits = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_check( &smallCtx, DZCOBS_CHECK_CRC32C ) );
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_encode_inc_end( &smallCtx, &encodedLen ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &smallCtx, DZCOBS_PLAIN, encoded, 9 ) );
+	smallCtx.user6bits = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_check( &smallCtx, DZCOBS_CHECK_CRC32C ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &smallCtx, &encodedLen ) );
+	CHECK_EQUAL( 9, encodedLen );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,337 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_dictfile.cpp
+///	@brief Tests the binary dictionary file
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstring>
+#include <dzcobs/dzcobs_crc.h>
+#include <dzcobs/dzcobs_dictfile.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_DICTFILE_MAX_SIZE ( 4096 )
+
+// clang-format off
+// NOLINTBEGIN
+static const char s_TEST_Dictionary[] =
+	DICT_ADD_WORD(2, "\r\n")
+	DICT_ADD_WORD(2, "er")
+	DICT_ADD_WORD(3, "\":\"")
+	DICT_ADD_WORD(3, "the")
+	DICT_ADD_WORD(4, "temp")
+	DICT_ADD_WORD(5, "\"id\":")
+	DICT_ADD_WORD(5, "state")
+;
+// NOLINTEND
+// clang-format on
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_DICTFILE ){
+	void setup()
+	{
+		memset( m_image, 0, sizeof( m_image ) );
+		m_imageLen = 0;
+	}
+
+	void teardown()
+	{
+	}
+
+	uint64_t m_image[UTEST_DICTFILE_MAX_SIZE / sizeof( uint64_t )];
+	size_t m_imageLen;
+};
+// NOLINTEND
+// clang-format on
+
+/// Searches every position of aData with both contexts
+static void check_same_search( const sDICT_ctx *aExpected,
+															 const sDICT_ctx *aLoaded,
+															 const uint8_t *aData,
+															 size_t aSize )
+{
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		size_t sizeExpected = 0;
+		size_t sizeLoaded		= 0;
+
+		const uint8_t idxExpected = dzcobs_dictionary_search( aExpected, &aData[i], aSize - i, &sizeExpected );
+		const uint8_t idxLoaded		= dzcobs_dictionary_search( aLoaded, &aData[i], aSize - i, &sizeLoaded );
+
+		CHECK_EQUAL( idxExpected, idxLoaded );
+		CHECK_EQUAL( sizeExpected, sizeLoaded );
+	}
+}
+
+/// Updates the checksum of a modified image
+static void reseal( uint64_t *aImage, size_t aImageLen )
+{
+	sDZCOBS_dictfile_header *pHeader = (sDZCOBS_dictfile_header *)aImage;
+	const uint8_t *pImage						 = (const uint8_t *)aImage;
+
+	pHeader->checksum = 0;
+	pHeader->checksum = dzcobs_crc32c( 0, pImage, aImageLen );
+}
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_DICTFILE, WriteLoad )
+// NOLINTEND
+{
+	static const uint8_t data[] = "{\"id\":12,\"temp\":\"the error\",\"state\":\"ok\"}\r\n";
+
+	sDICT_ctx expected;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &expected, s_TEST_Dictionary, sizeof( s_TEST_Dictionary ) ) );
+
+	const uint8_t indexesList[] = { 0,
+																	DZCOBS_DICTFILE_PACKED,
+																	DZCOBS_DICTFILE_AUTOMATON,
+																	DZCOBS_DICTFILE_PACKED | DZCOBS_DICTFILE_AUTOMATON };
+
+	for( size_t i = 0; i < sizeof( indexesList ); i++ )
+	{
+		const uint8_t indexes = indexesList[i];
+		const size_t size			= dzcobs_dictfile_size( s_TEST_Dictionary, sizeof( s_TEST_Dictionary ), indexes );
+
+		CHECK( size > sizeof( sDZCOBS_dictfile_header ) );
+		CHECK( size <= sizeof( m_image ) );
+		CHECK_EQUAL( 0, size % DZCOBS_DICTFILE_ALIGNMENT );
+
+		CHECK_EQUAL(
+			DICT_RET_SUCCESS,
+			dzcobs_dictfile_write( s_TEST_Dictionary, sizeof( s_TEST_Dictionary ), indexes, m_image, size, &m_imageLen ) );
+		CHECK_EQUAL( size, m_imageLen );
+
+		sDICT_ctx loaded;
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+
+		CHECK_EQUAL( expected.minWordSize, loaded.minWordSize );
+		CHECK_EQUAL( expected.maxWordSize, loaded.maxWordSize );
+		CHECK( ( loaded.wordSizeTable[0].pPackedKeys != NULL ) == ( ( indexes & DZCOBS_DICTFILE_PACKED ) != 0 ) );
+		CHECK( ( loaded.pTransitions != NULL ) == ( ( indexes & DZCOBS_DICTFILE_AUTOMATON ) != 0 ) );
+
+		// Words are read from the image
+		for( uint8_t wordIdx = 0; wordIdx < 7; wordIdx++ )
+		{
+			uint8_t sizeExpected = 0;
+			uint8_t sizeLoaded	 = 0;
+
+			const uint8_t *pExpected = dzcobs_dictionary_get( &expected, wordIdx, &sizeExpected );
+			const uint8_t *pLoaded	 = dzcobs_dictionary_get( &loaded, wordIdx, &sizeLoaded );
+
+			CHECK_EQUAL( sizeExpected, sizeLoaded );
+			CHECK_EQUAL( 0, memcmp( pExpected, pLoaded, sizeLoaded ) );
+			CHECK( pLoaded > (const uint8_t *)m_image );
+			CHECK( pLoaded < ( (const uint8_t *)m_image + m_imageLen ) );
+		}
+
+		check_same_search( &expected, &loaded, data, sizeof( data ) - 1 );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_DICTFILE, SameImage )
+// NOLINTEND
+{
+	static uint64_t other[UTEST_DICTFILE_MAX_SIZE / sizeof( uint64_t )];
+	size_t otherLen = 0;
+
+	const uint8_t indexes = DZCOBS_DICTFILE_PACKED | DZCOBS_DICTFILE_AUTOMATON;
+
+	memset( other, 0xA5, sizeof( other ) );
+
+	const char *pDict		 = G_DZCOBS_DefaultDictionary;
+	const size_t dictSize = G_DZCOBS_DefaultDictionary_size;
+
+	CHECK_EQUAL( DICT_RET_SUCCESS,
+							 dzcobs_dictfile_write( pDict, dictSize, indexes, m_image, sizeof( m_image ), &m_imageLen ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictfile_write( pDict, dictSize, indexes, other, sizeof( other ), &otherLen ) );
+
+	CHECK_EQUAL( m_imageLen, otherLen );
+	CHECK_EQUAL( 0, memcmp( m_image, other, m_imageLen ) );
+
+	// A copy at another address loads too, the image has no pointers
+	sDICT_ctx loaded;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictfile_load( &loaded, other, otherLen ) );
+
+	const sDZCOBS_dictfile_header *pHeader = (const sDZCOBS_dictfile_header *)m_image;
+	CHECK_EQUAL( 0, memcmp( pHeader->magic, DZCOBS_DICTFILE_MAGIC, 4 ) );
+	CHECK_EQUAL( DZCOBS_DICTFILE_VERSION, pHeader->version );
+	CHECK_EQUAL( G_DZCOBS_DefaultDictionary_size, pHeader->dictionarySize );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_DICTFILE, Corrupted )
+// NOLINTEND
+{
+	const uint8_t indexes = DZCOBS_DICTFILE_PACKED | DZCOBS_DICTFILE_AUTOMATON;
+
+	const char *pDict		 = s_TEST_Dictionary;
+	const size_t dictSize = sizeof( s_TEST_Dictionary );
+
+	CHECK_EQUAL( DICT_RET_SUCCESS,
+							 dzcobs_dictfile_write( pDict, dictSize, indexes, m_image, sizeof( m_image ), &m_imageLen ) );
+
+	uint8_t *pImage = (uint8_t *)m_image;
+	sDICT_ctx loaded;
+
+	// Any flipped bit is detected, by the header checks or by the checksum
+	for( size_t i = 0; i < m_imageLen; i++ )
+	{
+		for( uint8_t bit = 0; bit < 8; bit++ )
+		{
+			pImage[i] ^= (uint8_t)( 1 << bit );
+
+			CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+
+			pImage[i] ^= (uint8_t)( 1 << bit );
+		}
+	}
+
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen - 1 ) );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, sizeof( sDZCOBS_dictfile_header ) - 1 ) );
+
+	// A valid checksum does not make bad offsets loadable
+	sDZCOBS_dictfile_header *pHeader = (sDZCOBS_dictfile_header *)m_image;
+	pHeader->groups[1].wordsOffset += 4;
+	reseal( m_image, m_imageLen );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+	pHeader->groups[1].wordsOffset -= 4;
+
+	pHeader->automatonSize += 2;
+	reseal( m_image, m_imageLen );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+	pHeader->automatonSize -= 2;
+
+	pHeader->packedSize -= 8;
+	reseal( m_image, m_imageLen );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+	pHeader->packedSize += 8;
+
+	// An automaton transition to a state that does not exist
+	uint16_t *pTransitions = (uint16_t *)( pImage + pHeader->automatonOffset + DICT_AUTOMATON_BYTECLASS_SIZE );
+	const uint16_t transition = pTransitions[0];
+	pTransitions[0]						= 0x7FFF;
+	reseal( m_image, m_imageLen );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+	pTransitions[0] = transition;
+
+	// Words of the 3 bytes group swapped, so they are no longer sorted
+	uint8_t *pWords = pImage + pHeader->groups[1].wordsOffset;
+	uint8_t word[4];
+	memcpy( word, pWords, sizeof( word ) );
+	memcpy( pWords, pWords + 4, sizeof( word ) );
+	memcpy( pWords + 4, word, sizeof( word ) );
+	reseal( m_image, m_imageLen );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+	memcpy( pWords + 4, pWords, sizeof( word ) );
+	memcpy( pWords, word, sizeof( word ) );
+
+	// A size character that does not match its group
+	pWords[4] = '4';
+	reseal( m_image, m_imageLen );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+	pWords[4] = '3';
+
+	// Packed indexes in range, but swapped, so each key finds the other word
+	uint8_t *pIndex					= pImage + pHeader->groups[0].packedIndexOffset;
+	const uint8_t index1		= pIndex[1];
+	pIndex[1]								= pIndex[2];
+	pIndex[2]								= index1;
+	reseal( m_image, m_imageLen );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+	pIndex[2] = pIndex[1];
+	pIndex[1] = index1;
+
+	// A match of another word, and a match that no word reaches
+	size_t matchIdx = 0;
+
+	while( ( pTransitions[matchIdx] & DICT_AUTOMATON_MATCH ) == 0 )
+	{
+		matchIdx++;
+	}
+
+	const uint16_t match		 = pTransitions[matchIdx];
+	pTransitions[matchIdx] = (uint16_t)( DICT_AUTOMATON_MATCH | ( ( match & ~DICT_AUTOMATON_MATCH ) % 7 + 1 ) );
+	CHECK( pTransitions[matchIdx] != match );
+	reseal( m_image, m_imageLen );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+	pTransitions[matchIdx] = match;
+
+	size_t freeIdx = 0;
+
+	while( pTransitions[freeIdx] != 0 )
+	{
+		freeIdx++;
+	}
+
+	pTransitions[freeIdx] = match;
+	reseal( m_image, m_imageLen );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+	pTransitions[freeIdx] = 0;
+
+	reseal( m_image, m_imageLen );
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictfile_load( &loaded, m_image, m_imageLen ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_DICTFILE, BadArgs )
+// NOLINTEND
+{
+	static const char notSorted[] = DICT_ADD_WORD( 2, "er" ) DICT_ADD_WORD( 2, "\r\n" );
+
+	const char *pDict		 = s_TEST_Dictionary;
+	const size_t dictSize = sizeof( s_TEST_Dictionary );
+
+	sDICT_ctx loaded;
+
+	CHECK_EQUAL( 0, dzcobs_dictfile_size( notSorted, sizeof( notSorted ), 0 ) );
+	CHECK_EQUAL( DICT_RET_ERR_INVALID,
+							 dzcobs_dictfile_write( notSorted, sizeof( notSorted ), 0, m_image, sizeof( m_image ), &m_imageLen ) );
+
+	uint8_t *pUnaligned = (uint8_t *)m_image + 4;
+
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG,
+							 dzcobs_dictfile_write( NULL, dictSize, 0, m_image, sizeof( m_image ), &m_imageLen ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG,
+							 dzcobs_dictfile_write( pDict, dictSize, 0, NULL, sizeof( m_image ), &m_imageLen ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictfile_write( pDict, dictSize, 0, m_image, sizeof( m_image ), NULL ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG,
+							 dzcobs_dictfile_write( pDict, dictSize, 0x80, m_image, sizeof( m_image ), &m_imageLen ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG,
+							 dzcobs_dictfile_write( pDict, dictSize, 0, pUnaligned, sizeof( m_image ) - 4, &m_imageLen ) );
+
+	const size_t size = dzcobs_dictfile_size( pDict, dictSize, 0 );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictfile_write( pDict, dictSize, 0, m_image, size - 1, &m_imageLen ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictfile_write( pDict, dictSize, 0, m_image, size, &m_imageLen ) );
+
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictfile_load( NULL, m_image, m_imageLen ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictfile_load( &loaded, NULL, m_imageLen ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictfile_load( &loaded, pUnaligned, m_imageLen ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,8 @@
 #include <CppUTest/TestHarness.h>
 #include <CppUTest/UtestMacros.h>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <dzcobs/dzcobs_dictionary.h>
 
 // Definitions
@@ -170,5 +172,289 @@ TEST( DICTIONARY, SearchKey )
 
 // NOLINTEND
 
+// NOLINTBEGIN
+TEST( DICTIONARY, SearchKeyOnLastWordSize )
+{
+	// Word sizes skip 3 and the last size has more than one word
+	// clang-format off
+	static const char dictionary[] =
+		DICT_ADD_WORD(2, "\x01\x02")
+		DICT_ADD_WORD(4, "\x10\x11\x12\x13")
+		DICT_ADD_WORD(4, "\x20\x21\x22\x23")
+		DICT_ADD_WORD(4, "\x30\x31\x32\x33")
+	;
+	// clang-format on
+
+	CHECK_EQUAL( DICT_IS_VALID, dzcobs_dictionary_isvalid( dictionary, sizeof( dictionary ) ) );
+
+	sDICT_ctx dictCtx;
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, dictionary, sizeof( dictionary ) ) );
+
+	uint8_t ret = 0;
+	size_t keySizeFound;
+
+	ret = dzcobs_dictionary_search( &dictCtx, (uint8_t[]){ 0x01, 0x02 }, 2, &keySizeFound );
+	CHECK_EQUAL( 1, ret );
+	CHECK_EQUAL( 2, keySizeFound );
+
+	ret = dzcobs_dictionary_search( &dictCtx, (uint8_t[]){ 0x10, 0x11, 0x12, 0x13 }, 4, &keySizeFound );
+	CHECK_EQUAL( 2, ret );
+
+	ret = dzcobs_dictionary_search( &dictCtx, (uint8_t[]){ 0x30, 0x31, 0x32, 0x33, 0x34 }, 5, &keySizeFound );
+	CHECK_EQUAL( 4, ret );
+	CHECK_EQUAL( 4, keySizeFound );
+
+	ret = dzcobs_dictionary_search( &dictCtx, (uint8_t[]){ 0x30, 0x31, 0x32 }, 3, &keySizeFound );
+	CHECK_EQUAL( 0, ret );
+
+	uint8_t wordSize = 0;
+	const uint8_t *pWord = dzcobs_dictionary_get( &dictCtx, 3, &wordSize );
+	CHECK( pWord != NULL );
+	CHECK_EQUAL( 4, wordSize );
+	CHECK_EQUAL( 0x30, pWord[0] );
+
+	CHECK( dzcobs_dictionary_get( &dictCtx, 4, &wordSize ) == NULL );
+}
+
+// NOLINTEND
+
+/// Compare the automaton search with the binary search, for every key position and size
+/// Compares the automaton and the packed keys searches with the binary search
+static void check_search_engines( const char *aDictionary, size_t aDictionarySize )
+{
+	sDICT_ctx dictBinary;
+	sDICT_ctx dictAutomaton;
+	sDICT_ctx dictPacked;
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictBinary, aDictionary, aDictionarySize ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictAutomaton, aDictionary, aDictionarySize ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictPacked, aDictionary, aDictionarySize ) );
+
+	const size_t automatonSize = dzcobs_dictionary_automaton_size( &dictAutomaton );
+	uint16_t *pAutomaton			 = new uint16_t[( automatonSize + 1 ) / 2];
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_automaton_init( &dictAutomaton, pAutomaton, automatonSize ) );
+
+	const size_t packedSize = dzcobs_dictionary_packed_size( &dictPacked );
+	uint64_t *pPacked				= new uint64_t[( packedSize + 7 ) / 8];
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_packed_init( &dictPacked, pPacked, packedSize ) );
+
+	// Data made of the dictionary bytes, so there are many full and partial matches
+	uint8_t data[2048];
+
+	for( size_t i = 0; i < sizeof( data ); i++ )
+	{
+		const size_t dictIdx = (size_t)rand() % ( aDictionarySize - 1 );
+		data[i]							 = ( ( rand() % 16 ) == 0 ) ? (uint8_t)rand() : (uint8_t)aDictionary[dictIdx];
+	}
+
+	for( size_t i = 0; i < sizeof( data ); i++ )
+	{
+		for( size_t keySize = 1; keySize <= 6; keySize++ )
+		{
+			if( ( i + keySize ) > sizeof( data ) )
+			{
+				break;
+			}
+
+			size_t sizeBinary		 = 0;
+			size_t sizeAutomaton = 0;
+			size_t sizePacked		 = 0;
+
+			const uint8_t idxBinary		 = dzcobs_dictionary_search( &dictBinary, &data[i], keySize, &sizeBinary );
+			const uint8_t idxAutomaton = dzcobs_dictionary_search( &dictAutomaton, &data[i], keySize, &sizeAutomaton );
+			const uint8_t idxPacked		 = dzcobs_dictionary_search( &dictPacked, &data[i], keySize, &sizePacked );
+
+			CHECK_EQUAL( idxBinary, idxAutomaton );
+			CHECK_EQUAL( idxBinary, idxPacked );
+
+			if( idxBinary != 0 )
+			{
+				CHECK_EQUAL( sizeBinary, sizeAutomaton );
+				CHECK_EQUAL( sizeBinary, sizePacked );
+			}
+		}
+	}
+
+	// Every word is found by its own bytes
+	const uint8_t nWords = (uint8_t)( dictBinary.wordSizeTable[0].nEntries + dictBinary.wordSizeTable[1].nEntries +
+																		dictBinary.wordSizeTable[2].nEntries + dictBinary.wordSizeTable[3].nEntries );
+
+	for( uint8_t wordIdx = 0; wordIdx < nWords; wordIdx++ )
+	{
+		uint8_t wordSize		 = 0;
+		const uint8_t *pWord = dzcobs_dictionary_get( &dictBinary, wordIdx, &wordSize );
+
+		size_t sizeBinary = 0;
+		size_t sizePacked = 0;
+
+		CHECK_EQUAL( dzcobs_dictionary_search( &dictBinary, pWord, wordSize, &sizeBinary ),
+								 dzcobs_dictionary_search( &dictPacked, pWord, wordSize, &sizePacked ) );
+		CHECK_EQUAL( sizeBinary, sizePacked );
+	}
+
+	delete[] pAutomaton;
+	delete[] pPacked;
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY, SearchEngines )
+// NOLINTEND
+{
+	srand( 1 );
+
+	// "\x01\x00" shadows "\x01\x00\x00" and the longer ones
+	check_search_engines( s_TEST_Dictionary, s_TEST_Dictionary_size );
+	check_search_engines( G_DZCOBS_DefaultDictionary, G_DZCOBS_DefaultDictionary_size );
+
+	// clang-format off
+	static const char dictionaryText[] =
+		DICT_ADD_WORD(2, "\r\n")
+		DICT_ADD_WORD(2, "er")
+		DICT_ADD_WORD(3, "\":\"")
+		DICT_ADD_WORD(3, "the")
+		DICT_ADD_WORD(4, "temp")
+		DICT_ADD_WORD(4, "ther")
+		DICT_ADD_WORD(5, "\"id\":")
+		DICT_ADD_WORD(5, "error")
+		DICT_ADD_WORD(5, "state")
+	;
+	// clang-format on
+
+	check_search_engines( dictionaryText, sizeof( dictionaryText ) );
+
+	// Full dictionary, the words of each size fill several Eytzinger levels
+	static char dictionaryFull[126 * 6 + 1];
+	char *pDict = dictionaryFull;
+
+	for( int i = 0; i < 126; i++ )
+	{
+		const int wordSize = 2 + ( i / 32 );
+		const int wordIdx	 = i % 32;
+
+		*pDict++ = (char)( '0' + wordSize );
+
+		for( int j = 0; j < wordSize; j++ )
+		{
+			// Sorted, with bytes above 0x7F so the keys are compared unsigned
+			*pDict++ = (char)( ( j == 0 ) ? ( 0x70 + ( wordIdx * 4 ) ) : ( 0xFF - j ) );
+		}
+	}
+
+	*pDict++ = 0;
+
+	check_search_engines( dictionaryFull, (size_t)( pDict - dictionaryFull ) );
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY, AutomatonSize )
+// NOLINTEND
+{
+	// Classes: 0x00, 0x01, 0x0A, 0x0D and the others
+	// States: start, "\x00", "\x01", "\x0D" (the 3 bytes words are shadowed by the 2 bytes ones)
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS,
+							 dzcobs_dictionary_init( &dictCtx, G_DZCOBS_DefaultDictionary, G_DZCOBS_DefaultDictionary_size ) );
+
+	const size_t automatonSize = dzcobs_dictionary_automaton_size( &dictCtx );
+	CHECK_EQUAL( DICT_AUTOMATON_BYTECLASS_SIZE + ( 4 * 5 * sizeof( uint16_t ) ), automatonSize );
+
+	uint16_t automaton[( DICT_AUTOMATON_BYTECLASS_SIZE + ( 4 * 5 * sizeof( uint16_t ) ) ) / 2 + 1];
+
+	CHECK_EQUAL( 0, dzcobs_dictionary_automaton_size( NULL ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictionary_automaton_init( NULL, automaton, sizeof( automaton ) ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictionary_automaton_init( &dictCtx, NULL, sizeof( automaton ) ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG,
+							 dzcobs_dictionary_automaton_init( &dictCtx, (uint8_t *)automaton + 1, sizeof( automaton ) - 1 ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictionary_automaton_init( &dictCtx, automaton, automatonSize - 1 ) );
+	CHECK( dictCtx.pTransitions == NULL );
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_automaton_init( &dictCtx, automaton, automatonSize ) );
+	CHECK( dictCtx.pTransitions != NULL );
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY, PackedSize )
+// NOLINTEND
+{
+	// Each word size has 4 words, that is 5 keys and 5 index bytes, rounded to 8:
+	// 2 bytes words in uint16_t keys (16 + 8), 3 bytes words in uint32_t keys (24 + 8)
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS,
+							 dzcobs_dictionary_init( &dictCtx, G_DZCOBS_DefaultDictionary, G_DZCOBS_DefaultDictionary_size ) );
+
+	const size_t packedSize = dzcobs_dictionary_packed_size( &dictCtx );
+	CHECK_EQUAL( 16 + 8 + 24 + 8, packedSize );
+
+	uint64_t packed[( 16 + 8 + 24 + 8 ) / 8 + 1];
+
+	CHECK_EQUAL( 0, dzcobs_dictionary_packed_size( NULL ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictionary_packed_init( NULL, packed, sizeof( packed ) ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictionary_packed_init( &dictCtx, NULL, sizeof( packed ) ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG,
+							 dzcobs_dictionary_packed_init( &dictCtx, (uint8_t *)packed + 4, sizeof( packed ) - 4 ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_dictionary_packed_init( &dictCtx, packed, packedSize - 1 ) );
+	CHECK( dictCtx.wordSizeTable[0].pPackedKeys == NULL );
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_packed_init( &dictCtx, packed, packedSize ) );
+	CHECK( dictCtx.wordSizeTable[0].pPackedKeys != NULL );
+	CHECK( dictCtx.wordSizeTable[1].pPackedKeys != NULL );
+}
+
+/// Matcher of a single word, as generated by dzcobs_dict gen
+static uint8_t utest_matcher_search( const uint8_t *aSearchKey, size_t aSearchKeySize, size_t *aOutKeySizeFound )
+{
+	if( ( aSearchKeySize >= 3 ) && ( memcmp( aSearchKey, "abc", 3 ) == 0 ) )
+	{
+		*aOutKeySizeFound = 3;
+		return 1;
+	}
+
+	return 0;
+}
+
+static const uint8_t *utest_matcher_get( uint8_t aIndex, uint8_t *aOutWordSize )
+{
+	if( aIndex != 0 )
+	{
+		return NULL;
+	}
+
+	*aOutWordSize = 3;
+	return (const uint8_t *)"abc";
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY, GeneratedMatcher )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS,
+							 dzcobs_dictionary_init( &dictCtx, G_DZCOBS_DefaultDictionary, G_DZCOBS_DefaultDictionary_size ) );
+	POINTERS_EQUAL( NULL, (void *)dictCtx.searchFunc );
+	POINTERS_EQUAL( NULL, (void *)dictCtx.getFunc );
+
+	dictCtx.searchFunc = utest_matcher_search;
+	dictCtx.getFunc		 = utest_matcher_get;
+
+	static const uint8_t data[] = "abcdef";
+	size_t sizeFound						= 0;
+
+	CHECK_EQUAL( 1, dzcobs_dictionary_search( &dictCtx, data, sizeof( data ) - 1, &sizeFound ) );
+	CHECK_EQUAL( 3, sizeFound );
+
+	// The key size is limited to the dictionary word sizes before the matcher is called
+	CHECK_EQUAL( 0, dzcobs_dictionary_search( &dictCtx, data, dictCtx.minWordSize - 1, &sizeFound ) );
+	CHECK_EQUAL( 0, dzcobs_dictionary_search( &dictCtx, &data[1], sizeof( data ) - 2, &sizeFound ) );
+
+	uint8_t wordSize			 = 0;
+	const uint8_t *pWord = dzcobs_dictionary_get( &dictCtx, 0, &wordSize );
+	CHECK_EQUAL( 3, wordSize );
+	MEMCMP_EQUAL( "abc", pWord, 3 );
+	POINTERS_EQUAL( NULL, dzcobs_dictionary_get( &dictCtx, 1, &wordSize ) );
+}
+
 // EOF
 // /////////////////////////////////////////////////////////////////////////////
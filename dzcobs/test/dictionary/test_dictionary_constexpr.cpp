@@ -0,0 +1,212 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_dictionary_constexpr.cpp
+///	@brief Tests the dictionary checked and indexed at compile time
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstring>
+#include <dzcobs/dzcobs_dictionary.hpp>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+#define UTEST_DICTIONARY \
+	DICT_ADD_WORD(2, "\r\n") \
+	DICT_ADD_WORD(2, "er") \
+	DICT_ADD_WORD(2, "\xF0\x9F") \
+	DICT_ADD_WORD(3, "\":\"") \
+	DICT_ADD_WORD(3, "the") \
+	DICT_ADD_WORD(3, "\xFF\x00\x01") \
+	DICT_ADD_WORD(4, "temp") \
+	DICT_ADD_WORD(5, "\"id\":") \
+	DICT_ADD_WORD(5, "error") \
+	DICT_ADD_WORD(5, "state")
+
+static const char s_TEST_Dictionary[] = UTEST_DICTIONARY;
+
+DZCOBS_CONSTEXPR_DICTIONARY( s_TEST_ConstexprDictionary, UTEST_DICTIONARY );
+
+// The same checks of dzcobs_dictionary_isvalid
+static_assert( dzcobs::dictionary_isvalid( UTEST_DICTIONARY ) == DICT_IS_VALID, "" );
+static_assert( dzcobs::dictionary_isvalid(
+	DICT_ADD_WORD(2, "bb") DICT_ADD_WORD(2, "aa") ) == DICT_INVALID_NOT_SORTED, "" );
+static_assert( dzcobs::dictionary_isvalid(
+	DICT_ADD_WORD(2, "aa") DICT_ADD_WORD(2, "aa") ) == DICT_INVALID_NOT_SORTED, "" );
+static_assert( dzcobs::dictionary_isvalid( DICT_ADD_WORD(6, "abcdef") ) == DICT_INVALID_WORDSIZE, "" );
+static_assert( dzcobs::dictionary_isvalid( DICT_ADD_WORD(1, "a") ) == DICT_INVALID_WORDSIZE, "" );
+static_assert( dzcobs::dictionary_isvalid( "3ab" ) == DICT_INVALID_OUTOFBOUNDS, "" );
+static_assert( dzcobs::dictionary_isvalid( "2ab\0" "2cd" ) == DICT_INVALID_EARLIER_END, "" );
+static_assert( dzcobs::dictionary_isvalid(
+	DICT_ADD_WORD(2, "aa") DICT_ADD_WORD(3, "aaa") DICT_ADD_WORD(4, "aaaa") DICT_ADD_WORD(5, "aaaaa")
+	DICT_ADD_WORD(2, "bb") ) == DICT_INVALID_NUMBER_OF_WORDSIZES, "" );
+
+// Sizes must also be ascending
+static_assert( !dzcobs::dictionary_words( DICT_ADD_WORD(3, "aaa") DICT_ADD_WORD(2, "aa") ).isAscending, "" );
+static_assert( dzcobs::dictionary_words( DICT_ADD_WORD(2, "aa") DICT_ADD_WORD(4, "aaaa") ).isAscending, "" );
+
+// Precomputed context
+static_assert( s_TEST_ConstexprDictionary.minWordSize == 2, "" );
+static_assert( s_TEST_ConstexprDictionary.maxWordSize == 5, "" );
+static_assert( s_TEST_ConstexprDictionary.wordSizeTable[2].nEntries == 1, "" );
+static_assert( s_TEST_ConstexprDictionary.wordSizeTable[3].globalIndex == 8, "" );
+static_assert( s_TEST_ConstexprDictionary_index.keys32[4 + 1] == 0x74656D70, "" ); // "temp", the 4 bytes group root
+// NOLINTEND
+// clang-format on
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DICTIONARY_CONSTEXPR ){
+	void setup()
+	{
+		eDICT_ret ret = dzcobs_dictionary_init( &m_dictCtx, s_TEST_Dictionary, sizeof( s_TEST_Dictionary ) );
+		CHECK_EQUAL( DICT_RET_SUCCESS, ret );
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx m_dictCtx;
+};
+// NOLINTEND
+// clang-format on
+
+/// Both contexts must find the same words on every position of aData
+static void check_same_search( const sDICT_ctx *aExpected, const sDICT_ctx *aCtx, const uint8_t *aData, size_t aSize )
+{
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		size_t sizeExpected = 0;
+		size_t size					= 0;
+
+		const uint8_t idxExpected = dzcobs_dictionary_search( aExpected, &aData[i], aSize - i, &sizeExpected );
+		const uint8_t idx					= dzcobs_dictionary_search( aCtx, &aData[i], aSize - i, &size );
+
+		CHECK_EQUAL( idxExpected, idx );
+		CHECK_EQUAL( sizeExpected, size );
+	}
+}
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DICTIONARY_CONSTEXPR, SameContext )
+// NOLINTEND
+{
+	const sDICT_ctx *pCtx = &s_TEST_ConstexprDictionary;
+
+	CHECK_EQUAL( m_dictCtx.minWordSize, pCtx->minWordSize );
+	CHECK_EQUAL( m_dictCtx.maxWordSize, pCtx->maxWordSize );
+	POINTERS_EQUAL( NULL, pCtx->pTransitions );
+
+	for( size_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *pExpected = &m_dictCtx.wordSizeTable[i];
+		const sDICT_wordentry *pEntry		 = &pCtx->wordSizeTable[i];
+
+		CHECK_EQUAL( pExpected->nEntries, pEntry->nEntries );
+		CHECK_EQUAL( pExpected->lastIndex, pEntry->lastIndex );
+		CHECK_EQUAL( pExpected->globalIndex, pEntry->globalIndex );
+		CHECK_EQUAL( pExpected->strideSize, pEntry->strideSize );
+
+		if( pExpected->nEntries > 0 )
+		{
+			MEMCMP_EQUAL( pExpected->dictionaryBegin, pEntry->dictionaryBegin, pExpected->nEntries * pExpected->strideSize );
+			CHECK( pEntry->pPackedKeys != NULL );
+			CHECK( pEntry->pPackedIndex != NULL );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY_CONSTEXPR, SamePackedKeys )
+// NOLINTEND
+{
+	sDICT_ctx packedCtx = m_dictCtx;
+	uint64_t mem[64];
+
+	CHECK( dzcobs_dictionary_packed_size( &packedCtx ) <= sizeof( mem ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_packed_init( &packedCtx, mem, sizeof( mem ) ) );
+
+	for( size_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *pExpected = &packedCtx.wordSizeTable[i];
+		const sDICT_wordentry *pEntry		 = &s_TEST_ConstexprDictionary.wordSizeTable[i];
+
+		if( pExpected->nEntries > 0 )
+		{
+			const size_t n = pExpected->nEntries + 1u;
+
+			MEMCMP_EQUAL( pExpected->pPackedKeys,
+										pEntry->pPackedKeys,
+										n * dzcobs::dictionary_packed_keysize( pExpected->strideSize - 1u ) );
+			MEMCMP_EQUAL( pExpected->pPackedIndex, pEntry->pPackedIndex, n );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY_CONSTEXPR, Search )
+// NOLINTEND
+{
+	static const uint8_t data[] =
+		"{\"id\":12,\"temp\":\"the error\",\"state\":\"ok\"}\r\n\xF0\x9F\xFF\x00\x01the\xFF\x00\x02 state \r";
+
+	check_same_search( &m_dictCtx, &s_TEST_ConstexprDictionary, data, sizeof( data ) - 1 );
+
+	// Every word is read back, and searched by its own bytes
+	for( uint8_t wordIdx = 0; wordIdx < 10; wordIdx++ )
+	{
+		uint8_t sizeExpected					= 0;
+		uint8_t size									= 0;
+		const uint8_t *pWordExpected = dzcobs_dictionary_get( &m_dictCtx, wordIdx, &sizeExpected );
+		const uint8_t *pWord				 = dzcobs_dictionary_get( &s_TEST_ConstexprDictionary, wordIdx, &size );
+
+		CHECK_EQUAL( sizeExpected, size );
+		MEMCMP_EQUAL( pWordExpected, pWord, size );
+
+		check_same_search( &m_dictCtx, &s_TEST_ConstexprDictionary, pWord, size );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY_CONSTEXPR, FunctionScope )
+// NOLINTEND
+{
+	// clang-format off
+	DZCOBS_CONSTEXPR_DICTIONARY( dict, DICT_ADD_WORD(2, "ab") DICT_ADD_WORD(4, "wxyz") );
+	// clang-format on
+
+	static const uint8_t data[] = "xxwxyzxab";
+
+	size_t sizeFound = 0;
+	CHECK_EQUAL( 2, dzcobs_dictionary_search( &dict, &data[2], sizeof( data ) - 3, &sizeFound ) );
+	CHECK_EQUAL( 4, sizeFound );
+	CHECK_EQUAL( 1, dzcobs_dictionary_search( &dict, &data[7], 2, &sizeFound ) );
+	CHECK_EQUAL( 2, sizeFound );
+	CHECK_EQUAL( 0, dzcobs_dictionary_search( &dict, &data[0], 2, &sizeFound ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
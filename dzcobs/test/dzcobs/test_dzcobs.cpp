@@ -26,6 +26,7 @@
 #include <cstring>
 #include <dzcobs/dzcobs.h>
 #include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_stats.h>
 
 // Definitions
 // /////////////////////////////////////////////////////////////////////////////
@@ -181,6 +182,9 @@ static uint8_t s_dzcobs_datatest_dictionary[] = {
 	// 19
 	7, 0x00, 0x01, 0x01, 0x00, 0x01, 0x01, 0x00,		// decoded
 	6 + DZCOBS_FRAME_HEADER_SIZE, 0x01, 0x80 + 0, 0x01, 0x80 + 0, 0x01, 0x01, ( TEST_USERBITS << 2 ) | 1 /*Encoding*/, 0x08 /*CHECKSUM*/,	// encoded
+	// 20, the 0x00 after 'A' would be lost by a dictionary code, so the word is encoded plain
+	4, 'A', 0x00, 0x01, 0x01,		// decoded
+	5 + DZCOBS_FRAME_HEADER_SIZE, 0x02, 'A', 0x03, 0x01, 0x01, ( TEST_USERBITS << 2 ) | 1 /*Encoding*/, 0x38 /*CHECKSUM*/,	// encoded
 };
 
 // NOLINTEND
@@ -1030,6 +1034,8 @@ TEST( DZCOBS, EncodeDecode0xFFJumpDictionary )
 	decodeCtx.srcBufEncodedLen	= encodedLen;
 	decodeCtx.dstBufDecoded			= decoded_new + UTEST_GUARD_SIZE;
 	decodeCtx.dstBufDecodedSize = decodedDataSize;
+	decodeCtx.pDict[0]					= &dictCtx;
+	decodeCtx.pDict[1]					= NULL;
 
 	uint8_t user6bitDataRightAlgn = 0;
 
@@ -1311,5 +1317,1204 @@ TEST( DZCOBS, EncodeDecodeLongRandomDictionary )
 	CHECK_EQUAL( 0, memcmp( decodedData, decodeCtx.dstBufDecoded, decodedLen ) );
 }
 
+// NOLINTBEGIN
+TEST( DZCOBS, EncodeDecodeJumpAcrossCalls )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static constexpr size_t decodedDataSize = 600;
+	uint8_t decodedData[decodedDataSize];
+
+	for( size_t i = 0; i < decodedDataSize; i++ )
+	{
+		decodedData[i] = (uint8_t)( 0x10 + ( i % 0x20 ) );
+	}
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 };
+
+	for( const eDZCOBS_encoding encoding : encodings )
+	{
+		// First call ends exactly when a run reaches the jump code
+		const size_t firstCallSize = ( encoding == DZCOBS_PLAIN ) ? ( DZCOBS_CODE_JUMP_PLAIN - 1 )
+																															: ( DZCOBS_CODE_JUMP_DICTIONARY - 1 );
+
+		sDZCOBS_ctx ctx;
+
+		dzcobs_encode_set_dictionary( &ctx, &dictCtx, DZCOBS_USING_DICT_1 );
+
+		eDZCOBS_ret ret = dzcobs_encode_inc_begin( &ctx, encoding, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+
+		ctx.user6bits = TEST_USERBITS;
+
+		ret = dzcobs_encode_inc( &ctx, decodedData, firstCallSize );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+
+		ret = dzcobs_encode_inc( &ctx, decodedData + firstCallSize, decodedDataSize - firstCallSize );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+
+		size_t encodedLen = 0;
+
+		ret = dzcobs_encode_inc_end( &ctx, &encodedLen );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+
+		uint8_t decoded_new[decodedDataSize];
+
+		sDZCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= buffer;
+		decodeCtx.srcBufEncodedLen	= encodedLen;
+		decodeCtx.dstBufDecoded			= decoded_new;
+		decodeCtx.dstBufDecodedSize = decodedDataSize;
+		decodeCtx.pDict[0]					= &dictCtx;
+
+		size_t decodedLen							= 0;
+		uint8_t user6bitDataRightAlgn = 0;
+
+		ret = dzcobs_decode( &decodeCtx, &decodedLen, &user6bitDataRightAlgn );
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( decodedDataSize, decodedLen );
+		CHECK_EQUAL( 0, memcmp( decodedData, decoded_new, decodedLen ) );
+	}
+}
+
+/// Encodes aData with aEncoding, returns the encoded length and the encoding used
+static size_t encode_with( const sDICT_ctx *aDict,
+													 eDZCOBS_encoding aEncoding,
+													 const uint8_t *aData,
+													 size_t aDataSize,
+													 uint8_t *aDst,
+													 size_t aDstSize,
+													 eDZCOBS_encoding *aOutEncoding )
+{
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, aDict, DZCOBS_USING_DICT_1 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, aEncoding, aDst, aDstSize ) );
+
+	ctx.user6bits = TEST_USERBITS;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, aData, aDataSize ) );
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	*aOutEncoding = ctx.encoding;
+
+	return encodedLen;
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS, EncodeAuto )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size ) );
+
+	static constexpr size_t dataSize = 600;
+	uint8_t wordsData[dataSize];
+	uint8_t runsData[dataSize];
+
+	for( size_t i = 0; i < dataSize; i++ )
+	{
+		// Dictionary words, and long runs without any word
+		wordsData[i] = ( i % 3 == 2 ) ? 0x20 : 0x01;
+		runsData[i]	 = (uint8_t)( 0x10 + ( i % 0x20 ) );
+	}
+
+	uint8_t expected[UTEST_ENCODED_DECODED_DATA_MAX_SIZE];
+	eDZCOBS_encoding encoding = DZCOBS_AUTO;
+
+	const struct
+	{
+		const uint8_t *pData;
+		eDZCOBS_encoding expectedEncoding;
+	} cases[] = { { wordsData, DZCOBS_USING_DICT_1 }, { runsData, DZCOBS_PLAIN } };
+
+	for( const auto &c : cases )
+	{
+		const size_t encodedLen =
+			encode_with( &dictCtx, DZCOBS_AUTO, c.pData, dataSize, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE, &encoding );
+		CHECK_EQUAL( c.expectedEncoding, encoding );
+
+		// The same frame of the selected encoding
+		const size_t expectedLen =
+			encode_with( &dictCtx, c.expectedEncoding, c.pData, dataSize, expected, sizeof( expected ), &encoding );
+		CHECK_EQUAL( expectedLen, encodedLen );
+		MEMCMP_EQUAL( expected, buffer, encodedLen );
+
+		uint8_t decoded[dataSize];
+
+		sDZCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= buffer;
+		decodeCtx.srcBufEncodedLen	= encodedLen;
+		decodeCtx.dstBufDecoded			= decoded;
+		decodeCtx.dstBufDecodedSize = dataSize;
+		decodeCtx.pDict[0]					= &dictCtx;
+		decodeCtx.pDict[1]					= NULL;
+
+		size_t decodedLen							= 0;
+		uint8_t user6bitDataRightAlgn = 0;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode( &decodeCtx, &decodedLen, &user6bitDataRightAlgn ) );
+		CHECK_EQUAL( dataSize, decodedLen );
+		MEMCMP_EQUAL( c.pData, decoded, dataSize );
+	}
+
+	// Without dictionaries, and without data, it is plain
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_encode_inc_begin( &ctx, DZCOBS_AUTO, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, wordsData, dataSize ) );
+	CHECK_EQUAL( DZCOBS_PLAIN, ctx.encoding );
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_encode_inc_begin( &ctx, DZCOBS_AUTO, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+	CHECK_EQUAL( DZCOBS_PLAIN, buffer[encodedLen - 2] & 0x03 );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS, DecodeOverflowClosingZero )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size ) );
+
+	static constexpr size_t dataSize = 300;
+	uint8_t data[dataSize];
+	uint8_t decoded[dataSize];
+
+	srand( 13 );
+
+	for( size_t i = 0; i < dataSize; i++ )
+	{
+		data[i] = ( ( rand() % 8 ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+
+		if( ( rand() % 3 ) == 0 )
+		{
+			data[i] = (uint8_t)( ( rand() % 4 ) + 1 );
+		}
+	}
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 };
+
+	for( const eDZCOBS_encoding encoding : encodings )
+	{
+		// Decoded to a buffer a byte short, the data ending or not with 0x00
+		for( size_t size = 2; size < dataSize; size += ( size < 64 ) ? 1 : 37 )
+		{
+			eDZCOBS_encoding usedEncoding = DZCOBS_AUTO;
+			const size_t encodedLen =
+				encode_with( &dictCtx, encoding, data, size, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE, &usedEncoding );
+
+			memset( decoded, UTEST_GUARD_BYTE, sizeof( decoded ) );
+
+			sDZCOBS_decodectx decodeCtx;
+			decodeCtx.srcBufEncoded			= buffer;
+			decodeCtx.srcBufEncodedLen	= encodedLen;
+			decodeCtx.dstBufDecoded			= decoded;
+			decodeCtx.dstBufDecodedSize = size - 1;
+			decodeCtx.pDict[0]					= &dictCtx;
+			decodeCtx.pDict[1]					= NULL;
+
+			size_t decodedLen	 = 0;
+			uint8_t user6bits = 0;
+
+			CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) );
+			CHECK_EQUAL( UTEST_GUARD_BYTE, decoded[size - 1] );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS, EncodeCheckpointRollback )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size ) );
+
+	static constexpr size_t dataSize = 400;
+	uint8_t data[dataSize];
+	uint8_t dropped[dataSize];
+
+	for( size_t i = 0; i < dataSize; i++ )
+	{
+		// Words, zeros and long runs, so the splits land on every kind of state
+		data[i]		 = ( i < 150 ) ? (uint8_t)( ( i % 3 == 2 ) ? 0x20 : 0x01 ) : (uint8_t)( ( i % 37 ) ? i : 0 );
+		dropped[i] = (uint8_t)( 0xFF - i );
+	}
+
+	uint8_t expected[UTEST_ENCODED_DECODED_DATA_MAX_SIZE];
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1, DZCOBS_AUTO };
+	const size_t splits[]							 = { 0, 1, 2, 3, 126, 127, 150, 253, 254, 255, 399 };
+
+	for( const eDZCOBS_encoding encoding : encodings )
+	{
+		for( const size_t split : splits )
+		{
+			sDZCOBS_ctx ctx;
+			sDZCOBS_checkpoint checkpoint;
+
+			// Data before the split, checkpoint, dropped data, rollback, data after the split
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, &dictCtx, DZCOBS_USING_DICT_1 ) );
+			ctx.pDict[1] = NULL;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+									 dzcobs_encode_inc_begin( &ctx, encoding, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+			ctx.user6bits = TEST_USERBITS;
+
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, data, split ) );
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_checkpoint( &ctx, &checkpoint ) );
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, dropped, dataSize - split ) );
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_rollback( &ctx, &checkpoint ) );
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, data + split, dataSize - split ) );
+
+			size_t encodedLen = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+			// The same data, without the dropped one
+			sDZCOBS_ctx expectedCtx;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &expectedCtx, &dictCtx, DZCOBS_USING_DICT_1 ) );
+			expectedCtx.pDict[1] = NULL;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+									 dzcobs_encode_inc_begin( &expectedCtx, encoding, expected, sizeof( expected ) ) );
+			expectedCtx.user6bits = TEST_USERBITS;
+
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &expectedCtx, data, split ) );
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &expectedCtx, data + split, dataSize - split ) );
+
+			size_t expectedLen = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &expectedCtx, &expectedLen ) );
+
+			CHECK_EQUAL( expectedLen, encodedLen );
+			MEMCMP_EQUAL( expected, buffer, encodedLen );
+		}
+	}
+
+	// A frame that does not fit, the last data is dropped and the frame ended again.
+	// The 16 bytes fit on the 1 + 16 bytes of payload, but not the frame tail.
+	sDZCOBS_ctx ctx;
+	sDZCOBS_checkpoint checkpoint;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, buffer, 1 + 16 + 1 ) );
+	ctx.user6bits = TEST_USERBITS;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, data, 8 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_checkpoint( &ctx, &checkpoint ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, data, 8 ) );
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_rollback( &ctx, &checkpoint ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	eDZCOBS_encoding encoding = DZCOBS_PLAIN;
+	const size_t expectedLen	= encode_with( &dictCtx, DZCOBS_PLAIN, data, 8, expected, sizeof( expected ), &encoding );
+	CHECK_EQUAL( expectedLen, encodedLen );
+	MEMCMP_EQUAL( expected, buffer, encodedLen );
+
+	// A checkpoint of a previous frame, or after the end of a frame
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_encode_checkpoint( &ctx, &checkpoint ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, buffer, 16 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_rollback( &ctx, &checkpoint ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_checkpoint( NULL, &checkpoint ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_checkpoint( &ctx, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_rollback( NULL, &checkpoint ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_rollback( &ctx, NULL ) );
+}
+
+/// Encodes aData after aPrefix with the frame settings, checking the sizes
+/// predicted at the frame start, after aPrefix and of the decoded frame
+static void check_sizes( const sDICT_ctx *aDict,
+												 eDZCOBS_encoding aEncoding,
+												 int aSettings,
+												 const uint8_t *aData,
+												 size_t aPrefixSize,
+												 size_t aDataSize,
+												 uint8_t *aDst )
+{
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, aDict, DZCOBS_USING_DICT_1 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_encode_inc_begin( &ctx, aEncoding, aDst, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+	ctx.user6bits = TEST_USERBITS;
+
+	if( aSettings == 1 )
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA, 2 ) );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_check( &ctx, DZCOBS_CHECK_CRC16 ) );
+	}
+	else if( aSettings == 2 )
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_check( &ctx, DZCOBS_CHECK_CRC32C ) );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_fec( &ctx, 2 ) );
+	}
+	else if( aSettings == 3 )
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_acceleration( &ctx, 32 ) );
+	}
+
+	size_t frameSize	= 0;
+	size_t prefixSize = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encoded_size( &ctx, aData, aDataSize, &frameSize ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encoded_size( &ctx, aData, aPrefixSize, &prefixSize ) );
+
+	// The filter needs whole blocks before the last call
+	const bool isSplit = ( aSettings != 1 );
+
+	if( isSplit )
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, aData, aPrefixSize ) );
+	}
+
+	size_t restSize = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_encoded_size( &ctx, aData + aPrefixSize, aDataSize - aPrefixSize, &restSize ) );
+
+	if( isSplit )
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, aData + aPrefixSize, aDataSize - aPrefixSize ) );
+	}
+	else
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, aData, aDataSize ) );
+	}
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	// DZCOBS_AUTO selects by the data of the first call
+	if( ( aEncoding != DZCOBS_AUTO ) || ( !isSplit ) || ( aPrefixSize == 0 ) )
+	{
+		CHECK_EQUAL( encodedLen, frameSize );
+	}
+
+	if( isSplit )
+	{
+		CHECK_EQUAL( encodedLen, restSize );
+	}
+
+	CHECK_TRUE( prefixSize <= frameSize );
+
+	if( aSettings == 0 )
+	{
+		CHECK_TRUE( encodedLen <= DZCOBS_MAX_ENCODED_SIZE_DICT( aDataSize ) );
+
+		if( ctx.encoding == DZCOBS_PLAIN )
+		{
+			CHECK_TRUE( encodedLen <= DZCOBS_MAX_ENCODED_SIZE_PLAIN( aDataSize ) );
+			CHECK_TRUE( aDataSize <= DZCOBS_MAX_DECODED_SIZE_PLAIN( encodedLen ) );
+		}
+		else
+		{
+			CHECK_TRUE( aDataSize <= DZCOBS_MAX_DECODED_SIZE_DICT( encodedLen, aDict->maxWordSize ) );
+		}
+	}
+
+	sDZCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= aDst;
+	decodeCtx.srcBufEncodedLen	= encodedLen;
+	decodeCtx.dstBufDecoded			= NULL;
+	decodeCtx.dstBufDecodedSize = 0;
+	decodeCtx.pDict[0]					= aDict;
+	decodeCtx.pDict[1]					= NULL;
+
+	size_t decodedSize = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decoded_size( &decodeCtx, &decodedSize ) );
+	CHECK_EQUAL( aDataSize, decodedSize );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS, EncodedDecodedSize )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size ) );
+
+	static constexpr size_t dataSize = 700;
+	uint8_t data[dataSize];
+
+	srand( 42 );
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1, DZCOBS_AUTO };
+
+	// Data of dictionary words, zeros and long runs, on varying proportions
+	for( int pattern = 0; pattern < 24; pattern++ )
+	{
+		const int zeroOneIn = 1 + ( ( pattern % 4 ) * ( pattern % 4 ) * 40 );
+		const int wordOneIn = 1 + ( pattern / 4 );
+
+		for( size_t i = 0; i < dataSize; i++ )
+		{
+			data[i] = ( ( rand() % zeroOneIn ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+
+			if( ( rand() % wordOneIn ) == 0 )
+			{
+				data[i] = (uint8_t)( ( rand() % 4 ) + 1 );
+			}
+		}
+
+		const size_t size = 1 + ( (size_t)rand() % dataSize );
+
+		for( const eDZCOBS_encoding encoding : encodings )
+		{
+			for( int settings = 0; settings < 4; settings++ )
+			{
+				check_sizes( &dictCtx, encoding, settings, data, (size_t)rand() % size, size, buffer );
+				check_sizes( &dictCtx, encoding, settings, data, 0, 0, buffer );
+			}
+		}
+	}
+
+	// The worst cases are reached: runs without words, and all longest words
+	memset( data, 0x10, dataSize );
+
+	const size_t runSizes[] = { 1, 126, 127, 253, 254, 255, 508, 509 };
+
+	for( const size_t runSize : runSizes )
+	{
+		sDZCOBS_ctx ctx;
+		size_t size = 0;
+		memset( &ctx, 0, sizeof( ctx ) );
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, &dictCtx, DZCOBS_USING_DICT_1 ) );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, buffer, 2 ) );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encoded_size( &ctx, data, runSize, &size ) );
+		CHECK_EQUAL( DZCOBS_MAX_ENCODED_SIZE_PLAIN( runSize ), size );
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_USING_DICT_1, buffer, 2 ) );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encoded_size( &ctx, data, runSize, &size ) );
+		CHECK_EQUAL( DZCOBS_MAX_ENCODED_SIZE_DICT( runSize ), size );
+	}
+
+	for( size_t i = 0; i < dataSize; i += 5 )
+	{
+		memcpy( &data[i], "\x04\x00\x00\x00\x04", 5 );
+	}
+
+	eDZCOBS_encoding encoding = DZCOBS_PLAIN;
+	const size_t encodedLen = encode_with( &dictCtx, DZCOBS_USING_DICT_1, data, 50, buffer, 64, &encoding );
+	CHECK_EQUAL( 50, DZCOBS_MAX_DECODED_SIZE_DICT( encodedLen, dictCtx.maxWordSize ) );
+
+	CHECK_EQUAL( 1 + DZCOBS_FRAME_HEADER_SIZE, DZCOBS_MAX_ENCODED_SIZE_PLAIN( 0 ) );
+	CHECK_EQUAL( 0, DZCOBS_MAX_DECODED_SIZE_PLAIN( DZCOBS_FRAME_HEADER_SIZE ) );
+	CHECK_EQUAL( 0, DZCOBS_MAX_DECODED_SIZE_DICT( DZCOBS_FRAME_HEADER_SIZE, 5 ) );
+
+	sDZCOBS_ctx ctx;
+	size_t size = 0;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_encoded_size( &ctx, data, 1, &size ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encoded_size( NULL, data, 1, &size ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encoded_size( &ctx, NULL, 1, &size ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encoded_size( &ctx, data, 1, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decoded_size( NULL, &size ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS, DecodeInPlace )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size ) );
+
+	static constexpr size_t dataSize = 300;
+	uint8_t data[dataSize];
+	uint8_t encoded[UTEST_ENCODED_DECODED_DATA_MAX_SIZE];
+
+	srand( 7 );
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 };
+
+	for( int pattern = 0; pattern < 32; pattern++ )
+	{
+		// From no words to all the longest words, that decode ahead of the frame read
+		const int wordOneIn = 1 + ( pattern % 8 );
+
+		for( size_t i = 0; i < dataSize; i++ )
+		{
+			data[i] = ( ( rand() % 16 ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+
+			if( ( rand() % wordOneIn ) == 0 )
+			{
+				data[i] = 0x04;
+			}
+		}
+
+		if( pattern >= 24 )
+		{
+			for( size_t i = 0; ( i + 5 ) <= dataSize; i += 5 )
+			{
+				memcpy( &data[i], "\x04\x00\x00\x00\x04", 5 );
+			}
+		}
+
+		const size_t size = 1 + ( (size_t)rand() % dataSize );
+
+		for( const eDZCOBS_encoding encoding : encodings )
+		{
+			eDZCOBS_encoding usedEncoding = DZCOBS_PLAIN;
+			const size_t encodedLen =
+				encode_with( &dictCtx, encoding, data, size, encoded, sizeof( encoded ), &usedEncoding );
+
+			sDZCOBS_decodectx decodeCtx;
+			decodeCtx.srcBufEncoded			= encoded;
+			decodeCtx.srcBufEncodedLen	= encodedLen;
+			decodeCtx.dstBufDecoded			= NULL;
+			decodeCtx.dstBufDecodedSize = 0;
+			decodeCtx.pDict[0]					= &dictCtx;
+			decodeCtx.pDict[1]					= NULL;
+
+			size_t headroom = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode_headroom( &decodeCtx, &headroom ) );
+
+			if( encoding == DZCOBS_PLAIN )
+			{
+				CHECK_EQUAL( 0, headroom );
+			}
+
+			// The frame after the headroom, decoded to the buffer start
+			memset( buffer, UTEST_GUARD_BYTE, UTEST_ENCODED_DECODED_DATA_MAX_SIZE );
+			memcpy( buffer + headroom, encoded, encodedLen );
+
+			decodeCtx.srcBufEncoded			= buffer + headroom;
+			decodeCtx.dstBufDecoded			= buffer;
+			decodeCtx.dstBufDecodedSize = UTEST_ENCODED_DECODED_DATA_MAX_SIZE;
+
+			size_t decodedLen							= 0;
+			uint8_t user6bitDataRightAlgn = 0;
+
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode( &decodeCtx, &decodedLen, &user6bitDataRightAlgn ) );
+			CHECK_EQUAL( size, decodedLen );
+			MEMCMP_EQUAL( data, buffer, size );
+			CHECK_EQUAL( TEST_USERBITS, user6bitDataRightAlgn );
+
+			// With less headroom, it is refused before anything is written
+			if( headroom > 0 )
+			{
+				memcpy( buffer + headroom - 1, encoded, encodedLen );
+				decodeCtx.srcBufEncoded = buffer + headroom - 1;
+
+				CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode( &decodeCtx, &decodedLen, &user6bitDataRightAlgn ) );
+				MEMCMP_EQUAL( encoded, buffer + headroom - 1, encodedLen );
+			}
+		}
+	}
+
+	// The decoded data can not start after the frame
+	eDZCOBS_encoding usedEncoding = DZCOBS_PLAIN;
+	const size_t encodedLen				= encode_with( &dictCtx, DZCOBS_PLAIN, data, 10, buffer, 64, &usedEncoding );
+
+	sDZCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= buffer;
+	decodeCtx.srcBufEncodedLen	= encodedLen;
+	decodeCtx.dstBufDecoded			= buffer + 1;
+	decodeCtx.dstBufDecodedSize = 64;
+	decodeCtx.pDict[0]					= &dictCtx;
+	decodeCtx.pDict[1]					= NULL;
+
+	size_t decodedLen							= 0;
+	uint8_t user6bitDataRightAlgn = 0;
+	size_t headroom								= 0;
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode( &decodeCtx, &decodedLen, &user6bitDataRightAlgn ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_headroom( NULL, &headroom ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_headroom( &decodeCtx, NULL ) );
+}
+
+/// Step-wise encodes aData, checks it is the same frame as encoded at once
+static size_t encode_steps( const sDICT_ctx *aDict,
+														eDZCOBS_encoding aEncoding,
+														bool aIsExtended,
+														const uint8_t *aData,
+														size_t aDataSize,
+														size_t aStepSize,
+														uint8_t *aDst )
+{
+	uint8_t once[UTEST_ENCODED_DECODED_DATA_MAX_SIZE];
+	size_t onceLen		= 0;
+	size_t encodedLen = 0;
+
+	for( int isStepWise = 0; isStepWise < 2; isStepWise++ )
+	{
+		sDZCOBS_ctx ctx;
+		memset( &ctx, 0, sizeof( ctx ) );
+
+		uint8_t *pDst = isStepWise ? aDst : once;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, aDict, DZCOBS_USING_DICT_1 ) );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+								 dzcobs_encode_inc_begin( &ctx, aEncoding, pDst, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+
+		ctx.user6bits = TEST_USERBITS;
+
+		if( aIsExtended )
+		{
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA, 2 ) );
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_check( &ctx, DZCOBS_CHECK_CRC32C ) );
+		}
+
+		if( isStepWise )
+		{
+			const uint8_t *pSrc = aData;
+			size_t srcSize			= aDataSize;
+			size_t nSteps				= 0;
+			eDZCOBS_ret ret			= DZCOBS_RET_MORE;
+
+			while( ret == DZCOBS_RET_MORE )
+			{
+				ret = dzcobs_encode_inc_step( &ctx, &pSrc, &srcSize, aStepSize );
+				nSteps++;
+			}
+
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+			CHECK_EQUAL( 0, srcSize );
+			CHECK( pSrc == ( aData + aDataSize ) );
+			// A filtered frame is added by whole filter blocks
+			const size_t blocks		= std::max( (size_t)1, aStepSize / DZCOBS_FILTER_BLOCK_SIZE );
+			const size_t stepSize = aIsExtended ? ( blocks * DZCOBS_FILTER_BLOCK_SIZE ) : aStepSize;
+
+			CHECK_EQUAL( std::max( (size_t)1, ( aDataSize + stepSize - 1 ) / stepSize ), nSteps );
+		}
+		else
+		{
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, aData, aDataSize ) );
+		}
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, isStepWise ? &encodedLen : &onceLen ) );
+	}
+
+	// A dictionary word across two steps is not found, unless the steps are filter blocks
+	if( ( aEncoding == DZCOBS_PLAIN ) || aIsExtended )
+	{
+		CHECK_EQUAL( onceLen, encodedLen );
+		MEMCMP_EQUAL( once, aDst, encodedLen );
+	}
+
+	return encodedLen;
+}
+
+/// Step-wise decodes, returns the result of the last step
+static eDZCOBS_ret decode_steps( const sDZCOBS_decodectx *aDecodeCtx,
+																 size_t aStepSize,
+																 size_t *aOutDecodedLen,
+																 size_t *aOutSteps )
+{
+	sDZCOBS_decodestep step;
+	uint8_t user6bitDataRightAlgn = 0;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode_step_begin( &step, aDecodeCtx, aStepSize ) );
+
+	eDZCOBS_ret ret = DZCOBS_RET_MORE;
+	*aOutSteps			= 0;
+
+	while( ret == DZCOBS_RET_MORE )
+	{
+		ret = dzcobs_decode_step( &step, aOutDecodedLen, &user6bitDataRightAlgn );
+		( *aOutSteps )++;
+	}
+
+	if( ret == DZCOBS_RET_SUCCESS )
+	{
+		CHECK_EQUAL( TEST_USERBITS, user6bitDataRightAlgn );
+
+		// Once ended, it keeps its result
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode_step( &step, aOutDecodedLen, &user6bitDataRightAlgn ) );
+	}
+
+	return ret;
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS, EncodeDecodeStep )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size ) );
+
+	static constexpr size_t dataSize = 700;
+	uint8_t data[dataSize];
+	uint8_t encoded[UTEST_ENCODED_DECODED_DATA_MAX_SIZE];
+	uint8_t decoded[UTEST_ENCODED_DECODED_DATA_MAX_SIZE];
+
+	srand( 11 );
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 };
+	const size_t stepSizes[]					 = { 1, 7, 64, 300, 4096 };
+
+	for( int pattern = 0; pattern < 16; pattern++ )
+	{
+		const int zeroOneIn = 1 + ( ( pattern % 4 ) * ( pattern % 4 ) * 100 );
+
+		for( size_t i = 0; i < dataSize; i++ )
+		{
+			data[i] = ( ( rand() % zeroOneIn ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+
+			if( ( rand() % 3 ) == 0 )
+			{
+				data[i] = (uint8_t)( rand() % 5 );
+			}
+		}
+
+		const size_t size = (size_t)rand() % dataSize;
+
+		for( const eDZCOBS_encoding encoding : encodings )
+		{
+			for( int isExtended = 0; isExtended < 2; isExtended++ )
+			{
+				for( const size_t stepSize : stepSizes )
+				{
+					const size_t encodedLen =
+						encode_steps( &dictCtx, encoding, isExtended != 0, data, size, stepSize, encoded );
+
+					sDZCOBS_decodectx decodeCtx;
+					decodeCtx.srcBufEncoded			= encoded;
+					decodeCtx.srcBufEncodedLen	= encodedLen;
+					decodeCtx.dstBufDecoded			= decoded;
+					decodeCtx.dstBufDecodedSize = sizeof( decoded );
+					decodeCtx.pDict[0]					= &dictCtx;
+					decodeCtx.pDict[1]					= NULL;
+
+					memset( decoded, UTEST_GUARD_BYTE, sizeof( decoded ) );
+
+					size_t decodedLen = 0;
+					size_t nSteps			= 0;
+
+					CHECK_EQUAL( DZCOBS_RET_SUCCESS, decode_steps( &decodeCtx, stepSize, &decodedLen, &nSteps ) );
+					CHECK_EQUAL( size, decodedLen );
+					MEMCMP_EQUAL( data, decoded, size );
+					CHECK_EQUAL( UTEST_GUARD_BYTE, decoded[size] );
+
+					// The hash is a step per stepSize bytes, the payload steps stop
+					// past stepSize only to end a run
+					const size_t hashSteps = ( encodedLen - 1 + stepSize - 1 ) / stepSize;
+
+					CHECK( nSteps > hashSteps );
+
+					// A step per phase
+					if( stepSize >= UTEST_ENCODED_DECODED_DATA_MAX_SIZE )
+					{
+						CHECK_EQUAL( isExtended ? 4 : 2, nSteps );
+					}
+
+					// A corrupted frame fails on its last hash step, before decoding
+					encoded[encodedLen / 2]++;
+					memset( decoded, UTEST_GUARD_BYTE, sizeof( decoded ) );
+
+					CHECK_EQUAL( DZCOBS_RET_ERR_CRC, decode_steps( &decodeCtx, stepSize, &decodedLen, &nSteps ) );
+					CHECK_EQUAL( hashSteps, nSteps );
+					CHECK_EQUAL( UTEST_GUARD_BYTE, decoded[0] );
+				}
+			}
+		}
+	}
+
+	// In place, only a plain frame
+	for( const eDZCOBS_encoding encoding : encodings )
+	{
+		memset( data, 0x04, dataSize );
+
+		const size_t encodedLen = encode_steps( &dictCtx, encoding, false, data, 100, 16, buffer );
+
+		sDZCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= buffer;
+		decodeCtx.srcBufEncodedLen	= encodedLen;
+		decodeCtx.dstBufDecoded			= buffer;
+		decodeCtx.dstBufDecodedSize = UTEST_ENCODED_DECODED_DATA_MAX_SIZE;
+		decodeCtx.pDict[0]					= &dictCtx;
+		decodeCtx.pDict[1]					= NULL;
+
+		size_t decodedLen = 0;
+		size_t nSteps			= 0;
+
+		if( encoding == DZCOBS_PLAIN )
+		{
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, decode_steps( &decodeCtx, 16, &decodedLen, &nSteps ) );
+			CHECK_EQUAL( 100, decodedLen );
+			MEMCMP_EQUAL( data, buffer, 100 );
+		}
+		else
+		{
+			CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, decode_steps( &decodeCtx, 16, &decodedLen, &nSteps ) );
+		}
+	}
+
+	sDZCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= encoded;
+	decodeCtx.srcBufEncodedLen	= 3;
+	decodeCtx.dstBufDecoded			= decoded;
+	decodeCtx.dstBufDecodedSize = sizeof( decoded );
+	decodeCtx.pDict[0]					= NULL;
+	decodeCtx.pDict[1]					= NULL;
+
+	sDZCOBS_decodestep step;
+	size_t decodedLen							= 0;
+	uint8_t user6bitDataRightAlgn = 0;
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_step_begin( NULL, &decodeCtx, 16 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_step_begin( &step, NULL, 16 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_step_begin( &step, &decodeCtx, 0 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode_step_begin( &step, &decodeCtx, 16 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_step( NULL, &decodedLen, &user6bitDataRightAlgn ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_step( &step, NULL, &user6bitDataRightAlgn ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_step( &step, &decodedLen, NULL ) );
+
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	const uint8_t *pSrc = data;
+	size_t srcSize			= 10;
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_encode_inc_step( &ctx, &pSrc, &srcSize, 4 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_inc_step( &ctx, NULL, &srcSize, 4 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_inc_step( &ctx, &pSrc, NULL, 4 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_inc_step( &ctx, &pSrc, &srcSize, 0 ) );
+	CHECK_EQUAL( 10, srcSize );
+}
+
+/// Encodes aData with a dictionary, aRawSize bytes of it with dzcobs_encode_inc_raw
+static size_t encode_accelerated( const sDICT_ctx *aDict,
+																	uint8_t aAcceleration,
+																	const uint8_t *aData,
+																	size_t aRawSize,
+																	size_t aDataSize,
+																	uint8_t *aDst )
+{
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, aDict, DZCOBS_USING_DICT_1 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_encode_inc_begin( &ctx, DZCOBS_USING_DICT_1, aDst, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_acceleration( &ctx, aAcceleration ) );
+	ctx.user6bits = TEST_USERBITS;
+
+	size_t predictedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encoded_size( &ctx, aData, aDataSize, &predictedLen ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_raw( &ctx, aData, aRawSize ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, aData + aRawSize, aDataSize - aRawSize ) );
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	if( aRawSize == 0 )
+	{
+		CHECK_EQUAL( predictedLen, encodedLen );
+	}
+
+	uint8_t decoded[UTEST_ENCODED_DECODED_DATA_MAX_SIZE];
+
+	sDZCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= aDst;
+	decodeCtx.srcBufEncodedLen	= encodedLen;
+	decodeCtx.dstBufDecoded			= decoded;
+	decodeCtx.dstBufDecodedSize = sizeof( decoded );
+	decodeCtx.pDict[0]					= aDict;
+	decodeCtx.pDict[1]					= NULL;
+
+	size_t decodedLen							= 0;
+	uint8_t user6bitDataRightAlgn = 0;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode( &decodeCtx, &decodedLen, &user6bitDataRightAlgn ) );
+	CHECK_EQUAL( aDataSize, decodedLen );
+	MEMCMP_EQUAL( aData, decoded, aDataSize );
+
+	return encodedLen;
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS, EncodeAccelerationRaw )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size ) );
+
+	sDZCOBS_stats stats;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_stats_attach( &dictCtx, &stats ) );
+
+	// Random bytes, that have no words, followed by dictionary words
+	static constexpr size_t randomSize = 600;
+	static constexpr size_t dataSize	 = 900;
+	uint8_t data[dataSize];
+
+	srand( 5 );
+
+	for( size_t i = 0; i < dataSize; i++ )
+	{
+		data[i] = ( i < randomSize ) ? (uint8_t)( ( rand() % 250 ) + 5 ) : (uint8_t)( ( i % 3 == 2 ) ? 0x20 : 0x01 );
+	}
+
+	// Without acceleration, the frame is the same as the default one
+	eDZCOBS_encoding encoding = DZCOBS_PLAIN;
+	uint8_t expected[UTEST_ENCODED_DECODED_DATA_MAX_SIZE];
+
+	const size_t expectedLen =
+		encode_with( &dictCtx, DZCOBS_USING_DICT_1, data, dataSize, expected, sizeof( expected ), &encoding );
+	dzcobs_stats_reset( &stats );
+
+	CHECK_EQUAL( expectedLen, encode_accelerated( &dictCtx, 0, data, 0, dataSize, buffer ) );
+	MEMCMP_EQUAL( expected, buffer, expectedLen );
+
+	const uint32_t searches = stats.searches;
+
+	// The search backs off on the random bytes, and the words are still found
+	const uint8_t accelerations[] = { 1, 8, 255 };
+
+	for( const uint8_t acceleration : accelerations )
+	{
+		dzcobs_stats_reset( &stats );
+
+		const size_t encodedLen = encode_accelerated( &dictCtx, acceleration, data, 0, dataSize, buffer );
+
+		CHECK_TRUE( encodedLen <= DZCOBS_MAX_ENCODED_SIZE_DICT( dataSize ) );
+
+		// A single miss is enough to skip the next positions, some words are lost
+		if( acceleration < ( 1 << DZCOBS_ACCELERATION_SHIFT ) )
+		{
+			CHECK_TRUE( encodedLen <= ( expectedLen + DZCOBS_ACCELERATION_MAX_SKIP ) );
+		}
+
+#if DZCOBS_STATS == 1
+		CHECK_TRUE( stats.searches < searches );
+		CHECK_TRUE( stats.hits[0] > 0 );
+#else
+		CHECK_EQUAL( searches, stats.searches );
+#endif
+	}
+
+	// A raw span is not searched, its words are encoded plain
+	dzcobs_stats_reset( &stats );
+
+	const size_t wordsSize = dataSize - randomSize;
+
+	CHECK_EQUAL( DZCOBS_MAX_ENCODED_SIZE_DICT( wordsSize ),
+							 encode_accelerated( &dictCtx, 0, data + randomSize, wordsSize, wordsSize, buffer ) );
+	CHECK_EQUAL( 0, stats.searches );
+
+	const size_t rawLen = encode_accelerated( &dictCtx, 0, data, randomSize, dataSize, buffer );
+	CHECK_EQUAL( expectedLen, rawLen );
+	MEMCMP_EQUAL( expected, buffer, rawLen );
+
+	// The backoff of the random bytes does not skip a word right after a raw span
+	sDZCOBS_ctx ctx;
+	size_t encodedLen = 0;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, &dictCtx, DZCOBS_USING_DICT_1 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_encode_inc_begin( &ctx, DZCOBS_USING_DICT_1, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_acceleration( &ctx, 255 ) );
+	ctx.user6bits = TEST_USERBITS;
+
+	size_t nRandom = 0;
+
+	while( ( ctx.searchSkip < 2 ) && ( nRandom < randomSize ) )
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, &data[nRandom++], 1 ) );
+	}
+
+	CHECK_TRUE( ctx.searchSkip >= 2 );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_raw( &ctx, &data[nRandom], 1 ) );
+
+	// The shortest word, no other word is its prefix
+	uint8_t wordSize		 = 0;
+	const uint8_t *pWord = dzcobs_dictionary_get( &dictCtx, 0, &wordSize );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, pWord, wordSize ) );
+	CHECK_TRUE( ctx.isLastCodeDictionary );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	// On a plain frame, it is the same as dzcobs_encode_inc
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_raw( &ctx, data, dataSize ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	const size_t plainLen =
+		encode_with( &dictCtx, DZCOBS_PLAIN, data, dataSize, expected, sizeof( expected ), &encoding );
+	CHECK_EQUAL( plainLen, encodedLen );
+	MEMCMP_EQUAL( expected, buffer, plainLen );
+
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_set_acceleration( &ctx, 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_set_acceleration( NULL, 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_encode_inc_raw( &ctx, data, 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_inc_raw( NULL, data, 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_inc_raw( &ctx, NULL, 1 ) );
+
+	// Filtered frames encode whole filter blocks only
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA, 2 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_inc_raw( &ctx, data, 1 ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS, EncodeDecodeBuf )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size ) );
+
+	static constexpr size_t dataSize = 300;
+	uint8_t data[dataSize];
+	uint8_t expected[UTEST_ENCODED_DECODED_DATA_MAX_SIZE];
+	uint8_t decoded[dataSize + 1];
+
+	srand( 13 );
+
+	for( size_t i = 0; i < dataSize; i++ )
+	{
+		data[i] = ( ( rand() % 8 ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+
+		if( ( rand() % 3 ) == 0 )
+		{
+			data[i] = (uint8_t)( ( rand() % 4 ) + 1 );
+		}
+	}
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 };
+
+	for( const eDZCOBS_encoding encoding : encodings )
+	{
+		// Small frames, and runs that fill a code
+		for( size_t size = 0; size < dataSize; size += ( size < 64 ) ? 1 : 37 )
+		{
+			const size_t maxEncodedSize =
+				( encoding == DZCOBS_PLAIN ) ? DZCOBS_MAX_ENCODED_SIZE_PLAIN( size ) : DZCOBS_MAX_ENCODED_SIZE_DICT( size );
+
+			size_t encodedLen = 0;
+			CHECK_EQUAL(
+				DZCOBS_RET_SUCCESS,
+				dzcobs_encode( encoding, &dictCtx, TEST_USERBITS, data, size, buffer, maxEncodedSize, &encodedLen ) );
+
+			// The same frame of the incremental encoding
+			eDZCOBS_encoding usedEncoding = DZCOBS_AUTO;
+			const size_t expectedLen =
+				encode_with( &dictCtx, encoding, data, size, expected, sizeof( expected ), &usedEncoding );
+			CHECK_EQUAL( expectedLen, encodedLen );
+			MEMCMP_EQUAL( expected, buffer, encodedLen );
+
+			size_t decodedLen	 = 0;
+			uint8_t user6bits = 0;
+			memset( decoded, UTEST_GUARD_BYTE, sizeof( decoded ) );
+
+			CHECK_EQUAL(
+				DZCOBS_RET_SUCCESS,
+				dzcobs_decode_buf( encoding, &dictCtx, buffer, encodedLen, decoded, dataSize, &decodedLen, &user6bits ) );
+			CHECK_EQUAL( size, decodedLen );
+			CHECK_EQUAL( TEST_USERBITS, user6bits );
+			MEMCMP_EQUAL( data, decoded, size );
+			CHECK_EQUAL( UTEST_GUARD_BYTE, decoded[size] );
+
+			// A frame of another encoding is not decoded
+			const eDZCOBS_encoding otherEncoding = ( encoding == DZCOBS_PLAIN ) ? DZCOBS_USING_DICT_2 : DZCOBS_PLAIN;
+
+			CHECK_EQUAL(
+				DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+				dzcobs_decode_buf( otherEncoding, &dictCtx, buffer, encodedLen, decoded, dataSize, &decodedLen, &user6bits ) );
+
+			if( size > 0 )
+			{
+				// A byte short, a trailing 0x00 included, nothing is written past it
+				if( size > 1 )
+				{
+					memset( decoded, UTEST_GUARD_BYTE, sizeof( decoded ) );
+
+					CHECK_EQUAL(
+						DZCOBS_RET_ERR_WRITE_OVERFLOW,
+						dzcobs_decode_buf( encoding, &dictCtx, buffer, encodedLen, decoded, size - 1, &decodedLen, &user6bits ) );
+					CHECK_EQUAL( UTEST_GUARD_BYTE, decoded[size - 1] );
+
+					sDZCOBS_decodectx decodeCtx;
+					decodeCtx.srcBufEncoded			= buffer;
+					decodeCtx.srcBufEncodedLen	= encodedLen;
+					decodeCtx.dstBufDecoded			= decoded;
+					decodeCtx.dstBufDecodedSize = size - 1;
+					decodeCtx.pDict[0]					= &dictCtx;
+					decodeCtx.pDict[1]					= NULL;
+
+					CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) );
+					CHECK_EQUAL( UTEST_GUARD_BYTE, decoded[size - 1] );
+				}
+
+				CHECK_EQUAL(
+					DZCOBS_RET_ERR_WRITE_OVERFLOW,
+					dzcobs_encode( encoding, &dictCtx, TEST_USERBITS, data, size, buffer, maxEncodedSize - 1, &encodedLen ) );
+			}
+		}
+	}
+
+	// A corrupted frame, and an extended frame
+	size_t encodedLen	 = 0;
+	size_t decodedLen	 = 0;
+	uint8_t user6bits = 0;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_encode( DZCOBS_PLAIN, NULL, TEST_USERBITS, data, 40, buffer, 64, &encodedLen ) );
+	buffer[3]++;
+	CHECK_EQUAL( DZCOBS_RET_ERR_CRC,
+							 dzcobs_decode_buf( DZCOBS_PLAIN, NULL, buffer, encodedLen, decoded, 64, &decodedLen, &user6bits ) );
+
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, buffer, 64 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_check( &ctx, DZCOBS_CHECK_CRC16 ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, data, 40 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+							 dzcobs_decode_buf( DZCOBS_PLAIN, NULL, buffer, encodedLen, decoded, 64, &decodedLen, &user6bits ) );
+
+	// Bad arguments
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_encode( DZCOBS_USING_DICT_1, NULL, 1, data, 1, buffer, 64, &encodedLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode( DZCOBS_AUTO, &dictCtx, 1, data, 1, buffer, 64, &encodedLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode( DZCOBS_PLAIN, NULL, 1, NULL, 1, buffer, 64, &encodedLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode( DZCOBS_PLAIN, NULL, 1, data, 1, NULL, 64, &encodedLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode( DZCOBS_PLAIN, NULL, 1, data, 1, buffer, 64, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_INVALID_USER6BITS,
+							 dzcobs_encode( DZCOBS_PLAIN, NULL, 0, data, 1, buffer, 64, &encodedLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_INVALID_USER6BITS,
+							 dzcobs_encode( DZCOBS_PLAIN, NULL, 64, data, 1, buffer, 64, &encodedLen ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode( DZCOBS_PLAIN, NULL, 1, data, 40, buffer, 64, &encodedLen ) );
+	CHECK_EQUAL(
+		DZCOBS_RET_ERR_BAD_ARG,
+		dzcobs_decode_buf( DZCOBS_USING_DICT_1, NULL, buffer, encodedLen, decoded, 64, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_decode_buf( DZCOBS_PLAIN, NULL, NULL, encodedLen, decoded, 64, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_decode_buf( DZCOBS_PLAIN, NULL, buffer, 2, decoded, 64, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_decode_buf( DZCOBS_PLAIN, NULL, buffer, encodedLen, decoded, 0, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_decode_buf( DZCOBS_PLAIN, NULL, buffer, encodedLen, decoded, 64, NULL, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_decode_buf( DZCOBS_PLAIN, NULL, buffer, encodedLen, buffer, 64, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW,
+							 dzcobs_decode_buf( DZCOBS_PLAIN, NULL, buffer, encodedLen, decoded, 39, &decodedLen, &user6bits ) );
+}
+
 // EOF
 // /////////////////////////////////////////////////////////////////////////////
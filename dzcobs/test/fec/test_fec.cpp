@@ -0,0 +1,342 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_fec.cpp
+///	@brief Tests for the Reed-Solomon forward error correction
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_fec.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_FEC_MAX_SIZE ( 1500 )
+#define UTEST_FEC_ENCODED_SIZE ( ( UTEST_FEC_MAX_SIZE * 2 ) + 64 )
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_FEC ){
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+// NOLINTEND
+// clang-format on
+
+static const uint8_t s_fecT[] = { 1, 2, 4, 8, DZCOBS_FEC_MAX_T };
+
+static eDZCOBS_ret encode_fec( uint8_t aT,
+															 eDZCOBS_check aCheck,
+															 const uint8_t *aData,
+															 size_t aDataSize,
+															 uint8_t *aDst,
+															 size_t aDstSize,
+															 size_t *aOutEncodedLen )
+{
+	sDZCOBS_ctx ctx;
+
+	eDZCOBS_ret ret = dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, aDst, aDstSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	ctx.user6bits = 0x21;
+
+	ret = dzcobs_encode_set_check( &ctx, aCheck );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	ret = dzcobs_encode_set_fec( &ctx, aT );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	ret = dzcobs_encode_inc( &ctx, aData, aDataSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	return dzcobs_encode_inc_end( &ctx, aOutEncodedLen );
+}
+
+static eDZCOBS_ret decode( const uint8_t *aEncoded, size_t aEncodedLen, uint8_t *aDecoded, size_t *aOutDecodedLen )
+{
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	decodeCtx.srcBufEncoded			= aEncoded;
+	decodeCtx.srcBufEncodedLen	= aEncodedLen;
+	decodeCtx.dstBufDecoded			= aDecoded;
+	decodeCtx.dstBufDecodedSize = UTEST_FEC_MAX_SIZE;
+
+	uint8_t user6bitsValue = 0;
+
+	return dzcobs_decode( &decodeCtx, aOutDecodedLen, &user6bitsValue );
+}
+
+/// Change a byte to a different value that is not 0 (so the frame is not split)
+static void corrupt_byte( uint8_t *aByte )
+{
+	uint8_t value;
+
+	do
+	{
+		value = (uint8_t)( rand() & 0xFF );
+	} while( ( value == 0 ) || ( value == *aByte ) );
+
+	*aByte = value;
+}
+
+static void fill_random( uint8_t *aBuf, size_t aSize )
+{
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		aBuf[i] = ( ( rand() % 8 ) == 0 ) ? 0 : (uint8_t)( rand() & 0xFF );
+	}
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_FEC, DataSize )
+// NOLINTEND
+{
+	for( const uint8_t t : s_fecT )
+	{
+		for( size_t dataLen = 1; dataLen < 3000; dataLen++ )
+		{
+			const size_t parityLen = DZCOBS_FEC_PARITY_SIZE( dataLen, t );
+
+			CHECK_EQUAL( dataLen, dzcobs_fec_data_size( dataLen + parityLen, t ) );
+
+			// Each codeword takes exactly one block
+			CHECK( ( dataLen + parityLen ) <= ( ( parityLen / ( ( 2 * t ) + 1 ) ) * DZCOBS_FEC_BLOCK_SIZE ) );
+		}
+	}
+
+	CHECK_EQUAL( 0, dzcobs_fec_data_size( 3, 1 ) );
+	CHECK_EQUAL( 0, dzcobs_fec_data_size( 100, 0 ) );
+	CHECK_EQUAL( 0, dzcobs_fec_data_size( 100, DZCOBS_FEC_MAX_T + 1 ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FEC, EncodeDecodeNoErrors )
+// NOLINTEND
+{
+	uint8_t src[UTEST_FEC_MAX_SIZE];
+	uint8_t encoded[UTEST_FEC_ENCODED_SIZE];
+	uint8_t decoded[UTEST_FEC_MAX_SIZE];
+
+	fill_random( src, sizeof( src ) );
+
+	for( const uint8_t t : s_fecT )
+	{
+		for( size_t size = 1; size <= sizeof( src ); size += 83 )
+		{
+			size_t encodedLen = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+									 encode_fec( t, DZCOBS_CHECK_HASH8, src, size, encoded, sizeof( encoded ), &encodedLen ) );
+
+			for( size_t i = 0; i < encodedLen; i++ )
+			{
+				CHECK( encoded[i] != 0 );
+			}
+
+			CHECK_EQUAL( DZCOBS_EXT_MARKER | DZCOBS_EXT_FEC | DZCOBS_PLAIN, encoded[encodedLen - 3] );
+			CHECK_EQUAL( DZCOBS_FEC_DESC_MARKER | t, encoded[encodedLen - 4] );
+
+			size_t corrected = 1;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_fec_repair( encoded, encodedLen, &corrected ) );
+			CHECK_EQUAL( 0, corrected );
+
+			size_t decodedLen = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, decode( encoded, encodedLen, decoded, &decodedLen ) );
+			CHECK_EQUAL( size, decodedLen );
+			CHECK_EQUAL( 0, memcmp( src, decoded, size ) );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FEC, RepairRandomErrors )
+// NOLINTEND
+{
+	uint8_t src[UTEST_FEC_MAX_SIZE];
+	uint8_t encoded[UTEST_FEC_ENCODED_SIZE];
+	uint8_t decoded[UTEST_FEC_MAX_SIZE];
+
+	fill_random( src, sizeof( src ) );
+
+	for( const uint8_t t : s_fecT )
+	{
+		for( size_t size = 1; size <= sizeof( src ); size += 151 )
+		{
+			size_t encodedLen = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+									 encode_fec( t, DZCOBS_CHECK_CRC32C, src, size, encoded, sizeof( encoded ), &encodedLen ) );
+
+			// Errors on the protected bytes and on the parity of each codeword
+			const size_t fecLen		 = encodedLen - 4;
+			const size_t dataLen	 = dzcobs_fec_data_size( fecLen, t );
+			const size_t nBlocks	 = ( fecLen + DZCOBS_FEC_BLOCK_SIZE - 1 ) / DZCOBS_FEC_BLOCK_SIZE;
+			const size_t slotSize = ( 2 * (size_t)t ) + 1;
+
+			for( size_t block = 0; block < nBlocks; block++ )
+			{
+				const size_t nData = ( ( dataLen - block ) + nBlocks - 1 ) / nBlocks;
+
+				// A damaged parity byte that is a COBS code may count as more than one
+				// symbol error, so leave some margin
+				corrupt_byte( &encoded[dataLen + ( block * slotSize ) + 1 + (size_t)( rand() % ( 2 * t ) )] );
+
+				for( size_t e = 2; e < t; e++ )
+				{
+					corrupt_byte( &encoded[block + ( nBlocks * (size_t)( rand() % nData ) )] );
+				}
+			}
+
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_fec_repair( encoded, encodedLen, NULL ) );
+
+			size_t decodedLen = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, decode( encoded, encodedLen, decoded, &decodedLen ) );
+			CHECK_EQUAL( size, decodedLen );
+			CHECK_EQUAL( 0, memcmp( src, decoded, size ) );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FEC, RepairBurst )
+// NOLINTEND
+{
+	uint8_t src[UTEST_FEC_MAX_SIZE];
+	uint8_t encoded[UTEST_FEC_ENCODED_SIZE];
+	uint8_t decoded[UTEST_FEC_MAX_SIZE];
+
+	fill_random( src, sizeof( src ) );
+
+	const uint8_t t		 = 4;
+	size_t encodedLen = 0;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 encode_fec( t, DZCOBS_CHECK_CRC16, src, sizeof( src ), encoded, sizeof( encoded ), &encodedLen ) );
+
+	// Interleaving spreads a burst of nBlocks * t bytes to t errors per codeword
+	const size_t nBlocks = ( ( encodedLen - 4 ) + DZCOBS_FEC_BLOCK_SIZE - 1 ) / DZCOBS_FEC_BLOCK_SIZE;
+
+	for( size_t i = 0; i < ( nBlocks * t ); i++ )
+	{
+		corrupt_byte( &encoded[100 + i] );
+	}
+
+	size_t decodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_ERR_CRC, decode( encoded, encodedLen, decoded, &decodedLen ) );
+
+	size_t corrected = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_fec_repair( encoded, encodedLen, &corrected ) );
+	CHECK_EQUAL( nBlocks * t, corrected );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, decode( encoded, encodedLen, decoded, &decodedLen ) );
+	CHECK_EQUAL( sizeof( src ), decodedLen );
+	CHECK_EQUAL( 0, memcmp( src, decoded, sizeof( src ) ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FEC, TooManyErrors )
+// NOLINTEND
+{
+	uint8_t src[200];
+	uint8_t encoded[UTEST_FEC_ENCODED_SIZE];
+	uint8_t decoded[UTEST_FEC_MAX_SIZE];
+
+	fill_random( src, sizeof( src ) );
+
+	const uint8_t t		 = 2;
+	size_t encodedLen = 0;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 encode_fec( t, DZCOBS_CHECK_CRC32C, src, sizeof( src ), encoded, sizeof( encoded ), &encodedLen ) );
+
+	// Single codeword, 2 * t + 1 errors
+	for( size_t i = 0; i < ( ( 2 * t ) + 1 ); i++ )
+	{
+		corrupt_byte( &encoded[10 + ( i * 7 )] );
+	}
+
+	const eDZCOBS_ret ret = dzcobs_fec_repair( encoded, encodedLen, NULL );
+	CHECK( ( ret == DZCOBS_RET_ERR_FEC_UNCORRECTABLE ) || ( ret == DZCOBS_RET_SUCCESS ) );
+
+	// A miscorrection must still be caught by the checks
+	size_t decodedLen = 0;
+	CHECK( decode( encoded, encodedLen, decoded, &decodedLen ) != DZCOBS_RET_SUCCESS );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FEC, FrameWithoutFec )
+// NOLINTEND
+{
+	const uint8_t src[] = { 1, 2, 0, 3 };
+	uint8_t encoded[32];
+	uint8_t copy[32];
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 encode_fec( 0, DZCOBS_CHECK_CRC16, src, sizeof( src ), encoded, sizeof( encoded ), &encodedLen ) );
+	CHECK_EQUAL( 0, encoded[encodedLen - 3] & DZCOBS_EXT_FEC );
+
+	memcpy( copy, encoded, encodedLen );
+
+	size_t corrected = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_fec_repair( encoded, encodedLen, &corrected ) );
+	CHECK_EQUAL( 0, corrected );
+	CHECK_EQUAL( 0, memcmp( copy, encoded, encodedLen ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_fec_repair( NULL, encodedLen, &corrected ) );
+
+	sDZCOBS_ctx ctx;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, encoded, sizeof( encoded ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_set_fec( &ctx, DZCOBS_FEC_MAX_T + 1 ) );
+
+	// Not enough space for the parity
+	ctx.user6bits = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_fec( &ctx, 16 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, src, sizeof( src ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
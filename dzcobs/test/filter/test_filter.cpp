@@ -0,0 +1,345 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_filter.cpp
+///	@brief Tests for the pre-transform filters
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_filter.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_FILTER_MAX_SIZE ( 1024 )
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_FILTER ){
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+// NOLINTEND
+// clang-format on
+
+static const eDZCOBS_filter s_filters[] = { DZCOBS_FILTER_DELTA, DZCOBS_FILTER_SHUFFLE, DZCOBS_FILTER_DELTA_SHUFFLE };
+static const uint8_t s_elementSizes[]		= { 1, 2, 4, 8 };
+
+/// Encode a frame with the filter, adding the data in aChunkSize calls
+static eDZCOBS_ret encode_filtered( eDZCOBS_encoding aEncoding,
+																		const sDICT_ctx *aDict,
+																		uint8_t aDescriptorFilter,
+																		uint8_t aElementSize,
+																		const uint8_t *aData,
+																		size_t aDataSize,
+																		size_t aChunkSize,
+																		uint8_t *aDst,
+																		size_t aDstSize,
+																		size_t *aOutEncodedLen )
+{
+	sDZCOBS_ctx ctx;
+
+	if( aDict )
+	{
+		dzcobs_encode_set_dictionary( &ctx, aDict, aEncoding );
+	}
+
+	eDZCOBS_ret ret = dzcobs_encode_inc_begin( &ctx, aEncoding, aDst, aDstSize );
+
+	if( ret != DZCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	ctx.user6bits = 0x2A;
+
+	if( aDescriptorFilter != DZCOBS_FILTER_NONE )
+	{
+		ret = dzcobs_encode_set_filter( &ctx, (eDZCOBS_filter)aDescriptorFilter, aElementSize );
+
+		if( ret != DZCOBS_RET_SUCCESS )
+		{
+			return ret;
+		}
+	}
+
+	while( aDataSize )
+	{
+		const size_t chunk = ( aDataSize < aChunkSize ) ? aDataSize : aChunkSize;
+
+		ret = dzcobs_encode_inc( &ctx, aData, chunk );
+
+		if( ret != DZCOBS_RET_SUCCESS )
+		{
+			return ret;
+		}
+
+		aData += chunk;
+		aDataSize -= chunk;
+	}
+
+	return dzcobs_encode_inc_end( &ctx, aOutEncodedLen );
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_FILTER, Descriptor )
+// NOLINTEND
+{
+	CHECK_EQUAL( 0, dzcobs_filter_descriptor( DZCOBS_FILTER_NONE, 4 ) );
+	CHECK_EQUAL( 0, dzcobs_filter_descriptor( DZCOBS_FILTER_DELTA, 0 ) );
+	CHECK_EQUAL( 0, dzcobs_filter_descriptor( DZCOBS_FILTER_DELTA, 3 ) );
+	CHECK_EQUAL( 0, dzcobs_filter_descriptor( DZCOBS_FILTER_DELTA, 16 ) );
+
+	CHECK_EQUAL( 0x81, dzcobs_filter_descriptor( DZCOBS_FILTER_DELTA, 1 ) );
+	CHECK_EQUAL( 0x86, dzcobs_filter_descriptor( DZCOBS_FILTER_SHUFFLE, 2 ) );
+	CHECK_EQUAL( 0x8B, dzcobs_filter_descriptor( DZCOBS_FILTER_DELTA_SHUFFLE, 4 ) );
+	CHECK_EQUAL( 0x8D, dzcobs_filter_descriptor( DZCOBS_FILTER_DELTA, 8 ) );
+
+	CHECK_EQUAL( 1, dzcobs_filter_descriptor_isvalid( 0x8B ) );
+	CHECK_EQUAL( 0, dzcobs_filter_descriptor_isvalid( 0x0B ) );
+	CHECK_EQUAL( 0, dzcobs_filter_descriptor_isvalid( 0x80 ) );
+	CHECK_EQUAL( 0, dzcobs_filter_descriptor_isvalid( 0xCB ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FILTER, KnownValues )
+// NOLINTEND
+{
+	const uint8_t src[] = { 0x10, 0x01, 0x12, 0x01, 0x13, 0x01, 0x77 };
+	uint8_t dst[sizeof( src )];
+
+	// Shuffle, the trailing byte is kept
+	dzcobs_filter_encode( dzcobs_filter_descriptor( DZCOBS_FILTER_SHUFFLE, 2 ), src, dst, sizeof( src ) );
+	const uint8_t shuffled[] = { 0x10, 0x12, 0x13, 0x01, 0x01, 0x01, 0x77 };
+	CHECK_EQUAL( 0, memcmp( shuffled, dst, sizeof( src ) ) );
+
+	// Delta of little-endian 16 bit elements
+	dzcobs_filter_encode( dzcobs_filter_descriptor( DZCOBS_FILTER_DELTA, 2 ), src, dst, sizeof( src ) );
+	const uint8_t delta[] = { 0x10, 0x01, 0x02, 0x00, 0x01, 0x00, 0x77 };
+	CHECK_EQUAL( 0, memcmp( delta, dst, sizeof( src ) ) );
+
+	dzcobs_filter_encode( dzcobs_filter_descriptor( DZCOBS_FILTER_DELTA_SHUFFLE, 2 ), src, dst, sizeof( src ) );
+	const uint8_t deltaShuffled[] = { 0x10, 0x02, 0x01, 0x01, 0x00, 0x00, 0x77 };
+	CHECK_EQUAL( 0, memcmp( deltaShuffled, dst, sizeof( src ) ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FILTER, RoundTripRandom )
+// NOLINTEND
+{
+	uint8_t src[UTEST_FILTER_MAX_SIZE];
+	uint8_t filtered[UTEST_FILTER_MAX_SIZE];
+	uint8_t restored[UTEST_FILTER_MAX_SIZE];
+
+	for( size_t i = 0; i < sizeof( src ); i++ )
+	{
+		src[i] = (uint8_t)( rand() & 0xFF );
+	}
+
+	for( const eDZCOBS_filter filter : s_filters )
+	{
+		for( const uint8_t elementSize : s_elementSizes )
+		{
+			const uint8_t descriptor = dzcobs_filter_descriptor( filter, elementSize );
+
+			for( size_t size = 1; size <= sizeof( src ); size += 7 )
+			{
+				dzcobs_filter_encode( descriptor, src, filtered, size );
+
+				memset( restored, 0xEE, sizeof( restored ) );
+				dzcobs_filter_decode( descriptor, filtered, restored, size );
+				CHECK_EQUAL( 0, memcmp( src, restored, size ) );
+				CHECK_EQUAL( 0xEE, restored[size] );
+
+				dzcobs_filter_decode_inplace( descriptor, filtered, size );
+				CHECK_EQUAL( 0, memcmp( src, filtered, size ) );
+			}
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FILTER, EncodeDecodeFrame )
+// NOLINTEND
+{
+	uint8_t src[UTEST_FILTER_MAX_SIZE];
+	uint8_t encoded[DZCOBS_MAX_ENCODED_SIZE( UTEST_FILTER_MAX_SIZE ) + 8];
+	uint8_t decoded[UTEST_FILTER_MAX_SIZE];
+
+	for( size_t i = 0; i < sizeof( src ); i++ )
+	{
+		src[i] = (uint8_t)( rand() & 0xFF );
+	}
+
+	for( const eDZCOBS_filter filter : s_filters )
+	{
+		for( const uint8_t elementSize : s_elementSizes )
+		{
+			for( size_t size = 1; size <= sizeof( src ); size += 61 )
+			{
+				size_t encodedLen = 0;
+
+				eDZCOBS_ret ret = encode_filtered( DZCOBS_PLAIN,
+																					 NULL,
+																					 filter,
+																					 elementSize,
+																					 src,
+																					 size,
+																					 DZCOBS_FILTER_BLOCK_SIZE * 2,
+																					 encoded,
+																					 sizeof( encoded ),
+																					 &encodedLen );
+				CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+
+				// Tail has the descriptor and the extension byte
+				CHECK_EQUAL( dzcobs_filter_descriptor( filter, elementSize ), encoded[encodedLen - 4] );
+				CHECK_EQUAL( DZCOBS_EXT_MARKER | DZCOBS_EXT_FILTER | DZCOBS_PLAIN, encoded[encodedLen - 3] );
+				CHECK_EQUAL( ( 0x2A << 2 ) | DZCOBS_RESERVED, encoded[encodedLen - 2] );
+
+				for( size_t i = 0; i < encodedLen; i++ )
+				{
+					CHECK( encoded[i] != 0 );
+				}
+
+				sDZCOBS_decodectx decodeCtx;
+				memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+				decodeCtx.srcBufEncoded			= encoded;
+				decodeCtx.srcBufEncodedLen	= encodedLen;
+				decodeCtx.dstBufDecoded			= decoded;
+				decodeCtx.dstBufDecodedSize = sizeof( decoded );
+
+				size_t decodedLen			 = 0;
+				uint8_t user6bitsValue = 0;
+
+				ret = dzcobs_decode( &decodeCtx, &decodedLen, &user6bitsValue );
+				CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+				CHECK_EQUAL( 0x2A, user6bitsValue );
+				CHECK_EQUAL( size, decodedLen );
+				CHECK_EQUAL( 0, memcmp( src, decoded, size ) );
+			}
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FILTER, SensorSamplesCompressBetter )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS,
+							 dzcobs_dictionary_init( &dictCtx, G_DZCOBS_DefaultDictionary, G_DZCOBS_DefaultDictionary_size ) );
+
+	// Slow varying 32 bit samples
+	uint8_t src[UTEST_FILTER_MAX_SIZE];
+
+	for( size_t i = 0; i < ( sizeof( src ) / 4 ); i++ )
+	{
+		const uint32_t sample = 0x00123456 + ( (uint32_t)i * 3 ) + ( (uint32_t)rand() % 3 );
+		memcpy( &src[i * 4], &sample, sizeof( sample ) );
+	}
+
+	uint8_t encoded[DZCOBS_MAX_ENCODED_SIZE( UTEST_FILTER_MAX_SIZE ) + 8];
+	size_t rawLen			 = 0;
+	size_t filteredLen = 0;
+
+	eDZCOBS_ret ret = encode_filtered( DZCOBS_USING_DICT_1,
+																		 &dictCtx,
+																		 DZCOBS_FILTER_NONE,
+																		 4,
+																		 src,
+																		 sizeof( src ),
+																		 sizeof( src ),
+																		 encoded,
+																		 sizeof( encoded ),
+																		 &rawLen );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+
+	ret = encode_filtered( DZCOBS_USING_DICT_1,
+												 &dictCtx,
+												 DZCOBS_FILTER_DELTA_SHUFFLE,
+												 4,
+												 src,
+												 sizeof( src ),
+												 sizeof( src ),
+												 encoded,
+												 sizeof( encoded ),
+												 &filteredLen );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+
+	CHECK( ( filteredLen * 4 ) < ( rawLen * 3 ) );
+
+	uint8_t decoded[UTEST_FILTER_MAX_SIZE];
+
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	decodeCtx.srcBufEncoded			= encoded;
+	decodeCtx.srcBufEncodedLen	= filteredLen;
+	decodeCtx.dstBufDecoded			= decoded;
+	decodeCtx.dstBufDecodedSize = sizeof( decoded );
+	decodeCtx.pDict[0]					= &dictCtx;
+
+	size_t decodedLen			 = 0;
+	uint8_t user6bitsValue = 0;
+
+	ret = dzcobs_decode( &decodeCtx, &decodedLen, &user6bitsValue );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+	CHECK_EQUAL( sizeof( src ), decodedLen );
+	CHECK_EQUAL( 0, memcmp( src, decoded, sizeof( src ) ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FILTER, InvalidSequence )
+// NOLINTEND
+{
+	uint8_t src[DZCOBS_FILTER_BLOCK_SIZE] = { 1 };
+	uint8_t encoded[DZCOBS_MAX_ENCODED_SIZE( DZCOBS_FILTER_BLOCK_SIZE * 2 ) + 8];
+
+	sDZCOBS_ctx ctx;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, encoded, sizeof( encoded ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA, 3 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_NONE, 4 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA, 4 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_FILTER_SEQUENCE, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA, 4 ) );
+
+	// A partial block must be the last one
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, src, DZCOBS_FILTER_BLOCK_SIZE ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, src, 10 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_FILTER_SEQUENCE, dzcobs_encode_inc( &ctx, src, 10 ) );
+
+	// Filter cannot be set after data was added
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_PLAIN, encoded, sizeof( encoded ) ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, src, 10 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_FILTER_SEQUENCE, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA, 4 ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
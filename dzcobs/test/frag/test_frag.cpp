@@ -0,0 +1,464 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_frag.cpp
+///	@brief Tests for the fragmentation TX scheduler and the reassembler
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_frag.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_FRAG_MAX_SIZE ( 2048 )
+#define UTEST_FRAG_FRAME_SIZE ( 512 )
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_FRAG ){
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+// NOLINTEND
+// clang-format on
+
+static void fill_random( uint8_t *aBuf, size_t aSize )
+{
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		aBuf[i] = ( ( rand() % 8 ) == 0 ) ? 0 : (uint8_t)( rand() & 0xFF );
+	}
+}
+
+/// Encode the next fragment and decode it back
+static size_t next_fragment( sDZCOBS_txsched *aSched, uint8_t *aOutFragment, uint8_t *aOutUser6bits )
+{
+	uint8_t frame[UTEST_FRAG_FRAME_SIZE];
+	size_t frameLen = 0;
+
+	eDZCOBS_ret ret = dzcobs_txsched_next( aSched, frame, sizeof( frame ), &frameLen );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+
+	if( frameLen == 0 )
+	{
+		return 0;
+	}
+
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	decodeCtx.srcBufEncoded			= frame;
+	decodeCtx.srcBufEncodedLen	= frameLen;
+	decodeCtx.dstBufDecoded			= aOutFragment;
+	decodeCtx.dstBufDecodedSize = UTEST_FRAG_FRAME_SIZE;
+
+	size_t fragmentLen = 0;
+
+	ret = dzcobs_decode( &decodeCtx, &fragmentLen, aOutUser6bits );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, ret );
+	CHECK( fragmentLen >= DZCOBS_FRAG_HEADER_SIZE );
+
+	return fragmentLen;
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_FRAG, SplitAndReassemble )
+// NOLINTEND
+{
+	static uint8_t data[UTEST_FRAG_MAX_SIZE];
+	static uint8_t reasmBuf[UTEST_FRAG_MAX_SIZE];
+	uint8_t fragment[UTEST_FRAG_FRAME_SIZE];
+
+	const size_t fragmentSizes[] = { 1, 7, 64, 200 };
+	const size_t dataSizes[]		 = { 1, 2, 63, 64, 65, 199, 200, 201, 1000, UTEST_FRAG_MAX_SIZE };
+
+	for( const size_t fragmentSize : fragmentSizes )
+	{
+		for( const size_t dataSize : dataSizes )
+		{
+			if( ( ( dataSize + fragmentSize - 1 ) / fragmentSize ) > DZCOBS_FRAG_MAX_FRAGMENTS )
+			{
+				continue;
+			}
+
+			fill_random( data, dataSize );
+
+			sDZCOBS_txsched sched;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_init( &sched, DZCOBS_PLAIN, NULL, fragmentSize ) );
+
+			sDZCOBS_txmsg msg;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_submit( &sched, &msg, 2, 5, 0x15, data, dataSize ) );
+
+			sDZCOBS_reasm reasm;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_init( &reasm, reasmBuf, sizeof( reasmBuf ), 1 ) );
+
+			const uint8_t *pMsg = NULL;
+			size_t msgLen				= 0;
+			size_t nFragments		= 0;
+			uint8_t user6bits		= 0;
+			uint8_t streamId		= 0;
+			size_t fragmentLen;
+
+			while( ( fragmentLen = next_fragment( &sched, fragment, &user6bits ) ) != 0 )
+			{
+				CHECK( pMsg == NULL );
+				CHECK_EQUAL( 0x15, user6bits );
+				CHECK( ( fragmentLen - DZCOBS_FRAG_HEADER_SIZE ) <= fragmentSize );
+
+				nFragments++;
+
+				CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+										 dzcobs_reasm_push( &reasm, fragment, fragmentLen, &pMsg, &msgLen, &streamId ) );
+				CHECK_EQUAL( 5, streamId );
+			}
+
+			CHECK_EQUAL( ( dataSize + fragmentSize - 1 ) / fragmentSize, nFragments );
+			CHECK( dzcobs_txmsg_isdone( &msg ) );
+			CHECK( pMsg != NULL );
+			CHECK_EQUAL( dataSize, msgLen );
+			MEMCMP_EQUAL( data, pMsg, dataSize );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FRAG, BadArguments )
+// NOLINTEND
+{
+	const uint8_t data[8] = { 0 };
+	uint8_t buf[16];
+
+	sDZCOBS_txsched sched;
+	sDZCOBS_txmsg msg;
+	sDZCOBS_reasm reasm;
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_txsched_init( &sched, DZCOBS_PLAIN, NULL, 0 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_txsched_init( &sched, DZCOBS_USING_DICT_1, NULL, 8 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_init( &sched, DZCOBS_PLAIN, NULL, 1 ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_txsched_submit( &sched, &msg, 0, 0, 1, data, 0 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_txsched_submit( &sched, &msg, DZCOBS_TXSCHED_N_PRIORITIES, 0, 1, data, 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_txsched_submit( &sched, &msg, 0, DZCOBS_FRAG_N_STREAMS, 1, data, 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_txsched_submit( &sched, &msg, 0, 0, 0, data, 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_txsched_submit( &sched, &msg, 0, 0, 0x40, data, 1 ) );
+
+	// More than DZCOBS_FRAG_MAX_FRAGMENTS fragments
+	static uint8_t bigData[DZCOBS_FRAG_MAX_FRAGMENTS + 1];
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_txsched_submit( &sched, &msg, 0, 0, 1, bigData, sizeof( bigData ) ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_txsched_submit( &sched, &msg, 0, 0, 1, bigData, DZCOBS_FRAG_MAX_FRAGMENTS ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_reasm_init( &reasm, buf, sizeof( buf ), 0 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_reasm_init( &reasm, buf, sizeof( buf ), DZCOBS_REASM_MAX_SLOTS + 1 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_init( &reasm, buf, sizeof( buf ), 2 ) );
+
+	const uint8_t *pMsg = NULL;
+	size_t msgLen				= 0;
+	uint8_t streamId		= 0;
+
+	const uint8_t tooShort[1]		= { DZCOBS_FRAG_LAST };
+	const uint8_t reservedBit[3] = { DZCOBS_FRAG_LAST | 0x10, 0, 1 };
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+							 dzcobs_reasm_push( &reasm, tooShort, sizeof( tooShort ), &pMsg, &msgLen, &streamId ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+							 dzcobs_reasm_push( &reasm, reservedBit, sizeof( reservedBit ), &pMsg, &msgLen, &streamId ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FRAG, PriorityPreemption )
+// NOLINTEND
+{
+	static uint8_t lowData[1000];
+	static uint8_t highData[10];
+	uint8_t fragment[UTEST_FRAG_FRAME_SIZE];
+	uint8_t user6bits = 0;
+
+	fill_random( lowData, sizeof( lowData ) );
+	fill_random( highData, sizeof( highData ) );
+
+	sDZCOBS_txsched sched;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_init( &sched, DZCOBS_PLAIN, NULL, 100 ) );
+
+	sDZCOBS_txmsg lowMsg;
+	sDZCOBS_txmsg highMsg;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_txsched_submit( &sched, &lowMsg, 3, 1, 1, lowData, sizeof( lowData ) ) );
+
+	// Three fragments of the low priority message
+	for( size_t i = 0; i < 3; i++ )
+	{
+		CHECK_EQUAL( 102, next_fragment( &sched, fragment, &user6bits ) );
+		CHECK_EQUAL( 1, fragment[0] );
+		CHECK_EQUAL( i, fragment[1] );
+	}
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_txsched_submit( &sched, &highMsg, 0, 2, 2, highData, sizeof( highData ) ) );
+
+	// The high priority message goes on the next fragment
+	CHECK_EQUAL( 12, next_fragment( &sched, fragment, &user6bits ) );
+	CHECK_EQUAL( 2 | DZCOBS_FRAG_LAST, fragment[0] );
+	CHECK_EQUAL( 0, fragment[1] );
+	CHECK_EQUAL( 2, user6bits );
+	MEMCMP_EQUAL( highData, &fragment[DZCOBS_FRAG_HEADER_SIZE], sizeof( highData ) );
+	CHECK( dzcobs_txmsg_isdone( &highMsg ) );
+	CHECK_FALSE( dzcobs_txmsg_isdone( &lowMsg ) );
+
+	// The low priority message continues where it was
+	for( size_t i = 3; i < 10; i++ )
+	{
+		CHECK_EQUAL( 102, next_fragment( &sched, fragment, &user6bits ) );
+		CHECK_EQUAL( ( i == 9 ) ? ( 1 | DZCOBS_FRAG_LAST ) : 1, fragment[0] );
+		CHECK_EQUAL( i, fragment[1] );
+		MEMCMP_EQUAL( &lowData[i * 100], &fragment[DZCOBS_FRAG_HEADER_SIZE], 100 );
+	}
+
+	CHECK( dzcobs_txmsg_isdone( &lowMsg ) );
+	CHECK_EQUAL( 0, next_fragment( &sched, fragment, &user6bits ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FRAG, StreamInFlight )
+// NOLINTEND
+{
+	static uint8_t data[300];
+	uint8_t fragment[UTEST_FRAG_FRAME_SIZE];
+	uint8_t user6bits = 0;
+
+	fill_random( data, sizeof( data ) );
+
+	sDZCOBS_txsched sched;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_init( &sched, DZCOBS_PLAIN, NULL, 100 ) );
+
+	sDZCOBS_txmsg lowMsg;
+	sDZCOBS_txmsg highMsg;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_submit( &sched, &lowMsg, 1, 7, 1, data, sizeof( data ) ) );
+	CHECK_EQUAL( 102, next_fragment( &sched, fragment, &user6bits ) );
+
+	// Same stream, it must wait for the partial message to finish
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_submit( &sched, &highMsg, 0, 7, 2, data, 10 ) );
+
+	CHECK_EQUAL( 102, next_fragment( &sched, fragment, &user6bits ) );
+	CHECK_EQUAL( 1, user6bits );
+	CHECK_EQUAL( 102, next_fragment( &sched, fragment, &user6bits ) );
+	CHECK_EQUAL( 1, user6bits );
+	CHECK( dzcobs_txmsg_isdone( &lowMsg ) );
+
+	CHECK_EQUAL( 12, next_fragment( &sched, fragment, &user6bits ) );
+	CHECK_EQUAL( 2, user6bits );
+	CHECK( dzcobs_txmsg_isdone( &highMsg ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FRAG, DestinyTooSmall )
+// NOLINTEND
+{
+	static uint8_t data[200];
+	uint8_t frame[UTEST_FRAG_FRAME_SIZE];
+	uint8_t fragment[UTEST_FRAG_FRAME_SIZE];
+	uint8_t user6bits = 0;
+	size_t frameLen		= 0;
+
+	fill_random( data, sizeof( data ) );
+
+	sDZCOBS_txsched sched;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_init( &sched, DZCOBS_PLAIN, NULL, 100 ) );
+
+	sDZCOBS_txmsg msg;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_submit( &sched, &msg, 0, 0, 1, data, sizeof( data ) ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_txsched_next( &sched, frame, 16, &frameLen ) );
+	CHECK_EQUAL( 0, frameLen );
+
+	// Nothing was lost
+	CHECK_EQUAL( 102, next_fragment( &sched, fragment, &user6bits ) );
+	CHECK_EQUAL( 0, fragment[1] );
+	MEMCMP_EQUAL( data, &fragment[DZCOBS_FRAG_HEADER_SIZE], 100 );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FRAG, InterleavedStreams )
+// NOLINTEND
+{
+	static uint8_t data[4][500];
+	static uint8_t reasmBuf[4 * 500];
+	uint8_t fragment[UTEST_FRAG_FRAME_SIZE];
+	uint8_t user6bits = 0;
+
+	sDZCOBS_txsched sched;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_init( &sched, DZCOBS_PLAIN, NULL, 64 ) );
+
+	sDZCOBS_reasm reasm;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_init( &reasm, reasmBuf, sizeof( reasmBuf ), 4 ) );
+
+	sDZCOBS_txmsg msgs[4];
+
+	// Submit one message per priority, the others are submitted while sending
+	fill_random( data[3], sizeof( data[3] ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_txsched_submit( &sched, &msgs[3], 3, 3, 4, data[3], sizeof( data[3] ) ) );
+
+	size_t nReceived = 0;
+	size_t nSent		 = 0;
+	size_t fragmentLen;
+
+	while( ( fragmentLen = next_fragment( &sched, fragment, &user6bits ) ) != 0 )
+	{
+		nSent++;
+
+		if( ( nSent % 3 ) == 0 && ( nSent / 3 ) < 4 )
+		{
+			const size_t i = 3 - ( nSent / 3 );
+			fill_random( data[i], sizeof( data[i] ) );
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+									 dzcobs_txsched_submit( &sched, &msgs[i], (uint8_t)i, (uint8_t)i, (uint8_t)( i + 1 ), data[i],
+																					sizeof( data[i] ) ) );
+		}
+
+		const uint8_t *pMsg = NULL;
+		size_t msgLen				= 0;
+		uint8_t streamId		= 0;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, fragmentLen, &pMsg, &msgLen, &streamId ) );
+		CHECK_EQUAL( streamId + 1, user6bits );
+
+		if( pMsg )
+		{
+			CHECK_EQUAL( sizeof( data[streamId] ), msgLen );
+			MEMCMP_EQUAL( data[streamId], pMsg, msgLen );
+			nReceived++;
+		}
+	}
+
+	CHECK_EQUAL( 4, nReceived );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FRAG, ReassemblyBudget )
+// NOLINTEND
+{
+	uint8_t reasmBuf[64];
+	const uint8_t *pMsg = NULL;
+	size_t msgLen				= 0;
+	uint8_t streamId		= 0;
+
+	sDZCOBS_reasm reasm;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_init( &reasm, reasmBuf, sizeof( reasmBuf ), 2 ) );
+
+	uint8_t fragment[2 + 20];
+	memset( fragment, 0xA5, sizeof( fragment ) );
+
+	// Two partial messages use both slots
+	fragment[0] = 0;
+	fragment[1] = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+	fragment[0] = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+
+	// No slot for a third one
+	fragment[0] = 2;
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW,
+							 dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+
+	// A single fragment message does not need a slot
+	fragment[0] = 2 | DZCOBS_FRAG_LAST;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+	CHECK( pMsg == &fragment[DZCOBS_FRAG_HEADER_SIZE] );
+	CHECK_EQUAL( 20, msgLen );
+	CHECK_EQUAL( 2, streamId );
+
+	// Stream 0 exceeds the 32 bytes of its slot and is dropped
+	fragment[0] = 0;
+	fragment[1] = 1;
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW,
+							 dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+	CHECK( pMsg == NULL );
+
+	// Its slot can be used again
+	fragment[0] = 3;
+	fragment[1] = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, 2 + 12, &pMsg, &msgLen, &streamId ) );
+	fragment[0] = 3 | DZCOBS_FRAG_LAST;
+	fragment[1] = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+	CHECK( pMsg != NULL );
+	CHECK_EQUAL( 32, msgLen );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_FRAG, SequenceGap )
+// NOLINTEND
+{
+	uint8_t reasmBuf[256];
+	const uint8_t *pMsg = NULL;
+	size_t msgLen				= 0;
+	uint8_t streamId		= 0;
+
+	sDZCOBS_reasm reasm;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_init( &reasm, reasmBuf, sizeof( reasmBuf ), 1 ) );
+
+	uint8_t fragment[2 + 10];
+	memset( fragment, 0x5A, sizeof( fragment ) );
+
+	fragment[0] = 4;
+	fragment[1] = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+
+	// Fragment 1 was lost
+	fragment[0] = 4 | DZCOBS_FRAG_LAST;
+	fragment[1] = 2;
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_FRAGMENT_SEQUENCE,
+							 dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+	CHECK( pMsg == NULL );
+
+	// A continuation without its start
+	fragment[0] = 5;
+	fragment[1] = 1;
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_FRAGMENT_SEQUENCE,
+							 dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+
+	// The slot was released, a new message of the stream is received
+	fragment[0] = 4;
+	fragment[1] = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+
+	// A new start drops the incomplete message
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+	fragment[0] = 4 | DZCOBS_FRAG_LAST;
+	fragment[1] = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_reasm_push( &reasm, fragment, sizeof( fragment ), &pMsg, &msgLen, &streamId ) );
+	CHECK( pMsg != NULL );
+	CHECK_EQUAL( 20, msgLen );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
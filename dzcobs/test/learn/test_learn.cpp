@@ -0,0 +1,305 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_learn.cpp
+///	@brief Tests for the on-device dictionary learner
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_learn.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_LEARN_PAYLOAD_MAX_SIZE ( 128 )
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_LEARN ){
+	void setup()
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_init( &m_learn ) );
+	}
+
+	void teardown()
+	{
+	}
+
+	sDZCOBS_learn m_learn;
+	char m_dict[DZCOBS_LEARN_MAX_DICT_SIZE];
+	size_t m_dictLen;
+};
+// NOLINTEND
+// clang-format on
+
+/// Telemetry like payload, with some fixed text and a changing value
+static size_t make_payload( uint8_t *aBuf, unsigned aSeq )
+{
+	const int len = snprintf( (char *)aBuf,
+														UTEST_LEARN_PAYLOAD_MAX_SIZE,
+														"{\"seq\":%u,\"temp\":%u}\r\n",
+														aSeq,
+														( aSeq * 7u ) % 100u );
+
+	return (size_t)len;
+}
+
+/// Size of the encoded frame, checking it decodes back
+static size_t encode_size( const sDICT_ctx *aDict, const uint8_t *aPayload, size_t aPayloadSize )
+{
+	uint8_t encoded[DZCOBS_MAX_ENCODED_SIZE( UTEST_LEARN_PAYLOAD_MAX_SIZE ) + DZCOBS_FRAME_HEADER_SIZE];
+	uint8_t decoded[UTEST_LEARN_PAYLOAD_MAX_SIZE];
+
+	const eDZCOBS_encoding encoding = ( aDict != NULL ) ? DZCOBS_USING_DICT_1 : DZCOBS_PLAIN;
+
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	if( aDict != NULL )
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, aDict, DZCOBS_USING_DICT_1 ) );
+	}
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, encoding, encoded, sizeof( encoded ) ) );
+	ctx.user6bits = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, aPayload, aPayloadSize ) );
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	decodeCtx.srcBufEncoded			= encoded;
+	decodeCtx.srcBufEncodedLen	= encodedLen;
+	decodeCtx.dstBufDecoded			= decoded;
+	decodeCtx.dstBufDecodedSize = sizeof( decoded );
+	decodeCtx.pDict[0]					= aDict;
+
+	size_t decodedLen = 0;
+	uint8_t user6bits = 0;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( aPayloadSize, decodedLen );
+	CHECK_EQUAL( 0, memcmp( aPayload, decoded, aPayloadSize ) );
+
+	return encodedLen;
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_LEARN, InvalidArgs )
+// NOLINTEND
+{
+	const uint8_t data[] = { 1, 2, 3 };
+
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_learn_init( NULL ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_learn_update( NULL, data, sizeof( data ) ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_learn_update( &m_learn, NULL, 1 ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_learn_payload_end( NULL ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_learn_build( NULL, m_dict, sizeof( m_dict ), &m_dictLen ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_learn_build( &m_learn, NULL, sizeof( m_dict ), &m_dictLen ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_learn_build( &m_learn, m_dict, sizeof( m_dict ), NULL ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_LEARN, NotEnoughData )
+// NOLINTEND
+{
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_learn_build( &m_learn, m_dict, sizeof( m_dict ), &m_dictLen ) );
+
+	// Every n-gram seen once
+	const uint8_t data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &m_learn, data, sizeof( data ) ) );
+
+	CHECK_EQUAL( DICT_RET_ERR_INVALID, dzcobs_learn_build( &m_learn, m_dict, sizeof( m_dict ), &m_dictLen ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_LEARN, BuildReducesEncodedSize )
+// NOLINTEND
+{
+	uint8_t payload[UTEST_LEARN_PAYLOAD_MAX_SIZE];
+
+	for( unsigned seq = 0; seq < 500; seq++ )
+	{
+		const size_t payloadSize = make_payload( payload, seq );
+
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &m_learn, payload, payloadSize ) );
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_payload_end( &m_learn ) );
+	}
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_build( &m_learn, m_dict, sizeof( m_dict ), &m_dictLen ) );
+	CHECK_EQUAL( DICT_IS_VALID, dzcobs_dictionary_isvalid( m_dict, m_dictLen ) );
+	CHECK_EQUAL( 0, m_dict[m_dictLen - 1] );
+
+	sDICT_ctx dictCtx;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCtx, m_dict, m_dictLen ) );
+
+	size_t plainSize = 0;
+	size_t dictSize	 = 0;
+
+	for( unsigned seq = 1000; seq < 1100; seq++ )
+	{
+		const size_t payloadSize = make_payload( payload, seq );
+
+		plainSize += encode_size( NULL, payload, payloadSize );
+		dictSize += encode_size( &dictCtx, payload, payloadSize );
+	}
+
+	CHECK( ( dictSize * 10 ) < ( plainSize * 7 ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_LEARN, ShadowedWordsAreLeftOut )
+// NOLINTEND
+{
+	// "ABCDE" and all its n-grams are frequent, "AB" shadows every longer word
+	// starting with it
+	const uint8_t data[] = { 'A', 'B', 'C', 'D', 'E', 0 };
+
+	for( int i = 0; i < 100; i++ )
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &m_learn, data, sizeof( data ) ) );
+	}
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_build( &m_learn, m_dict, sizeof( m_dict ), &m_dictLen ) );
+	CHECK_EQUAL( DICT_IS_VALID, dzcobs_dictionary_isvalid( m_dict, m_dictLen ) );
+
+	// No word is a prefix of another word
+	const char *pWord = m_dict;
+
+	while( *pWord != 0 )
+	{
+		const size_t size = (size_t)( *pWord - '0' );
+
+		for( const char *pOther = m_dict; *pOther != 0; pOther += ( *pOther - '0' ) + 1 )
+		{
+			const size_t otherSize = (size_t)( *pOther - '0' );
+
+			if( ( pOther != pWord ) && ( otherSize < size ) )
+			{
+				CHECK( memcmp( pOther + 1, pWord + 1, otherSize ) != 0 );
+			}
+		}
+
+		pWord += size + 1;
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_LEARN, PayloadSplitAcrossCalls )
+// NOLINTEND
+{
+	sDZCOBS_learn learnSplit;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_init( &learnSplit ) );
+
+	uint8_t payload[UTEST_LEARN_PAYLOAD_MAX_SIZE];
+
+	for( unsigned seq = 0; seq < 50; seq++ )
+	{
+		const size_t payloadSize = make_payload( payload, seq );
+
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &m_learn, payload, payloadSize ) );
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_payload_end( &m_learn ) );
+
+		for( size_t i = 0; i < payloadSize; i++ )
+		{
+			CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &learnSplit, &payload[i], 1 ) );
+		}
+
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_payload_end( &learnSplit ) );
+	}
+
+	CHECK_EQUAL( 0, memcmp( &m_learn, &learnSplit, sizeof( sDZCOBS_learn ) ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_LEARN, BufferTooSmall )
+// NOLINTEND
+{
+	const uint8_t data[] = { 'x', 'y', 'x', 'y', 'x', 'y' };
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &m_learn, data, sizeof( data ) ) );
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_build( &m_learn, m_dict, sizeof( m_dict ), &m_dictLen ) );
+	CHECK_EQUAL( DICT_RET_ERR_BAD_ARG, dzcobs_learn_build( &m_learn, m_dict, m_dictLen - 1, &m_dictLen ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_LEARN, CountsSaturation )
+// NOLINTEND
+{
+	const uint8_t zeros[256] = { 0 };
+
+	for( int i = 0; i < 300; i++ )
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &m_learn, zeros, sizeof( zeros ) ) );
+	}
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_build( &m_learn, m_dict, sizeof( m_dict ), &m_dictLen ) );
+
+	// The longest run of zeros has the best gain, the shorter ones would shadow it
+	CHECK_EQUAL( 7, m_dictLen );
+	CHECK_EQUAL( 0, memcmp( m_dict, "5\0\0\0\0\0", 7 ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_LEARN, AgingIsSpread )
+// NOLINTEND
+{
+	const uint8_t zero					= 0;
+	const size_t nNgramsPerByte = DZCOBS_LEARN_MAX_WORD_SIZE - DZCOBS_LEARN_MIN_WORD_SIZE + 1;
+
+	while( m_learn.nAging == 0 )
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &m_learn, &zero, 1 ) );
+	}
+
+	// The aging started on one of the n-grams of the last byte
+	CHECK( m_learn.nAging > ( DZCOBS_LEARN_N_ENTRIES - nNgramsPerByte ) );
+
+	// Each byte halves one entry per n-gram, not the whole table
+	while( m_learn.nAging >= nNgramsPerByte )
+	{
+		const size_t nAging = m_learn.nAging;
+
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &m_learn, &zero, 1 ) );
+		CHECK_EQUAL( nAging - nNgramsPerByte, m_learn.nAging );
+	}
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_update( &m_learn, &zero, 1 ) );
+	CHECK_EQUAL( 0, m_learn.nAging );
+
+	for( size_t i = 0; i < DZCOBS_LEARN_N_ENTRIES; i++ )
+	{
+		CHECK( m_learn.entries[i].count <= 0x8000 + DZCOBS_LEARN_N_ENTRIES );
+	}
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_learn_build( &m_learn, m_dict, sizeof( m_dict ), &m_dictLen ) );
+	CHECK_EQUAL( 7, m_dictLen );
+	CHECK_EQUAL( 0, memcmp( m_dict, "5\0\0\0\0\0", 7 ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,75 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dictionary_matcher.c
+///	@brief Dictionary of the generated matcher tests. All the word sizes, words
+/// sharing their first bytes across sizes, zero and high bytes.
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs_dictionary.h>
+
+extern const char G_UTEST_MatcherDictionary[];
+extern const size_t G_UTEST_MatcherDictionary_size;
+
+// clang-format off
+
+/// Dictionary string, descendent order, null terminated
+const char G_UTEST_MatcherDictionary[] =
+	DICT_ADD_WORD(2, "\x00\x00")
+	DICT_ADD_WORD(2, "\x00\xFF")
+	DICT_ADD_WORD(2, "\x0D\x0A")
+	DICT_ADD_WORD(2, "\x22\x2C")
+	DICT_ADD_WORD(2, "\x22\x3A")
+	DICT_ADD_WORD(2, "\x65\x20")
+	DICT_ADD_WORD(2, "\x65\x64")
+	DICT_ADD_WORD(2, "\x65\x72")
+	DICT_ADD_WORD(2, "\x74\x00")
+	DICT_ADD_WORD(2, "\x74\x68")
+	DICT_ADD_WORD(2, "\xFF\x00")
+	DICT_ADD_WORD(3, "\x00\x00\x00")
+	DICT_ADD_WORD(3, "\x00\x00\x01")
+	DICT_ADD_WORD(3, "\x22\x2C\x22")
+	DICT_ADD_WORD(3, "\x22\x3A\x22")
+	DICT_ADD_WORD(3, "\x65\x0D\x0A")
+	DICT_ADD_WORD(3, "\x69\x6E\x67")
+	DICT_ADD_WORD(3, "\x74\x65\x72")
+	DICT_ADD_WORD(3, "\x74\x68\x00")
+	DICT_ADD_WORD(3, "\x74\x68\x65")
+	DICT_ADD_WORD(3, "\xFF\xFF\xFF")
+	DICT_ADD_WORD(4, "\x00\x00\x00\x01")
+	DICT_ADD_WORD(4, "\x01\x00\x00\x00")
+	DICT_ADD_WORD(4, "\x22\x69\x64\x22")
+	DICT_ADD_WORD(4, "\x65\x72\x72\x6F")
+	DICT_ADD_WORD(4, "\x74\x65\x6D\x70")
+	DICT_ADD_WORD(4, "\x74\x65\x78\x74")
+	DICT_ADD_WORD(4, "\x74\x68\x65\x6E")
+	DICT_ADD_WORD(4, "\x74\x72\x75\x65")
+	DICT_ADD_WORD(4, "\xFE\xFF\x00\x00")
+	DICT_ADD_WORD(5, "\x00\x00\x00\x00\x00")
+	DICT_ADD_WORD(5, "\x22\x69\x64\x22\x3A")
+	DICT_ADD_WORD(5, "\x65\x72\x72\x6F\x72")
+	DICT_ADD_WORD(5, "\x66\x61\x6C\x73\x65")
+	DICT_ADD_WORD(5, "\x73\x74\x61\x74\x65")
+	DICT_ADD_WORD(5, "\x74\x65\x6D\x70\x22")
+	DICT_ADD_WORD(5, "\x74\x68\x65\x0D\x0A")
+	DICT_ADD_WORD(5, "\x74\x68\x65\x72\x65")
+	DICT_ADD_WORD(5, "\xFF\xFE\xFD\xFC\xFB")
+;
+
+// clang-format on
+
+const size_t G_UTEST_MatcherDictionary_size = sizeof( G_UTEST_MatcherDictionary );
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
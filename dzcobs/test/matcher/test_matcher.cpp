@@ -0,0 +1,199 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_matcher.cpp
+///	@brief Tests the matcher generated by dzcobs_add_dictionary_matcher against
+/// the generic dictionary search
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzcobs/dzcobs_dictionary.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_MATCHER_N_RANDOM_KEYS ( 200000 )
+#define UTEST_MATCHER_MAX_KEY_SIZE ( 8 )
+
+extern "C" const char G_UTEST_MatcherDictionary[];
+extern "C" const size_t G_UTEST_MatcherDictionary_size;
+
+/// Generated from test/matcher/dictionary_matcher.c
+extern "C" const sDICT_ctx G_UTEST_Matcher;
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_MATCHER ){
+	void setup()
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS,
+								 dzcobs_dictionary_init( &m_dict, G_UTEST_MatcherDictionary, G_UTEST_MatcherDictionary_size ) );
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx m_dict;
+};
+// NOLINTEND
+// clang-format on
+
+/// Searches aKey with the generic search and the generated matcher
+static void check_same_search( const sDICT_ctx *aExpected, const uint8_t *aKey, size_t aKeySize )
+{
+	size_t sizeExpected = 0;
+	size_t sizeMatcher	= 0;
+
+	const uint8_t idxExpected = dzcobs_dictionary_search( aExpected, aKey, aKeySize, &sizeExpected );
+	const uint8_t idxMatcher	= dzcobs_dictionary_search( &G_UTEST_Matcher, aKey, aKeySize, &sizeMatcher );
+
+	CHECK_EQUAL( idxExpected, idxMatcher );
+
+	if( idxExpected != 0 )
+	{
+		CHECK_EQUAL( sizeExpected, sizeMatcher );
+	}
+}
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_MATCHER, Context )
+// NOLINTEND
+{
+	CHECK( G_UTEST_Matcher.searchFunc != NULL );
+	CHECK( G_UTEST_Matcher.getFunc != NULL );
+
+	CHECK_EQUAL( m_dict.minWordSize, G_UTEST_Matcher.minWordSize );
+	CHECK_EQUAL( m_dict.maxWordSize, G_UTEST_Matcher.maxWordSize );
+
+	for( size_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *pExpected = &m_dict.wordSizeTable[i];
+		const sDICT_wordentry *pMatcher	 = &G_UTEST_Matcher.wordSizeTable[i];
+
+		CHECK_EQUAL( pExpected->nEntries, pMatcher->nEntries );
+
+		if( pExpected->nEntries > 0 )
+		{
+			CHECK_EQUAL( pExpected->lastIndex, pMatcher->lastIndex );
+			CHECK_EQUAL( pExpected->globalIndex, pMatcher->globalIndex );
+			CHECK_EQUAL( pExpected->strideSize, pMatcher->strideSize );
+			MEMCMP_EQUAL( pExpected->dictionaryBegin, pMatcher->dictionaryBegin,
+										(size_t)pExpected->nEntries * pExpected->strideSize );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_MATCHER, EveryWord )
+// NOLINTEND
+{
+	uint8_t nWords = 0;
+
+	for( size_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		nWords += m_dict.wordSizeTable[i].nEntries;
+	}
+
+	for( uint8_t i = 0; i < nWords; i++ )
+	{
+		uint8_t sizeExpected = 0;
+		uint8_t sizeMatcher	 = 0;
+
+		const uint8_t *pExpected = dzcobs_dictionary_get( &m_dict, i, &sizeExpected );
+		const uint8_t *pMatcher	 = dzcobs_dictionary_get( &G_UTEST_Matcher, i, &sizeMatcher );
+
+		CHECK( pExpected != NULL );
+		CHECK( pMatcher != NULL );
+		CHECK_EQUAL( sizeExpected, sizeMatcher );
+		MEMCMP_EQUAL( pExpected, pMatcher, sizeExpected );
+
+		// The word, alone, cut, and followed by each byte value
+		uint8_t key[UTEST_MATCHER_MAX_KEY_SIZE];
+		memcpy( key, pExpected, sizeExpected );
+
+		for( size_t size = 1; size <= sizeExpected; size++ )
+		{
+			check_same_search( &m_dict, key, size );
+		}
+
+		// A word is always matched, by itself or by a shorter word that starts it
+		size_t sizeFound		= 0;
+		const uint8_t index = dzcobs_dictionary_search( &G_UTEST_Matcher, key, sizeExpected, &sizeFound );
+		CHECK( index != 0 );
+
+		uint8_t foundSize			= 0;
+		const uint8_t *pFound = dzcobs_dictionary_get( &G_UTEST_Matcher, (uint8_t)( index - 1 ), &foundSize );
+		CHECK_EQUAL( sizeFound, foundSize );
+		MEMCMP_EQUAL( key, pFound, foundSize );
+
+		for( unsigned b = 0; b < 256; b++ )
+		{
+			key[sizeExpected] = (uint8_t)b;
+			check_same_search( &m_dict, key, sizeExpected + 1 );
+		}
+	}
+
+	uint8_t wordSize = 0;
+	POINTERS_EQUAL( NULL, dzcobs_dictionary_get( &m_dict, nWords, &wordSize ) );
+	POINTERS_EQUAL( NULL, dzcobs_dictionary_get( &G_UTEST_Matcher, nWords, &wordSize ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_MATCHER, RandomKeys )
+// NOLINTEND
+{
+	// Bytes of the dictionary words, and a few others, so keys often match
+	uint8_t alphabet[256];
+	size_t alphabetSize = 0;
+	bool isInAlphabet[256];
+	memset( isInAlphabet, 0, sizeof( isInAlphabet ) );
+
+	for( size_t i = 0; i < ( G_UTEST_MatcherDictionary_size - 1 ); i++ )
+	{
+		const uint8_t value = (uint8_t)G_UTEST_MatcherDictionary[i];
+
+		if( !isInAlphabet[value] )
+		{
+			isInAlphabet[value]			= true;
+			alphabet[alphabetSize++] = value;
+		}
+	}
+
+	for( size_t n = 0; n < UTEST_MATCHER_N_RANDOM_KEYS; n++ )
+	{
+		uint8_t key[UTEST_MATCHER_MAX_KEY_SIZE];
+		const size_t keySize = 1 + ( (size_t)rand() % UTEST_MATCHER_MAX_KEY_SIZE );
+
+		for( size_t i = 0; i < keySize; i++ )
+		{
+			key[i] = ( ( rand() % 8 ) == 0 ) ? (uint8_t)rand() : alphabet[(size_t)rand() % alphabetSize];
+		}
+
+		check_same_search( &m_dict, key, keySize );
+	}
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
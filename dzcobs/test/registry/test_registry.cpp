@@ -0,0 +1,480 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_registry.cpp
+///	@brief Tests the dictionary registry and the negotiation
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstring>
+#include <dzcobs/dzcobs_crc.h>
+#include <dzcobs/dzcobs_registry.h>
+
+#if defined( UTEST_HAS_THREADS ) && ( UTEST_HAS_THREADS == 1 )
+#include <atomic>
+#include <thread>
+#endif
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_REGISTRY_N_ENTRIES ( 4 )
+
+#define UTEST_REGISTRY_THREADS_N_DICTS	 ( 16 )
+#define UTEST_REGISTRY_THREADS_N_ENTRIES ( 32 )
+#define UTEST_REGISTRY_THREADS_N_ADDERS	 ( 4 )
+#define UTEST_REGISTRY_THREADS_N_FINDERS ( 4 )
+#define UTEST_REGISTRY_THREADS_N_ROUNDS	 ( 50 )
+
+// clang-format off
+// NOLINTBEGIN
+static const char s_TEST_DictionaryA[] =
+	DICT_ADD_WORD(2, "er")
+	DICT_ADD_WORD(3, "the")
+	DICT_ADD_WORD(5, "state")
+;
+
+static const char s_TEST_DictionaryB[] =
+	DICT_ADD_WORD(2, "\r\n")
+	DICT_ADD_WORD(4, "temp")
+;
+
+static const char s_TEST_DictionaryC[] =
+	DICT_ADD_WORD(3, "\":\"")
+	DICT_ADD_WORD(5, "\"id\":")
+;
+// NOLINTEND
+// clang-format on
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_REGISTRY ){
+	void setup()
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS,
+								 dzcobs_dictionary_init( &m_dictA, s_TEST_DictionaryA, sizeof( s_TEST_DictionaryA ) ) );
+		CHECK_EQUAL( DICT_RET_SUCCESS,
+								 dzcobs_dictionary_init( &m_dictB, s_TEST_DictionaryB, sizeof( s_TEST_DictionaryB ) ) );
+		CHECK_EQUAL( DICT_RET_SUCCESS,
+								 dzcobs_dictionary_init( &m_dictC, s_TEST_DictionaryC, sizeof( s_TEST_DictionaryC ) ) );
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_init( &m_registry, m_entries, UTEST_REGISTRY_N_ENTRIES ) );
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx m_dictA;
+	sDICT_ctx m_dictB;
+	sDICT_ctx m_dictC;
+
+	sDZCOBS_registry_entry m_entries[UTEST_REGISTRY_N_ENTRIES];
+	sDZCOBS_registry m_registry;
+};
+// NOLINTEND
+// clang-format on
+
+/// Encodes with a connection and decodes with the other one
+static void check_connections( const sDZCOBS_connection *aEncoderConn,
+															 const sDZCOBS_connection *aDecoderConn,
+															 eDZCOBS_encoding aEncoding )
+{
+	static const uint8_t data[] = "{\"id\":12,\"temp\":\"the error\",\"state\":\"ok\"}\r\n";
+
+	uint8_t encoded[DZCOBS_MAX_ENCODED_SIZE( sizeof( data ) ) + DZCOBS_FRAME_HEADER_SIZE];
+	uint8_t decoded[sizeof( data )];
+	size_t encodedLen = 0;
+	size_t decodedLen = 0;
+	uint8_t user6bits = 0;
+
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_connection_set_encoder( aEncoderConn, &ctx ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, aEncoding, encoded, sizeof( encoded ) ) );
+	ctx.user6bits = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, data, sizeof( data ) ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	sDZCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= encoded;
+	decodeCtx.srcBufEncodedLen	= encodedLen;
+	decodeCtx.dstBufDecoded			= decoded;
+	decodeCtx.dstBufDecodedSize = sizeof( decoded );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_connection_set_decoder( aDecoderConn, &decodeCtx ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( sizeof( data ), decodedLen );
+	MEMCMP_EQUAL( data, decoded, sizeof( data ) );
+}
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_REGISTRY, Id )
+// NOLINTEND
+{
+	// CRC-32C of the dictionary string, without the terminator
+	const uint32_t idA = dzcobs_registry_id( &m_dictA );
+	CHECK_EQUAL( dzcobs_crc32c( 0, (const uint8_t *)s_TEST_DictionaryA, sizeof( s_TEST_DictionaryA ) - 1 ), idA );
+
+	CHECK( idA != 0 );
+	CHECK( idA != dzcobs_registry_id( &m_dictB ) );
+	CHECK( dzcobs_registry_id( &m_dictB ) != dzcobs_registry_id( &m_dictC ) );
+
+	// Same contents, same id
+	static const char dictionaryCopy[] = DICT_ADD_WORD( 2, "er" ) DICT_ADD_WORD( 3, "the" ) DICT_ADD_WORD( 5, "state" );
+	sDICT_ctx dictCopy;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictCopy, dictionaryCopy, sizeof( dictionaryCopy ) ) );
+	CHECK_EQUAL( idA, dzcobs_registry_id( &dictCopy ) );
+
+	CHECK_EQUAL( 0, dzcobs_registry_id( NULL ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_REGISTRY, AddFind )
+// NOLINTEND
+{
+	uint32_t idA = 0;
+	uint32_t idB = 0;
+	uint32_t idC = 0;
+
+	POINTERS_EQUAL( NULL, dzcobs_registry_find( &m_registry, dzcobs_registry_id( &m_dictA ) ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &m_registry, &m_dictA, &idA ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &m_registry, &m_dictB, &idB ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &m_registry, &m_dictC, &idC ) );
+
+	CHECK_EQUAL( dzcobs_registry_id( &m_dictA ), idA );
+
+	POINTERS_EQUAL( &m_dictA, dzcobs_registry_find( &m_registry, idA ) );
+	POINTERS_EQUAL( &m_dictB, dzcobs_registry_find( &m_registry, idB ) );
+	POINTERS_EQUAL( &m_dictC, dzcobs_registry_find( &m_registry, idC ) );
+
+	POINTERS_EQUAL( NULL, dzcobs_registry_find( &m_registry, 0 ) );
+	POINTERS_EQUAL( NULL, dzcobs_registry_find( &m_registry, idA ^ idB ^ idC ) );
+
+	// Adding again keeps the first one
+	sDICT_ctx dictCopy = m_dictA;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &m_registry, &dictCopy, NULL ) );
+	POINTERS_EQUAL( &m_dictA, dzcobs_registry_find( &m_registry, idA ) );
+
+	// Fill it
+	static const char dictionaryD[] = DICT_ADD_WORD( 2, "ok" );
+	static const char dictionaryE[] = DICT_ADD_WORD( 2, "no" );
+	sDICT_ctx dictD;
+	sDICT_ctx dictE;
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictD, dictionaryD, sizeof( dictionaryD ) ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dictE, dictionaryE, sizeof( dictionaryE ) ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &m_registry, &dictD, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_registry_add( &m_registry, &dictE, NULL ) );
+
+	// A full registry still finds all, and ends a search of a missing id
+	POINTERS_EQUAL( &m_dictA, dzcobs_registry_find( &m_registry, idA ) );
+	POINTERS_EQUAL( &m_dictB, dzcobs_registry_find( &m_registry, idB ) );
+	POINTERS_EQUAL( &m_dictC, dzcobs_registry_find( &m_registry, idC ) );
+	POINTERS_EQUAL( &dictD, dzcobs_registry_find( &m_registry, dzcobs_registry_id( &dictD ) ) );
+	POINTERS_EQUAL( NULL, dzcobs_registry_find( &m_registry, dzcobs_registry_id( &dictE ) ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_REGISTRY, Negotiate )
+// NOLINTEND
+{
+	// The server knows all the dictionaries, the device only B and C
+	sDZCOBS_registry_entry deviceEntries[2];
+	sDZCOBS_registry deviceRegistry;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_init( &deviceRegistry, deviceEntries, 2 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &deviceRegistry, &m_dictB, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &deviceRegistry, &m_dictC, NULL ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &m_registry, &m_dictA, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &m_registry, &m_dictB, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &m_registry, &m_dictC, NULL ) );
+
+	// The device offers C, B and an unknown id, the server knows C and B
+	const uint32_t offerIds[] = { dzcobs_registry_id( &m_dictC ), 0x12345678, dzcobs_registry_id( &m_dictB ) };
+
+	uint8_t offer[DZCOBS_NEGOTIATE_OFFER_SIZE( DZCOBS_NEGOTIATE_MAX_IDS )];
+	size_t offerLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_negotiate_offer( offerIds, 3, offer, sizeof( offer ), &offerLen ) );
+	CHECK_EQUAL( DZCOBS_NEGOTIATE_OFFER_SIZE( 3 ), offerLen );
+
+	sDZCOBS_connection serverConn;
+	uint8_t accept[DZCOBS_NEGOTIATE_ACCEPT_SIZE];
+	size_t acceptLen = 0;
+	CHECK_EQUAL(
+		DZCOBS_RET_SUCCESS,
+		dzcobs_negotiate_accept( &m_registry, offer, offerLen, &serverConn, accept, sizeof( accept ), &acceptLen ) );
+	CHECK_EQUAL( DZCOBS_NEGOTIATE_ACCEPT_SIZE, acceptLen );
+
+	POINTERS_EQUAL( &m_dictC, serverConn.pDict[0] );
+	POINTERS_EQUAL( &m_dictB, serverConn.pDict[1] );
+	CHECK_EQUAL( offerIds[0], serverConn.dictId[0] );
+	CHECK_EQUAL( offerIds[2], serverConn.dictId[1] );
+
+	sDZCOBS_connection deviceConn;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_negotiate_complete( &deviceRegistry, accept, acceptLen, &deviceConn ) );
+	POINTERS_EQUAL( &m_dictC, deviceConn.pDict[0] );
+	POINTERS_EQUAL( &m_dictB, deviceConn.pDict[1] );
+
+	// Both ways, with both slots
+	check_connections( &deviceConn, &serverConn, DZCOBS_USING_DICT_1 );
+	check_connections( &deviceConn, &serverConn, DZCOBS_USING_DICT_2 );
+	check_connections( &serverConn, &deviceConn, DZCOBS_USING_DICT_1 );
+	check_connections( &serverConn, &deviceConn, DZCOBS_USING_DICT_2 );
+
+	// Only one common dictionary, DICT_2 is not bound
+	const uint32_t offerOneId[] = { dzcobs_registry_id( &m_dictB ), dzcobs_registry_id( &m_dictB ) };
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_negotiate_offer( offerOneId, 2, offer, sizeof( offer ), &offerLen ) );
+	CHECK_EQUAL(
+		DZCOBS_RET_SUCCESS,
+		dzcobs_negotiate_accept( &m_registry, offer, offerLen, &serverConn, accept, sizeof( accept ), &acceptLen ) );
+	POINTERS_EQUAL( &m_dictB, serverConn.pDict[0] );
+	POINTERS_EQUAL( NULL, serverConn.pDict[1] );
+	CHECK_EQUAL( 0, serverConn.dictId[1] );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_negotiate_complete( &deviceRegistry, accept, acceptLen, &deviceConn ) );
+	POINTERS_EQUAL( &m_dictB, deviceConn.pDict[0] );
+	POINTERS_EQUAL( NULL, deviceConn.pDict[1] );
+
+	check_connections( &serverConn, &deviceConn, DZCOBS_USING_DICT_1 );
+	check_connections( &serverConn, &deviceConn, DZCOBS_PLAIN );
+
+	// The server accepted a dictionary the device does not have
+	const uint32_t offerA[] = { dzcobs_registry_id( &m_dictA ) };
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_negotiate_offer( offerA, 1, offer, sizeof( offer ), &offerLen ) );
+	CHECK_EQUAL(
+		DZCOBS_RET_SUCCESS,
+		dzcobs_negotiate_accept( &m_registry, offer, offerLen, &serverConn, accept, sizeof( accept ), &acceptLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE,
+							 dzcobs_negotiate_complete( &deviceRegistry, accept, acceptLen, &deviceConn ) );
+
+	// The device connection was kept
+	POINTERS_EQUAL( &m_dictB, deviceConn.pDict[0] );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_REGISTRY, BadMessages )
+// NOLINTEND
+{
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_add( &m_registry, &m_dictA, NULL ) );
+
+	const uint32_t ids[] = { dzcobs_registry_id( &m_dictA ) };
+
+	uint8_t offer[DZCOBS_NEGOTIATE_OFFER_SIZE( 1 )];
+	uint8_t accept[DZCOBS_NEGOTIATE_ACCEPT_SIZE];
+	size_t offerLen	 = 0;
+	size_t acceptLen = 0;
+
+	sDZCOBS_connection conn;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_negotiate_offer( ids, 1, offer, sizeof( offer ), &offerLen ) );
+
+	// Truncated, wrong type and wrong count
+	CHECK_EQUAL(
+		DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+		dzcobs_negotiate_accept( &m_registry, offer, offerLen - 1, &conn, accept, sizeof( accept ), &acceptLen ) );
+
+	offer[0] = DZCOBS_NEGOTIATE_ACCEPT;
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+							 dzcobs_negotiate_accept( &m_registry, offer, offerLen, &conn, accept, sizeof( accept ), &acceptLen ) );
+	offer[0] = DZCOBS_NEGOTIATE_OFFER;
+
+	offer[1] = 2;
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+							 dzcobs_negotiate_accept( &m_registry, offer, offerLen, &conn, accept, sizeof( accept ), &acceptLen ) );
+	offer[1] = 0;
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+							 dzcobs_negotiate_accept( &m_registry, offer, offerLen, &conn, accept, sizeof( accept ), &acceptLen ) );
+	offer[1] = 1;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS,
+							 dzcobs_negotiate_accept( &m_registry, offer, offerLen, &conn, accept, sizeof( accept ), &acceptLen ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+							 dzcobs_negotiate_complete( &m_registry, accept, acceptLen - 1, &conn ) );
+	accept[0] = DZCOBS_NEGOTIATE_OFFER;
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, dzcobs_negotiate_complete( &m_registry, accept, acceptLen, &conn ) );
+	accept[0] = DZCOBS_NEGOTIATE_ACCEPT;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_negotiate_complete( &m_registry, accept, acceptLen, &conn ) );
+}
+
+#if defined( UTEST_HAS_THREADS ) && ( UTEST_HAS_THREADS == 1 )
+// NOLINTBEGIN
+TEST( DZCOBS_REGISTRY, Threads )
+// NOLINTEND
+{
+	char dictionaries[UTEST_REGISTRY_THREADS_N_DICTS][4];
+	sDICT_ctx dicts[UTEST_REGISTRY_THREADS_N_DICTS];
+	uint32_t ids[UTEST_REGISTRY_THREADS_N_DICTS];
+
+	// One 2 bytes word each, so all the ids are different
+	for( size_t i = 0; i < UTEST_REGISTRY_THREADS_N_DICTS; i++ )
+	{
+		dictionaries[i][0] = '2';
+		dictionaries[i][1] = (char)( 'a' + i );
+		dictionaries[i][2] = 'z';
+		dictionaries[i][3] = 0;
+
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &dicts[i], dictionaries[i], sizeof( dictionaries[i] ) ) );
+		ids[i] = dzcobs_registry_id( &dicts[i] );
+	}
+
+	for( size_t round = 0; round < UTEST_REGISTRY_THREADS_N_ROUNDS; round++ )
+	{
+		sDZCOBS_registry_entry entries[UTEST_REGISTRY_THREADS_N_ENTRIES];
+		sDZCOBS_registry registry;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_registry_init( &registry, entries, UTEST_REGISTRY_THREADS_N_ENTRIES ) );
+
+		// CppUTest checks are not thread safe, the threads count the errors
+		std::atomic< size_t > errors( 0 );
+		std::atomic< size_t > addersDone( 0 );
+		std::thread adders[UTEST_REGISTRY_THREADS_N_ADDERS];
+		std::thread finders[UTEST_REGISTRY_THREADS_N_FINDERS];
+
+		for( size_t t = 0; t < UTEST_REGISTRY_THREADS_N_FINDERS; t++ )
+		{
+			finders[t] = std::thread( [&, t]() {
+				bool isDone = false;
+
+				while( !isDone )
+				{
+					isDone = ( addersDone.load() == UTEST_REGISTRY_THREADS_N_ADDERS );
+
+					for( size_t i = 0; i < UTEST_REGISTRY_THREADS_N_DICTS; i++ )
+					{
+						const size_t k					= ( i + t ) % UTEST_REGISTRY_THREADS_N_DICTS;
+						const sDICT_ctx *pFound = dzcobs_registry_find( &registry, ids[k] );
+
+						// Not yet added, or the added one; once all are added, always found
+						if( ( ( pFound != NULL ) && ( pFound != &dicts[k] ) ) || ( isDone && ( pFound == NULL ) ) )
+						{
+							errors++;
+						}
+					}
+				}
+			} );
+		}
+
+		// Every adder adds all the dictionaries, each one from a different start
+		for( size_t t = 0; t < UTEST_REGISTRY_THREADS_N_ADDERS; t++ )
+		{
+			adders[t] = std::thread( [&, t]() {
+				for( size_t i = 0; i < UTEST_REGISTRY_THREADS_N_DICTS; i++ )
+				{
+					const size_t k = ( i + ( t * UTEST_REGISTRY_THREADS_N_DICTS ) / UTEST_REGISTRY_THREADS_N_ADDERS ) %
+													 UTEST_REGISTRY_THREADS_N_DICTS;
+					uint32_t id		 = 0;
+
+					if( ( dzcobs_registry_add( &registry, &dicts[k], &id ) != DZCOBS_RET_SUCCESS ) || ( id != ids[k] ) )
+					{
+						errors++;
+					}
+				}
+
+				addersDone++;
+			} );
+		}
+
+		for( size_t t = 0; t < UTEST_REGISTRY_THREADS_N_ADDERS; t++ )
+		{
+			adders[t].join();
+		}
+
+		for( size_t t = 0; t < UTEST_REGISTRY_THREADS_N_FINDERS; t++ )
+		{
+			finders[t].join();
+		}
+
+		CHECK_EQUAL( 0, errors.load() );
+
+		// Each dictionary was added once
+		size_t nUsed = 0;
+
+		for( size_t i = 0; i < UTEST_REGISTRY_THREADS_N_ENTRIES; i++ )
+		{
+			nUsed += ( entries[i].id.load() != 0 ) ? 1 : 0;
+		}
+
+		CHECK_EQUAL( UTEST_REGISTRY_THREADS_N_DICTS, nUsed );
+	}
+}
+#endif
+
+// NOLINTBEGIN
+TEST( DZCOBS_REGISTRY, BadArgs )
+// NOLINTEND
+{
+	sDZCOBS_registry_entry entries[3];
+	sDZCOBS_registry registry;
+	sDZCOBS_connection conn;
+	sDZCOBS_ctx ctx;
+	sDZCOBS_decodectx decodeCtx;
+
+	const uint32_t ids[] = { 1, 0 };
+	uint8_t msg[DZCOBS_NEGOTIATE_OFFER_SIZE( DZCOBS_NEGOTIATE_MAX_IDS + 1 )];
+	size_t msgLen = 0;
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_registry_init( NULL, entries, 2 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_registry_init( &registry, NULL, 2 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_registry_init( &registry, entries, 0 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_registry_init( &registry, entries, 3 ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_registry_add( NULL, &m_dictA, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_registry_add( &m_registry, NULL, NULL ) );
+	POINTERS_EQUAL( NULL, dzcobs_registry_find( NULL, 1 ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_negotiate_offer( NULL, 1, msg, sizeof( msg ), &msgLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_negotiate_offer( ids, 0, msg, sizeof( msg ), &msgLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_negotiate_offer( ids, DZCOBS_NEGOTIATE_MAX_IDS + 1, msg, sizeof( msg ), &msgLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_negotiate_offer( ids, 1, NULL, sizeof( msg ), &msgLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_negotiate_offer( ids, 1, msg, DZCOBS_NEGOTIATE_OFFER_SIZE( 1 ) - 1, &msgLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_negotiate_offer( ids, 1, msg, sizeof( msg ), NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_negotiate_offer( ids, 2, msg, sizeof( msg ), &msgLen ) ); // Id 0
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_negotiate_offer( ids, 1, msg, sizeof( msg ), &msgLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_negotiate_accept( NULL, msg, msgLen, &conn, msg, sizeof( msg ), &msgLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_negotiate_accept( &m_registry, NULL, msgLen, &conn, msg, sizeof( msg ), &msgLen ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG,
+							 dzcobs_negotiate_accept( &m_registry, msg, msgLen, NULL, msg, sizeof( msg ), &msgLen ) );
+	CHECK_EQUAL(
+		DZCOBS_RET_ERR_BAD_ARG,
+		dzcobs_negotiate_accept( &m_registry, msg, msgLen, &conn, msg, DZCOBS_NEGOTIATE_ACCEPT_SIZE - 1, &msgLen ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_negotiate_complete( NULL, msg, msgLen, &conn ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_negotiate_complete( &m_registry, NULL, msgLen, &conn ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_negotiate_complete( &m_registry, msg, msgLen, NULL ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_connection_set_encoder( NULL, &ctx ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_connection_set_encoder( &conn, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_connection_set_decoder( NULL, &decodeCtx ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_connection_set_decoder( &conn, NULL ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
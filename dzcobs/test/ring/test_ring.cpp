@@ -0,0 +1,339 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_ring.cpp
+///	@brief Tests the decoding to a sink and to a ring buffer
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_ring.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_RING_MAX_SIZE ( 1200 )
+
+// clang-format off
+// NOLINTBEGIN
+static const char s_TEST_Dictionary[] =
+	DICT_ADD_WORD(2, "\x01\x01")
+	DICT_ADD_WORD(3, "\x02\x00\x02")
+	DICT_ADD_WORD(5, "\x04\x00\x00\x00\x04")
+;
+// NOLINTEND
+// clang-format on
+
+/// Data given to utest_sink
+typedef struct s_UTEST_sink
+{
+	uint8_t buf[UTEST_RING_MAX_SIZE];
+	size_t len;
+	size_t nCalls[3];	 ///< Calls by run kind
+	size_t failAtCall; ///< Call that fails, 0 to never fail
+} sUTEST_sink;
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_RING ){
+	void setup()
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &m_dict, s_TEST_Dictionary, sizeof( s_TEST_Dictionary ) ) );
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx m_dict;
+};
+// NOLINTEND
+// clang-format on
+
+static eDZCOBS_ret utest_sink( void *aArg, eDZCOBS_run aRun, const uint8_t *aData, size_t aSize )
+{
+	sUTEST_sink *pSink = (sUTEST_sink *)aArg;
+
+	CHECK( aSize > 0 );
+	CHECK( ( pSink->len + aSize ) <= sizeof( pSink->buf ) );
+
+	if( aRun == DZCOBS_RUN_ZERO )
+	{
+		CHECK_EQUAL( 1, aSize );
+		CHECK_EQUAL( 0, aData[0] );
+	}
+
+	pSink->nCalls[aRun]++;
+
+	if( ( pSink->nCalls[0] + pSink->nCalls[1] + pSink->nCalls[2] ) == pSink->failAtCall )
+	{
+		return DZCOBS_RET_ERR_WRITE_OVERFLOW;
+	}
+
+	memcpy( &pSink->buf[pSink->len], aData, aSize );
+	pSink->len += aSize;
+
+	return DZCOBS_RET_SUCCESS;
+}
+
+/// Encodes aData, optionally filtered, returns the encoded length
+static size_t ring_encode( const sDICT_ctx *aDict,
+													 eDZCOBS_encoding aEncoding,
+													 bool aIsFiltered,
+													 const uint8_t *aData,
+													 size_t aDataSize,
+													 uint8_t *aEncoded )
+{
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, aDict, DZCOBS_USING_DICT_1 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, aEncoding, aEncoded, UTEST_RING_MAX_SIZE ) );
+	ctx.user6bits = 0x2A;
+
+	if( aIsFiltered )
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA_SHUFFLE, 2 ) );
+	}
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, aData, aDataSize ) );
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	return encodedLen;
+}
+
+static void ring_fill( uint8_t *aData, size_t aSize, int aPattern )
+{
+	// Zeros, long runs and dictionary words on varying proportions
+	const int zeroOneIn = 1 + ( ( aPattern % 5 ) * ( aPattern % 5 ) * 30 );
+	const int wordOneIn = 1 + ( aPattern / 5 );
+
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		aData[i] = ( ( rand() % zeroOneIn ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+
+		if( ( rand() % wordOneIn ) == 0 )
+		{
+			aData[i] = (uint8_t)( ( rand() % 5 ) );
+		}
+	}
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_RING, Sink )
+// NOLINTEND
+{
+	static uint8_t data[UTEST_RING_MAX_SIZE];
+	static uint8_t encoded[UTEST_RING_MAX_SIZE];
+	static sUTEST_sink sink;
+
+	srand( 5 );
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 };
+
+	for( int pattern = 0; pattern < 40; pattern++ )
+	{
+		const size_t size = (size_t)rand() % 1000;
+
+		ring_fill( data, size, pattern );
+
+		for( const eDZCOBS_encoding encoding : encodings )
+		{
+			for( int isFiltered = 0; isFiltered < 2; isFiltered++ )
+			{
+				const size_t encodedLen = ring_encode( &m_dict, encoding, isFiltered != 0, data, size, encoded );
+
+				sDZCOBS_decodectx decodeCtx;
+				memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+				decodeCtx.srcBufEncoded		 = encoded;
+				decodeCtx.srcBufEncodedLen = encodedLen;
+				decodeCtx.pDict[0]				 = &m_dict;
+
+				memset( &sink, 0, sizeof( sink ) );
+
+				size_t decodedLen = 0;
+				uint8_t user6bits = 0;
+
+				CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode_sink( &decodeCtx, utest_sink, &sink, &decodedLen, &user6bits ) );
+				CHECK_EQUAL( 0x2A, user6bits );
+				CHECK_EQUAL( size, decodedLen );
+				CHECK_EQUAL( size, sink.len );
+				MEMCMP_EQUAL( data, sink.buf, size );
+
+				if( isFiltered )
+				{
+					// By filter blocks
+					CHECK_EQUAL( ( size + DZCOBS_FILTER_BLOCK_SIZE - 1 ) / DZCOBS_FILTER_BLOCK_SIZE,
+											 sink.nCalls[DZCOBS_RUN_LITERAL] );
+					CHECK_EQUAL( 0, sink.nCalls[DZCOBS_RUN_ZERO] + sink.nCalls[DZCOBS_RUN_WORD] );
+				}
+				else if( encoding == DZCOBS_PLAIN )
+				{
+					CHECK_EQUAL( 0, sink.nCalls[DZCOBS_RUN_WORD] );
+				}
+			}
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_RING, SinkRuns )
+// NOLINTEND
+{
+	static uint8_t encoded[UTEST_RING_MAX_SIZE];
+	static sUTEST_sink sink;
+
+	const uint8_t data[] = { 0x11, 0x22, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x33 };
+
+	const size_t encodedLen = ring_encode( &m_dict, DZCOBS_USING_DICT_1, false, data, sizeof( data ), encoded );
+
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	decodeCtx.srcBufEncoded		 = encoded;
+	decodeCtx.srcBufEncodedLen = encodedLen;
+	decodeCtx.pDict[0]				 = &m_dict;
+
+	size_t decodedLen = 0;
+	uint8_t user6bits = 0;
+
+	memset( &sink, 0, sizeof( sink ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode_sink( &decodeCtx, utest_sink, &sink, &decodedLen, &user6bits ) );
+	MEMCMP_EQUAL( data, sink.buf, sizeof( data ) );
+	CHECK_EQUAL( 2, sink.nCalls[DZCOBS_RUN_LITERAL] );
+	CHECK_EQUAL( 2, sink.nCalls[DZCOBS_RUN_ZERO] );
+	CHECK_EQUAL( 1, sink.nCalls[DZCOBS_RUN_WORD] );
+
+	// The sink stops the decoding
+	memset( &sink, 0, sizeof( sink ) );
+	sink.failAtCall = 2;
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW,
+							 dzcobs_decode_sink( &decodeCtx, utest_sink, &sink, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( 2, sink.len );
+
+	// Nothing is given from a corrupted frame
+	memset( &sink, 0, sizeof( sink ) );
+	encoded[1]++;
+	CHECK_EQUAL( DZCOBS_RET_ERR_CRC, dzcobs_decode_sink( &decodeCtx, utest_sink, &sink, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( 0, sink.len );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_sink( NULL, utest_sink, &sink, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_sink( &decodeCtx, NULL, &sink, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_sink( &decodeCtx, utest_sink, &sink, NULL, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_sink( &decodeCtx, utest_sink, &sink, &decodedLen, NULL ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_RING, Ring )
+// NOLINTEND
+{
+	static uint8_t data[UTEST_RING_MAX_SIZE];
+	static uint8_t encoded[UTEST_RING_MAX_SIZE];
+	static uint8_t stream[UTEST_RING_MAX_SIZE * 10];
+	static uint8_t consumed[UTEST_RING_MAX_SIZE * 10];
+
+	uint8_t storage[300];
+	sDZCOBS_ring ring;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_ring_init( &ring, storage, sizeof( storage ) ) );
+
+	srand( 7 );
+
+	// A stream of frames through a ring smaller than some of them put together
+	size_t streamLen		= 0;
+	size_t consumedLen	= 0;
+	size_t nOverflows		= 0;
+
+	const uint8_t *pData = NULL;
+
+	for( int pattern = 0; pattern < 60; pattern++ )
+	{
+		const size_t size = (size_t)rand() % 200;
+
+		const eDZCOBS_encoding encoding = ( ( pattern & 1 ) != 0 ) ? DZCOBS_USING_DICT_1 : DZCOBS_PLAIN;
+
+		ring_fill( data, size, pattern % 40 );
+
+		const size_t encodedLen = ring_encode( &m_dict, encoding, false, data, size, encoded );
+
+		sDZCOBS_decodectx decodeCtx;
+		memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+		decodeCtx.srcBufEncoded		 = encoded;
+		decodeCtx.srcBufEncodedLen = encodedLen;
+		decodeCtx.pDict[0]				 = &m_dict;
+
+		size_t decodedLen = 0;
+		uint8_t user6bits = 0;
+
+		const size_t usedBefore = dzcobs_ring_used( &ring );
+
+		if( size > dzcobs_ring_free( &ring ) )
+		{
+			// Nothing is written
+			CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_decode_ring( &decodeCtx, &ring, &decodedLen, &user6bits ) );
+			CHECK_EQUAL( usedBefore, dzcobs_ring_used( &ring ) );
+			nOverflows++;
+
+			// Consume all, by the contiguous parts
+			while( dzcobs_ring_used( &ring ) > 0 )
+			{
+				const size_t peekSize = dzcobs_ring_peek( &ring, &pData );
+
+				CHECK( peekSize > 0 );
+				memcpy( &consumed[consumedLen], pData, peekSize );
+				consumedLen += peekSize;
+
+				CHECK_EQUAL( peekSize, dzcobs_ring_read( &ring, NULL, peekSize ) );
+			}
+		}
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode_ring( &decodeCtx, &ring, &decodedLen, &user6bits ) );
+		CHECK_EQUAL( size, decodedLen );
+		CHECK_EQUAL( 0x2A, user6bits );
+
+		memcpy( &stream[streamLen], data, size );
+		streamLen += size;
+
+		// Consume a part
+		consumedLen += dzcobs_ring_read( &ring, &consumed[consumedLen], (size_t)rand() % 150 );
+	}
+
+	consumedLen += dzcobs_ring_read( &ring, &consumed[consumedLen], sizeof( consumed ) - consumedLen );
+
+	CHECK( nOverflows > 0 );
+	CHECK_EQUAL( streamLen, consumedLen );
+	MEMCMP_EQUAL( stream, consumed, streamLen );
+	CHECK_EQUAL( 0, dzcobs_ring_used( &ring ) );
+	CHECK_EQUAL( sizeof( storage ), dzcobs_ring_free( &ring ) );
+	CHECK_EQUAL( 0, dzcobs_ring_peek( &ring, &pData ) );
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_ring_init( NULL, storage, sizeof( storage ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_ring_init( &ring, NULL, sizeof( storage ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_ring_init( &ring, storage, 0 ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,213 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_stats.cpp
+///	@brief Tests the dictionary words use instrumentation
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_stats.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+static const char s_TEST_Dictionary[] =
+	DICT_ADD_WORD(2, "ok")
+	DICT_ADD_WORD(3, "the")
+	DICT_ADD_WORD(4, "temp")
+	DICT_ADD_WORD(5, "error")
+;
+// NOLINTEND
+// clang-format on
+
+/// Words reported by dzcobs_stats_dump
+typedef struct s_UTEST_dump
+{
+	size_t nWords;
+	uint32_t hits[DZCOBS_STATS_MAX_WORDS];
+	uint32_t bytesSaved[DZCOBS_STATS_MAX_WORDS];
+	uint8_t wordSize[DZCOBS_STATS_MAX_WORDS];
+} sUTEST_dump;
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_STATS ){
+	void setup()
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &m_dict, s_TEST_Dictionary, sizeof( s_TEST_Dictionary ) ) );
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx m_dict;
+};
+// NOLINTEND
+// clang-format on
+
+static void utest_dump_word( void *aArg,
+														 uint8_t aIndex,
+														 const uint8_t *aWord,
+														 uint8_t aWordSize,
+														 uint32_t aHits,
+														 uint32_t aBytesSaved )
+{
+	sUTEST_dump *pDump = (sUTEST_dump *)aArg;
+
+	CHECK_EQUAL( pDump->nWords, aIndex );
+	CHECK( aWord != NULL );
+
+	pDump->hits[aIndex]				= aHits;
+	pDump->bytesSaved[aIndex] = aBytesSaved;
+	pDump->wordSize[aIndex]		= aWordSize;
+	pDump->nWords++;
+}
+
+/// Encodes and decodes aData, the encoder and the decoder using their own dictionary
+static void encode_decode( const sDICT_ctx *aEncodeDict, const sDICT_ctx *aDecodeDict, const char *aData )
+{
+	const size_t dataSize = strlen( aData );
+
+	uint8_t encoded[64];
+	uint8_t decoded[64];
+	size_t encodedLen = 0;
+	size_t decodedLen = 0;
+	uint8_t user6bits = 0;
+
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, aEncodeDict, DZCOBS_USING_DICT_1 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, DZCOBS_USING_DICT_1, encoded, sizeof( encoded ) ) );
+	ctx.user6bits = 1;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, (const uint8_t *)aData, dataSize ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	sDZCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= encoded;
+	decodeCtx.srcBufEncodedLen	= encodedLen;
+	decodeCtx.dstBufDecoded			= decoded;
+	decodeCtx.dstBufDecodedSize = sizeof( decoded );
+	decodeCtx.pDict[0]					= aDecodeDict;
+	decodeCtx.pDict[1]					= NULL;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( dataSize, decodedLen );
+	MEMCMP_EQUAL( aData, decoded, dataSize );
+}
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_STATS, EncodeDecode )
+// NOLINTEND
+{
+	// Separate stats for the encoder and for the decoder
+	sDICT_ctx decodeDict = m_dict;
+	sDZCOBS_stats encodeStats;
+	sDZCOBS_stats decodeStats;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_stats_attach( &m_dict, &encodeStats ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_stats_attach( &decodeDict, &decodeStats ) );
+	POINTERS_EQUAL( &encodeStats, m_dict.pStats );
+
+	encode_decode( &m_dict, &decodeDict, "the temp is ok" );
+	encode_decode( &m_dict, &decodeDict, "error: the temp" );
+
+#if DZCOBS_STATS == 1
+	const uint32_t expectedHits[4] = { 1, 2, 2, 1 };
+
+	for( size_t i = 0; i < 4; i++ )
+	{
+		CHECK_EQUAL( expectedHits[i], encodeStats.hits[i] );
+		CHECK_EQUAL( expectedHits[i] * ( i + 1 ), encodeStats.bytesSaved[i] );
+		CHECK_EQUAL( expectedHits[i], decodeStats.hits[i] );
+		CHECK_EQUAL( expectedHits[i] * ( i + 1 ), decodeStats.bytesSaved[i] );
+	}
+
+	// Each search that found a word skips its bytes: 29 bytes, 6 words of 21 bytes
+	CHECK_EQUAL( 29 - 21 + 6, encodeStats.searches );
+	CHECK_EQUAL( 29 - 21, encodeStats.misses );
+	CHECK_EQUAL( 0, decodeStats.searches );
+#else
+	CHECK_EQUAL( 0, encodeStats.searches );
+	CHECK_EQUAL( 0, decodeStats.hits[0] );
+#endif
+
+	// Detached, nothing else is counted
+	sDZCOBS_stats before = encodeStats;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_stats_attach( &m_dict, NULL ) );
+	encode_decode( &m_dict, &decodeDict, "the" );
+	MEMCMP_EQUAL( &before, &encodeStats, sizeof( before ) );
+
+	dzcobs_stats_reset( &decodeStats );
+	CHECK_EQUAL( 0, decodeStats.hits[1] );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_STATS, Dump )
+// NOLINTEND
+{
+	sDZCOBS_stats stats;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_stats_attach( &m_dict, &stats ) );
+
+	encode_decode( &m_dict, &m_dict, "temp error" );
+
+	sUTEST_dump dump;
+	memset( &dump, 0, sizeof( dump ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_stats_dump( &stats, &m_dict, utest_dump_word, &dump ) );
+	CHECK_EQUAL( 4, dump.nWords );
+	CHECK_EQUAL( 2, dump.wordSize[0] );
+	CHECK_EQUAL( 5, dump.wordSize[3] );
+
+#if DZCOBS_STATS == 1
+	// Encoded and decoded with the same dictionary, so each use is counted twice
+	CHECK_EQUAL( 0, dump.hits[0] );
+	CHECK_EQUAL( 0, dump.hits[1] );
+	CHECK_EQUAL( 2, dump.hits[2] );
+	CHECK_EQUAL( 2, dump.hits[3] );
+	CHECK_EQUAL( 2 * 4, dump.bytesSaved[3] );
+#else
+	CHECK_EQUAL( 0, dump.hits[2] );
+#endif
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_STATS, BadArgs )
+// NOLINTEND
+{
+	sDZCOBS_stats stats;
+	sUTEST_dump dump;
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_stats_attach( NULL, &stats ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_stats_dump( NULL, &m_dict, utest_dump_word, &dump ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_stats_dump( &stats, NULL, utest_dump_word, &dump ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_stats_dump( &stats, &m_dict, NULL, &dump ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,438 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_tail.cpp
+///	@brief Tests for the tail-coded streaming encoder
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_ring.h>
+#include <dzcobs/dzcobs_tail.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_TAIL_MAX_SIZE ( 1500 )
+#define UTEST_TAIL_ENCODED_SIZE ( ( UTEST_TAIL_MAX_SIZE * 2 ) + 64 )
+
+typedef struct s_UTEST_tailsink
+{
+	uint8_t buf[UTEST_TAIL_ENCODED_SIZE];
+	size_t len;
+	bool hasZero;
+} sUTEST_tailsink;
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+/// Dictionary string, descendent order, null terminated
+static const char s_TEST_TailDictionary[] =
+	DICT_ADD_WORD(2, "\x00\x00")
+	DICT_ADD_WORD(2, "\x01\x01")
+	DICT_ADD_WORD(3, "\x02\x00\x02")
+	DICT_ADD_WORD(4, "\x03\x00\x00\x03")
+;
+
+TEST_GROUP( DZCOBS_TAIL ){
+	void setup()
+	{
+		const eDICT_ret ret = dzcobs_dictionary_init( &dictCtx, s_TEST_TailDictionary, sizeof( s_TEST_TailDictionary ) );
+		CHECK_EQUAL( DICT_RET_SUCCESS, ret );
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx dictCtx;
+};
+// NOLINTEND
+// clang-format on
+
+static void tail_put( void *aUser, uint8_t aByte )
+{
+	sUTEST_tailsink *pSink = (sUTEST_tailsink *)aUser;
+
+	if( aByte == 0 )
+	{
+		pSink->hasZero = true;
+	}
+
+	if( pSink->len < sizeof( pSink->buf ) )
+	{
+		pSink->buf[pSink->len++] = aByte;
+	}
+}
+
+static void tail_encode( eDZCOBS_encoding aEncoding,
+												 const sDICT_ctx *aDict,
+												 eDZCOBS_check aCheck,
+												 const uint8_t *aData,
+												 size_t aDataSize,
+												 size_t aChunkSize,
+												 sUTEST_tailsink *aSink )
+{
+	memset( aSink, 0, sizeof( *aSink ) );
+
+	sDZCOBS_tailctx ctx;
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_tail_encode_begin( &ctx, aEncoding, aDict, 0x2A, tail_put, aSink ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_tail_encode_set_check( &ctx, aCheck ) );
+
+	for( size_t i = 0; i < aDataSize; i += aChunkSize )
+	{
+		const size_t chunk = ( ( aDataSize - i ) < aChunkSize ) ? ( aDataSize - i ) : aChunkSize;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_tail_encode( &ctx, aData + i, chunk ) );
+	}
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_tail_encode_end( &ctx ) );
+	CHECK_FALSE( aSink->hasZero );
+}
+
+static eDZCOBS_ret tail_decode( const sDICT_ctx *aDict,
+																const uint8_t *aEncoded,
+																size_t aEncodedLen,
+																uint8_t *aDecoded,
+																size_t *aOutDecodedLen )
+{
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	decodeCtx.srcBufEncoded			= aEncoded;
+	decodeCtx.srcBufEncodedLen	= aEncodedLen;
+	decodeCtx.dstBufDecoded			= aDecoded;
+	decodeCtx.dstBufDecodedSize = UTEST_TAIL_MAX_SIZE;
+	decodeCtx.pDict[0]					= aDict;
+
+	uint8_t user6bits = 0;
+
+	const eDZCOBS_ret ret = dzcobs_decode( &decodeCtx, aOutDecodedLen, &user6bits );
+
+	if( ret == DZCOBS_RET_SUCCESS )
+	{
+		CHECK_EQUAL( 0x2A, user6bits );
+
+		size_t decodedSize = 0;
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decoded_size( &decodeCtx, &decodedSize ) );
+		CHECK_EQUAL( *aOutDecodedLen, decodedSize );
+	}
+
+	return ret;
+}
+
+static void fill_random( uint8_t *aBuf, size_t aSize, int aZeroOneIn )
+{
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		aBuf[i] = ( ( rand() % aZeroOneIn ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+	}
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_TAIL, PlainRoundTrip )
+// NOLINTEND
+{
+	static uint8_t data[UTEST_TAIL_MAX_SIZE];
+	static uint8_t decoded[UTEST_TAIL_MAX_SIZE];
+	static sUTEST_tailsink sink;
+
+	const int zeroRates[] = { 2, 8, 300, 100000 };
+
+	for( const int zeroRate : zeroRates )
+	{
+		for( size_t dataSize = 0; dataSize < UTEST_TAIL_MAX_SIZE; dataSize += ( dataSize < 600 ) ? 1 : 97 )
+		{
+			fill_random( data, dataSize, zeroRate );
+
+			tail_encode( DZCOBS_PLAIN, NULL, DZCOBS_CHECK_HASH8, data, dataSize, UTEST_TAIL_MAX_SIZE, &sink );
+
+			// One byte for the extension, and one more if the frame ends on a full run
+			CHECK( sink.len <= ( DZCOBS_MAX_ENCODED_SIZE( dataSize ) + DZCOBS_FRAME_HEADER_SIZE + 2 ) );
+
+			size_t decodedLen = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, tail_decode( NULL, sink.buf, sink.len, decoded, &decodedLen ) );
+			CHECK_EQUAL( dataSize, decodedLen );
+			MEMCMP_EQUAL( data, decoded, dataSize );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_TAIL, FullRuns )
+// NOLINTEND
+{
+	static uint8_t data[UTEST_TAIL_MAX_SIZE];
+	static uint8_t decoded[UTEST_TAIL_MAX_SIZE];
+	static sUTEST_tailsink sink;
+
+	const size_t sizes[] = { 125, 126, 127, 253, 254, 255, 508, 509 };
+
+	for( const size_t dataSize : sizes )
+	{
+		memset( data, 0xA5, dataSize );
+
+		for( int isWithZero = 0; isWithZero < 2; isWithZero++ )
+		{
+			if( isWithZero )
+			{
+				data[dataSize - 1] = 0;
+			}
+
+			tail_encode( DZCOBS_PLAIN, NULL, DZCOBS_CHECK_HASH8, data, dataSize, UTEST_TAIL_MAX_SIZE, &sink );
+
+			size_t decodedLen = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, tail_decode( NULL, sink.buf, sink.len, decoded, &decodedLen ) );
+			CHECK_EQUAL( dataSize, decodedLen );
+			MEMCMP_EQUAL( data, decoded, dataSize );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_TAIL, WireFormat )
+// NOLINTEND
+{
+	static sUTEST_tailsink sink;
+
+	const uint8_t data[] = { 0x11, 0x22, 0x00, 0x33 };
+
+	tail_encode( DZCOBS_PLAIN, NULL, DZCOBS_CHECK_HASH8, data, sizeof( data ), sizeof( data ), &sink );
+
+	// Runs followed by their codes, then extension, encoding and hash
+	CHECK_EQUAL( 8, sink.len );
+	CHECK_EQUAL( 0x11, sink.buf[0] );
+	CHECK_EQUAL( 0x22, sink.buf[1] );
+	CHECK_EQUAL( 0x03, sink.buf[2] );
+	CHECK_EQUAL( 0x33, sink.buf[3] );
+	CHECK_EQUAL( 0x02, sink.buf[4] );
+	CHECK_EQUAL( DZCOBS_EXT_MARKER | DZCOBS_EXT_TAIL_CODED | DZCOBS_PLAIN, sink.buf[5] );
+	CHECK_EQUAL( ( 0x2A << 2 ) | DZCOBS_RESERVED, sink.buf[6] );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_TAIL, ChunkedPlainIsEqual )
+// NOLINTEND
+{
+	static uint8_t data[UTEST_TAIL_MAX_SIZE];
+	static sUTEST_tailsink whole;
+	static sUTEST_tailsink chunked;
+
+	const size_t chunkSizes[] = { 1, 3, 254, 255 };
+
+	fill_random( data, sizeof( data ), 16 );
+
+	tail_encode( DZCOBS_PLAIN, NULL, DZCOBS_CHECK_CRC32C, data, sizeof( data ), sizeof( data ), &whole );
+
+	for( const size_t chunkSize : chunkSizes )
+	{
+		tail_encode( DZCOBS_PLAIN, NULL, DZCOBS_CHECK_CRC32C, data, sizeof( data ), chunkSize, &chunked );
+
+		CHECK_EQUAL( whole.len, chunked.len );
+		MEMCMP_EQUAL( whole.buf, chunked.buf, whole.len );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_TAIL, DictionaryRoundTrip )
+// NOLINTEND
+{
+	static uint8_t data[UTEST_TAIL_MAX_SIZE];
+	static uint8_t decoded[UTEST_TAIL_MAX_SIZE];
+	static sUTEST_tailsink sink;
+
+	const size_t chunkSizes[] = { 1, 5, UTEST_TAIL_MAX_SIZE };
+
+	for( const size_t chunkSize : chunkSizes )
+	{
+		for( size_t dataSize = 0; dataSize < 400; dataSize++ )
+		{
+			// Small values, so the dictionary words are frequent
+			for( size_t i = 0; i < dataSize; i++ )
+			{
+				data[i] = ( ( rand() % 4 ) == 0 ) ? (uint8_t)( rand() % 256 ) : (uint8_t)( rand() % 4 );
+			}
+
+			tail_encode( DZCOBS_USING_DICT_1, &dictCtx, DZCOBS_CHECK_HASH8, data, dataSize, chunkSize, &sink );
+
+			size_t decodedLen = 0;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, tail_decode( &dictCtx, sink.buf, sink.len, decoded, &decodedLen ) );
+			CHECK_EQUAL( dataSize, decodedLen );
+			MEMCMP_EQUAL( data, decoded, dataSize );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_TAIL, DictionaryZeroBeforeWord )
+// NOLINTEND
+{
+	static uint8_t decoded[UTEST_TAIL_MAX_SIZE];
+	static sUTEST_tailsink sink;
+
+	// Run closed by a 0x00 and then a word, and a run closed by a word
+	const uint8_t data[] = { 'a', 'b', 0x00, 0x01, 0x01, 'c', 0x01, 0x01, 0x00 };
+
+	tail_encode( DZCOBS_USING_DICT_1, &dictCtx, DZCOBS_CHECK_HASH8, data, sizeof( data ), sizeof( data ), &sink );
+
+	// a b 3 | 1 | word | c 2 | word | 1 (last run, after the 0x00)
+	const uint8_t expected[] = { 'a', 'b', 3, 1, 0x81, 'c', 2, 0x81, 1 };
+	MEMCMP_EQUAL( expected, sink.buf, sizeof( expected ) );
+
+	size_t decodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, tail_decode( &dictCtx, sink.buf, sink.len, decoded, &decodedLen ) );
+	CHECK_EQUAL( sizeof( data ), decodedLen );
+	MEMCMP_EQUAL( data, decoded, sizeof( data ) );
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_TAIL, Checks )
+// NOLINTEND
+{
+	static uint8_t data[300];
+	static uint8_t decoded[UTEST_TAIL_MAX_SIZE];
+	static sUTEST_tailsink sink;
+
+	const eDZCOBS_check checks[] = { DZCOBS_CHECK_CRC16, DZCOBS_CHECK_CRC32C };
+
+	for( const eDZCOBS_check check : checks )
+	{
+		fill_random( data, sizeof( data ), 8 );
+
+		tail_encode( DZCOBS_PLAIN, NULL, check, data, sizeof( data ), 7, &sink );
+
+		size_t decodedLen = 0;
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, tail_decode( NULL, sink.buf, sink.len, decoded, &decodedLen ) );
+		CHECK_EQUAL( sizeof( data ), decodedLen );
+		MEMCMP_EQUAL( data, decoded, sizeof( data ) );
+
+		// Swap two payload bytes, the 8 bit hash does not see it
+		const uint8_t tmp = sink.buf[10];
+		sink.buf[10]			= sink.buf[20];
+		sink.buf[20]			= tmp;
+
+		if( sink.buf[10] != sink.buf[20] )
+		{
+			CHECK_EQUAL( DZCOBS_RET_ERR_CRC, tail_decode( NULL, sink.buf, sink.len, decoded, &decodedLen ) );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_TAIL, BadArguments )
+// NOLINTEND
+{
+	static sUTEST_tailsink sink;
+	sDZCOBS_tailctx ctx;
+	const uint8_t data[2] = { 1, 0 };
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_tail_encode_begin( &ctx, DZCOBS_PLAIN, NULL, 1, NULL, &sink ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_tail_encode_begin( &ctx, DZCOBS_USING_DICT_1, NULL, 1, tail_put, &sink ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_tail_encode_begin( &ctx, DZCOBS_RESERVED, NULL, 1, tail_put, &sink ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_INVALID_USER6BITS,
+							 dzcobs_tail_encode_begin( &ctx, DZCOBS_PLAIN, NULL, 0, tail_put, &sink ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_INVALID_USER6BITS,
+							 dzcobs_tail_encode_begin( &ctx, DZCOBS_PLAIN, NULL, 0x40, tail_put, &sink ) );
+
+	memset( &sink, 0, sizeof( sink ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_tail_encode_begin( &ctx, DZCOBS_PLAIN, NULL, 1, tail_put, &sink ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_tail_encode_set_check( &ctx, (eDZCOBS_check)3 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_tail_encode( &ctx, data, sizeof( data ) ) );
+
+	// Bytes were already sent
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_tail_encode_set_check( &ctx, DZCOBS_CHECK_CRC16 ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_tail_encode_end( &ctx ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_tail_encode( &ctx, data, sizeof( data ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_NOTINITIALIZED, dzcobs_tail_encode_end( &ctx ) );
+}
+
+static void fix_hash8( uint8_t *aEncoded, size_t aEncodedLen )
+{
+	uint8_t hashsum = 0;
+
+	for( size_t i = 0; i < ( aEncodedLen - 1 ); i++ )
+	{
+		hashsum += DZCOBS_HASH8( aEncoded[i] );
+	}
+
+	aEncoded[aEncodedLen - 1] = ( hashsum == 0 ) ? DZCOBS_HASH_VALUE_WHEN_CRC_IS_ZERO : hashsum;
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_TAIL, BadPayload )
+// NOLINTEND
+{
+	static uint8_t decoded[UTEST_TAIL_MAX_SIZE];
+	static sUTEST_tailsink sink;
+
+	const uint8_t data[] = { 0x11, 0x22, 0x00, 0x33 };
+	size_t decodedLen		 = 0;
+
+	// Last code longer than the payload
+	tail_encode( DZCOBS_PLAIN, NULL, DZCOBS_CHECK_HASH8, data, sizeof( data ), sizeof( data ), &sink );
+	sink.buf[4] = 0x10;
+	fix_hash8( sink.buf, sink.len );
+	CHECK_EQUAL( DZCOBS_RET_ERR_READ_OVERFLOW, tail_decode( NULL, sink.buf, sink.len, decoded, &decodedLen ) );
+
+	// Run with a 0x00
+	tail_encode( DZCOBS_PLAIN, NULL, DZCOBS_CHECK_HASH8, data, sizeof( data ), sizeof( data ), &sink );
+	sink.buf[3] = 0x00;
+	fix_hash8( sink.buf, sink.len );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, tail_decode( NULL, sink.buf, sink.len, decoded, &decodedLen ) );
+
+	// Does not fit on the destiny buffer
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	tail_encode( DZCOBS_PLAIN, NULL, DZCOBS_CHECK_HASH8, data, sizeof( data ), sizeof( data ), &sink );
+	decodeCtx.srcBufEncoded			= sink.buf;
+	decodeCtx.srcBufEncodedLen	= sink.len;
+	decodeCtx.dstBufDecoded			= decoded;
+	decodeCtx.dstBufDecodedSize = sizeof( data ) - 1;
+
+	uint8_t user6bits = 0;
+	CHECK_EQUAL( DZCOBS_RET_ERR_WRITE_OVERFLOW, dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) );
+
+	// Decoded backwards, it can not be decoded in place
+	size_t headroom							= 0;
+	decodeCtx.dstBufDecoded			= sink.buf;
+	decodeCtx.dstBufDecodedSize = sizeof( sink.buf );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode( &decodeCtx, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_headroom( &decodeCtx, &headroom ) );
+
+	// Nor to a sink
+	sDZCOBS_ring ring;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_ring_init( &ring, decoded, sizeof( decoded ) ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_ring( &decodeCtx, &ring, &decodedLen, &user6bits ) );
+	CHECK_EQUAL( 0, dzcobs_ring_used( &ring ) );
+
+	// Nor step-wise, once hashed
+	sDZCOBS_decodestep step;
+	decodeCtx.dstBufDecoded = decoded;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_decode_step_begin( &step, &decodeCtx, 64 ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_step( &step, &decodedLen, &user6bits ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,296 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_view.cpp
+///	@brief Tests the decoded data views
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_view.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_VIEW_MAX_SIZE ( 1200 )
+
+// clang-format off
+// NOLINTBEGIN
+static const char s_TEST_Dictionary[] =
+	DICT_ADD_WORD(2, "\x01\x01")
+	DICT_ADD_WORD(3, "\x02\x00\x02")
+	DICT_ADD_WORD(5, "\x04\x00\x00\x00\x04")
+;
+// NOLINTEND
+// clang-format on
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZCOBS_VIEW ){
+	void setup()
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS, dzcobs_dictionary_init( &m_dict, s_TEST_Dictionary, sizeof( s_TEST_Dictionary ) ) );
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx m_dict;
+};
+// NOLINTEND
+// clang-format on
+
+/// Encodes aData, optionally filtered, returns the encoded length
+static size_t view_encode( const sDICT_ctx *aDict,
+													 eDZCOBS_encoding aEncoding,
+													 bool aIsFiltered,
+													 const uint8_t *aData,
+													 size_t aDataSize,
+													 uint8_t *aEncoded )
+{
+	sDZCOBS_ctx ctx;
+	memset( &ctx, 0, sizeof( ctx ) );
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_dictionary( &ctx, aDict, DZCOBS_USING_DICT_1 ) );
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_begin( &ctx, aEncoding, aEncoded, UTEST_VIEW_MAX_SIZE ) );
+	ctx.user6bits = 0x15;
+
+	if( aIsFiltered )
+	{
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_set_filter( &ctx, DZCOBS_FILTER_DELTA, 1 ) );
+	}
+
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc( &ctx, aData, aDataSize ) );
+
+	size_t encodedLen = 0;
+	CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	return encodedLen;
+}
+
+static eDZCOBS_ret view_decode( const sDICT_ctx *aDict,
+																const uint8_t *aEncoded,
+																size_t aEncodedLen,
+																sDZCOBS_view *aOutView )
+{
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	decodeCtx.srcBufEncoded		 = aEncoded;
+	decodeCtx.srcBufEncodedLen = aEncodedLen;
+	decodeCtx.pDict[0]				 = aDict;
+
+	uint8_t user6bits = 0;
+
+	const eDZCOBS_ret ret = dzcobs_decode_view( &decodeCtx, aOutView, &user6bits );
+
+	if( ret == DZCOBS_RET_SUCCESS )
+	{
+		CHECK_EQUAL( 0x15, user6bits );
+	}
+
+	return ret;
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZCOBS_VIEW, RoundTrip )
+// NOLINTEND
+{
+	static uint8_t data[UTEST_VIEW_MAX_SIZE];
+	static uint8_t encoded[UTEST_VIEW_MAX_SIZE];
+	static uint8_t decoded[UTEST_VIEW_MAX_SIZE];
+
+	srand( 3 );
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 };
+
+	for( int pattern = 0; pattern < 40; pattern++ )
+	{
+		// Zeros, long runs and dictionary words on varying proportions
+		const int zeroOneIn = 1 + ( ( pattern % 5 ) * ( pattern % 5 ) * 30 );
+		const int wordOneIn = 1 + ( pattern / 5 );
+		const size_t size		= (size_t)rand() % 1000;
+
+		for( size_t i = 0; i < size; i++ )
+		{
+			data[i] = ( ( rand() % zeroOneIn ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+
+			if( ( rand() % wordOneIn ) == 0 )
+			{
+				data[i] = (uint8_t)( ( rand() % 5 ) );
+			}
+		}
+
+		for( const eDZCOBS_encoding encoding : encodings )
+		{
+			const size_t encodedLen = view_encode( &m_dict, encoding, false, data, size, encoded );
+
+			sDZCOBS_view view;
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, view_decode( &m_dict, encoded, encodedLen, &view ) );
+			CHECK_EQUAL( size, view.decodedLen );
+
+			// By segments
+			sDZCOBS_viewreader reader;
+			sDZCOBS_segment segment;
+			size_t decodedLen = 0;
+
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_view_reader_init( &reader, &view ) );
+
+			while( dzcobs_view_next_segment( &reader, &segment ) )
+			{
+				// Plain segments are on the frame itself
+				if( encoding == DZCOBS_PLAIN )
+				{
+					CHECK( ( segment.pData >= encoded ) && ( ( segment.pData + segment.size ) <= ( encoded + encodedLen ) ) );
+				}
+
+				memcpy( &decoded[decodedLen], segment.pData, segment.size );
+				decodedLen += segment.size;
+
+				if( segment.isZeroAfter )
+				{
+					decoded[decodedLen++] = 0;
+				}
+			}
+
+			CHECK_EQUAL( size, decodedLen );
+			MEMCMP_EQUAL( data, decoded, size );
+			CHECK_EQUAL( 0, dzcobs_view_remaining( &reader ) );
+
+			// By chunks, across the segments
+			CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_view_reader_init( &reader, &view ) );
+			memset( decoded, 0xEE, sizeof( decoded ) );
+
+			decodedLen = 0;
+
+			while( decodedLen < size )
+			{
+				size_t chunk = 1 + ( (size_t)rand() % 300 );
+				chunk				 = ( chunk < ( size - decodedLen ) ) ? chunk : ( size - decodedLen );
+
+				CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_view_read( &reader, &decoded[decodedLen], chunk ) );
+				decodedLen += chunk;
+				CHECK_EQUAL( size - decodedLen, dzcobs_view_remaining( &reader ) );
+			}
+
+			MEMCMP_EQUAL( data, decoded, size );
+			CHECK_EQUAL( DZCOBS_RET_ERR_READ_OVERFLOW, dzcobs_view_read( &reader, decoded, 1 ) );
+			CHECK_FALSE( dzcobs_view_next_segment( &reader, &segment ) );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_VIEW, Integers )
+// NOLINTEND
+{
+	static uint8_t encoded[UTEST_VIEW_MAX_SIZE];
+
+	// An integer on each side of a 0x00, one across a full plain run, and a word
+	uint8_t data[300];
+
+	for( size_t i = 0; i < sizeof( data ); i++ )
+	{
+		data[i] = (uint8_t)( 0x10 + ( i % 0x40 ) );
+	}
+
+	data[2]		= 0x00;
+	data[260] = 0x02;
+	data[261] = 0x00;
+	data[262] = 0x02;
+
+	const eDZCOBS_encoding encodings[] = { DZCOBS_PLAIN, DZCOBS_USING_DICT_1 };
+
+	for( const eDZCOBS_encoding encoding : encodings )
+	{
+		const size_t encodedLen = view_encode( &m_dict, encoding, false, data, sizeof( data ), encoded );
+
+		sDZCOBS_view view;
+		sDZCOBS_viewreader reader;
+		uint64_t value = 0;
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, view_decode( &m_dict, encoded, encodedLen, &view ) );
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_view_reader_init( &reader, &view ) );
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_view_read_le( &reader, 4, &value ) );
+		CHECK_EQUAL( 0x13001110ULL, value );
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_view_read( &reader, NULL, 250 ) );
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_view_read_be( &reader, 8, &value ) );
+		CHECK_EQUAL( 0x4E4F101112130200ULL, value );
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_view_read_be( &reader, 4, &value ) );
+		CHECK_EQUAL( 0x02171819ULL, value );
+
+		CHECK_EQUAL( DZCOBS_RET_SUCCESS, dzcobs_view_read_le( &reader, 1, &value ) );
+		CHECK_EQUAL( 0x1AULL, value );
+
+		CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_view_read_le( &reader, 9, &value ) );
+		CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_view_read_be( &reader, 0, &value ) );
+		CHECK_EQUAL( sizeof( data ) - 4 - 250 - 8 - 4 - 1, dzcobs_view_remaining( &reader ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZCOBS_VIEW, Rejected )
+// NOLINTEND
+{
+	static uint8_t encoded[UTEST_VIEW_MAX_SIZE];
+
+	const uint8_t data[] = { 0x11, 0x22, 0x00, 0x33 };
+	sDZCOBS_view view;
+
+	// Corrupted
+	size_t encodedLen = view_encode( &m_dict, DZCOBS_PLAIN, false, data, sizeof( data ), encoded );
+	encoded[1]++;
+	CHECK_EQUAL( DZCOBS_RET_ERR_CRC, view_decode( &m_dict, encoded, encodedLen, &view ) );
+
+	// The filter can not be undone on the frame
+	encodedLen = view_encode( &m_dict, DZCOBS_PLAIN, true, data, sizeof( data ), encoded );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, view_decode( &m_dict, encoded, encodedLen, &view ) );
+
+	// Without its dictionary
+	encodedLen = view_encode( &m_dict, DZCOBS_USING_DICT_1, false, data, sizeof( data ), encoded );
+	CHECK_EQUAL( DZCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE, view_decode( NULL, encoded, encodedLen, &view ) );
+
+	sDZCOBS_decodectx decodeCtx;
+	memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+	decodeCtx.srcBufEncoded		 = encoded;
+	decodeCtx.srcBufEncodedLen = encodedLen;
+
+	uint8_t user6bits = 0;
+	sDZCOBS_viewreader reader;
+
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_view( NULL, &view, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_view( &decodeCtx, NULL, &user6bits ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_decode_view( &decodeCtx, &view, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_view_reader_init( NULL, &view ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_view_reader_init( &reader, NULL ) );
+	CHECK_EQUAL( DZCOBS_RET_ERR_BAD_ARG, dzcobs_view_read( NULL, NULL, 1 ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,897 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_analyze.c
+///	@brief Payload analyzer, reports the ratio and speed of each encoding
+///
+/// Reads a capture of payloads and reports, to choose the encoding of a message
+/// type:
+///  - the zero density and the histograms of the zero and non-zero runs
+///  - for each dictionary, the bytes covered by its words as the encoder finds
+///    them (coverage), the share of positions where any word matches (match
+///    density) and the distinct words used
+///  - for each encoding (DZCOBS_PLAIN, DZCOBS_USING_DICT_1, DZCOBS_USING_DICT_2),
+///    the encoded size and ratio, the jump codes (0xFF plain, 0x7F dictionary)
+///    used to split long runs, and the measured encode and decode speed
+///
+/// The dictionaries are binary dictionary files (see dzcobs_dict tobin). When
+/// none is given, DICT_1 is the library default dictionary.
+///
+/// Usage: dzcobs_analyze [options] <capture files...>
+///  -o <file>     output report (default: stdout)
+///  -f <format>   json or csv (default: json). The csv has section,item,value rows
+///  -1 <file>     DICT_1 binary dictionary file
+///  -2 <file>     DICT_2 binary dictionary file
+///  -c <size>     split the files in payloads of this size (default: one payload
+///                per file)
+///  -m <size>     maximum capture bytes to read (default: 16777216)
+///  -t <ms>       minimum time measuring each encoding speed (default: 200)
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_decode.h>
+#include <dzcobs/dzcobs_dictfile.h>
+#include <dzcobs/dzcobs_dictionary.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	ANALYZE_N_ENCODINGS		 = ( 1 + DZCOBS_DICT_N ),
+	ANALYZE_N_RUN_BUCKETS	 = ( 10 ), ///< Runs of 1, 2..3, 4..7, .., 256..511 and 512 or more bytes
+	ANALYZE_MAX_WORDS			 = ( 126 ),
+	ANALYZE_DEFAULT_TIMEMS = ( 200 )
+};
+
+#define ANALYZE_DEFAULT_MAX_CAPTURE ( 16 * 1024 * 1024 )
+
+typedef enum e_ANALYZE_format
+{
+	ANALYZE_FORMAT_JSON = 0,
+	ANALYZE_FORMAT_CSV
+} eANALYZE_format;
+
+typedef struct s_ANALYZE_payload
+{
+	size_t offset;
+	size_t size;
+} sANALYZE_payload;
+
+typedef struct s_ANALYZE_capture
+{
+	uint8_t *pData;
+	size_t size;
+	size_t capacity;
+
+	sANALYZE_payload *pPayloads;
+	size_t nPayloads;
+	size_t maxPayloadSize;
+} sANALYZE_capture;
+
+/// Zero density and runs of the capture
+typedef struct s_ANALYZE_runs
+{
+	size_t zeroBytes;
+	size_t zeroRuns[ANALYZE_N_RUN_BUCKETS];
+	size_t nonZeroRuns[ANALYZE_N_RUN_BUCKETS];
+} sANALYZE_runs;
+
+/// Results of an encoding
+typedef struct s_ANALYZE_result
+{
+	eDZCOBS_encoding encoding;
+	const sDICT_ctx *pDict; ///< NULL for DZCOBS_PLAIN
+	const char *pDictName;	///< Dictionary file, or "default"
+
+	size_t encodedBytes;
+	size_t jumpCodes;				///< Codes of runs split only by their length
+	size_t wordCodes;				///< Dictionary words encoded
+	size_t wordBytes;				///< Payload bytes encoded as dictionary words
+	size_t matchPositions;	///< Payload positions where any word matches
+	size_t distinctWords;		///< Different dictionary words encoded
+	double encodeMBs;
+	double decodeMBs;
+} sANALYZE_result;
+
+/// Encoded frames of the capture, the last one of each payload
+typedef struct s_ANALYZE_frames
+{
+	uint8_t *pData;
+	size_t *pOffsets; ///< nPayloads + 1 offsets
+} sANALYZE_frames;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static void analyze_fatal( const char *aMessage, const char *aDetail )
+{
+	if( aDetail != NULL )
+	{
+		fprintf( stderr, "dzcobs_analyze: %s %s\n", aMessage, aDetail );
+	}
+	else
+	{
+		fprintf( stderr, "dzcobs_analyze: %s\n", aMessage );
+	}
+
+	exit( EXIT_FAILURE );
+}
+
+static void *analyze_realloc( void *aPtr, size_t aSize )
+{
+	void *pNew = realloc( aPtr, aSize );
+
+	if( pNew == NULL )
+	{
+		analyze_fatal( "out of memory", NULL );
+	}
+
+	return pNew;
+}
+
+static void analyze_add_payload( sANALYZE_capture *aCapture, size_t aOffset, size_t aSize )
+{
+	aCapture->pPayloads =
+		analyze_realloc( aCapture->pPayloads, ( aCapture->nPayloads + 1 ) * sizeof( sANALYZE_payload ) );
+
+	aCapture->pPayloads[aCapture->nPayloads].offset = aOffset;
+	aCapture->pPayloads[aCapture->nPayloads].size		= aSize;
+	aCapture->nPayloads++;
+
+	if( aCapture->maxPayloadSize < aSize )
+	{
+		aCapture->maxPayloadSize = aSize;
+	}
+}
+
+/// Read a file to the capture. Returns false if the capture is full.
+static bool analyze_read_file( sANALYZE_capture *aCapture, const char *aFileName, size_t aChunkSize )
+{
+	FILE *pFile = fopen( aFileName, "rb" );
+
+	if( pFile == NULL )
+	{
+		analyze_fatal( "cannot open", aFileName );
+	}
+
+	const size_t fileOffset = aCapture->size;
+
+	while( aCapture->size < aCapture->capacity )
+	{
+		const size_t nRead = fread( aCapture->pData + aCapture->size, 1, aCapture->capacity - aCapture->size, pFile );
+
+		if( nRead == 0 )
+		{
+			break;
+		}
+
+		aCapture->size += nRead;
+	}
+
+	const bool isFull = ( aCapture->size == aCapture->capacity ) && ( fgetc( pFile ) != EOF );
+
+	fclose( pFile );
+
+	size_t offset = fileOffset;
+
+	while( offset < aCapture->size )
+	{
+		size_t payloadSize = aCapture->size - offset;
+
+		if( ( aChunkSize != 0 ) && ( payloadSize > aChunkSize ) )
+		{
+			payloadSize = aChunkSize;
+		}
+
+		analyze_add_payload( aCapture, offset, payloadSize );
+		offset += payloadSize;
+	}
+
+	return !isFull;
+}
+
+/// Read a binary dictionary file. The image is kept while the dictionary is in use.
+static void analyze_load_dictionary( const char *aFileName, sDICT_ctx *aOutCtx )
+{
+	FILE *pFile = fopen( aFileName, "rb" );
+
+	if( ( pFile == NULL ) || ( fseek( pFile, 0, SEEK_END ) != 0 ) )
+	{
+		analyze_fatal( "cannot open", aFileName );
+	}
+
+	const long fileSize = ftell( pFile );
+	rewind( pFile );
+
+	if( fileSize <= 0 )
+	{
+		analyze_fatal( "not a valid dictionary file:", aFileName );
+	}
+
+	// malloc memory is aligned for any type, so DZCOBS_DICTFILE_ALIGNMENT too
+	void *pImage = analyze_realloc( NULL, (size_t)fileSize );
+
+	if( fread( pImage, 1, (size_t)fileSize, pFile ) != (size_t)fileSize )
+	{
+		analyze_fatal( "cannot read", aFileName );
+	}
+
+	fclose( pFile );
+
+	if( dzcobs_dictfile_load( aOutCtx, pImage, (size_t)fileSize ) != DICT_RET_SUCCESS )
+	{
+		analyze_fatal( "not a valid dictionary file:", aFileName );
+	}
+}
+
+static size_t analyze_run_bucket( size_t aRunLen )
+{
+	size_t bucket = 0;
+
+	while( ( aRunLen > 1 ) && ( bucket < ( ANALYZE_N_RUN_BUCKETS - 1 ) ) )
+	{
+		aRunLen >>= 1;
+		bucket++;
+	}
+
+	return bucket;
+}
+
+static void analyze_runs( const sANALYZE_capture *aCapture, sANALYZE_runs *aOutRuns )
+{
+	memset( aOutRuns, 0, sizeof( sANALYZE_runs ) );
+
+	for( size_t p = 0; p < aCapture->nPayloads; p++ )
+	{
+		const uint8_t *pData = aCapture->pData + aCapture->pPayloads[p].offset;
+		const size_t size		 = aCapture->pPayloads[p].size;
+
+		size_t i = 0;
+
+		while( i < size )
+		{
+			const bool isZero = ( pData[i] == 0 );
+			const size_t runStart = i;
+
+			while( ( i < size ) && ( ( pData[i] == 0 ) == isZero ) )
+			{
+				i++;
+			}
+
+			const size_t runLen = i - runStart;
+
+			if( isZero )
+			{
+				aOutRuns->zeroBytes += runLen;
+				aOutRuns->zeroRuns[analyze_run_bucket( runLen )]++;
+			}
+			else
+			{
+				aOutRuns->nonZeroRuns[analyze_run_bucket( runLen )]++;
+			}
+		}
+	}
+}
+
+/// Dictionary words as the encoder finds them, and the positions where any word matches
+static void analyze_coverage( const sANALYZE_capture *aCapture, sANALYZE_result *aResult )
+{
+	bool isWordUsed[ANALYZE_MAX_WORDS];
+	memset( isWordUsed, 0, sizeof( isWordUsed ) );
+
+	for( size_t p = 0; p < aCapture->nPayloads; p++ )
+	{
+		const uint8_t *pData = aCapture->pData + aCapture->pPayloads[p].offset;
+		const size_t size		 = aCapture->pPayloads[p].size;
+
+		size_t nextWordPos = 0;
+		size_t runLen			 = 0;
+		bool isZeroPending = false;
+
+		for( size_t i = 0; i < size; i++ )
+		{
+			size_t keySize			= 0;
+			const uint8_t index = dzcobs_dictionary_search( aResult->pDict, &pData[i], size - i, &keySize );
+
+			if( index != 0 )
+			{
+				aResult->matchPositions++;
+			}
+
+			if( i < nextWordPos )
+			{
+				continue;
+			}
+
+			// As the encoder, the byte after the 0x00 that closes a run is plain
+			if( ( index != 0 ) && ( !isZeroPending ) )
+			{
+				aResult->wordCodes++;
+				aResult->wordBytes += keySize;
+				isWordUsed[index - 1] = true;
+				nextWordPos						= i + keySize;
+				runLen								= 0;
+				continue;
+			}
+
+			isZeroPending = ( pData[i] == 0 ) && ( runLen != 0 );
+			runLen				= ( pData[i] == 0 ) ? 0 : runLen + 1;
+			nextWordPos		= i + 1;
+
+			// A full run is closed by a jump code
+			if( runLen == ( DZCOBS_CODE_JUMP_DICTIONARY - 1 ) )
+			{
+				runLen = 0;
+			}
+		}
+	}
+
+	for( size_t i = 0; i < ANALYZE_MAX_WORDS; i++ )
+	{
+		aResult->distinctWords += isWordUsed[i] ? 1 : 0;
+	}
+}
+
+/// Jump codes of an encoded frame, found by walking its codes
+static size_t analyze_jump_codes( const uint8_t *aFrame, size_t aFrameLen, eDZCOBS_encoding aEncoding )
+{
+	const size_t payloadLen = aFrameLen - DZCOBS_FRAME_HEADER_SIZE;
+	const uint8_t jumpCode	= ( aEncoding == DZCOBS_PLAIN ) ? DZCOBS_CODE_JUMP_PLAIN : DZCOBS_CODE_JUMP_DICTIONARY;
+
+	size_t nJumps = 0;
+	size_t i			= 0;
+
+	while( i < payloadLen )
+	{
+		const uint8_t code = aFrame[i];
+
+		if( ( aEncoding != DZCOBS_PLAIN ) && ( code >= DZCOBS_DICTIONARY_BITMASK ) )
+		{
+			i++;
+			continue;
+		}
+
+		// A last run is not split by its length
+		if( ( code == jumpCode ) && ( ( i + code ) < payloadLen ) )
+		{
+			nJumps++;
+		}
+
+		i += code;
+	}
+
+	return nJumps;
+}
+
+static double analyze_seconds( void )
+{
+	return (double)clock() / (double)CLOCKS_PER_SEC;
+}
+
+static void analyze_encode_all( const sANALYZE_capture *aCapture,
+																const sANALYZE_result *aResult,
+																sANALYZE_frames *aFrames,
+																size_t aFrameBufSize )
+{
+	size_t offset = 0;
+
+	for( size_t p = 0; p < aCapture->nPayloads; p++ )
+	{
+		sDZCOBS_ctx ctx;
+		memset( &ctx, 0, sizeof( ctx ) );
+
+		if( aResult->pDict != NULL )
+		{
+			dzcobs_encode_set_dictionary( &ctx, aResult->pDict, aResult->encoding );
+		}
+
+		size_t encodedSize = 0;
+
+		if( dzcobs_encode_inc_begin( &ctx, aResult->encoding, aFrames->pData + offset, aFrameBufSize ) !=
+				DZCOBS_RET_SUCCESS )
+		{
+			analyze_fatal( "encoding failed", NULL );
+		}
+
+		ctx.user6bits = 1;
+
+		if( ( dzcobs_encode_inc( &ctx, aCapture->pData + aCapture->pPayloads[p].offset, aCapture->pPayloads[p].size ) !=
+					DZCOBS_RET_SUCCESS ) ||
+				( dzcobs_encode_inc_end( &ctx, &encodedSize ) != DZCOBS_RET_SUCCESS ) )
+		{
+			analyze_fatal( "encoding failed", NULL );
+		}
+
+		aFrames->pOffsets[p] = offset;
+		offset += encodedSize;
+	}
+
+	aFrames->pOffsets[aCapture->nPayloads] = offset;
+}
+
+static void analyze_decode_all( const sANALYZE_capture *aCapture,
+																const sANALYZE_result *aResult,
+																const sANALYZE_frames *aFrames,
+																uint8_t *aDecodeBuf,
+																bool aIsToVerify )
+{
+	for( size_t p = 0; p < aCapture->nPayloads; p++ )
+	{
+		sDZCOBS_decodectx decodeCtx;
+		memset( &decodeCtx, 0, sizeof( decodeCtx ) );
+
+		decodeCtx.srcBufEncoded			= aFrames->pData + aFrames->pOffsets[p];
+		decodeCtx.srcBufEncodedLen	= aFrames->pOffsets[p + 1] - aFrames->pOffsets[p];
+		decodeCtx.dstBufDecoded			= aDecodeBuf;
+		decodeCtx.dstBufDecodedSize = aCapture->maxPayloadSize + 1;
+
+		if( aResult->pDict != NULL )
+		{
+			decodeCtx.pDict[aResult->encoding - DZCOBS_USING_DICT_1] = aResult->pDict;
+		}
+
+		size_t decodedLen = 0;
+		uint8_t user6bits = 0;
+
+		const eDZCOBS_ret ret = dzcobs_decode( &decodeCtx, &decodedLen, &user6bits );
+
+		if( aIsToVerify &&
+				( ( ret != DZCOBS_RET_SUCCESS ) || ( decodedLen != aCapture->pPayloads[p].size ) ||
+					( memcmp( aDecodeBuf, aCapture->pData + aCapture->pPayloads[p].offset, decodedLen ) != 0 ) ) )
+		{
+			analyze_fatal( "decoded payload differs", NULL );
+		}
+	}
+}
+
+static void analyze_encoding( const sANALYZE_capture *aCapture, sANALYZE_result *aResult, double aMinSeconds )
+{
+	const size_t frameBufSize = DZCOBS_MAX_ENCODED_SIZE( aCapture->maxPayloadSize ) + DZCOBS_FRAME_HEADER_SIZE;
+
+	sANALYZE_frames frames;
+	frames.pData		= analyze_realloc( NULL, aCapture->nPayloads * frameBufSize );
+	frames.pOffsets = analyze_realloc( NULL, ( aCapture->nPayloads + 1 ) * sizeof( size_t ) );
+
+	uint8_t *pDecodeBuf = analyze_realloc( NULL, aCapture->maxPayloadSize + 1 );
+
+	analyze_encode_all( aCapture, aResult, &frames, frameBufSize );
+	analyze_decode_all( aCapture, aResult, &frames, pDecodeBuf, true );
+
+	aResult->encodedBytes = frames.pOffsets[aCapture->nPayloads];
+
+	for( size_t p = 0; p < aCapture->nPayloads; p++ )
+	{
+		aResult->jumpCodes += analyze_jump_codes(
+			frames.pData + frames.pOffsets[p], frames.pOffsets[p + 1] - frames.pOffsets[p], aResult->encoding );
+	}
+
+	if( aResult->pDict != NULL )
+	{
+		analyze_coverage( aCapture, aResult );
+	}
+
+	// Speed, repeating the whole capture until aMinSeconds
+	size_t nRounds = 0;
+	double start	 = analyze_seconds();
+	double elapsed = 0;
+
+	do
+	{
+		analyze_encode_all( aCapture, aResult, &frames, frameBufSize );
+		nRounds++;
+		elapsed = analyze_seconds() - start;
+	} while( elapsed < aMinSeconds );
+
+	aResult->encodeMBs = ( (double)aCapture->size * (double)nRounds ) / ( elapsed * 1e6 );
+
+	nRounds = 0;
+	start		= analyze_seconds();
+
+	do
+	{
+		analyze_decode_all( aCapture, aResult, &frames, pDecodeBuf, false );
+		nRounds++;
+		elapsed = analyze_seconds() - start;
+	} while( elapsed < aMinSeconds );
+
+	aResult->decodeMBs = ( (double)aCapture->size * (double)nRounds ) / ( elapsed * 1e6 );
+
+	free( pDecodeBuf );
+	free( frames.pOffsets );
+	free( frames.pData );
+}
+
+static const char *analyze_encoding_name( eDZCOBS_encoding aEncoding )
+{
+	switch( aEncoding )
+	{
+	case DZCOBS_PLAIN:
+		return "DZCOBS_PLAIN";
+	case DZCOBS_USING_DICT_1:
+		return "DZCOBS_USING_DICT_1";
+	case DZCOBS_USING_DICT_2:
+		return "DZCOBS_USING_DICT_2";
+	case DZCOBS_RESERVED:
+	default:
+		return "DZCOBS_RESERVED";
+	}
+}
+
+static double analyze_ratio( size_t aNumerator, size_t aDenominator )
+{
+	return ( aDenominator == 0 ) ? 0.0 : (double)aNumerator / (double)aDenominator;
+}
+
+/// Run bucket limits, the last bucket has no maximum (0)
+static void analyze_bucket_limits( size_t aBucket, size_t *aOutMin, size_t *aOutMax )
+{
+	*aOutMin = (size_t)1 << aBucket;
+	*aOutMax = ( aBucket == ( ANALYZE_N_RUN_BUCKETS - 1 ) ) ? 0 : ( ( (size_t)2 << aBucket ) - 1 );
+}
+
+/// JSON string, escaping the quotes, backslashes and control characters
+static void analyze_write_json_string( FILE *aFile, const char *aText )
+{
+	fputc( '"', aFile );
+
+	for( ; *aText != 0; aText++ )
+	{
+		const unsigned char c = (unsigned char)*aText;
+
+		if( ( c == '"' ) || ( c == '\\' ) )
+		{
+			fprintf( aFile, "\\%c", c );
+		}
+		else if( c < 0x20 )
+		{
+			fprintf( aFile, "\\u%04X", c );
+		}
+		else
+		{
+			fputc( c, aFile );
+		}
+	}
+
+	fputc( '"', aFile );
+}
+
+static void analyze_write_json_runs( FILE *aFile, const char *aName, const size_t *aRuns )
+{
+	fprintf( aFile, "  \"%s\": [\n", aName );
+
+	for( size_t b = 0; b < ANALYZE_N_RUN_BUCKETS; b++ )
+	{
+		size_t runMin = 0;
+		size_t runMax = 0;
+		analyze_bucket_limits( b, &runMin, &runMax );
+
+		fprintf( aFile, "    { \"min\": %zu, ", runMin );
+
+		// The last bucket is open-ended
+		if( runMax == 0 )
+		{
+			fprintf( aFile, "\"max\": null, " );
+		}
+		else
+		{
+			fprintf( aFile, "\"max\": %zu, ", runMax );
+		}
+
+		fprintf( aFile, "\"count\": %zu }%s\n", aRuns[b], ( b == ( ANALYZE_N_RUN_BUCKETS - 1 ) ) ? "" : "," );
+	}
+
+	fprintf( aFile, "  ],\n" );
+}
+
+static void analyze_write_json( FILE *aFile,
+																const sANALYZE_capture *aCapture,
+																const sANALYZE_runs *aRuns,
+																const sANALYZE_result *aResults,
+																size_t aNResults )
+{
+	fprintf( aFile, "{\n" );
+	fprintf( aFile, "  \"payloads\": %zu,\n", aCapture->nPayloads );
+	fprintf( aFile, "  \"bytes\": %zu,\n", aCapture->size );
+	fprintf( aFile, "  \"zero_bytes\": %zu,\n", aRuns->zeroBytes );
+	fprintf( aFile, "  \"zero_density\": %.6f,\n", analyze_ratio( aRuns->zeroBytes, aCapture->size ) );
+
+	analyze_write_json_runs( aFile, "zero_runs", aRuns->zeroRuns );
+	analyze_write_json_runs( aFile, "nonzero_runs", aRuns->nonZeroRuns );
+
+	fprintf( aFile, "  \"encodings\": [\n" );
+
+	for( size_t r = 0; r < aNResults; r++ )
+	{
+		const sANALYZE_result *pResult = &aResults[r];
+
+		fprintf( aFile, "    {\n" );
+		fprintf( aFile, "      \"encoding\": \"%s\",\n", analyze_encoding_name( pResult->encoding ) );
+
+		if( pResult->pDict != NULL )
+		{
+			fprintf( aFile, "      \"dictionary\": " );
+			analyze_write_json_string( aFile, pResult->pDictName );
+			fprintf( aFile, ",\n" );
+			fprintf( aFile, "      \"word_codes\": %zu,\n", pResult->wordCodes );
+			fprintf( aFile, "      \"distinct_words\": %zu,\n", pResult->distinctWords );
+			fprintf( aFile, "      \"coverage\": %.6f,\n", analyze_ratio( pResult->wordBytes, aCapture->size ) );
+			fprintf( aFile,
+							 "      \"match_density\": %.6f,\n",
+							 analyze_ratio( pResult->matchPositions, aCapture->size ) );
+		}
+
+		fprintf( aFile, "      \"encoded_bytes\": %zu,\n", pResult->encodedBytes );
+		fprintf( aFile, "      \"ratio\": %.6f,\n", analyze_ratio( pResult->encodedBytes, aCapture->size ) );
+		fprintf( aFile, "      \"jump_codes\": %zu,\n", pResult->jumpCodes );
+		fprintf( aFile, "      \"encode_mbs\": %.2f,\n", pResult->encodeMBs );
+		fprintf( aFile, "      \"decode_mbs\": %.2f\n", pResult->decodeMBs );
+		fprintf( aFile, "    }%s\n", ( r == ( aNResults - 1 ) ) ? "" : "," );
+	}
+
+	fprintf( aFile, "  ]\n" );
+	fprintf( aFile, "}\n" );
+}
+
+static void analyze_write_csv_runs( FILE *aFile, const char *aName, const size_t *aRuns )
+{
+	for( size_t b = 0; b < ANALYZE_N_RUN_BUCKETS; b++ )
+	{
+		size_t runMin = 0;
+		size_t runMax = 0;
+		analyze_bucket_limits( b, &runMin, &runMax );
+
+		if( runMax == 0 )
+		{
+			fprintf( aFile, "%s,%zu+,%zu\n", aName, runMin, aRuns[b] );
+		}
+		else
+		{
+			fprintf( aFile, "%s,%zu-%zu,%zu\n", aName, runMin, runMax, aRuns[b] );
+		}
+	}
+}
+
+static void analyze_write_csv( FILE *aFile,
+															 const sANALYZE_capture *aCapture,
+															 const sANALYZE_runs *aRuns,
+															 const sANALYZE_result *aResults,
+															 size_t aNResults )
+{
+	fprintf( aFile, "section,item,value\n" );
+	fprintf( aFile, "capture,payloads,%zu\n", aCapture->nPayloads );
+	fprintf( aFile, "capture,bytes,%zu\n", aCapture->size );
+	fprintf( aFile, "capture,zero_bytes,%zu\n", aRuns->zeroBytes );
+	fprintf( aFile, "capture,zero_density,%.6f\n", analyze_ratio( aRuns->zeroBytes, aCapture->size ) );
+
+	analyze_write_csv_runs( aFile, "zero_runs", aRuns->zeroRuns );
+	analyze_write_csv_runs( aFile, "nonzero_runs", aRuns->nonZeroRuns );
+
+	for( size_t r = 0; r < aNResults; r++ )
+	{
+		const sANALYZE_result *pResult = &aResults[r];
+		const char *pName							 = analyze_encoding_name( pResult->encoding );
+
+		if( pResult->pDict != NULL )
+		{
+			fprintf( aFile, "%s,dictionary,%s\n", pName, pResult->pDictName );
+			fprintf( aFile, "%s,word_codes,%zu\n", pName, pResult->wordCodes );
+			fprintf( aFile, "%s,distinct_words,%zu\n", pName, pResult->distinctWords );
+			fprintf( aFile, "%s,coverage,%.6f\n", pName, analyze_ratio( pResult->wordBytes, aCapture->size ) );
+			fprintf( aFile, "%s,match_density,%.6f\n", pName, analyze_ratio( pResult->matchPositions, aCapture->size ) );
+		}
+
+		fprintf( aFile, "%s,encoded_bytes,%zu\n", pName, pResult->encodedBytes );
+		fprintf( aFile, "%s,ratio,%.6f\n", pName, analyze_ratio( pResult->encodedBytes, aCapture->size ) );
+		fprintf( aFile, "%s,jump_codes,%zu\n", pName, pResult->jumpCodes );
+		fprintf( aFile, "%s,encode_mbs,%.2f\n", pName, pResult->encodeMBs );
+		fprintf( aFile, "%s,decode_mbs,%.2f\n", pName, pResult->decodeMBs );
+	}
+}
+
+static void analyze_usage( const char *aProgram )
+{
+	fprintf( stderr,
+					 "usage: %s [-o out] [-f json|csv] [-1 dict.dzd] [-2 dict.dzd] [-c chunk size] [-m max capture bytes] "
+					 "[-t ms] <capture files...>\n",
+					 aProgram );
+	exit( EXIT_FAILURE );
+}
+
+int main( int argc, char **argv )
+{
+	const char *pOutFileName = NULL;
+	const char *pDictFile[DZCOBS_DICT_N];
+	eANALYZE_format format = ANALYZE_FORMAT_JSON;
+	size_t chunkSize			 = 0;
+	size_t maxCapture			 = ANALYZE_DEFAULT_MAX_CAPTURE;
+	size_t timeMs					 = ANALYZE_DEFAULT_TIMEMS;
+
+	memset( pDictFile, 0, sizeof( pDictFile ) );
+
+	int argIdx = 1;
+
+	for( ; ( argIdx < argc ) && ( argv[argIdx][0] == '-' ); argIdx++ )
+	{
+		const char option = argv[argIdx][1];
+
+		if( ( argv[argIdx][2] != 0 ) || ( ( argIdx + 1 ) >= argc ) )
+		{
+			analyze_usage( argv[0] );
+		}
+
+		const char *pValue = argv[++argIdx];
+
+		switch( option )
+		{
+		case 'o':
+			pOutFileName = pValue;
+			break;
+
+		case 'f':
+			if( strcmp( pValue, "json" ) == 0 )
+			{
+				format = ANALYZE_FORMAT_JSON;
+			}
+			else if( strcmp( pValue, "csv" ) == 0 )
+			{
+				format = ANALYZE_FORMAT_CSV;
+			}
+			else
+			{
+				analyze_usage( argv[0] );
+			}
+			break;
+
+		case '1':
+			pDictFile[0] = pValue;
+			break;
+
+		case '2':
+			pDictFile[1] = pValue;
+			break;
+
+		case 'c':
+			chunkSize = (size_t)strtoul( pValue, NULL, 0 );
+			break;
+
+		case 'm':
+			maxCapture = (size_t)strtoul( pValue, NULL, 0 );
+			break;
+
+		case 't':
+			timeMs = (size_t)strtoul( pValue, NULL, 0 );
+			break;
+
+		default:
+			analyze_usage( argv[0] );
+		}
+	}
+
+	if( ( argIdx >= argc ) || ( maxCapture == 0 ) )
+	{
+		analyze_usage( argv[0] );
+	}
+
+	// Read the capture
+
+	sANALYZE_capture capture;
+	memset( &capture, 0, sizeof( capture ) );
+
+	capture.capacity = maxCapture;
+	capture.pData		 = analyze_realloc( NULL, maxCapture );
+
+	for( ; argIdx < argc; argIdx++ )
+	{
+		if( !analyze_read_file( &capture, argv[argIdx], chunkSize ) )
+		{
+			fprintf( stderr, "dzcobs_analyze: capture limited to %zu bytes\n", maxCapture );
+			break;
+		}
+	}
+
+	if( capture.nPayloads == 0 )
+	{
+		analyze_fatal( "empty capture", NULL );
+	}
+
+	// Dictionaries
+
+	sDICT_ctx dictCtx[DZCOBS_DICT_N];
+
+	if( ( pDictFile[0] == NULL ) && ( pDictFile[1] == NULL ) )
+	{
+		if( dzcobs_dictionary_init( &dictCtx[0], G_DZCOBS_DefaultDictionary, G_DZCOBS_DefaultDictionary_size ) !=
+				DICT_RET_SUCCESS )
+		{
+			analyze_fatal( "invalid default dictionary", NULL );
+		}
+	}
+
+	for( size_t i = 0; i < DZCOBS_DICT_N; i++ )
+	{
+		if( pDictFile[i] != NULL )
+		{
+			analyze_load_dictionary( pDictFile[i], &dictCtx[i] );
+		}
+	}
+
+	// Analyze
+
+	sANALYZE_runs runs;
+	analyze_runs( &capture, &runs );
+
+	sANALYZE_result results[ANALYZE_N_ENCODINGS];
+	memset( results, 0, sizeof( results ) );
+
+	size_t nResults = 0;
+
+	results[nResults++].encoding = DZCOBS_PLAIN;
+
+	for( size_t i = 0; i < DZCOBS_DICT_N; i++ )
+	{
+		if( ( pDictFile[i] != NULL ) || ( ( i == 0 ) && ( pDictFile[1] == NULL ) ) )
+		{
+			results[nResults].encoding	= (eDZCOBS_encoding)( DZCOBS_USING_DICT_1 + i );
+			results[nResults].pDict			= &dictCtx[i];
+			results[nResults].pDictName = ( pDictFile[i] != NULL ) ? pDictFile[i] : "default";
+			nResults++;
+		}
+	}
+
+	for( size_t r = 0; r < nResults; r++ )
+	{
+		analyze_encoding( &capture, &results[r], (double)timeMs / 1000.0 );
+	}
+
+	// Report
+
+	FILE *pOutFile = stdout;
+
+	if( pOutFileName != NULL )
+	{
+		pOutFile = fopen( pOutFileName, "w" );
+
+		if( pOutFile == NULL )
+		{
+			analyze_fatal( "cannot create", pOutFileName );
+		}
+	}
+
+	if( format == ANALYZE_FORMAT_JSON )
+	{
+		analyze_write_json( pOutFile, &capture, &runs, results, nResults );
+	}
+	else
+	{
+		analyze_write_csv( pOutFile, &capture, &runs, results, nResults );
+	}
+
+	if( pOutFile != stdout )
+	{
+		fclose( pOutFile );
+	}
+
+	free( capture.pPayloads );
+	free( capture.pData );
+
+	return EXIT_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
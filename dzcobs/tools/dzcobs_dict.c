@@ -0,0 +1,981 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_dict.c
+///	@brief Converts dictionaries between the C source and the binary file forms,
+/// and generates dictionary matchers
+///
+/// The C source form is a dictionary_default.c style file (as written by
+/// dzcobs_train), its DICT_ADD_WORD entries are parsed in order. The binary
+/// form is the dzcobs_dictfile.h image, that is loaded by mapping the file.
+///
+/// Usage:
+///  dzcobs_dict tobin [-p] [-a] <in.c> <out.dzd>
+///    -p  store the packed keys
+///    -a  store the search automaton
+///  dzcobs_dict toc [-n symbol] <in.dzd> <out.c>
+///    -n  dictionary symbol name (default: G_DZCOBS_Dictionary)
+///  dzcobs_dict info <in.dzd>
+///  dzcobs_dict gen [-n symbol] <in.c> <out.c>
+///    -n  matcher sDICT_ctx symbol name (default: G_DZCOBS_DictionaryMatcher)
+///
+/// gen writes a C source with a const sDICT_ctx of the dictionary that has a
+/// specialized search (a switch on the first byte, then integer compares of
+/// the other bytes) and a word offset table, used by dzcobs_dictionary_search
+/// and dzcobs_dictionary_get instead of the generic tables. Declare it with
+/// extern const sDICT_ctx <symbol>; (see dzcobs_add_dictionary_matcher on
+/// cmake/dzcobs_matcher.cmake).
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define _POSIX_C_SOURCE 200809L
+#define DICT_TOOL_HAS_MMAP ( 1 )
+#endif
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <ctype.h>
+#include <dzcobs/dzcobs_dictfile.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef DICT_TOOL_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	DICT_TOOL_MAX_WORD_SIZE		= ( 5 ),
+	DICT_TOOL_MAX_WORDS				= ( 126 ),
+	DICT_TOOL_DICT_STRING_SIZE = ( DICT_TOOL_MAX_WORDS * ( DICT_TOOL_MAX_WORD_SIZE + 1 ) + 1 )
+};
+
+#define DICT_TOOL_DEFAULT_SYMBOL "G_DZCOBS_Dictionary"
+#define DICT_TOOL_DEFAULT_MATCHER_SYMBOL "G_DZCOBS_DictionaryMatcher"
+
+/// A dictionary file, mapped or read
+typedef struct s_DICT_TOOL_image
+{
+	void *pData;
+	size_t size;
+	bool isMapped;
+} sDICT_TOOL_image;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static void dict_tool_fatal( const char *aMessage, const char *aDetail )
+{
+	if( aDetail != NULL )
+	{
+		fprintf( stderr, "dzcobs_dict: %s %s\n", aMessage, aDetail );
+	}
+	else
+	{
+		fprintf( stderr, "dzcobs_dict: %s\n", aMessage );
+	}
+
+	exit( EXIT_FAILURE );
+}
+
+static char *dict_tool_read_text( const char *aFileName )
+{
+	FILE *pFile = fopen( aFileName, "rb" );
+
+	if( pFile == NULL )
+	{
+		dict_tool_fatal( "cannot open", aFileName );
+	}
+
+	size_t size		= 0;
+	size_t capacity = 4096;
+	char *pText			= malloc( capacity );
+
+	for( ;; )
+	{
+		if( pText == NULL )
+		{
+			dict_tool_fatal( "out of memory", NULL );
+		}
+
+		size += fread( pText + size, 1, capacity - size - 1, pFile );
+
+		if( size < ( capacity - 1 ) )
+		{
+			break;
+		}
+
+		capacity *= 2;
+		pText = realloc( pText, capacity );
+	}
+
+	fclose( pFile );
+
+	pText[size] = 0;
+
+	return pText;
+}
+
+static const char *dict_tool_skip_spaces( const char *aText )
+{
+	while( isspace( (unsigned char)*aText ) )
+	{
+		aText++;
+	}
+
+	return aText;
+}
+
+/**
+ * @brief Parse a C string literal, with its escapes
+ *
+ * @param aText At the opening quote
+ * @param aOut Bytes output
+ * @param aOutSize Size of aOut
+ * @param aOutLen Number of bytes, added to
+ * @return const char* After the closing quote, NULL on a parse error
+ */
+static const char *dict_tool_parse_literal( const char *aText, uint8_t *aOut, size_t aOutSize, size_t *aOutLen )
+{
+	aText++;
+
+	while( *aText != '"' )
+	{
+		int value = (unsigned char)*aText++;
+
+		if( ( value == 0 ) || ( value == '\n' ) )
+		{
+			return NULL;
+		}
+
+		if( value == '\\' )
+		{
+			const char escape = *aText++;
+
+			switch( escape )
+			{
+			case 'x':
+				if( !isxdigit( (unsigned char)*aText ) )
+				{
+					return NULL;
+				}
+
+				value = 0;
+
+				while( isxdigit( (unsigned char)*aText ) )
+				{
+					const char digit = (char)tolower( (unsigned char)*aText++ );
+					value						 = ( value * 16 ) + ( ( digit <= '9' ) ? ( digit - '0' ) : ( digit - 'a' + 10 ) );
+
+					if( value > 0xFF )
+					{
+						return NULL;
+					}
+				}
+				break;
+
+			case 'n':
+				value = '\n';
+				break;
+
+			case 'r':
+				value = '\r';
+				break;
+
+			case 't':
+				value = '\t';
+				break;
+
+			case 'a':
+				value = '\a';
+				break;
+
+			case 'b':
+				value = '\b';
+				break;
+
+			case 'f':
+				value = '\f';
+				break;
+
+			case 'v':
+				value = '\v';
+				break;
+
+			case '\\':
+			case '\'':
+			case '"':
+			case '?':
+				value = escape;
+				break;
+
+			default:
+				if( ( escape < '0' ) || ( escape > '7' ) )
+				{
+					return NULL;
+				}
+
+				value = escape - '0';
+
+				for( int i = 0; ( i < 2 ) && ( *aText >= '0' ) && ( *aText <= '7' ); i++ )
+				{
+					value = ( value * 8 ) + ( *aText++ - '0' );
+				}
+
+				if( value > 0xFF )
+				{
+					return NULL;
+				}
+				break;
+			}
+		}
+
+		if( *aOutLen >= aOutSize )
+		{
+			return NULL;
+		}
+
+		aOut[( *aOutLen )++] = (uint8_t)value;
+	}
+
+	return aText + 1;
+}
+
+/// Collects the DICT_ADD_WORD entries of a C source, in order, as a dictionary string
+static size_t dict_tool_parse_source( const char *aFileName, char *aOutDict )
+{
+	static const char keyword[] = "DICT_ADD_WORD";
+
+	char *pText				= dict_tool_read_text( aFileName );
+	const char *pCur	= pText;
+	size_t dictLen		= 0;
+	size_t nWords			= 0;
+	bool isIdentifier = false;
+
+	while( *pCur != 0 )
+	{
+		if( ( pCur[0] == '/' ) && ( pCur[1] == '/' ) )
+		{
+			pCur = strchr( pCur, '\n' );
+			pCur = ( pCur != NULL ) ? pCur : "";
+			continue;
+		}
+
+		if( ( pCur[0] == '/' ) && ( pCur[1] == '*' ) )
+		{
+			pCur = strstr( pCur + 2, "*/" );
+			pCur = ( pCur != NULL ) ? ( pCur + 2 ) : "";
+			continue;
+		}
+
+		if( *pCur == '#' )
+		{
+			// Preprocessor directives, e.g. #define DICT_ADD_WORD
+			pCur = strchr( pCur, '\n' );
+			pCur = ( pCur != NULL ) ? pCur : "";
+			continue;
+		}
+
+		if( ( *pCur == '"' ) || ( *pCur == '\'' ) )
+		{
+			// Other literals, skipped
+			const char quote = *pCur++;
+
+			while( ( *pCur != 0 ) && ( *pCur != quote ) )
+			{
+				pCur += ( ( pCur[0] == '\\' ) && ( pCur[1] != 0 ) ) ? 2 : 1;
+			}
+
+			pCur += ( *pCur != 0 ) ? 1 : 0;
+			isIdentifier = false;
+			continue;
+		}
+
+		if( ( !isIdentifier ) && ( strncmp( pCur, keyword, sizeof( keyword ) - 1 ) == 0 ) &&
+				( !isalnum( (unsigned char)pCur[sizeof( keyword ) - 1] ) ) && ( pCur[sizeof( keyword ) - 1] != '_' ) )
+		{
+			pCur = dict_tool_skip_spaces( pCur + sizeof( keyword ) - 1 );
+
+			if( *pCur != '(' )
+			{
+				// Not a use
+				isIdentifier = true;
+				continue;
+			}
+
+			char *pEnd						= NULL;
+			const long wordSize = strtol( dict_tool_skip_spaces( pCur + 1 ), &pEnd, 10 );
+
+			pCur = dict_tool_skip_spaces( pEnd );
+
+			if( ( *pCur != ',' ) || ( wordSize < 2 ) || ( wordSize > DICT_TOOL_MAX_WORD_SIZE ) ||
+					( nWords >= DICT_TOOL_MAX_WORDS ) )
+			{
+				dict_tool_fatal( "bad DICT_ADD_WORD entry in", aFileName );
+			}
+
+			uint8_t word[DICT_TOOL_MAX_WORD_SIZE];
+			size_t wordLen = 0;
+
+			pCur = dict_tool_skip_spaces( pCur + 1 );
+
+			// Adjacent literals are concatenated
+			while( ( pCur != NULL ) && ( *pCur == '"' ) )
+			{
+				pCur = dict_tool_parse_literal( pCur, word, sizeof( word ), &wordLen );
+				pCur = ( pCur != NULL ) ? dict_tool_skip_spaces( pCur ) : NULL;
+			}
+
+			if( ( pCur == NULL ) || ( *pCur != ')' ) || ( wordLen != (size_t)wordSize ) )
+			{
+				dict_tool_fatal( "bad DICT_ADD_WORD entry in", aFileName );
+			}
+
+			aOutDict[dictLen++] = (char)( '0' + wordSize );
+			memcpy( &aOutDict[dictLen], word, wordLen );
+			dictLen += wordLen;
+			nWords++;
+
+			pCur++;
+			isIdentifier = false;
+			continue;
+		}
+
+		isIdentifier = isalnum( (unsigned char)*pCur ) || ( *pCur == '_' );
+		pCur++;
+	}
+
+	free( pText );
+
+	if( nWords == 0 )
+	{
+		dict_tool_fatal( "no DICT_ADD_WORD entries in", aFileName );
+	}
+
+	aOutDict[dictLen++] = 0;
+
+	return dictLen;
+}
+
+static void dict_tool_map( const char *aFileName, sDICT_TOOL_image *aOutImage )
+{
+	memset( aOutImage, 0, sizeof( sDICT_TOOL_image ) );
+
+#ifdef DICT_TOOL_HAS_MMAP
+	const int fd = open( aFileName, O_RDONLY );
+	struct stat fileStat;
+
+	if( ( fd < 0 ) || ( fstat( fd, &fileStat ) != 0 ) )
+	{
+		dict_tool_fatal( "cannot open", aFileName );
+	}
+
+	aOutImage->size = (size_t)fileStat.st_size;
+
+	if( aOutImage->size > 0 )
+	{
+		// Read only and shared, processes that map the same file share its pages
+		aOutImage->pData = mmap( NULL, aOutImage->size, PROT_READ, MAP_SHARED, fd, 0 );
+
+		if( aOutImage->pData == MAP_FAILED )
+		{
+			dict_tool_fatal( "cannot map", aFileName );
+		}
+
+		aOutImage->isMapped = true;
+	}
+
+	close( fd );
+#else
+	FILE *pFile = fopen( aFileName, "rb" );
+
+	if( ( pFile == NULL ) || ( fseek( pFile, 0, SEEK_END ) != 0 ) )
+	{
+		dict_tool_fatal( "cannot open", aFileName );
+	}
+
+	aOutImage->size = (size_t)ftell( pFile );
+	rewind( pFile );
+
+	// malloc memory is aligned for any type, so DZCOBS_DICTFILE_ALIGNMENT too
+	aOutImage->pData = malloc( aOutImage->size + 1 );
+
+	if( ( aOutImage->pData == NULL ) || ( fread( aOutImage->pData, 1, aOutImage->size, pFile ) != aOutImage->size ) )
+	{
+		dict_tool_fatal( "cannot read", aFileName );
+	}
+
+	fclose( pFile );
+#endif
+}
+
+static void dict_tool_unmap( sDICT_TOOL_image *aImage )
+{
+#ifdef DICT_TOOL_HAS_MMAP
+	if( aImage->isMapped )
+	{
+		munmap( aImage->pData, aImage->size );
+	}
+#else
+	free( aImage->pData );
+#endif
+	memset( aImage, 0, sizeof( sDICT_TOOL_image ) );
+}
+
+static void dict_tool_load( const char *aFileName, sDICT_TOOL_image *aOutImage, sDICT_ctx *aOutCtx )
+{
+	dict_tool_map( aFileName, aOutImage );
+
+	if( dzcobs_dictfile_load( aOutCtx, aOutImage->pData, aOutImage->size ) != DICT_RET_SUCCESS )
+	{
+		dict_tool_fatal( "not a valid dictionary file:", aFileName );
+	}
+}
+
+static uint8_t dict_tool_nwords( const sDICT_ctx *aCtx )
+{
+	uint8_t nWords = 0;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		nWords += aCtx->wordSizeTable[i].nEntries;
+	}
+
+	return nWords;
+}
+
+static void dict_tool_write_source( FILE *aFile, const char *aFileName, const char *aSymbol, const sDICT_ctx *aCtx )
+{
+	const char *pBaseName = strrchr( aFileName, '/' );
+	pBaseName							= ( pBaseName != NULL ) ? ( pBaseName + 1 ) : aFileName;
+
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n" );
+	fprintf( aFile, "///\t@file %s\n", pBaseName );
+	fprintf( aFile, "///\t@brief Dictionary converted by dzcobs_dict\n" );
+	fprintf( aFile, "///\n" );
+	fprintf( aFile, "///\t@par  Plataform Target:\tAny\n" );
+	fprintf( aFile, "/// @par  Tab Size: 2\n" );
+	fprintf( aFile, "///\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n\n" );
+	fprintf( aFile, "// Includes\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n" );
+	fprintf( aFile, "#include <dzcobs/dzcobs_dictionary.h>\n\n" );
+	fprintf( aFile, "extern const char %s[];\n", aSymbol );
+	fprintf( aFile, "extern const size_t %s_size;\n\n", aSymbol );
+	fprintf( aFile, "// clang-format off\n\n" );
+	fprintf( aFile, "/// Dictionary string, descendent order, null terminated\n" );
+	fprintf( aFile, "const char %s[] =\n", aSymbol );
+
+	const uint8_t nWords = dict_tool_nwords( aCtx );
+
+	for( uint8_t i = 0; i < nWords; i++ )
+	{
+		uint8_t wordSize		 = 0;
+		const uint8_t *pWord = dzcobs_dictionary_get( aCtx, i, &wordSize );
+
+		fprintf( aFile, "\tDICT_ADD_WORD(%u, \"", wordSize );
+
+		for( uint8_t j = 0; j < wordSize; j++ )
+		{
+			fprintf( aFile, "\\x%02X", pWord[j] );
+		}
+
+		fprintf( aFile, "\")\n" );
+	}
+
+	fprintf( aFile, ";\n\n" );
+	fprintf( aFile, "// clang-format on\n\n" );
+	fprintf( aFile, "const size_t %s_size = sizeof( %s );\n\n", aSymbol, aSymbol );
+	fprintf( aFile, "// EOF\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n" );
+}
+
+/// Expression of the word bytes after the first one, as a big endian integer
+static void dict_tool_write_tail_key( FILE *aFile, uint8_t aWordSize )
+{
+	for( uint8_t i = 1; i < aWordSize; i++ )
+	{
+		const unsigned shift = 8u * (unsigned)( aWordSize - 1 - i );
+
+		if( shift > 0 )
+		{
+			fprintf( aFile, "( (uint32_t)aKey[%u] << %u ) | ", i, shift );
+		}
+		else
+		{
+			fprintf( aFile, "aKey[%u]", i );
+		}
+	}
+}
+
+static uint32_t dict_tool_tail_key( const uint8_t *aWord, uint8_t aWordSize )
+{
+	uint32_t key = 0;
+
+	for( uint8_t i = 1; i < aWordSize; i++ )
+	{
+		key = ( key << 8 ) | aWord[i];
+	}
+
+	return key;
+}
+
+/// Matches the words that start with aFirstByte, shortest first as dzcobs_dictionary_search
+static void dict_tool_write_matcher_case( FILE *aFile, const sDICT_ctx *aCtx, uint8_t aFirstByte )
+{
+	fprintf( aFile, "\tcase 0x%02X:\n", aFirstByte );
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *pEntry = &aCtx->wordSizeTable[i];
+		const uint8_t wordSize				= (uint8_t)( pEntry->strideSize - 1 );
+		uint8_t nMatches							= 0;
+
+		for( uint8_t j = 0; j < pEntry->nEntries; j++ )
+		{
+			nMatches += ( pEntry->dictionaryBegin[1 + ( j * pEntry->strideSize )] == aFirstByte ) ? 1 : 0;
+		}
+
+		if( nMatches == 0 )
+		{
+			continue;
+		}
+
+		// The key is at least minWordSize bytes
+		const char *pIndent = ( wordSize > aCtx->minWordSize ) ? "\t\t\t" : "\t\t";
+
+		if( wordSize > aCtx->minWordSize )
+		{
+			fprintf( aFile, "\t\tif( aKeySize >= %u )\n\t\t{\n", wordSize );
+		}
+
+		fprintf( aFile, "%sswitch( ", pIndent );
+		dict_tool_write_tail_key( aFile, wordSize );
+		fprintf( aFile, " )\n%s{\n", pIndent );
+
+		for( uint8_t j = 0; j < pEntry->nEntries; j++ )
+		{
+			const uint8_t *pWord = &pEntry->dictionaryBegin[1 + ( j * pEntry->strideSize )];
+
+			if( pWord[0] == aFirstByte )
+			{
+				fprintf( aFile,
+								 "%scase 0x%0*XU:\n",
+								 pIndent,
+								 2 * ( wordSize - 1 ),
+								 (unsigned)dict_tool_tail_key( pWord, wordSize ) );
+				fprintf( aFile, "%s\t*aOutKeySizeFound = %u;\n", pIndent, wordSize );
+				fprintf( aFile, "%s\treturn %u;\n", pIndent, (unsigned)( pEntry->globalIndex + j ) );
+			}
+		}
+
+		fprintf( aFile, "%sdefault:\n%s\tbreak;\n%s}\n", pIndent, pIndent, pIndent );
+
+		if( wordSize > aCtx->minWordSize )
+		{
+			fprintf( aFile, "\t\t}\n" );
+		}
+	}
+
+	fprintf( aFile, "\t\treturn 0;\n\n" );
+}
+
+static void dict_tool_write_matcher( FILE *aFile,
+																		 const char *aFileName,
+																		 const char *aSymbol,
+																		 const char *aDictionary,
+																		 const sDICT_ctx *aCtx )
+{
+	const char *pBaseName = strrchr( aFileName, '/' );
+	pBaseName							= ( pBaseName != NULL ) ? ( pBaseName + 1 ) : aFileName;
+
+	const uint8_t nWords = dict_tool_nwords( aCtx );
+
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n" );
+	fprintf( aFile, "///\t@file %s\n", pBaseName );
+	fprintf( aFile, "///\t@brief Dictionary matcher generated by dzcobs_dict, do not edit\n" );
+	fprintf( aFile, "///\n" );
+	fprintf( aFile, "///\t@par  Plataform Target:\tAny\n" );
+	fprintf( aFile, "/// @par  Tab Size: 2\n" );
+	fprintf( aFile, "///\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n\n" );
+	fprintf( aFile, "// Includes\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n" );
+	fprintf( aFile, "#include <dzcobs/dzcobs_dictionary.h>\n\n" );
+	fprintf( aFile, "extern const sDICT_ctx %s;\n\n", aSymbol );
+	fprintf( aFile, "// Definitions\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n\n" );
+	fprintf( aFile, "// clang-format off\n\n" );
+	fprintf( aFile, "/// Dictionary string, descendent order, null terminated\n" );
+	fprintf( aFile, "static const char s_%s_Dictionary[] =\n", aSymbol );
+
+	for( uint8_t i = 0; i < nWords; i++ )
+	{
+		uint8_t wordSize		 = 0;
+		const uint8_t *pWord = dzcobs_dictionary_get( aCtx, i, &wordSize );
+
+		fprintf( aFile, "\tDICT_ADD_WORD(%u, \"", wordSize );
+
+		for( uint8_t j = 0; j < wordSize; j++ )
+		{
+			fprintf( aFile, "\\x%02X", pWord[j] );
+		}
+
+		fprintf( aFile, "\")\n" );
+	}
+
+	fprintf( aFile, ";\n\n" );
+	fprintf( aFile, "/// Offset of each word on the dictionary string, its size is the byte before\n" );
+	fprintf( aFile, "static const uint16_t s_%s_WordOffset[%u] = {", aSymbol, nWords );
+
+	for( uint8_t i = 0; i < nWords; i++ )
+	{
+		uint8_t wordSize		 = 0;
+		const uint8_t *pWord = dzcobs_dictionary_get( aCtx, i, &wordSize );
+
+		fprintf( aFile, "%s%u%s", ( ( i % 16 ) == 0 ) ? "\n\t" : " ",
+						 (unsigned)( pWord - (const uint8_t *)aDictionary ),
+						 ( i + 1 < nWords ) ? "," : "\n" );
+	}
+
+	fprintf( aFile, "};\n\n" );
+	fprintf( aFile, "// clang-format on\n\n" );
+	fprintf( aFile, "// Implementation\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n\n" );
+
+	// Search
+	fprintf( aFile,
+					 "static uint8_t %s_search( const uint8_t *aKey, size_t aKeySize, size_t *aOutKeySizeFound )\n{\n",
+					 aSymbol );
+	fprintf( aFile, "\t(void)aKeySize;\n\n" );
+	fprintf( aFile, "\tswitch( aKey[0] )\n\t{\n" );
+
+	bool isFirstByte[256] = { false };
+
+	for( uint8_t i = 0; i < nWords; i++ )
+	{
+		uint8_t wordSize = 0;
+		isFirstByte[dzcobs_dictionary_get( aCtx, i, &wordSize )[0]] = true;
+	}
+
+	for( unsigned b = 0; b < 256; b++ )
+	{
+		if( isFirstByte[b] )
+		{
+			dict_tool_write_matcher_case( aFile, aCtx, (uint8_t)b );
+		}
+	}
+
+	fprintf( aFile, "\tdefault:\n\t\treturn 0;\n\t}\n}\n\n" );
+
+	// Get
+	fprintf( aFile, "static const uint8_t *%s_get( uint8_t aIndex, uint8_t *aOutWordSize )\n{\n", aSymbol );
+	fprintf( aFile, "\tif( aIndex >= %u )\n\t{\n\t\treturn NULL;\n\t}\n\n", nWords );
+	fprintf( aFile,
+					 "\tconst uint8_t *pWord = (const uint8_t *)&s_%s_Dictionary[s_%s_WordOffset[aIndex]];\n\n",
+					 aSymbol,
+					 aSymbol );
+	fprintf( aFile, "\t*aOutWordSize = (uint8_t)( pWord[-1] - '0' );\n\n" );
+	fprintf( aFile, "\treturn pWord;\n}\n\n" );
+
+	// Context
+	fprintf( aFile, "const sDICT_ctx %s = {\n", aSymbol );
+	fprintf( aFile, "\t.wordSizeTable = {\n" );
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *pEntry = &aCtx->wordSizeTable[i];
+
+		if( pEntry->nEntries > 0 )
+		{
+			fprintf( aFile,
+							 "\t\t{ .dictionaryBegin = (const uint8_t *)&s_%s_Dictionary[%u],\n"
+							 "\t\t\t.nEntries = %u, .lastIndex = %u, .globalIndex = %u, .strideSize = %u },\n",
+							 aSymbol,
+							 (unsigned)( pEntry->dictionaryBegin - (const uint8_t *)aDictionary ),
+							 pEntry->nEntries,
+							 pEntry->lastIndex,
+							 pEntry->globalIndex,
+							 pEntry->strideSize );
+		}
+	}
+
+	fprintf( aFile, "\t},\n" );
+	fprintf( aFile, "\t.minWordSize = %u,\n", aCtx->minWordSize );
+	fprintf( aFile, "\t.maxWordSize = %u,\n", aCtx->maxWordSize );
+	fprintf( aFile, "\t.searchFunc = %s_search,\n", aSymbol );
+	fprintf( aFile, "\t.getFunc = %s_get,\n", aSymbol );
+	fprintf( aFile, "};\n\n" );
+	fprintf( aFile, "// EOF\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n" );
+}
+
+static void dict_tool_usage( const char *aProgram )
+{
+	fprintf( stderr,
+					 "usage: %s tobin [-p] [-a] <in.c> <out.dzd>\n"
+					 "       %s toc [-n symbol] <in.dzd> <out.c>\n"
+					 "       %s info <in.dzd>\n"
+					 "       %s gen [-n symbol] <in.c> <out.c>\n",
+					 aProgram,
+					 aProgram,
+					 aProgram,
+					 aProgram );
+	exit( EXIT_FAILURE );
+}
+
+static int dict_tool_tobin( int argc, char **argv, const char *aProgram )
+{
+	uint8_t indexes = 0;
+	int argIdx			= 0;
+
+	for( ; ( argIdx < argc ) && ( argv[argIdx][0] == '-' ); argIdx++ )
+	{
+		if( strcmp( argv[argIdx], "-p" ) == 0 )
+		{
+			indexes |= DZCOBS_DICTFILE_PACKED;
+		}
+		else if( strcmp( argv[argIdx], "-a" ) == 0 )
+		{
+			indexes |= DZCOBS_DICTFILE_AUTOMATON;
+		}
+		else
+		{
+			dict_tool_usage( aProgram );
+		}
+	}
+
+	if( ( argIdx + 2 ) != argc )
+	{
+		dict_tool_usage( aProgram );
+	}
+
+	char dictString[DICT_TOOL_DICT_STRING_SIZE];
+	const size_t dictSize = dict_tool_parse_source( argv[argIdx], dictString );
+
+	const eDICTVALID_ret validRet = dzcobs_dictionary_isvalid( dictString, dictSize );
+
+	if( validRet != DICT_IS_VALID )
+	{
+		fprintf( stderr, "dzcobs_dict: invalid dictionary (%d) in %s\n", (int)validRet, argv[argIdx] );
+		return EXIT_FAILURE;
+	}
+
+	const size_t imageSize = dzcobs_dictfile_size( dictString, dictSize, indexes );
+
+	// malloc memory is aligned for any type, so DZCOBS_DICTFILE_ALIGNMENT too
+	void *pImage		= malloc( imageSize );
+	size_t imageLen = 0;
+
+	if( ( pImage == NULL ) ||
+			( dzcobs_dictfile_write( dictString, dictSize, indexes, pImage, imageSize, &imageLen ) != DICT_RET_SUCCESS ) )
+	{
+		dict_tool_fatal( "cannot build the dictionary file", NULL );
+	}
+
+	FILE *pOutFile = fopen( argv[argIdx + 1], "wb" );
+
+	if( ( pOutFile == NULL ) || ( fwrite( pImage, 1, imageLen, pOutFile ) != imageLen ) || ( fclose( pOutFile ) != 0 ) )
+	{
+		dict_tool_fatal( "cannot write", argv[argIdx + 1] );
+	}
+
+	free( pImage );
+
+	return EXIT_SUCCESS;
+}
+
+static int dict_tool_toc( int argc, char **argv, const char *aProgram )
+{
+	const char *pSymbol = DICT_TOOL_DEFAULT_SYMBOL;
+	int argIdx					= 0;
+
+	if( ( argc > 0 ) && ( strcmp( argv[0], "-n" ) == 0 ) )
+	{
+		if( argc < 2 )
+		{
+			dict_tool_usage( aProgram );
+		}
+
+		pSymbol = argv[1];
+		argIdx	= 2;
+	}
+
+	if( ( argIdx + 2 ) != argc )
+	{
+		dict_tool_usage( aProgram );
+	}
+
+	sDICT_TOOL_image image;
+	sDICT_ctx dictCtx;
+
+	dict_tool_load( argv[argIdx], &image, &dictCtx );
+
+	FILE *pOutFile = fopen( argv[argIdx + 1], "w" );
+
+	if( pOutFile == NULL )
+	{
+		dict_tool_fatal( "cannot create", argv[argIdx + 1] );
+	}
+
+	dict_tool_write_source( pOutFile, argv[argIdx + 1], pSymbol, &dictCtx );
+
+	if( fclose( pOutFile ) != 0 )
+	{
+		dict_tool_fatal( "cannot write", argv[argIdx + 1] );
+	}
+
+	dict_tool_unmap( &image );
+
+	return EXIT_SUCCESS;
+}
+
+static int dict_tool_info( int argc, char **argv, const char *aProgram )
+{
+	if( argc != 1 )
+	{
+		dict_tool_usage( aProgram );
+	}
+
+	sDICT_TOOL_image image;
+	sDICT_ctx dictCtx;
+
+	dict_tool_load( argv[0], &image, &dictCtx );
+
+	const sDZCOBS_dictfile_header *pHeader = (const sDZCOBS_dictfile_header *)image.pData;
+
+	printf( "version:   %u\n", pHeader->version );
+	printf( "size:      %u bytes\n", (unsigned)pHeader->imageSize );
+	printf( "checksum:  0x%08X\n", (unsigned)pHeader->checksum );
+	printf( "words:     %u\n", dict_tool_nwords( &dictCtx ) );
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		if( dictCtx.wordSizeTable[i].nEntries > 0 )
+		{
+			printf( "  %u bytes: %u words\n",
+							(unsigned)( dictCtx.wordSizeTable[i].strideSize - 1 ),
+							dictCtx.wordSizeTable[i].nEntries );
+		}
+	}
+
+	printf( "packed:    %s (%u bytes)\n",
+					( pHeader->indexes & DZCOBS_DICTFILE_PACKED ) ? "yes" : "no",
+					(unsigned)pHeader->packedSize );
+	printf( "automaton: %s (%u bytes, %u classes)\n",
+					( pHeader->indexes & DZCOBS_DICTFILE_AUTOMATON ) ? "yes" : "no",
+					(unsigned)pHeader->automatonSize,
+					pHeader->nClasses );
+
+	dict_tool_unmap( &image );
+
+	return EXIT_SUCCESS;
+}
+
+static int dict_tool_gen( int argc, char **argv, const char *aProgram )
+{
+	const char *pSymbol = DICT_TOOL_DEFAULT_MATCHER_SYMBOL;
+	int argIdx					= 0;
+
+	if( ( argc > 0 ) && ( strcmp( argv[0], "-n" ) == 0 ) )
+	{
+		if( argc < 2 )
+		{
+			dict_tool_usage( aProgram );
+		}
+
+		pSymbol = argv[1];
+		argIdx	= 2;
+	}
+
+	if( ( argIdx + 2 ) != argc )
+	{
+		dict_tool_usage( aProgram );
+	}
+
+	char dictString[DICT_TOOL_DICT_STRING_SIZE];
+	const size_t dictSize = dict_tool_parse_source( argv[argIdx], dictString );
+
+	const eDICTVALID_ret validRet = dzcobs_dictionary_isvalid( dictString, dictSize );
+
+	if( validRet != DICT_IS_VALID )
+	{
+		fprintf( stderr, "dzcobs_dict: invalid dictionary (%d) in %s\n", (int)validRet, argv[argIdx] );
+		return EXIT_FAILURE;
+	}
+
+	sDICT_ctx dictCtx;
+
+	if( dzcobs_dictionary_init( &dictCtx, dictString, dictSize ) != DICT_RET_SUCCESS )
+	{
+		dict_tool_fatal( "cannot use the dictionary in", argv[argIdx] );
+	}
+
+	FILE *pOutFile = fopen( argv[argIdx + 1], "w" );
+
+	if( pOutFile == NULL )
+	{
+		dict_tool_fatal( "cannot create", argv[argIdx + 1] );
+	}
+
+	dict_tool_write_matcher( pOutFile, argv[argIdx + 1], pSymbol, dictString, &dictCtx );
+
+	if( fclose( pOutFile ) != 0 )
+	{
+		dict_tool_fatal( "cannot write", argv[argIdx + 1] );
+	}
+
+	return EXIT_SUCCESS;
+}
+
+int main( int argc, char **argv )
+{
+	if( argc < 2 )
+	{
+		dict_tool_usage( argv[0] );
+	}
+
+	if( strcmp( argv[1], "tobin" ) == 0 )
+	{
+		return dict_tool_tobin( argc - 2, argv + 2, argv[0] );
+	}
+
+	if( strcmp( argv[1], "toc" ) == 0 )
+	{
+		return dict_tool_toc( argc - 2, argv + 2, argv[0] );
+	}
+
+	if( strcmp( argv[1], "info" ) == 0 )
+	{
+		return dict_tool_info( argc - 2, argv + 2, argv[0] );
+	}
+
+	if( strcmp( argv[1], "gen" ) == 0 )
+	{
+		return dict_tool_gen( argc - 2, argv + 2, argv[0] );
+	}
+
+	dict_tool_usage( argv[0] );
+
+	return EXIT_FAILURE;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,692 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzcobs_train.c
+///	@brief Dictionary trainer, it writes a dictionary_default.c style source
+///
+/// Reads a corpus of sample payloads, counts its 2..5 bytes n-grams and keeps
+/// the most frequent ones as candidates. Words are then selected one by one by
+/// greedy marginal gain: the gain of a candidate is the reduction of the total
+/// encoded size of the corpus when it is added to the dictionary, measured by
+/// encoding every payload with the library encoder. So shadowed words (the
+/// search takes the shortest word first), overlapped matches, the code bytes and
+/// the 0x00 handling are all taken into account.
+///
+/// Candidates keep their last gain as an upper bound (lazy greedy), so only the
+/// candidates that may be the best are encoded again on each round.
+///
+/// Usage: dzcobs_train [options] <corpus files...>
+///  -o <file>     output C source (default: stdout)
+///  -n <symbol>   dictionary symbol name (default: G_DZCOBS_TrainedDictionary)
+///  -c <size>     split the files in payloads of this size (default: one payload
+///                per file)
+///  -m <size>     maximum corpus bytes to read (default: 262144)
+///  -w <count>    maximum number of words, 1..126 (default: 126)
+///  -k <count>    number of candidates (default: 256)
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzcobs/dzcobs.h>
+#include <dzcobs/dzcobs_dictionary.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+enum
+{
+	TRAIN_MIN_WORD_SIZE				= ( 2 ),
+	TRAIN_MAX_WORD_SIZE				= ( 5 ),
+	TRAIN_MAX_WORDS						= ( 126 ),
+	TRAIN_MIN_WORD_COUNT			= ( 2 ), ///< n-grams seen less times are not candidates
+	TRAIN_DICT_STRING_SIZE		= ( TRAIN_MAX_WORDS * ( TRAIN_MAX_WORD_SIZE + 1 ) + 1 ),
+	TRAIN_NGRAM_TABLE_INITIAL = ( 1 << 16 )
+};
+
+#define TRAIN_DEFAULT_SYMBOL "G_DZCOBS_TrainedDictionary"
+#define TRAIN_DEFAULT_MAX_CORPUS ( 256 * 1024 )
+#define TRAIN_DEFAULT_CANDIDATES ( 256 )
+
+typedef struct s_TRAIN_ngram
+{
+	uint32_t count;
+	uint8_t size; ///< 0 if the table entry is free
+	uint8_t bytes[TRAIN_MAX_WORD_SIZE];
+} sTRAIN_ngram;
+
+typedef struct s_TRAIN_payload
+{
+	size_t offset;
+	size_t size;
+} sTRAIN_payload;
+
+typedef struct s_TRAIN_candidate
+{
+	sTRAIN_ngram word;
+	long bound;		 ///< Last measured gain, or the estimated one, in bytes
+	size_t round;	 ///< Round where bound was measured, 0 if estimated
+	bool isSelected;
+} sTRAIN_candidate;
+
+typedef struct s_TRAIN_corpus
+{
+	uint8_t *pData;
+	size_t size;
+	size_t capacity;
+
+	sTRAIN_payload *pPayloads;
+	size_t nPayloads;
+	size_t maxPayloadSize;
+} sTRAIN_corpus;
+
+static uint8_t *s_pEncodeBuf = NULL;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static void train_fatal( const char *aMessage )
+{
+	fprintf( stderr, "dzcobs_train: %s\n", aMessage );
+	exit( EXIT_FAILURE );
+}
+
+static void *train_realloc( void *aPtr, size_t aSize )
+{
+	void *pNew = realloc( aPtr, aSize );
+
+	if( pNew == NULL )
+	{
+		train_fatal( "out of memory" );
+	}
+
+	return pNew;
+}
+
+static void train_add_payload( sTRAIN_corpus *aCorpus, size_t aOffset, size_t aSize )
+{
+	aCorpus->pPayloads = train_realloc( aCorpus->pPayloads, ( aCorpus->nPayloads + 1 ) * sizeof( sTRAIN_payload ) );
+
+	aCorpus->pPayloads[aCorpus->nPayloads].offset = aOffset;
+	aCorpus->pPayloads[aCorpus->nPayloads].size		= aSize;
+	aCorpus->nPayloads++;
+
+	if( aCorpus->maxPayloadSize < aSize )
+	{
+		aCorpus->maxPayloadSize = aSize;
+	}
+}
+
+/// Read a file to the corpus. Returns false if the corpus is full.
+static bool train_read_file( sTRAIN_corpus *aCorpus, const char *aFileName, size_t aChunkSize )
+{
+	FILE *pFile = fopen( aFileName, "rb" );
+
+	if( pFile == NULL )
+	{
+		fprintf( stderr, "dzcobs_train: cannot open %s\n", aFileName );
+		exit( EXIT_FAILURE );
+	}
+
+	const size_t fileOffset = aCorpus->size;
+
+	while( aCorpus->size < aCorpus->capacity )
+	{
+		const size_t nRead = fread( aCorpus->pData + aCorpus->size, 1, aCorpus->capacity - aCorpus->size, pFile );
+
+		if( nRead == 0 )
+		{
+			break;
+		}
+
+		aCorpus->size += nRead;
+	}
+
+	const bool isFull = ( aCorpus->size == aCorpus->capacity ) && ( fgetc( pFile ) != EOF );
+
+	fclose( pFile );
+
+	size_t offset = fileOffset;
+
+	while( offset < aCorpus->size )
+	{
+		size_t payloadSize = aCorpus->size - offset;
+
+		if( ( aChunkSize != 0 ) && ( payloadSize > aChunkSize ) )
+		{
+			payloadSize = aChunkSize;
+		}
+
+		train_add_payload( aCorpus, offset, payloadSize );
+		offset += payloadSize;
+	}
+
+	return !isFull;
+}
+
+static uint32_t train_ngram_hash( const uint8_t *aBytes, uint8_t aSize )
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u ^ aSize;
+
+	for( uint8_t i = 0; i < aSize; i++ )
+	{
+		hash ^= aBytes[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/// Add aCount to a n-gram. Returns true if it was not on the table.
+static bool train_ngram_insert( sTRAIN_ngram *aTable,
+																size_t aTableSize,
+																const uint8_t *aBytes,
+																uint8_t aSize,
+																uint32_t aCount )
+{
+	size_t idx = train_ngram_hash( aBytes, aSize ) & ( aTableSize - 1 );
+
+	while( aTable[idx].size != 0 )
+	{
+		if( ( aTable[idx].size == aSize ) && ( memcmp( aTable[idx].bytes, aBytes, aSize ) == 0 ) )
+		{
+			aTable[idx].count += aCount;
+			return false;
+		}
+
+		idx = ( idx + 1 ) & ( aTableSize - 1 );
+	}
+
+	aTable[idx].size	= aSize;
+	aTable[idx].count = aCount;
+	memcpy( aTable[idx].bytes, aBytes, aSize );
+
+	return true;
+}
+
+/// Count all the 2..5 bytes n-grams of the payloads
+static sTRAIN_ngram *train_count_ngrams( const sTRAIN_corpus *aCorpus, size_t *aOutTableSize )
+{
+	size_t tableSize = TRAIN_NGRAM_TABLE_INITIAL;
+	size_t nUsed		 = 0;
+
+	sTRAIN_ngram *pTable = train_realloc( NULL, tableSize * sizeof( sTRAIN_ngram ) );
+	memset( pTable, 0, tableSize * sizeof( sTRAIN_ngram ) );
+
+	for( size_t p = 0; p < aCorpus->nPayloads; p++ )
+	{
+		const uint8_t *pPayload		 = aCorpus->pData + aCorpus->pPayloads[p].offset;
+		const size_t payloadSize = aCorpus->pPayloads[p].size;
+
+		for( size_t i = 0; i < payloadSize; i++ )
+		{
+			for( uint8_t n = TRAIN_MIN_WORD_SIZE; ( n <= TRAIN_MAX_WORD_SIZE ) && ( ( i + n ) <= payloadSize ); n++ )
+			{
+				// Keep the load factor under 1/2
+				if( ( ( nUsed + 1 ) * 2 ) > tableSize )
+				{
+					const size_t newTableSize = tableSize * 2;
+					sTRAIN_ngram *pNewTable		= train_realloc( NULL, newTableSize * sizeof( sTRAIN_ngram ) );
+					memset( pNewTable, 0, newTableSize * sizeof( sTRAIN_ngram ) );
+
+					for( size_t j = 0; j < tableSize; j++ )
+					{
+						if( pTable[j].size != 0 )
+						{
+							train_ngram_insert( pNewTable, newTableSize, pTable[j].bytes, pTable[j].size, pTable[j].count );
+						}
+					}
+
+					free( pTable );
+					pTable		= pNewTable;
+					tableSize = newTableSize;
+				}
+
+				if( train_ngram_insert( pTable, tableSize, pPayload + i, n, 1 ) )
+				{
+					nUsed++;
+				}
+			}
+		}
+	}
+
+	*aOutTableSize = tableSize;
+
+	return pTable;
+}
+
+/// Estimated gain: each match replaces the word by a single code byte
+static long train_estimate( const sTRAIN_ngram *aNgram )
+{
+	return (long)aNgram->count * (long)( aNgram->size - 1 );
+}
+
+static int train_compare_estimate( const void *aLeft, const void *aRight )
+{
+	const long left	 = train_estimate( aLeft );
+	const long right = train_estimate( aRight );
+
+	return ( left < right ) ? 1 : ( ( left > right ) ? -1 : 0 );
+}
+
+/// Dictionary order: word size ascending, then bytes ascending
+static int train_compare_word( const void *aLeft, const void *aRight )
+{
+	const sTRAIN_ngram *pLeft	 = aLeft;
+	const sTRAIN_ngram *pRight = aRight;
+
+	if( pLeft->size != pRight->size )
+	{
+		return ( pLeft->size < pRight->size ) ? -1 : 1;
+	}
+
+	return memcmp( pLeft->bytes, pRight->bytes, pLeft->size );
+}
+
+/// Build a dictionary string from the words, sorting them. Returns its size
+/// including the terminator 0.
+static size_t train_build_dictionary( sTRAIN_ngram *aWords, size_t aNWords, char *aOutDict )
+{
+	qsort( aWords, aNWords, sizeof( sTRAIN_ngram ), train_compare_word );
+
+	char *pDict = aOutDict;
+
+	for( size_t i = 0; i < aNWords; i++ )
+	{
+		*pDict++ = (char)( '0' + aWords[i].size );
+		memcpy( pDict, aWords[i].bytes, aWords[i].size );
+		pDict += aWords[i].size;
+	}
+
+	*pDict++ = 0;
+
+	return (size_t)( pDict - aOutDict );
+}
+
+/// Total encoded size of the corpus, frames without the 0x00 delimiter
+static size_t train_encode_corpus( const sTRAIN_corpus *aCorpus, const sDICT_ctx *aDict )
+{
+	const eDZCOBS_encoding encoding = ( aDict == NULL ) ? DZCOBS_PLAIN : DZCOBS_USING_DICT_1;
+	const size_t encodeBufSize			= DZCOBS_MAX_ENCODED_SIZE( aCorpus->maxPayloadSize ) + DZCOBS_FRAME_HEADER_SIZE;
+
+	size_t total = 0;
+
+	for( size_t p = 0; p < aCorpus->nPayloads; p++ )
+	{
+		sDZCOBS_ctx ctx;
+		memset( &ctx, 0, sizeof( ctx ) );
+
+		if( aDict != NULL )
+		{
+			dzcobs_encode_set_dictionary( &ctx, aDict, DZCOBS_USING_DICT_1 );
+		}
+
+		size_t encodedSize = 0;
+
+		if( dzcobs_encode_inc_begin( &ctx, encoding, s_pEncodeBuf, encodeBufSize ) != DZCOBS_RET_SUCCESS )
+		{
+			train_fatal( "encoding failed" );
+		}
+
+		ctx.user6bits = 1;
+
+		if( ( dzcobs_encode_inc( &ctx, aCorpus->pData + aCorpus->pPayloads[p].offset, aCorpus->pPayloads[p].size ) !=
+					DZCOBS_RET_SUCCESS ) ||
+				( dzcobs_encode_inc_end( &ctx, &encodedSize ) != DZCOBS_RET_SUCCESS ) )
+		{
+			train_fatal( "encoding failed" );
+		}
+
+		total += encodedSize;
+	}
+
+	return total;
+}
+
+/// Encoded size of the corpus with the selected candidates and aExtra, if not NULL
+static size_t train_evaluate( const sTRAIN_corpus *aCorpus,
+															const sTRAIN_candidate *aCandidates,
+															size_t aNCandidates,
+															const sTRAIN_candidate *aExtra )
+{
+	sTRAIN_ngram words[TRAIN_MAX_WORDS];
+	size_t nWords = 0;
+
+	for( size_t i = 0; i < aNCandidates; i++ )
+	{
+		if( aCandidates[i].isSelected )
+		{
+			words[nWords++] = aCandidates[i].word;
+		}
+	}
+
+	if( aExtra != NULL )
+	{
+		words[nWords++] = aExtra->word;
+	}
+
+	if( nWords == 0 )
+	{
+		return train_encode_corpus( aCorpus, NULL );
+	}
+
+	char dictString[TRAIN_DICT_STRING_SIZE];
+	const size_t dictSize = train_build_dictionary( words, nWords, dictString );
+
+	sDICT_ctx dictCtx;
+
+	if( dzcobs_dictionary_init( &dictCtx, dictString, dictSize ) != DICT_RET_SUCCESS )
+	{
+		train_fatal( "invalid dictionary" );
+	}
+
+	return train_encode_corpus( aCorpus, &dictCtx );
+}
+
+static void train_write_source( FILE *aFile,
+																const char *aFileName,
+																const char *aSymbol,
+																const sTRAIN_ngram *aWords,
+																size_t aNWords,
+																size_t aCorpusSize,
+																size_t aNPayloads )
+{
+	const char *pBaseName = strrchr( aFileName, '/' );
+	pBaseName							= ( pBaseName != NULL ) ? ( pBaseName + 1 ) : aFileName;
+
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n" );
+	fprintf( aFile, "///\t@file %s\n", pBaseName );
+	fprintf( aFile, "///\t@brief Dictionary generated by dzcobs_train\n" );
+	fprintf( aFile, "/// Trained on %zu bytes of %zu sample payloads.\n", aCorpusSize, aNPayloads );
+	fprintf( aFile, "///\n" );
+	fprintf( aFile, "///\t@par  Plataform Target:\tAny\n" );
+	fprintf( aFile, "/// @par  Tab Size: 2\n" );
+	fprintf( aFile, "///\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n\n" );
+	fprintf( aFile, "// Includes\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n" );
+	fprintf( aFile, "#include <dzcobs/dzcobs_dictionary.h>\n\n" );
+	fprintf( aFile, "extern const char %s[];\n", aSymbol );
+	fprintf( aFile, "extern const size_t %s_size;\n\n", aSymbol );
+	fprintf( aFile, "// clang-format off\n\n" );
+	fprintf( aFile, "/// Dictionary string, descendent order, null terminated\n" );
+	fprintf( aFile, "const char %s[] =\n", aSymbol );
+
+	for( size_t i = 0; i < aNWords; i++ )
+	{
+		fprintf( aFile, "\tDICT_ADD_WORD(%u, \"", aWords[i].size );
+
+		for( uint8_t j = 0; j < aWords[i].size; j++ )
+		{
+			fprintf( aFile, "\\x%02X", aWords[i].bytes[j] );
+		}
+
+		fprintf( aFile, "\")\n" );
+	}
+
+	fprintf( aFile, ";\n\n" );
+	fprintf( aFile, "// clang-format on\n\n" );
+	fprintf( aFile, "const size_t %s_size = sizeof( %s );\n\n", aSymbol, aSymbol );
+	fprintf( aFile, "// EOF\n" );
+	fprintf( aFile, "// /////////////////////////////////////////////////////////////////////////////\n" );
+}
+
+static void train_usage( const char *aProgram )
+{
+	fprintf( stderr,
+					 "usage: %s [-o out.c] [-n symbol] [-c chunk size] [-m max corpus bytes] [-w max words] "
+					 "[-k candidates] <corpus files...>\n",
+					 aProgram );
+	exit( EXIT_FAILURE );
+}
+
+int main( int argc, char **argv )
+{
+	const char *pOutFileName = NULL;
+	const char *pSymbol			 = TRAIN_DEFAULT_SYMBOL;
+	size_t chunkSize				 = 0;
+	size_t maxCorpus				 = TRAIN_DEFAULT_MAX_CORPUS;
+	size_t maxWords					 = TRAIN_MAX_WORDS;
+	size_t nMaxCandidates		 = TRAIN_DEFAULT_CANDIDATES;
+
+	int argIdx = 1;
+
+	for( ; ( argIdx < argc ) && ( argv[argIdx][0] == '-' ); argIdx++ )
+	{
+		const char option = argv[argIdx][1];
+
+		if( ( argv[argIdx][2] != 0 ) || ( ( argIdx + 1 ) >= argc ) )
+		{
+			train_usage( argv[0] );
+		}
+
+		const char *pValue = argv[++argIdx];
+
+		switch( option )
+		{
+		case 'o':
+			pOutFileName = pValue;
+			break;
+
+		case 'n':
+			pSymbol = pValue;
+			break;
+
+		case 'c':
+			chunkSize = (size_t)strtoul( pValue, NULL, 0 );
+			break;
+
+		case 'm':
+			maxCorpus = (size_t)strtoul( pValue, NULL, 0 );
+			break;
+
+		case 'w':
+			maxWords = (size_t)strtoul( pValue, NULL, 0 );
+			break;
+
+		case 'k':
+			nMaxCandidates = (size_t)strtoul( pValue, NULL, 0 );
+			break;
+
+		default:
+			train_usage( argv[0] );
+		}
+	}
+
+	if( ( argIdx >= argc ) || ( maxCorpus == 0 ) || ( maxWords == 0 ) || ( maxWords > TRAIN_MAX_WORDS ) ||
+			( nMaxCandidates == 0 ) )
+	{
+		train_usage( argv[0] );
+	}
+
+	// Read the corpus
+
+	sTRAIN_corpus corpus;
+	memset( &corpus, 0, sizeof( corpus ) );
+
+	corpus.capacity = maxCorpus;
+	corpus.pData		= train_realloc( NULL, maxCorpus );
+
+	for( ; argIdx < argc; argIdx++ )
+	{
+		if( !train_read_file( &corpus, argv[argIdx], chunkSize ) )
+		{
+			fprintf( stderr, "dzcobs_train: corpus limited to %zu bytes\n", maxCorpus );
+			break;
+		}
+	}
+
+	if( corpus.nPayloads == 0 )
+	{
+		train_fatal( "empty corpus" );
+	}
+
+	s_pEncodeBuf = train_realloc( NULL, DZCOBS_MAX_ENCODED_SIZE( corpus.maxPayloadSize ) + DZCOBS_FRAME_HEADER_SIZE );
+
+	// Candidates, the most frequent n-grams by estimated gain
+
+	size_t tableSize			= 0;
+	sTRAIN_ngram *pNgrams = train_count_ngrams( &corpus, &tableSize );
+
+	qsort( pNgrams, tableSize, sizeof( sTRAIN_ngram ), train_compare_estimate );
+
+	sTRAIN_candidate *pCandidates = train_realloc( NULL, nMaxCandidates * sizeof( sTRAIN_candidate ) );
+	size_t nCandidates						= 0;
+
+	for( size_t i = 0; ( i < tableSize ) && ( nCandidates < nMaxCandidates ); i++ )
+	{
+		if( ( pNgrams[i].size != 0 ) && ( pNgrams[i].count >= TRAIN_MIN_WORD_COUNT ) )
+		{
+			pCandidates[nCandidates].word				= pNgrams[i];
+			pCandidates[nCandidates].bound			= train_estimate( &pNgrams[i] );
+			pCandidates[nCandidates].round			= 0;
+			pCandidates[nCandidates].isSelected = false;
+			nCandidates++;
+		}
+	}
+
+	free( pNgrams );
+
+	// Lazy greedy selection
+
+	const size_t plainSize = train_encode_corpus( &corpus, NULL );
+
+	size_t currentSize = plainSize;
+	size_t nSelected	 = 0;
+	size_t round			 = 1;
+	bool isSizeUsed[TRAIN_MAX_WORD_SIZE + 1];
+	size_t nSizesUsed = 0;
+
+	memset( isSizeUsed, 0, sizeof( isSizeUsed ) );
+
+	while( nSelected < maxWords )
+	{
+		sTRAIN_candidate *pBest = NULL;
+
+		for( size_t i = 0; i < nCandidates; i++ )
+		{
+			sTRAIN_candidate *pCandidate = &pCandidates[i];
+
+			if( pCandidate->isSelected ||
+					( ( !isSizeUsed[pCandidate->word.size] ) && ( nSizesUsed == DICT_MAX_DIFFERENTWORDSIZES ) ) )
+			{
+				continue;
+			}
+
+			if( ( pBest == NULL ) || ( pCandidate->bound > pBest->bound ) )
+			{
+				pBest = pCandidate;
+			}
+		}
+
+		if( ( pBest == NULL ) || ( pBest->bound <= 0 ) )
+		{
+			break;
+		}
+
+		if( pBest->round != round )
+		{
+			// Stale bound, measure it with the current selection
+			pBest->bound = (long)currentSize - (long)train_evaluate( &corpus, pCandidates, nCandidates, pBest );
+			pBest->round = round;
+			continue;
+		}
+
+		// Its gain is up to date and no other candidate can do better
+		pBest->isSelected = true;
+		currentSize -= (size_t)pBest->bound;
+		nSelected++;
+		round++;
+
+		if( !isSizeUsed[pBest->word.size] )
+		{
+			isSizeUsed[pBest->word.size] = true;
+			nSizesUsed++;
+		}
+	}
+
+	if( nSelected == 0 )
+	{
+		train_fatal( "no word reduces the encoded size of the corpus" );
+	}
+
+	// Output
+
+	sTRAIN_ngram words[TRAIN_MAX_WORDS];
+	size_t nWords = 0;
+
+	for( size_t i = 0; i < nCandidates; i++ )
+	{
+		if( pCandidates[i].isSelected )
+		{
+			words[nWords++] = pCandidates[i].word;
+		}
+	}
+
+	char dictString[TRAIN_DICT_STRING_SIZE];
+	const size_t dictSize = train_build_dictionary( words, nWords, dictString );
+
+	if( dzcobs_dictionary_isvalid( dictString, dictSize ) != DICT_IS_VALID )
+	{
+		train_fatal( "invalid dictionary" );
+	}
+
+	FILE *pOutFile = stdout;
+
+	if( pOutFileName != NULL )
+	{
+		pOutFile = fopen( pOutFileName, "w" );
+
+		if( pOutFile == NULL )
+		{
+			train_fatal( "cannot create the output file" );
+		}
+	}
+
+	train_write_source( pOutFile,
+											( pOutFileName != NULL ) ? pOutFileName : "dictionary_trained.c",
+											pSymbol,
+											words,
+											nWords,
+											corpus.size,
+											corpus.nPayloads );
+
+	if( ( pOutFile != stdout ) && ( fclose( pOutFile ) != 0 ) )
+	{
+		train_fatal( "cannot write the output file" );
+	}
+
+	fprintf( stderr,
+					 "dzcobs_train: %zu payloads, %zu bytes, %zu candidates, %zu words\n",
+					 corpus.nPayloads,
+					 corpus.size,
+					 nCandidates,
+					 nWords );
+	fprintf( stderr,
+					 "dzcobs_train: encoded %zu bytes plain, %zu bytes with the dictionary (%.1f%%)\n",
+					 plainSize,
+					 currentSize,
+					 ( 100.0 * (double)currentSize ) / (double)plainSize );
+
+	free( pCandidates );
+	free( s_pEncodeBuf );
+	free( corpus.pPayloads );
+	free( corpus.pData );
+
+	return EXIT_SUCCESS;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////